@@ -53,3 +53,35 @@ AC_DEFUN([SECP_SET_DEFAULT], [
     $1="$2"
   fi
 ])
+
+dnl Check whether the compiler can build functions for AVX2 (without enabling it globally)
+dnl and detect CPU support at runtime.
+AC_DEFUN([SECP_X86_SIMD_CHECK],[
+AC_MSG_CHECKING(for x86 SIMD intrinsics with runtime CPU detection)
+AC_LINK_IFELSE([AC_LANG_PROGRAM([[
+  #include <immintrin.h>
+  __attribute__((target("avx2"))) static int f(void) {
+    __m256i a = _mm256_set1_epi32(1);
+    return _mm256_movemask_epi8(_mm256_blendv_epi8(a, _mm256_cmpeq_epi32(a, a), a));
+  }]],[[
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") ? f() : 0;
+  ]])],[has_x86_simd=yes],[has_x86_simd=no])
+AC_MSG_RESULT([$has_x86_simd])
+])
+
+dnl Check whether the compiler can build functions for the SHA extensions and detect CPU
+dnl support at runtime (GCC before 11 does not know the "sha" CPU feature).
+AC_DEFUN([SECP_X86_SHANI_CHECK],[
+AC_MSG_CHECKING(for x86 SHA extensions intrinsics with runtime CPU detection)
+AC_LINK_IFELSE([AC_LANG_PROGRAM([[
+  #include <immintrin.h>
+  __attribute__((target("sha,sse4.1"))) static int g(void) {
+    __m128i a = _mm_set1_epi32(1);
+    return _mm_extract_epi32(_mm_sha256rnds2_epu32(a, a, a), 0);
+  }]],[[
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("sha") ? g() : 0;
+  ]])],[has_x86_shani=yes],[has_x86_shani=no])
+AC_MSG_RESULT([$has_x86_shani])
+])
@@ -196,6 +196,7 @@ typedef int (*secp256k1_nonce_function)(
 #define SECP256K1_FLAGS_BIT_CONTEXT_VERIFY (1 << 8)
 #define SECP256K1_FLAGS_BIT_CONTEXT_SIGN (1 << 9)
 #define SECP256K1_FLAGS_BIT_CONTEXT_DECLASSIFY (1 << 10)
+#define SECP256K1_FLAGS_BIT_CONTEXT_LARGE_GEN_TABLE (1 << 11)
 #define SECP256K1_FLAGS_BIT_COMPRESSION (1 << 8)
 
 /** Context flags to pass to secp256k1_context_create, secp256k1_context_preallocated_size, and
@@ -206,6 +207,11 @@ typedef int (*secp256k1_nonce_function)(
 #define SECP256K1_CONTEXT_VERIFY (SECP256K1_FLAGS_TYPE_CONTEXT | SECP256K1_FLAGS_BIT_CONTEXT_VERIFY)
 #define SECP256K1_CONTEXT_SIGN (SECP256K1_FLAGS_TYPE_CONTEXT | SECP256K1_FLAGS_BIT_CONTEXT_SIGN)
 
+/** Context flag to make the context build a larger table for multiplication with the
+ *  generator at creation time (see secp256k1_context_create). It can be combined with
+ *  the other context flags. */
+#define SECP256K1_CONTEXT_LARGE_GEN_TABLE (SECP256K1_FLAGS_TYPE_CONTEXT | SECP256K1_FLAGS_BIT_CONTEXT_LARGE_GEN_TABLE)
+
 /* Testing flag. Do not use. */
 #define SECP256K1_CONTEXT_DECLASSIFY (SECP256K1_FLAGS_TYPE_CONTEXT | SECP256K1_FLAGS_BIT_CONTEXT_DECLASSIFY)
 
@@ -264,14 +270,21 @@ SECP256K1_API void secp256k1_selftest(void);
  *  secp256k1_preallocated.h.
  *
  *  Returns: a newly created context object.
- *  In:      flags: Always set to SECP256K1_CONTEXT_NONE (see below).
+ *  In:      flags: Set to SECP256K1_CONTEXT_NONE or SECP256K1_CONTEXT_LARGE_GEN_TABLE
+ *                  (see below).
  *
- *  The only valid non-deprecated flag in recent library versions is
- *  SECP256K1_CONTEXT_NONE, which will create a context sufficient for all functionality
- *  offered by the library. All other (deprecated) flags will be treated as equivalent
- *  to the SECP256K1_CONTEXT_NONE flag. Though the flags parameter primarily exists for
+ *  The flag SECP256K1_CONTEXT_NONE will create a context sufficient for all functionality
+ *  offered by the library. All deprecated flags will be treated as equivalent to the
+ *  SECP256K1_CONTEXT_NONE flag. Though the flags parameter primarily exists for
  *  historical reasons, future versions of the library may introduce new flags.
  *
+ *  With SECP256K1_CONTEXT_LARGE_GEN_TABLE, the context additionally builds and stores
+ *  a table of 256 kB for multiplication with the generator, which is used instead of
+ *  the table compiled into the library. This makes signing and public key generation
+ *  faster, at the cost of memory and a context creation time of a few milliseconds.
+ *  If the table compiled into the library is at least as large (see the
+ *  --with-ecmult-gen-kb configure option), the flag has no effect.
+ *
  *  If the context is intended to be used for API functions that perform computations
  *  involving secret keys, e.g., signing and public key generation, then it is highly
  *  recommended to call secp256k1_context_randomize on the context before calling
@@ -430,6 +443,80 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ec_pubkey_parse(
     size_t inputlen
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
 
+/** Opaque data structure that caches decompressed public keys.
+ *
+ *  Parsing a compressed public key requires computing a square root to
+ *  recover its Y coordinate, which dominates the cost of parsing. The cache
+ *  stores the points of parsed public keys, so that parsing a public key
+ *  with the same X coordinate again only requires a hash computation and a
+ *  table lookup.
+ *
+ *  The cache uses a fixed amount of memory. It is organized as a
+ *  set-associative table whose sets are selected by a salted hash of the X
+ *  coordinate. When a set is full, inserting an entry replaces another one.
+ *
+ *  Lookups only read the cache, so any number of threads can parse with the
+ *  same cache concurrently as long as they do not store results (i.e., pass
+ *  store = 0). Parsing that stores results must not run concurrently with
+ *  any other use of the cache.
+ */
+typedef struct secp256k1_pubkey_cache_struct secp256k1_pubkey_cache;
+
+/** Create a public key cache.
+ *
+ *  Returns: a newly created public key cache, or NULL if size is too small
+ *           for a single set of entries.
+ *  Args:    ctx: a secp256k1 context object.
+ *  In:     size: the memory in bytes to use for the entries of the cache.
+ *                Every entry requires 64 bytes (on most platforms), and a
+ *                set consists of 4 entries.
+ *        salt32: pointer to 32 random bytes. The salt prevents an attacker
+ *                from predicting the positions of entries in the cache.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT secp256k1_pubkey_cache *secp256k1_pubkey_cache_create(
+    const secp256k1_context* ctx,
+    size_t size,
+    const unsigned char *salt32
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(3);
+
+/** Destroy a public key cache.
+ *
+ *  Args:   ctx: a secp256k1 context object.
+ *        cache: pointer to the cache to destroy (can be NULL, in which case
+ *               this function does nothing).
+ */
+SECP256K1_API void secp256k1_pubkey_cache_destroy(
+    const secp256k1_context* ctx,
+    secp256k1_pubkey_cache *cache
+) SECP256K1_ARG_NONNULL(1);
+
+/** Parse a variable-length public key into the pubkey object with a public
+ *  key cache.
+ *
+ *  Same as secp256k1_ec_pubkey_parse, but compressed public keys whose X
+ *  coordinate is found in the cache are not decompressed. Public keys in
+ *  other formats are parsed without using the cache.
+ *
+ *  Returns: 1 if the public key was fully valid.
+ *           0 if the public key could not be parsed or is invalid.
+ *  Args: ctx:      a secp256k1 context object.
+ *        cache:    pointer to a public key cache.
+ *  Out:  pubkey:   pointer to a pubkey object. If 1 is returned, it is set to a
+ *                  parsed version of input. If not, its value is undefined.
+ *  In:   input:    pointer to a serialized public key
+ *        inputlen: length of the array pointed to by input
+ *        store:    if non-zero, a valid compressed public key that is not in
+ *                  the cache yet is inserted.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ec_pubkey_parse_cached(
+    const secp256k1_context* ctx,
+    secp256k1_pubkey_cache *cache,
+    secp256k1_pubkey* pubkey,
+    const unsigned char *input,
+    size_t inputlen,
+    int store
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
 /** Serialize a pubkey object into a serialized byte sequence.
  *
  *  Returns: 1 always.
@@ -576,6 +663,170 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdsa_verify(
     const secp256k1_pubkey *pubkey
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
 
+/** Verify several ECDSA signatures.
+ *
+ *  Gives the same result for every signature as secp256k1_ecdsa_verify, but
+ *  is faster, because up to four verifications are computed side by side in
+ *  the same loop (most effectively on CPUs with AVX2). Unlike batch
+ *  verification, every signature gets its own result at no extra cost.
+ *
+ *  Returns: 1: all signatures are correct (this includes the case n = 0)
+ *           0: at least one signature is incorrect or unparseable
+ *  Args:    ctx:        a secp256k1 context object.
+ *  Out:     results:    pointer to an array of n ints. results[i] is set to 1
+ *                       if the i-th signature is correct and to 0 otherwise.
+ *  In:      sigs:       array of n pointers to the signatures being verified.
+ *           msghash32s: array of n pointers to the 32-byte message hashes
+ *                       being verified (see secp256k1_ecdsa_verify).
+ *           pubkeys:    array of n pointers to public keys to verify with.
+ *           n:          number of signatures. The arrays can only be NULL if n
+ *                       is 0.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdsa_verify_many(
+    const secp256k1_context* ctx,
+    int *results,
+    const secp256k1_ecdsa_signature * const *sigs,
+    const unsigned char * const *msghash32s,
+    const secp256k1_pubkey * const *pubkeys,
+    size_t n
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
+/** Opaque data structure that holds precomputed tables for verifying
+ *  signatures under a single public key.
+ *
+ *  Building the object costs about as much as a signature verification and
+ *  it requires 8 KiB of memory (on most platforms), but verifications with it
+ *  are about a quarter faster than with the public key itself. It is
+ *  worthwhile for public keys that are used to verify many signatures.
+ *
+ *  The object can be used with secp256k1_ecdsa_verify_precomp and, if the
+ *  schnorrsig module is enabled, secp256k1_schnorrsig_verify_precomp.
+ */
+typedef struct secp256k1_pubkey_precomp_struct secp256k1_pubkey_precomp;
+
+/** Create a precomputation object for a public key.
+ *
+ *  Returns: a newly created precomputation object, or NULL if the public key
+ *           is invalid.
+ *  Args:    ctx: a secp256k1 context object.
+ *  In:   pubkey: pointer to a public key.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT secp256k1_pubkey_precomp *secp256k1_pubkey_precomp_create(
+    const secp256k1_context* ctx,
+    const secp256k1_pubkey *pubkey
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
+/** Destroy a precomputation object.
+ *
+ *  Args:     ctx: a secp256k1 context object.
+ *        precomp: pointer to the precomputation object to destroy (can be
+ *                 NULL, in which case this function does nothing).
+ */
+SECP256K1_API void secp256k1_pubkey_precomp_destroy(
+    const secp256k1_context* ctx,
+    secp256k1_pubkey_precomp *precomp
+) SECP256K1_ARG_NONNULL(1);
+
+/** Verify an ECDSA signature with a precomputation object.
+ *
+ *  Same as secp256k1_ecdsa_verify, but with the public key that precomp was
+ *  created for.
+ *
+ *  Returns: 1: correct signature
+ *           0: incorrect or unparseable signature
+ *  Args:    ctx:       a secp256k1 context object.
+ *  In:      sig:       the signature being verified.
+ *           msghash32: the 32-byte message hash being verified (see
+ *                      secp256k1_ecdsa_verify).
+ *           precomp:   pointer to a precomputation object for the public key
+ *                      to verify with.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdsa_verify_precomp(
+    const secp256k1_context* ctx,
+    const secp256k1_ecdsa_signature *sig,
+    const unsigned char *msghash32,
+    const secp256k1_pubkey_precomp *precomp
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
+/** Opaque data structure that caches the results of successful signature
+ *  verifications.
+ *
+ *  The cache uses a fixed amount of memory, and stores salted hashes of the
+ *  verified signatures, messages and public keys in a cuckoo hash table.
+ *  When the cache is full, inserting an entry drops another one.
+ *
+ *  Lookups only read the cache, so any number of threads can verify with
+ *  the same cache concurrently as long as they do not store results (i.e.,
+ *  pass store = 0). Verifications that store results must not run
+ *  concurrently with any other use of the cache.
+ */
+typedef struct secp256k1_sigcache_struct secp256k1_sigcache;
+
+/** Counters for cache lookups.
+ *
+ *  A verification with a cache increments hits if the signature was found
+ *  in the cache and misses otherwise. Threads that use the same cache
+ *  concurrently should use separate counters.
+ */
+typedef struct {
+    size_t hits;
+    size_t misses;
+} secp256k1_sigcache_stats;
+
+/** Create a signature cache.
+ *
+ *  Returns: a newly created signature cache, or NULL if size is too small
+ *           for a single entry.
+ *  Args:    ctx: a secp256k1 context object.
+ *  In:     size: the memory in bytes to use for the entries of the cache.
+ *                Every entry requires 32 bytes.
+ *        salt32: pointer to 32 random bytes. The salt prevents an attacker
+ *                from predicting the positions of entries in the cache.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT secp256k1_sigcache *secp256k1_sigcache_create(
+    const secp256k1_context* ctx,
+    size_t size,
+    const unsigned char *salt32
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(3);
+
+/** Destroy a signature cache.
+ *
+ *  Args:   ctx: a secp256k1 context object.
+ *        cache: pointer to the cache to destroy (can be NULL, in which case
+ *               this function does nothing).
+ */
+SECP256K1_API void secp256k1_sigcache_destroy(
+    const secp256k1_context* ctx,
+    secp256k1_sigcache *cache
+) SECP256K1_ARG_NONNULL(1);
+
+/** Verify an ECDSA signature with a signature cache.
+ *
+ *  Same as secp256k1_ecdsa_verify, but returns 1 without verifying if the
+ *  signature is found in the cache.
+ *
+ *  Returns: 1: correct signature
+ *           0: incorrect or unparseable signature
+ *  Args:    ctx:       a secp256k1 context object.
+ *           cache:     pointer to a signature cache.
+ *           stats:     pointer to lookup counters to update (can be NULL).
+ *  In:      sig:       the signature being verified.
+ *           msghash32: the 32-byte message hash being verified (see
+ *                      secp256k1_ecdsa_verify).
+ *           pubkey:    pointer to an initialized public key to verify with.
+ *           store:     if non-zero, a correct signature that is not in the
+ *                      cache yet is inserted.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdsa_verify_cached(
+    const secp256k1_context* ctx,
+    secp256k1_sigcache *cache,
+    secp256k1_sigcache_stats *stats,
+    const secp256k1_ecdsa_signature *sig,
+    const unsigned char *msghash32,
+    const secp256k1_pubkey *pubkey,
+    int store
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5) SECP256K1_ARG_NONNULL(6);
+
 /** Convert a signature to a normalized lower-S form.
  *
  *  Returns: 1 if sigin was not normalized, 0 if it already was.
@@ -659,6 +910,122 @@ SECP256K1_API int secp256k1_ecdsa_sign(
     const void *ndata
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
 
+/** Create ECDSA signatures for many messages with the same secret key.
+ *
+ *  Produces the same signatures as calling secp256k1_ecdsa_sign for every
+ *  message, but faster, because the inversions of the nonces and the
+ *  conversions of the nonce points to affine coordinates are shared between
+ *  the signatures.
+ *
+ *  Returns: 1: all signatures created
+ *           0: the nonce generation function failed for at least one message,
+ *              or the secret key was invalid. The signatures that could not
+ *              be created are cleared.
+ *  Args:    ctx:        pointer to a context object (not secp256k1_context_static).
+ *  Out:     sigs:       pointer to an array of n signatures.
+ *  In:      msghash32s: array of n pointers to the 32-byte message hashes
+ *                       being signed.
+ *           n:          number of messages. The arrays can only be NULL if n
+ *                       is 0.
+ *           seckey:     pointer to a 32-byte secret key.
+ *           noncefp:    pointer to a nonce generation function. If NULL,
+ *                       secp256k1_nonce_function_default is used.
+ *           ndata:      pointer to arbitrary data used by the nonce generation
+ *                       function for every message (see secp256k1_ecdsa_sign).
+ */
+SECP256K1_API int secp256k1_ecdsa_sign_batch(
+    const secp256k1_context* ctx,
+    secp256k1_ecdsa_signature *sigs,
+    const unsigned char * const *msghash32s,
+    size_t n,
+    const unsigned char *seckey,
+    secp256k1_nonce_function noncefp,
+    const void *ndata
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(5);
+
+/** Opaque data structure that holds a secret key for repeated ECDSA signing.
+ *
+ *  Besides the secret key, it holds the part of the RFC6979 nonce derivation
+ *  that only depends on the secret key, so that signing with it (see
+ *  secp256k1_ecdsa_sign_with_key) saves three of the SHA256 compressions of
+ *  secp256k1_ecdsa_sign with the default nonce function.
+ *
+ *  The exact representation of data inside is implementation defined and not
+ *  guaranteed to be portable between different platforms or versions. It is
+ *  however guaranteed to be 96 bytes in size, and can be safely copied/moved.
+ *  It contains secret data and should be cleared like a secret key.
+ */
+typedef struct {
+    unsigned char data[96];
+} secp256k1_ecdsa_signing_key;
+
+/** Create a signing key from a secret key.
+ *
+ *  Returns: 1: secret key was valid, signing key created.
+ *           0: secret key was invalid, signing key cleared.
+ *  Args:    ctx:         pointer to a context object.
+ *  Out:     signing_key: pointer to the created signing key.
+ *  In:      seckey:      pointer to a 32-byte secret key.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdsa_signing_key_create(
+    const secp256k1_context* ctx,
+    secp256k1_ecdsa_signing_key *signing_key,
+    const unsigned char *seckey
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+/** Create an ECDSA signature with a signing key.
+ *
+ *  Produces the same signature as secp256k1_ecdsa_sign with the secret key
+ *  of the signing key, noncefp = NULL (the default RFC6979 nonce function)
+ *  and ndata = ndata32, but is faster.
+ *
+ *  Returns: 1: signature created
+ *           0: the signing key was invalid (i.e., it was cleared by a failed
+ *              call to secp256k1_ecdsa_signing_key_create).
+ *  Args:    ctx:         pointer to a context object (not secp256k1_context_static).
+ *  Out:     sig:         pointer to an array where the signature will be placed.
+ *  In:      msghash32:   the 32-byte message hash being signed.
+ *           signing_key: pointer to a signing key.
+ *           ndata32:     pointer to 32 bytes of extra entropy for the nonce
+ *                        function (can be NULL).
+ */
+SECP256K1_API int secp256k1_ecdsa_sign_with_key(
+    const secp256k1_context* ctx,
+    secp256k1_ecdsa_signature *sig,
+    const unsigned char *msghash32,
+    const secp256k1_ecdsa_signing_key *signing_key,
+    const unsigned char *ndata32
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
+/** Create an ECDSA signature with a low R value by grinding the nonce.
+ *
+ *  A signature whose R value is below 2^255 can be encoded in DER with one
+ *  byte less (71 bytes instead of 72, unless S is also small). This function
+ *  produces the same signature as calling secp256k1_ecdsa_sign_with_key first
+ *  with ndata32 = NULL and then with ndata32 set to the little endian encoding
+ *  of 1, 2, 3, ... (followed by zero bytes) until the R value of the signature
+ *  is below 2^255, which is what Bitcoin Core does. It is faster than that loop
+ *  because it only computes the nonce point for every attempt, and the rest of
+ *  the signature only for the accepted one.
+ *
+ *  On average, two attempts are needed. The number of attempts is not
+ *  secret, just like with the loop.
+ *
+ *  Returns: 1: signature created
+ *           0: the signing key was invalid (i.e., it was cleared by a failed
+ *              call to secp256k1_ecdsa_signing_key_create).
+ *  Args:    ctx:         pointer to a context object (not secp256k1_context_static).
+ *  Out:     sig:         pointer to an array where the signature will be placed.
+ *  In:      msghash32:   the 32-byte message hash being signed.
+ *           signing_key: pointer to a signing key.
+ */
+SECP256K1_API int secp256k1_ecdsa_sign_low_r(
+    const secp256k1_context* ctx,
+    secp256k1_ecdsa_signature *sig,
+    const unsigned char *msghash32,
+    const secp256k1_ecdsa_signing_key *signing_key
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
 /** Verify an ECDSA secret key.
  *
  *  A secret key is valid if it is not 0 and less than the secp256k1 curve order
@@ -690,6 +1057,59 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ec_pubkey_create(
     const unsigned char *seckey
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
 
+/** Compute the public keys for many secret keys.
+ *
+ *  Same as calling secp256k1_ec_pubkey_create for every secret key, but
+ *  faster, because the public keys share the field inversion that converts
+ *  them to affine coordinates.
+ *
+ *  Returns: 1: all secret keys were valid, public keys stored.
+ *           0: at least one secret key was invalid. The public keys of the
+ *              invalid secret keys are cleared, the others are stored.
+ *  Args:    ctx:     pointer to a context object (not secp256k1_context_static).
+ *  Out:     pubkeys: pointer to an array of n public keys to create.
+ *  In:      seckeys: array of n pointers to 32-byte secret keys.
+ *           n:       number of secret keys. The arrays can only be NULL if n
+ *                    is 0.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ec_pubkey_create_batch(
+    const secp256k1_context* ctx,
+    secp256k1_pubkey *pubkeys,
+    const unsigned char * const *seckeys,
+    size_t n
+) SECP256K1_ARG_NONNULL(1);
+
+/** Compute the public keys for a sequence of evenly spaced secret keys.
+ *
+ *  Computes the public keys for the secret keys seckey, seckey + step,
+ *  seckey + 2*step, ..., seckey + (n-1)*step (modulo the group order), e.g.,
+ *  for consecutive secret keys with step = 1. Only the first public key is
+ *  computed with a full point multiplication; every further public key is
+ *  obtained by adding step*G to the previous one, which is much faster than
+ *  calling secp256k1_ec_pubkey_create for every secret key.
+ *
+ *  The additions are not constant time, but they only operate on points
+ *  that are revealed by the outputs anyway.
+ *
+ *  Returns: 1: seckey and step were valid, and all public keys were stored.
+ *           0: seckey was invalid, step overflowed (in which case all public
+ *              keys are cleared), or one of the secret keys in the sequence
+ *              is zero (in which case only its public key is cleared).
+ *  Args:    ctx:     pointer to a context object (not secp256k1_context_static).
+ *  Out:     pubkeys: pointer to an array of n public keys to create.
+ *  In:      seckey:  pointer to the 32-byte secret key of the first public key.
+ *           step32:  pointer to the 32-byte difference between consecutive
+ *                    secret keys (can be zero).
+ *           n:       number of public keys. pubkeys can only be NULL if n is 0.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ec_pubkey_create_sequence(
+    const secp256k1_context* ctx,
+    secp256k1_pubkey *pubkeys,
+    const unsigned char *seckey,
+    const unsigned char *step32,
+    size_t n
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
 /** Negates a secret key in place.
  *
  *  Returns: 0 if the given secret key is invalid according to
@@ -900,6 +1320,117 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_tagged_sha256(
     size_t msglen
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(5);
 
+/** Compute tagged hashes of many messages of the same length under one tag.
+ *
+ *  Produces the same outputs as calling secp256k1_tagged_sha256 for every
+ *  message, but is faster: the tag is hashed only once, and on CPUs with AVX2
+ *  (but without the SHA extensions) eight messages are hashed in parallel.
+ *
+ *  Returns: 1 always.
+ *  Args:    ctx:     pointer to a context object
+ *  Out:     hash32s: array of n pointers to 32-byte arrays to store the
+ *                    resulting hashes
+ *  In:      tag:     pointer to an array containing the tag
+ *           taglen:  length of the tag array
+ *           msgs:    array of n pointers to arrays containing the messages
+ *           msglen:  length of every message array
+ *           n:       number of messages. The arrays can only be NULL if n is 0.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_tagged_sha256_batch(
+    const secp256k1_context* ctx,
+    unsigned char * const *hash32s,
+    const unsigned char *tag,
+    size_t taglen,
+    const unsigned char * const *msgs,
+    size_t msglen,
+    size_t n
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(3);
+
+/** Opaque data structure that holds a tagged hash state for a fixed tag.
+ *
+ *  It caches SHA256 of the prefix SHA256(tag)||SHA256(tag), so that hashing
+ *  a message under the tag does not need to hash the tag and the prefix again.
+ *  This halves the cost of tagged hashes of messages shorter than 56 bytes.
+ *
+ *  Besides the cached prefix, the object holds the state of a hash that is
+ *  being computed with secp256k1_tagged_hasher_write and
+ *  secp256k1_tagged_hasher_finalize. secp256k1_tagged_hasher_hash does not
+ *  modify the object, so it can be called from several threads at once.
+ *
+ *  The exact representation of data inside is implementation defined and not
+ *  guaranteed to be portable between different platforms or versions. It is
+ *  however guaranteed to be 136 bytes in size, and can be safely copied/moved,
+ *  e.g., to continue a partially written hash in different ways.
+ */
+typedef struct {
+    unsigned char data[136];
+} secp256k1_tagged_hasher;
+
+/** Initialize a tagged hasher for a tag.
+ *
+ *  Returns: 1 always.
+ *  Args:    ctx:    pointer to a context object
+ *  Out:     hasher: pointer to the tagged hasher to initialize
+ *  In:      tag:    pointer to an array containing the tag
+ *           taglen: length of the tag array
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_tagged_hasher_init(
+    const secp256k1_context* ctx,
+    secp256k1_tagged_hasher *hasher,
+    const unsigned char *tag,
+    size_t taglen
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+/** Compute a tagged hash with a tagged hasher.
+ *
+ *  Returns the same hash as secp256k1_tagged_sha256 with the tag of the hasher.
+ *  Neither uses nor modifies the state of a hash being written to the hasher.
+ *
+ *  Returns: 1 always.
+ *  Args:    ctx:    pointer to a context object
+ *  Out:     hash32: pointer to a 32-byte array to store the resulting hash
+ *  In:      hasher: pointer to an initialized tagged hasher
+ *           msg:    pointer to an array containing the message
+ *           msglen: length of the message array
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_tagged_hasher_hash(
+    const secp256k1_context* ctx,
+    unsigned char *hash32,
+    const secp256k1_tagged_hasher *hasher,
+    const unsigned char *msg,
+    size_t msglen
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
+/** Append data to the message that is being hashed with a tagged hasher.
+ *
+ *  Returns: 1 always.
+ *  Args:    ctx:    pointer to a context object
+ *  In/Out:  hasher: pointer to an initialized tagged hasher
+ *  In:      data:   pointer to an array containing the data
+ *           len:    length of the data array
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_tagged_hasher_write(
+    const secp256k1_context* ctx,
+    secp256k1_tagged_hasher *hasher,
+    const unsigned char *data,
+    size_t len
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+/** Finish the tagged hash of the data written to a tagged hasher.
+ *
+ *  Afterwards, the hasher is ready to hash a new message under the same tag.
+ *
+ *  Returns: 1 always.
+ *  Args:    ctx:    pointer to a context object
+ *  Out:     hash32: pointer to a 32-byte array to store the resulting hash
+ *  In/Out:  hasher: pointer to an initialized tagged hasher
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_tagged_hasher_finalize(
+    const secp256k1_context* ctx,
+    unsigned char *hash32,
+    secp256k1_tagged_hasher *hasher
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
 #ifdef __cplusplus
 }
 #endif
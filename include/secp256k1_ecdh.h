@@ -56,6 +56,40 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdh(
   void *data
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
 
+/** Compute EC Diffie-Hellman secrets of one secret key with many public keys
+ *  in constant time
+ *
+ *  Produces the same outputs as calling secp256k1_ecdh for every public key,
+ *  but is faster: the secret key is recoded only once, and the resulting
+ *  points are converted to affine coordinates with a shared field inversion.
+ *  hashfp is called once for every public key, in order.
+ *
+ *  Returns: 1: exponentiation was successful
+ *           0: seckey was invalid (zero or overflow), a public key was
+ *              invalid or hashfp returned 0 for at least one public key
+ *  Args:    ctx:        pointer to a context object.
+ *  Out:     outputs:    array of n pointers to arrays to be filled by hashfp.
+ *  In:      pubkeys:    array of n pointers to initialized public keys.
+ *           n:          number of public keys. The arrays can only be NULL if
+ *                       n is 0.
+ *           seckey:     a 32-byte scalar with which to multiply the points.
+ *           hashfp:     pointer to a hash function. If NULL,
+ *                       secp256k1_ecdh_hash_function_sha256 is used
+ *                       (in which case, 32 bytes will be written to every
+ *                       output).
+ *           data:       arbitrary data pointer that is passed through to hashfp
+ *                       (can be NULL for secp256k1_ecdh_hash_function_sha256).
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdh_batch(
+  const secp256k1_context* ctx,
+  unsigned char * const *outputs,
+  const secp256k1_pubkey * const *pubkeys,
+  size_t n,
+  const unsigned char *seckey,
+  secp256k1_ecdh_hash_function hashfp,
+  void *data
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(5);
+
 #ifdef __cplusplus
 }
 #endif
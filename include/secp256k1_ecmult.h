@@ -0,0 +1,260 @@
+/* Not SECP256K1_ECMULT_H, which is used by the internal src/ecmult.h. */
+#ifndef SECP256K1_ECMULT_API_H
+#define SECP256K1_ECMULT_API_H
+
+#include "secp256k1.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** This module exposes the multi-scalar multiplication used internally for
+ *  batch verification, i.e., the computation of
+ *
+ *    g_scalar*G + scalars[0]*pubkeys[0] + ... + scalars[n-1]*pubkeys[n-1]
+ *
+ *  for arbitrary public keys. Depending on the number of points and the size
+ *  of the scratch space, it uses Strauss' or Pippenger's algorithm and splits
+ *  the computation into batches. This is considerably faster than computing
+ *  the products separately (e.g., with secp256k1_ec_pubkey_tweak_mul) and
+ *  combining them with secp256k1_ec_pubkey_combine.
+ *
+ *  The computation is NOT constant time. It must not be used with secret
+ *  scalars or points.
+ */
+
+/** Compute a multi-scalar multiplication.
+ *
+ *  Returns: 1: the result is a valid public key, and was written to result.
+ *           0: a scalar overflows, a public key is invalid or the result is
+ *              the point at infinity (which cannot be represented as a
+ *              public key). In that case result is cleared.
+ *  Args:       ctx: pointer to a context object.
+ *          scratch: scratch space used for the computation (can be NULL, in
+ *                   which case all points are multiplied separately). Use
+ *                   secp256k1_ecmult_multi_scratch_size to obtain a size that
+ *                   allows processing all points in a single batch.
+ *  Out:     result: pointer to a public key object for the result.
+ *  In:  g_scalar32: pointer to a 32-byte scalar to multiply the generator with
+ *                   (can be NULL, in which case the generator is omitted).
+ *          pubkeys: array of n pointers to public keys.
+ *        scalars32: array of n pointers to 32-byte scalars.
+ *                n: number of public keys. The arrays can only be NULL if n
+ *                   is 0.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecmult_multi(
+    const secp256k1_context* ctx,
+    secp256k1_scratch_space *scratch,
+    secp256k1_pubkey *result,
+    const unsigned char *g_scalar32,
+    const secp256k1_pubkey * const *pubkeys,
+    const unsigned char * const *scalars32,
+    size_t n
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(3);
+
+/** A pointer to a function that runs tasks on a thread pool.
+ *
+ *  The function must call task(task_data, i) exactly once for every i in
+ *  [0, n_tasks), possibly concurrently on different threads, and return
+ *  only after all of these calls have completed.
+ *
+ *  Returns: 1 if all tasks have been run.
+ *           0 if the tasks could not be run, which causes
+ *           secp256k1_ecmult_multi_parallel to fail.
+ *  In:      task: pointer to the function that performs a task.
+ *      task_data: opaque data pointer to pass to task.
+ *        n_tasks: number of tasks.
+ *           data: arbitrary data pointer that is passed through.
+ */
+typedef int (*secp256k1_ecmult_multi_threadpool)(
+    void (*task)(void *task_data, size_t idx),
+    void *task_data,
+    size_t n_tasks,
+    void *data
+);
+
+/** Compute a multi-scalar multiplication using multiple threads.
+ *
+ *  Same as secp256k1_ecmult_multi, but the public keys are split into n_tasks
+ *  ranges of (almost) equal size, which are processed as independent tasks
+ *  by the caller-provided threadpool function. Each task uses an equal share
+ *  of the scratch space, so the scratch space should be n_tasks times as
+ *  large as for a single-threaded computation (see
+ *  secp256k1_ecmult_multi_scratch_size). The library itself does not create
+ *  any threads.
+ *
+ *  The illegal callback of ctx may be called from the tasks, e.g., if a
+ *  public key is invalid.
+ *
+ *  Returns: 1: the result is a valid public key, and was written to result.
+ *           0: a scalar overflows, a public key is invalid, the result is
+ *              the point at infinity or the threadpool function failed. In
+ *              that case result is cleared.
+ *  Args:       ctx: pointer to a context object.
+ *          scratch: scratch space that is split up between the tasks (can be
+ *                   NULL, in which case the computation is single-threaded).
+ *  Out:     result: pointer to a public key object for the result.
+ *  In:  g_scalar32: pointer to a 32-byte scalar to multiply the generator with
+ *                   (can be NULL, in which case the generator is omitted).
+ *          pubkeys: array of n pointers to public keys.
+ *        scalars32: array of n pointers to 32-byte scalars.
+ *                n: number of public keys. The arrays can only be NULL if n
+ *                   is 0.
+ *       threadpool: pointer to a function that runs the tasks.
+ *  threadpool_data: arbitrary data pointer passed to threadpool.
+ *          n_tasks: number of tasks to split the computation into, typically
+ *                   the number of threads. Must be greater than 0.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecmult_multi_parallel(
+    const secp256k1_context* ctx,
+    secp256k1_scratch_space *scratch,
+    secp256k1_pubkey *result,
+    const unsigned char *g_scalar32,
+    const secp256k1_pubkey * const *pubkeys,
+    const unsigned char * const *scalars32,
+    size_t n,
+    secp256k1_ecmult_multi_threadpool threadpool,
+    void *threadpool_data,
+    size_t n_tasks
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(8);
+
+/** Get the size of a scratch space that allows secp256k1_ecmult_multi to
+ *  process n public keys in a single batch. For more than about 90 public
+ *  keys this results in Pippenger's algorithm being used, for fewer in
+ *  Strauss' algorithm.
+ *
+ *  Returns: the scratch space size in bytes, or 0 if n is too large to be
+ *           processed in a single batch.
+ *  In:    n: number of public keys.
+ */
+SECP256K1_API size_t secp256k1_ecmult_multi_scratch_size(
+    size_t n
+);
+
+/** Opaque data structure that holds precomputed tables for a fixed set of
+ *  public keys.
+ *
+ *  It allows computing multi-scalar multiplications of these public keys
+ *  with varying scalars faster than secp256k1_ecmult_multi, because the
+ *  tables do not have to be rebuilt for every computation and most of the
+ *  point doublings are avoided. The object requires 8 KiB of memory per
+ *  public key (on most platforms).
+ *
+ *  The object can be serialized with secp256k1_ecmult_multi_precomp_serialize,
+ *  e.g., to compute the tables offline and load them at startup.
+ */
+typedef struct secp256k1_ecmult_multi_precomp_struct secp256k1_ecmult_multi_precomp;
+
+/** Create a precomputation object for a set of public keys.
+ *
+ *  Returns: a newly created precomputation object, or NULL if a public key
+ *           is invalid.
+ *  Args:    ctx: pointer to a context object.
+ *  In:  pubkeys: array of n pointers to public keys (can only be NULL if n
+ *                is 0).
+ *             n: number of public keys.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT secp256k1_ecmult_multi_precomp *secp256k1_ecmult_multi_precomp_create(
+    const secp256k1_context* ctx,
+    const secp256k1_pubkey * const *pubkeys,
+    size_t n
+) SECP256K1_ARG_NONNULL(1);
+
+/** Destroy a precomputation object.
+ *
+ *  Args:     ctx: pointer to a context object.
+ *        precomp: pointer to the precomputation object to destroy (can be
+ *                 NULL, in which case this function does nothing).
+ */
+SECP256K1_API void secp256k1_ecmult_multi_precomp_destroy(
+    const secp256k1_context* ctx,
+    secp256k1_ecmult_multi_precomp *precomp
+) SECP256K1_ARG_NONNULL(1);
+
+/** Compute a multi-scalar multiplication of the public keys of a
+ *  precomputation object, i.e.,
+ *
+ *    g_scalar*G + scalars[0]*pubkeys[0] + ... + scalars[n-1]*pubkeys[n-1]
+ *
+ *  where pubkeys are the n public keys that the object was created for.
+ *
+ *  The computation is NOT constant time. It must not be used with secret
+ *  scalars.
+ *
+ *  Returns: 1: the result is a valid public key, and was written to result.
+ *           0: a scalar overflows or the result is the point at infinity. In
+ *              that case result is cleared.
+ *  Args:       ctx: pointer to a context object.
+ *  Out:     result: pointer to a public key object for the result.
+ *  In:  g_scalar32: pointer to a 32-byte scalar to multiply the generator with
+ *                   (can be NULL, in which case the generator is omitted).
+ *          precomp: pointer to a precomputation object.
+ *        scalars32: array of n pointers to 32-byte scalars (can only be NULL
+ *                   if n is 0).
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecmult_multi_with_precomp(
+    const secp256k1_context* ctx,
+    secp256k1_pubkey *result,
+    const unsigned char *g_scalar32,
+    const secp256k1_ecmult_multi_precomp *precomp,
+    const unsigned char * const *scalars32
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(4);
+
+/** Get the size of the serialization of a precomputation object.
+ *
+ *  Returns: the size in bytes.
+ *  Args:     ctx: pointer to a context object.
+ *  In:   precomp: pointer to a precomputation object.
+ */
+SECP256K1_API size_t secp256k1_ecmult_multi_precomp_serialized_size(
+    const secp256k1_context* ctx,
+    const secp256k1_ecmult_multi_precomp *precomp
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
+/** Serialize a precomputation object into a byte sequence.
+ *
+ *  The serialization contains the precomputed tables and a checksum. It is
+ *  independent of the platform, but only valid for the version of this
+ *  library that created it.
+ *
+ *  Returns: 1 always.
+ *  Args:       ctx: pointer to a context object.
+ *  Out:     output: pointer to an array to store the serialization.
+ *  In/Out: outputlen: pointer to an integer which is initially set to the
+ *                   size of output, which must be at least
+ *                   secp256k1_ecmult_multi_precomp_serialized_size, and is
+ *                   overwritten with the written size.
+ *  In:     precomp: pointer to a precomputation object.
+ */
+SECP256K1_API int secp256k1_ecmult_multi_precomp_serialize(
+    const secp256k1_context* ctx,
+    unsigned char *output,
+    size_t *outputlen,
+    const secp256k1_ecmult_multi_precomp *precomp
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
+/** Parse a serialized precomputation object.
+ *
+ *  The checksum protects against accidental corruption, and every table
+ *  entry is checked to be a valid point. However, the tables are not
+ *  recomputed, so the serialization must come from a trusted source: the
+ *  results of secp256k1_ecmult_multi_with_precomp are only correct if the
+ *  serialization was created by secp256k1_ecmult_multi_precomp_serialize.
+ *
+ *  Returns: a newly created precomputation object, or NULL if the
+ *           serialization could not be parsed.
+ *  Args:      ctx: pointer to a context object.
+ *  In:      input: pointer to the serialization.
+ *        inputlen: length of the serialization.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT secp256k1_ecmult_multi_precomp *secp256k1_ecmult_multi_precomp_parse(
+    const secp256k1_context* ctx,
+    const unsigned char *input,
+    size_t inputlen
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SECP256K1_ECMULT_API_H */
@@ -50,6 +50,32 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_xonly_pubkey_parse(
     const unsigned char *input32
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
 
+/** Parse a 32-byte sequence into a xonly_pubkey object with a public key
+ *  cache.
+ *
+ *  Same as secp256k1_xonly_pubkey_parse, but the public key is not
+ *  decompressed if its X coordinate is found in the cache. The cache can be
+ *  shared with secp256k1_ec_pubkey_parse_cached.
+ *
+ *  Returns: 1 if the public key was fully valid.
+ *           0 if the public key could not be parsed or is invalid.
+ *
+ *  Args:   ctx: a secp256k1 context object.
+ *        cache: pointer to a public key cache.
+ *  Out: pubkey: pointer to a pubkey object. If 1 is returned, it is set to a
+ *               parsed version of input. If not, it's set to an invalid value.
+ *  In: input32: pointer to a serialized xonly_pubkey.
+ *        store: if non-zero, a valid public key that is not in the cache yet
+ *               is inserted.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_xonly_pubkey_parse_cached(
+    const secp256k1_context* ctx,
+    secp256k1_pubkey_cache *cache,
+    secp256k1_xonly_pubkey* pubkey,
+    const unsigned char *input32,
+    int store
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
+
 /** Serialize an xonly_pubkey object into a 32-byte sequence.
  *
  *  Returns: 1 always.
@@ -155,6 +181,47 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_xonly_pubkey_tweak_add_
     const unsigned char *tweak32
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5);
 
+/** Checks a batch of tweaked pubkeys, each of which must be the result of
+ *  calling secp256k1_xonly_pubkey_tweak_add with the corresponding
+ *  internal_pubkey and tweak32.
+ *
+ *  Checks a random linear combination of the tweak equations of all items
+ *  with a single multi-scalar multiplication, which is considerably faster
+ *  than calling secp256k1_xonly_pubkey_tweak_add_check for every item. The
+ *  random coefficients are derived from a hash of all inputs. Accepts exactly
+ *  the same items as secp256k1_xonly_pubkey_tweak_add_check (except with
+ *  negligible probability), including the check of the parity.
+ *
+ *  Returns: 1 if all tweaked pubkeys are correct (this includes the case n = 0),
+ *           0 if at least one is incorrect or the arguments are invalid.
+ *  Args:              ctx: pointer to a context object.
+ *                 scratch: scratch space used for the multi-scalar
+ *                          multiplication. Its size determines how many items
+ *                          can be checked at once; larger batches are split up.
+ *  Out:             valid: pointer to an array of n ints (can be NULL). If
+ *                          non-NULL, valid[i] is set to 1 if the i-th tweaked
+ *                          pubkey is correct and to 0 otherwise, locating the
+ *                          incorrect items by repeatedly checking halves of
+ *                          the batch.
+ *  In:   tweaked_pubkey32: array of n pointers to serialized xonly_pubkeys.
+ *       tweaked_pk_parity: array of n parities of the tweaked pubkeys.
+ *         internal_pubkey: array of n pointers to x-only public keys to apply
+ *                          the tweaks to.
+ *                 tweak32: array of n pointers to 32-byte tweaks.
+ *                       n: number of items in the batch. The arrays can only
+ *                          be NULL if n is 0.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_xonly_pubkey_tweak_add_check_batch(
+    const secp256k1_context* ctx,
+    secp256k1_scratch_space *scratch,
+    int *valid,
+    const unsigned char * const *tweaked_pubkey32,
+    const int *tweaked_pk_parity,
+    const secp256k1_xonly_pubkey * const *internal_pubkey,
+    const unsigned char * const *tweak32,
+    size_t n
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
 /** Compute the keypair for a secret key.
  *
  *  Returns: 1: secret was valid, keypair is ready to use
@@ -169,6 +236,27 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_keypair_create(
     const unsigned char *seckey
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
 
+/** Compute the keypairs for many secret keys.
+ *
+ *  Same as calling secp256k1_keypair_create for every secret key, but
+ *  faster (see secp256k1_ec_pubkey_create_batch).
+ *
+ *  Returns: 1: all secrets were valid, keypairs are ready to use
+ *           0: at least one secret was invalid. The keypairs of the invalid
+ *              secrets are cleared, the others are ready to use.
+ *  Args:     ctx: pointer to a context object (not secp256k1_context_static).
+ *  Out: keypairs: pointer to an array of n keypairs to create.
+ *  In:   seckeys: array of n pointers to 32-byte secret keys.
+ *              n: number of secret keys. The arrays can only be NULL if n is
+ *                 0.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_keypair_create_batch(
+    const secp256k1_context* ctx,
+    secp256k1_keypair *keypairs,
+    const unsigned char * const *seckeys,
+    size_t n
+) SECP256K1_ARG_NONNULL(1);
+
 /** Get the secret key from a keypair.
  *
  *  Returns: 1 always.
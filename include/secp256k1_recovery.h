@@ -106,6 +106,44 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdsa_recover(
     const unsigned char *msghash32
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
 
+/** Verify a batch of recoverable ECDSA signatures against known public keys.
+ *
+ *  Checks a random linear combination of the recovery equations of all
+ *  signatures with a single multi-scalar multiplication, which is
+ *  considerably faster than recovering the public keys one by one. The random
+ *  coefficients are derived from a hash of all inputs. A signature is
+ *  considered correct if and only if secp256k1_ecdsa_recover would recover
+ *  the given public key from it (except with negligible probability). In
+ *  particular, signatures with a high S value are accepted, unlike in
+ *  secp256k1_ecdsa_verify.
+ *
+ *  Returns: 1: all signatures are correct (this includes the case n_sigs = 0)
+ *           0: at least one signature is incorrect
+ *  Args:    ctx: a secp256k1 context object.
+ *       scratch: scratch space used for the multi-scalar multiplication. Its
+ *                size determines how many signatures can be checked at once;
+ *                larger batches are split up.
+ *  Out:   valid: pointer to an array of n_sigs ints (can be NULL). If non-NULL,
+ *                valid[i] is set to 1 if the i-th signature is correct and to
+ *                0 otherwise, locating the incorrect signatures by repeatedly
+ *                checking halves of the batch.
+ *  In:     sigs: array of n_sigs pointers to recoverable signatures.
+ *     msghash32: array of n_sigs pointers to the 32-byte message hashes
+ *                assumed to be signed.
+ *       pubkeys: array of n_sigs pointers to the expected public keys.
+ *        n_sigs: number of signatures in the batch. The arrays can only be
+ *                NULL if n_sigs is 0.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdsa_recoverable_verify_batch(
+    const secp256k1_context* ctx,
+    secp256k1_scratch_space *scratch,
+    int *valid,
+    const secp256k1_ecdsa_recoverable_signature * const *sigs,
+    const unsigned char * const *msghash32,
+    const secp256k1_pubkey * const *pubkeys,
+    size_t n_sigs
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
 #ifdef __cplusplus
 }
 #endif
@@ -157,6 +157,38 @@ SECP256K1_API int secp256k1_schnorrsig_sign_custom(
     secp256k1_schnorrsig_extraparams *extraparams
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(5);
 
+/** Create Schnorr signatures for many messages with the same keypair.
+ *
+ *  Creates the same signatures as calling secp256k1_schnorrsig_sign_custom
+ *  for every message with extraparams.ndata set to aux_rand32s[i], but
+ *  faster, because the keypair is loaded only once and the nonce points are
+ *  converted to affine coordinates with shared field inversions.
+ *
+ *  Returns 1 on success, 0 on failure (in which case all signatures are
+ *  cleared).
+ *  Args:        ctx: pointer to a context object (not secp256k1_context_static).
+ *  Out:       sig64s: array of n pointers to 64-byte arrays to store the
+ *                     signatures in.
+ *  In:          msgs: array of n pointers to the messages being signed.
+ *                     msgs[i] can only be NULL if msglens[i] is 0.
+ *            msglens: array of n message lengths.
+ *                  n: number of messages. The arrays can only be NULL if n
+ *                     is 0.
+ *            keypair: pointer to an initialized keypair.
+ *        aux_rand32s: array of n pointers to 32 bytes of fresh randomness
+ *                     (see secp256k1_schnorrsig_sign32). Can be NULL, in
+ *                     which case no randomness is used for any message.
+ */
+SECP256K1_API int secp256k1_schnorrsig_sign_batch(
+    const secp256k1_context* ctx,
+    unsigned char * const *sig64s,
+    const unsigned char * const *msgs,
+    const size_t *msglens,
+    size_t n,
+    const secp256k1_keypair *keypair,
+    const unsigned char * const *aux_rand32s
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(6);
+
 /** Verify a Schnorr signature.
  *
  *  Returns: 1: correct signature
@@ -175,6 +207,128 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_schnorrsig_verify(
     const secp256k1_xonly_pubkey *pubkey
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(5);
 
+/** Verify a Schnorr signature with a precomputation object.
+ *
+ *  Same as secp256k1_schnorrsig_verify, but with the x-only public key that
+ *  corresponds to the public key that precomp was created for (see
+ *  secp256k1_pubkey_precomp_create and secp256k1_xonly_pubkey_from_pubkey).
+ *
+ *  Returns: 1: correct signature
+ *           0: incorrect signature
+ *  Args:    ctx: a secp256k1 context object.
+ *  In:    sig64: pointer to the 64-byte signature to verify.
+ *           msg: the message being verified. Can only be NULL if msglen is 0.
+ *        msglen: length of the message
+ *       precomp: pointer to a precomputation object for the public key to
+ *                verify with (cannot be NULL)
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_schnorrsig_verify_precomp(
+    const secp256k1_context* ctx,
+    const unsigned char *sig64,
+    const unsigned char *msg,
+    size_t msglen,
+    const secp256k1_pubkey_precomp *precomp
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(5);
+
+/** Verify a Schnorr signature with a signature cache.
+ *
+ *  Same as secp256k1_schnorrsig_verify, but returns 1 without verifying if
+ *  the signature is found in the cache (see secp256k1_sigcache_create).
+ *
+ *  Returns: 1: correct signature
+ *           0: incorrect signature
+ *  Args:    ctx: a secp256k1 context object.
+ *         cache: pointer to a signature cache.
+ *         stats: pointer to lookup counters to update (can be NULL).
+ *  In:    sig64: pointer to the 64-byte signature to verify.
+ *           msg: the message being verified. Can only be NULL if msglen is 0.
+ *        msglen: length of the message
+ *        pubkey: pointer to an x-only public key to verify with (cannot be NULL)
+ *         store: if non-zero, a correct signature that is not in the cache
+ *                yet is inserted.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_schnorrsig_verify_cached(
+    const secp256k1_context* ctx,
+    secp256k1_sigcache *cache,
+    secp256k1_sigcache_stats *stats,
+    const unsigned char *sig64,
+    const unsigned char *msg,
+    size_t msglen,
+    const secp256k1_xonly_pubkey *pubkey,
+    int store
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(7);
+
+/** Verify a batch of Schnorr signatures.
+ *
+ *  Checks a random linear combination of the verification equations of all
+ *  signatures with a single multi-scalar multiplication, which is
+ *  considerably faster than verifying the signatures one by one. The random
+ *  coefficients are derived from a hash of all inputs. Accepts exactly the
+ *  same signatures as secp256k1_schnorrsig_verify (except with negligible
+ *  probability).
+ *
+ *  Returns: 1: all signatures are correct (this includes the case n_sigs = 0)
+ *           0: at least one signature is incorrect
+ *  Args:    ctx: a secp256k1 context object.
+ *       scratch: scratch space used for the multi-scalar multiplication. Its
+ *                size determines how many signatures can be checked at once;
+ *                larger batches are split up.
+ *  Out:   valid: pointer to an array of n_sigs ints (can be NULL). If non-NULL,
+ *                valid[i] is set to 1 if the i-th signature is correct and to
+ *                0 otherwise. If the batch fails, the incorrect signatures are
+ *                located by repeatedly checking halves of the batch, which is
+ *                much cheaper than verifying every signature individually if
+ *                only a few signatures are incorrect.
+ *  In:    sig64: array of n_sigs pointers to 64-byte signatures.
+ *          msgs: array of n_sigs pointers to the messages being verified.
+ *                msgs[i] can only be NULL if msglens[i] is 0.
+ *       msglens: array of n_sigs message lengths.
+ *       pubkeys: array of n_sigs pointers to x-only public keys to verify with.
+ *        n_sigs: number of signatures in the batch. The arrays can only be
+ *                NULL if n_sigs is 0.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_schnorrsig_verify_batch(
+    const secp256k1_context* ctx,
+    secp256k1_scratch_space *scratch,
+    int *valid,
+    const unsigned char * const *sig64,
+    const unsigned char * const *msgs,
+    const size_t *msglens,
+    const secp256k1_xonly_pubkey * const *pubkeys,
+    size_t n_sigs
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
+/** Verify several Schnorr signatures.
+ *
+ *  Gives the same result for every signature as secp256k1_schnorrsig_verify,
+ *  but is faster, because up to four verifications are computed side by side
+ *  in the same loop (most effectively on CPUs with AVX2). It is slower than
+ *  secp256k1_schnorrsig_verify_batch for large batches, but every signature
+ *  gets its own result at no extra cost, and no scratch space is needed.
+ *
+ *  Returns: 1: all signatures are correct (this includes the case n_sigs = 0)
+ *           0: at least one signature is incorrect
+ *  Args:    ctx: a secp256k1 context object.
+ *  Out: results: pointer to an array of n_sigs ints. results[i] is set to 1 if
+ *                the i-th signature is correct and to 0 otherwise.
+ *  In:    sig64: array of n_sigs pointers to 64-byte signatures.
+ *          msgs: array of n_sigs pointers to the messages being verified.
+ *                msgs[i] can only be NULL if msglens[i] is 0.
+ *       msglens: array of n_sigs message lengths.
+ *       pubkeys: array of n_sigs pointers to x-only public keys to verify with.
+ *        n_sigs: number of signatures. The arrays can only be NULL if n_sigs
+ *                is 0.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_schnorrsig_verify_many(
+    const secp256k1_context* ctx,
+    int *results,
+    const unsigned char * const *sig64,
+    const unsigned char * const *msgs,
+    const size_t *msglens,
+    const secp256k1_xonly_pubkey * const *pubkeys,
+    size_t n_sigs
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
 #ifdef __cplusplus
 }
 #endif
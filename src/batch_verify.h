@@ -0,0 +1,65 @@
+/***********************************************************************
+ * Copyright (c) 2023 The libsecp256k1 developers                      *
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_BATCH_VERIFY_H
+#define SECP256K1_BATCH_VERIFY_H
+
+#include "../include/secp256k1.h"
+#include "scalar.h"
+#include "scratch.h"
+
+/** Derive the randomizer for item idx of a batch from a 32-byte seed that
+ *  commits to all items of the batch. The randomizer of the first item is
+ *  always 1, all others are SHA256(seed32 || idx) reduced modulo the group
+ *  order (and never zero). */
+static void secp256k1_batch_verify_randomizer(secp256k1_scalar *r, const unsigned char *seed32, size_t idx);
+
+/** State of a batch verification that checks ranges of the batch with a
+ *  multi-multiplication in which every item contributes two points. */
+typedef struct {
+    const secp256k1_context *ctx;
+    const secp256k1_callback *error_callback;
+    secp256k1_scratch *scratch;
+    unsigned char seed[32];
+    /* first item of the range that is currently being checked */
+    size_t offset;
+    /* The randomizers of all items, computed once in state_init, or NULL if
+     * they did not fit into the scratch space. */
+    secp256k1_scalar *randomizers;
+    size_t scratch_checkpoint;
+    /* Without the randomizers array, every item still contributes two points
+     * to the multi-multiplication, so the randomizer of the last item is
+     * cached. */
+    size_t randomizer_idx;
+    secp256k1_scalar randomizer;
+} secp256k1_batch_verify_state;
+
+/** Initialize a batch verification state for a batch of n items with the
+ *  randomizer seed seed32, where error_callback is the error callback of ctx.
+ *  If they take up only a small part of the scratch space, the randomizers of
+ *  all items are computed once and stored in it until
+ *  secp256k1_batch_verify_state_clear is called. */
+static void secp256k1_batch_verify_state_init(secp256k1_batch_verify_state *state, const secp256k1_context *ctx, const secp256k1_callback *error_callback, secp256k1_scratch *scratch, const unsigned char *seed32, size_t n);
+
+/** Release the scratch space used by the state. */
+static void secp256k1_batch_verify_state_clear(secp256k1_batch_verify_state *state);
+
+/** Set r to the randomizer of item idx (see secp256k1_batch_verify_randomizer). */
+static void secp256k1_batch_verify_state_randomizer(secp256k1_scalar *r, secp256k1_batch_verify_state *state, size_t idx);
+
+/** Checks whether the items in the range [offset, offset + n) of a batch are
+ *  all valid. Returns 1 if they are and 0 otherwise. */
+typedef int (secp256k1_batch_verify_range_callback)(size_t offset, size_t n, void *data);
+
+/** Given a callback checking ranges of a batch whose full range [0, n) is
+ *  already known to contain at least one invalid item, set valid[i] to 1 for
+ *  every valid item and to 0 for every invalid one. The range is bisected
+ *  recursively, so that only ranges containing invalid items are split
+ *  further, and ranges known to contain an invalid item are never checked
+ *  again. With k invalid items, this requires O(k log n) range checks. */
+static void secp256k1_batch_verify_find_invalid(int *valid, size_t n, secp256k1_batch_verify_range_callback cb, void *cbdata);
+
+#endif /* SECP256K1_BATCH_VERIFY_H */
@@ -0,0 +1,129 @@
+/***********************************************************************
+ * Copyright (c) 2023 The libsecp256k1 developers                      *
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_BATCH_VERIFY_IMPL_H
+#define SECP256K1_BATCH_VERIFY_IMPL_H
+
+#include <string.h>
+
+#include "batch_verify.h"
+#include "hash.h"
+#include "scalar.h"
+#include "util.h"
+
+static void secp256k1_batch_verify_randomizer(secp256k1_scalar *r, const unsigned char *seed32, size_t idx) {
+    secp256k1_sha256 sha;
+    unsigned char buf[32];
+    unsigned char idx8[8];
+
+    if (idx == 0) {
+        /* Fixing the first randomizer to 1 does not weaken the batch
+         * equation, because it is equivalent to dividing it by the first
+         * randomizer. It saves a scalar multiplication per batch. */
+        *r = secp256k1_scalar_one;
+        return;
+    }
+    secp256k1_write_be64(idx8, idx);
+    secp256k1_sha256_initialize(&sha);
+    secp256k1_sha256_write(&sha, seed32, 32);
+    secp256k1_sha256_write(&sha, idx8, sizeof(idx8));
+    secp256k1_sha256_finalize(&sha, buf);
+    secp256k1_scalar_set_b32(r, buf, NULL);
+    /* A zero randomizer would remove the item from the batch equation. */
+    if (secp256k1_scalar_is_zero(r)) {
+        *r = secp256k1_scalar_one;
+    }
+}
+
+/* The randomizers are stored in the scratch space only if they take up at
+ * most 1/SECP256K1_BATCH_VERIFY_RANDOMIZERS_SCRATCH_FRACTION of it, because
+ * the rest determines how many points the multi-multiplication can process at
+ * once. Every item needs two points, which take up far more space than its
+ * randomizer. */
+#define SECP256K1_BATCH_VERIFY_RANDOMIZERS_SCRATCH_FRACTION 8
+
+static void secp256k1_batch_verify_state_init(secp256k1_batch_verify_state *state, const secp256k1_context *ctx, const secp256k1_callback *error_callback, secp256k1_scratch *scratch, const unsigned char *seed32, size_t n) {
+    size_t i;
+
+    state->ctx = ctx;
+    state->error_callback = error_callback;
+    state->scratch = scratch;
+    memcpy(state->seed, seed32, sizeof(state->seed));
+    state->offset = 0;
+    state->randomizers = NULL;
+    state->scratch_checkpoint = secp256k1_scratch_checkpoint(error_callback, scratch);
+    state->randomizer_idx = SIZE_MAX;
+
+    if (n > SIZE_MAX / sizeof(secp256k1_scalar)
+        || n * sizeof(secp256k1_scalar) > secp256k1_scratch_max_allocation(error_callback, scratch, 1) / SECP256K1_BATCH_VERIFY_RANDOMIZERS_SCRATCH_FRACTION) {
+        return;
+    }
+    state->randomizers = (secp256k1_scalar *) secp256k1_scratch_alloc(error_callback, scratch, n * sizeof(secp256k1_scalar));
+    if (state->randomizers == NULL) {
+        return;
+    }
+    for (i = 0; i < n; i++) {
+        secp256k1_batch_verify_randomizer(&state->randomizers[i], state->seed, i);
+    }
+}
+
+static void secp256k1_batch_verify_state_clear(secp256k1_batch_verify_state *state) {
+    secp256k1_scratch_apply_checkpoint(state->error_callback, state->scratch, state->scratch_checkpoint);
+    state->randomizers = NULL;
+}
+
+static void secp256k1_batch_verify_state_randomizer(secp256k1_scalar *r, secp256k1_batch_verify_state *state, size_t idx) {
+    if (state->randomizers != NULL) {
+        *r = state->randomizers[idx];
+        return;
+    }
+    if (state->randomizer_idx != idx) {
+        secp256k1_batch_verify_randomizer(&state->randomizer, state->seed, idx);
+        state->randomizer_idx = idx;
+    }
+    *r = state->randomizer;
+}
+
+static void secp256k1_batch_verify_set_valid(int *valid, size_t offset, size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) {
+        valid[offset + i] = 1;
+    }
+}
+
+/* Requires that [offset, offset + n) contains at least one invalid item. */
+static void secp256k1_batch_verify_find_invalid_range(int *valid, size_t offset, size_t n, secp256k1_batch_verify_range_callback cb, void *cbdata) {
+    size_t half;
+
+    VERIFY_CHECK(n > 0);
+    if (n == 1) {
+        valid[offset] = 0;
+        return;
+    }
+    half = n / 2;
+    if (cb(offset, half, cbdata)) {
+        /* The first half is valid, so the invalid item must be in the
+         * second half. No need to check it. */
+        secp256k1_batch_verify_set_valid(valid, offset, half);
+        secp256k1_batch_verify_find_invalid_range(valid, offset + half, n - half, cb, cbdata);
+        return;
+    }
+    secp256k1_batch_verify_find_invalid_range(valid, offset, half, cb, cbdata);
+    if (cb(offset + half, n - half, cbdata)) {
+        secp256k1_batch_verify_set_valid(valid, offset + half, n - half);
+    } else {
+        secp256k1_batch_verify_find_invalid_range(valid, offset + half, n - half, cb, cbdata);
+    }
+}
+
+static void secp256k1_batch_verify_find_invalid(int *valid, size_t n, secp256k1_batch_verify_range_callback cb, void *cbdata) {
+    if (n == 0) {
+        return;
+    }
+    secp256k1_batch_verify_find_invalid_range(valid, 0, n, cb, cbdata);
+}
+
+#endif /* SECP256K1_BATCH_VERIFY_IMPL_H */
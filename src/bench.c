@@ -27,6 +27,10 @@ void help(int default_iters) {
     printf("    - Schnorr signatures (optional module)\n");
 #endif
 
+#ifdef ENABLE_MODULE_ECMULT
+    printf("    - Multi-scalar multiplication (optional module)\n");
+#endif
+
     printf("\n");
     printf("The default number of iterations for each benchmark is %d. This can be\n", default_iters);
     printf("customized using the SECP256K1_BENCH_ITERS environment variable.\n");
@@ -37,20 +41,39 @@ void help(int default_iters) {
     printf("    help              : display this help and exit\n");
     printf("    ecdsa             : all ECDSA algorithms--sign, verify, recovery (if enabled)\n");
     printf("    ecdsa_sign        : ECDSA siging algorithm\n");
+    printf("    ecdsa_sign_batch  : ECDSA signing of many messages with the same key\n");
+    printf("    ecdsa_sign_with_key : ECDSA signing with a signing key\n");
+    printf("    ecdsa_sign_low_r  : ECDSA signing with low R values, by repeated signing and with a signing key\n");
     printf("    ecdsa_verify      : ECDSA verification algorithm\n");
+    printf("    ecdsa_verify_many : ECDSA verification of four signatures at once\n");
+    printf("    ecdsa_verify_precomp : ECDSA verification with a precomputed public key\n");
+    printf("    ecdsa_verify_cached : ECDSA verification of a signature that is in a signature cache\n");
+    printf("    ec_pubkey_create  : Public key creation, single, batched and for a sequence of secret keys\n");
+    printf("    ec_pubkey_parse   : Parsing of a compressed public key with and without a public key cache\n");
+    printf("    tagged_sha256     : Tagged hash of a 32-byte message with and without a tagged hasher\n");
 
 #ifdef ENABLE_MODULE_RECOVERY
     printf("    ecdsa_recover     : ECDSA public key recovery algorithm\n");
+    printf("    ecdsa_recoverable_verify_batch : ECDSA batch verification of recoverable signatures\n");
 #endif
 
 #ifdef ENABLE_MODULE_ECDH
-    printf("    ecdh              : ECDH key exchange algorithm\n");
+    printf("    ecdh              : ECDH key exchange algorithm, single and batched\n");
 #endif
 
 #ifdef ENABLE_MODULE_SCHNORRSIG
-    printf("    schnorrsig        : all Schnorr signature algorithms (sign, verify)\n");
+    printf("    schnorrsig        : all Schnorr signature algorithms (sign, verify, verify_many, verify_batch)\n");
     printf("    schnorrsig_sign   : Schnorr sigining algorithm\n");
     printf("    schnorrsig_verify : Schnorr verification algorithm\n");
+    printf("    schnorrsig_verify_many : Schnorr verification of four signatures at once\n");
+    printf("    schnorrsig_verify_precomp : Schnorr verification with a precomputed public key\n");
+    printf("    schnorrsig_verify_batch : Schnorr batch verification algorithm\n");
+    printf("    schnorrsig_sign_batch : Schnorr signing of many messages with one key\n");
+#endif
+
+#ifdef ENABLE_MODULE_ECMULT
+    printf("    ecmult_multi      : Multi-scalar multiplication with as many points as iterations\n");
+    printf("    ecmult_multi_precomp : Multi-scalar multiplication of 128 points with and without precomputation\n");
 #endif
 
     printf("\n");
@@ -64,6 +87,9 @@ typedef struct {
     size_t siglen;
     unsigned char pubkey[33];
     size_t pubkeylen;
+    secp256k1_pubkey_precomp *precomp;
+    secp256k1_sigcache *cache;
+    secp256k1_pubkey_cache *pubkey_cache;
 } bench_verify_data;
 
 static void bench_verify(void* arg, int iters) {
@@ -85,6 +111,80 @@ static void bench_verify(void* arg, int iters) {
     }
 }
 
+static void bench_verify_many(void* arg, int iters) {
+    int i, k;
+    bench_verify_data* data = (bench_verify_data*)arg;
+
+    for (i = 0; i < iters; i += 4) {
+        secp256k1_pubkey pubkey;
+        secp256k1_ecdsa_signature sig;
+        const secp256k1_pubkey *pubkeys[4];
+        const secp256k1_ecdsa_signature *sigs[4];
+        const unsigned char *msgs[4];
+        int results[4];
+        CHECK(secp256k1_ec_pubkey_parse(data->ctx, &pubkey, data->pubkey, data->pubkeylen) == 1);
+        CHECK(secp256k1_ecdsa_signature_parse_der(data->ctx, &sig, data->sig, data->siglen) == 1);
+        for (k = 0; k < 4; k++) {
+            pubkeys[k] = &pubkey;
+            sigs[k] = &sig;
+            msgs[k] = data->msg;
+        }
+        CHECK(secp256k1_ecdsa_verify_many(data->ctx, results, sigs, msgs, pubkeys, iters - i < 4 ? iters - i : 4) == 1);
+    }
+}
+
+static void bench_verify_precomp(void* arg, int iters) {
+    int i;
+    bench_verify_data* data = (bench_verify_data*)arg;
+
+    for (i = 0; i < iters; i++) {
+        secp256k1_ecdsa_signature sig;
+        data->sig[data->siglen - 1] ^= (i & 0xFF);
+        data->sig[data->siglen - 2] ^= ((i >> 8) & 0xFF);
+        data->sig[data->siglen - 3] ^= ((i >> 16) & 0xFF);
+        CHECK(secp256k1_ecdsa_signature_parse_der(data->ctx, &sig, data->sig, data->siglen) == 1);
+        CHECK(secp256k1_ecdsa_verify_precomp(data->ctx, &sig, data->msg, data->precomp) == (i == 0));
+        data->sig[data->siglen - 1] ^= (i & 0xFF);
+        data->sig[data->siglen - 2] ^= ((i >> 8) & 0xFF);
+        data->sig[data->siglen - 3] ^= ((i >> 16) & 0xFF);
+    }
+}
+
+static void bench_verify_cached(void* arg, int iters) {
+    int i;
+    bench_verify_data* data = (bench_verify_data*)arg;
+    secp256k1_sigcache_stats stats = { 0, 0 };
+
+    for (i = 0; i < iters; i++) {
+        secp256k1_pubkey pubkey;
+        secp256k1_ecdsa_signature sig;
+        CHECK(secp256k1_ec_pubkey_parse(data->ctx, &pubkey, data->pubkey, data->pubkeylen) == 1);
+        CHECK(secp256k1_ecdsa_signature_parse_der(data->ctx, &sig, data->sig, data->siglen) == 1);
+        CHECK(secp256k1_ecdsa_verify_cached(data->ctx, data->cache, &stats, &sig, data->msg, &pubkey, 1) == 1);
+    }
+    CHECK(stats.misses <= 1);
+}
+
+static void bench_pubkey_parse(void* arg, int iters) {
+    int i;
+    bench_verify_data* data = (bench_verify_data*)arg;
+
+    for (i = 0; i < iters; i++) {
+        secp256k1_pubkey pubkey;
+        CHECK(secp256k1_ec_pubkey_parse(data->ctx, &pubkey, data->pubkey, data->pubkeylen) == 1);
+    }
+}
+
+static void bench_pubkey_parse_cached(void* arg, int iters) {
+    int i;
+    bench_verify_data* data = (bench_verify_data*)arg;
+
+    for (i = 0; i < iters; i++) {
+        secp256k1_pubkey pubkey;
+        CHECK(secp256k1_ec_pubkey_parse_cached(data->ctx, data->pubkey_cache, &pubkey, data->pubkey, data->pubkeylen, 1) == 1);
+    }
+}
+
 typedef struct {
     secp256k1_context* ctx;
     unsigned char msg[32];
@@ -121,6 +221,182 @@ static void bench_sign_run(void* arg, int iters) {
     }
 }
 
+static void bench_sign_with_key_run(void* arg, int iters) {
+    int i;
+    bench_sign_data *data = (bench_sign_data*)arg;
+    secp256k1_ecdsa_signing_key signing_key;
+
+    unsigned char sig[74];
+    CHECK(secp256k1_ecdsa_signing_key_create(data->ctx, &signing_key, data->key));
+    for (i = 0; i < iters; i++) {
+        size_t siglen = 74;
+        int j;
+        secp256k1_ecdsa_signature signature;
+        CHECK(secp256k1_ecdsa_sign_with_key(data->ctx, &signature, data->msg, &signing_key, NULL));
+        CHECK(secp256k1_ecdsa_signature_serialize_der(data->ctx, sig, &siglen, &signature));
+        for (j = 0; j < 32; j++) {
+            data->msg[j] = sig[j];
+        }
+    }
+}
+
+/* Same as bench_sign_run, but with the grinding loop of Bitcoin Core for low R values. */
+static void bench_sign_grind_run(void* arg, int iters) {
+    int i;
+    bench_sign_data *data = (bench_sign_data*)arg;
+
+    unsigned char sig[64];
+    for (i = 0; i < iters; i++) {
+        unsigned char extra[32] = {0};
+        int j;
+        secp256k1_ecdsa_signature signature;
+        CHECK(secp256k1_ecdsa_sign(data->ctx, &signature, data->msg, data->key, NULL, NULL));
+        CHECK(secp256k1_ecdsa_signature_serialize_compact(data->ctx, sig, &signature));
+        while (sig[0] >= 0x80) {
+            extra[0]++;
+            CHECK(secp256k1_ecdsa_sign(data->ctx, &signature, data->msg, data->key, NULL, extra));
+            CHECK(secp256k1_ecdsa_signature_serialize_compact(data->ctx, sig, &signature));
+        }
+        for (j = 0; j < 32; j++) {
+            data->msg[j] = sig[j + 32];
+        }
+    }
+}
+
+static void bench_sign_low_r_run(void* arg, int iters) {
+    int i;
+    bench_sign_data *data = (bench_sign_data*)arg;
+    secp256k1_ecdsa_signing_key signing_key;
+
+    unsigned char sig[64];
+    CHECK(secp256k1_ecdsa_signing_key_create(data->ctx, &signing_key, data->key));
+    for (i = 0; i < iters; i++) {
+        int j;
+        secp256k1_ecdsa_signature signature;
+        CHECK(secp256k1_ecdsa_sign_low_r(data->ctx, &signature, data->msg, &signing_key));
+        CHECK(secp256k1_ecdsa_signature_serialize_compact(data->ctx, sig, &signature));
+        for (j = 0; j < 32; j++) {
+            data->msg[j] = sig[j + 32];
+        }
+    }
+}
+
+#define BENCH_SIGN_BATCH 64
+
+typedef struct {
+    secp256k1_context* ctx;
+    unsigned char key[32];
+    unsigned char msgs[BENCH_SIGN_BATCH][32];
+    const unsigned char *msghash32s[BENCH_SIGN_BATCH];
+    secp256k1_ecdsa_signature sigs[BENCH_SIGN_BATCH];
+} bench_sign_batch_data;
+
+static void bench_sign_batch_setup(void* arg) {
+    int i, j;
+    bench_sign_batch_data *data = (bench_sign_batch_data*)arg;
+
+    for (i = 0; i < 32; i++) {
+        data->key[i] = i + 65;
+    }
+    for (i = 0; i < BENCH_SIGN_BATCH; i++) {
+        for (j = 0; j < 32; j++) {
+            data->msgs[i][j] = i + j + 1;
+        }
+        data->msghash32s[i] = data->msgs[i];
+    }
+}
+
+/* Creates iters signatures in batches of BENCH_SIGN_BATCH, so that the result
+ * is the time per signature. */
+static void bench_sign_batch_run(void* arg, int iters) {
+    int i;
+    bench_sign_batch_data *data = (bench_sign_batch_data*)arg;
+
+    for (i = 0; i < iters; i += BENCH_SIGN_BATCH) {
+        size_t n = iters - i < BENCH_SIGN_BATCH ? iters - i : BENCH_SIGN_BATCH;
+        CHECK(secp256k1_ecdsa_sign_batch(data->ctx, data->sigs, data->msghash32s, n, data->key, NULL, NULL) == 1);
+        data->msgs[0][0]++;
+    }
+}
+
+#define BENCH_PUBKEY_CREATE_BATCH 64
+#define BENCH_PUBKEY_CREATE_SEQUENCE 1024
+
+typedef struct {
+    secp256k1_context* ctx;
+    unsigned char keys[BENCH_PUBKEY_CREATE_BATCH][32];
+    const unsigned char *seckeys[BENCH_PUBKEY_CREATE_BATCH];
+    secp256k1_pubkey pubkeys[BENCH_PUBKEY_CREATE_SEQUENCE];
+} bench_pubkey_create_data;
+
+static void bench_pubkey_create_setup(void* arg) {
+    int i, j;
+    bench_pubkey_create_data *data = (bench_pubkey_create_data*)arg;
+
+    for (i = 0; i < BENCH_PUBKEY_CREATE_BATCH; i++) {
+        for (j = 0; j < 32; j++) {
+            data->keys[i][j] = i + j + 1;
+        }
+        data->seckeys[i] = data->keys[i];
+    }
+}
+
+static void bench_pubkey_create(void* arg, int iters) {
+    int i;
+    bench_pubkey_create_data *data = (bench_pubkey_create_data*)arg;
+
+    for (i = 0; i < iters; i++) {
+        CHECK(secp256k1_ec_pubkey_create(data->ctx, &data->pubkeys[0], data->keys[i % BENCH_PUBKEY_CREATE_BATCH]) == 1);
+    }
+}
+
+/* Creates iters public keys in batches of BENCH_PUBKEY_CREATE_BATCH, so that
+ * the result is the time per public key. */
+static void bench_pubkey_create_batch(void* arg, int iters) {
+    int i;
+    bench_pubkey_create_data *data = (bench_pubkey_create_data*)arg;
+
+    for (i = 0; i < iters; i += BENCH_PUBKEY_CREATE_BATCH) {
+        size_t n = iters - i < BENCH_PUBKEY_CREATE_BATCH ? iters - i : BENCH_PUBKEY_CREATE_BATCH;
+        CHECK(secp256k1_ec_pubkey_create_batch(data->ctx, data->pubkeys, data->seckeys, n) == 1);
+    }
+}
+
+/* Creates iters public keys of consecutive secret keys in sequences of
+ * BENCH_PUBKEY_CREATE_SEQUENCE, so that the result is the time per public
+ * key. */
+static void bench_pubkey_create_sequence(void* arg, int iters) {
+    int i;
+    bench_pubkey_create_data *data = (bench_pubkey_create_data*)arg;
+    unsigned char step[32] = { 0 };
+
+    step[31] = 1;
+    for (i = 0; i < iters; i += BENCH_PUBKEY_CREATE_SEQUENCE) {
+        size_t n = iters - i < BENCH_PUBKEY_CREATE_SEQUENCE ? iters - i : BENCH_PUBKEY_CREATE_SEQUENCE;
+        CHECK(secp256k1_ec_pubkey_create_sequence(data->ctx, data->pubkeys, data->keys[0], step, n) == 1);
+    }
+}
+
+static void bench_tagged_sha256(void* arg, int iters) {
+    int i;
+    bench_verify_data *data = (bench_verify_data*)arg;
+
+    for (i = 0; i < iters; i++) {
+        CHECK(secp256k1_tagged_sha256(data->ctx, data->msg, data->key, sizeof(data->key), data->msg, sizeof(data->msg)) == 1);
+    }
+}
+
+static void bench_tagged_hasher_hash(void* arg, int iters) {
+    int i;
+    bench_verify_data *data = (bench_verify_data*)arg;
+    secp256k1_tagged_hasher hasher;
+
+    CHECK(secp256k1_tagged_hasher_init(data->ctx, &hasher, data->key, sizeof(data->key)) == 1);
+    for (i = 0; i < iters; i++) {
+        CHECK(secp256k1_tagged_hasher_hash(data->ctx, data->msg, &hasher, data->msg, sizeof(data->msg)) == 1);
+    }
+}
+
 #ifdef ENABLE_MODULE_ECDH
 # include "modules/ecdh/bench_impl.h"
 #endif
@@ -133,19 +409,26 @@ static void bench_sign_run(void* arg, int iters) {
 # include "modules/schnorrsig/bench_impl.h"
 #endif
 
+#ifdef ENABLE_MODULE_ECMULT
+# include "modules/ecmult/bench_impl.h"
+#endif
+
 int main(int argc, char** argv) {
     int i;
     secp256k1_pubkey pubkey;
     secp256k1_ecdsa_signature sig;
     bench_verify_data data;
+    bench_sign_batch_data sign_batch_data;
+    bench_pubkey_create_data pubkey_create_data;
 
     int d = argc == 1;
     int default_iters = 20000;
     int iters = get_iters(default_iters);
 
     /* Check for invalid user arguments */
-    char* valid_args[] = {"ecdsa", "verify", "ecdsa_verify", "sign", "ecdsa_sign", "ecdh", "recover",
-                         "ecdsa_recover", "schnorrsig", "schnorrsig_verify", "schnorrsig_sign"};
+    char* valid_args[] = {"ecdsa", "verify", "ecdsa_verify", "ecdsa_verify_many", "ecdsa_verify_precomp", "ecdsa_verify_cached", "ec_pubkey_create", "ec_pubkey_parse", "tagged_sha256", "sign", "ecdsa_sign", "ecdsa_sign_batch", "ecdsa_sign_with_key", "ecdsa_sign_low_r", "ecdh", "recover",
+                         "ecdsa_recover", "ecdsa_recoverable_verify_batch", "schnorrsig", "schnorrsig_verify", "schnorrsig_verify_many", "schnorrsig_verify_precomp", "schnorrsig_sign", "schnorrsig_verify_batch", "schnorrsig_sign_batch",
+                         "ecmult_multi", "ecmult_multi_precomp"};
     size_t valid_args_size = sizeof(valid_args)/sizeof(valid_args[0]);
     int invalid_args = have_invalid_args(argc, argv, valid_args, valid_args_size);
 
@@ -172,7 +455,7 @@ int main(int argc, char** argv) {
 #endif
 
 #ifndef ENABLE_MODULE_RECOVERY
-    if (have_flag(argc, argv, "recover") || have_flag(argc, argv, "ecdsa_recover")) { 
+    if (have_flag(argc, argv, "recover") || have_flag(argc, argv, "ecdsa_recover") || have_flag(argc, argv, "ecdsa_recoverable_verify_batch")) {
         fprintf(stderr, "./bench: Public key recovery module not enabled.\n");
         fprintf(stderr, "Use ./configure --enable-module-recovery.\n\n");
         return 1;
@@ -180,13 +463,21 @@ int main(int argc, char** argv) {
 #endif
 
 #ifndef ENABLE_MODULE_SCHNORRSIG
-    if (have_flag(argc, argv, "schnorrsig") || have_flag(argc, argv, "schnorrsig_sign") || have_flag(argc, argv, "schnorrsig_verify")) { 
+    if (have_flag(argc, argv, "schnorrsig") || have_flag(argc, argv, "schnorrsig_sign") || have_flag(argc, argv, "schnorrsig_verify") || have_flag(argc, argv, "schnorrsig_verify_many") || have_flag(argc, argv, "schnorrsig_verify_precomp") || have_flag(argc, argv, "schnorrsig_verify_batch") || have_flag(argc, argv, "schnorrsig_sign_batch")) { 
         fprintf(stderr, "./bench: Schnorr signatures module not enabled.\n");
         fprintf(stderr, "Use ./configure --enable-module-schnorrsig.\n\n");
         return 1;
     }
 #endif
 
+#ifndef ENABLE_MODULE_ECMULT
+    if (have_flag(argc, argv, "ecmult_multi") || have_flag(argc, argv, "ecmult_multi_precomp")) {
+        fprintf(stderr, "./bench: Multi-scalar multiplication module not enabled.\n");
+        fprintf(stderr, "Use ./configure --enable-module-ecmult.\n\n");
+        return 1;
+    }
+#endif
+
     /* ECDSA verification benchmark */
     data.ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
 
@@ -205,6 +496,22 @@ int main(int argc, char** argv) {
 
     print_output_table_header_row();
     if (d || have_flag(argc, argv, "ecdsa") || have_flag(argc, argv, "verify") || have_flag(argc, argv, "ecdsa_verify")) run_benchmark("ecdsa_verify", bench_verify, NULL, NULL, &data, 10, iters);
+    if (d || have_flag(argc, argv, "ecdsa") || have_flag(argc, argv, "verify") || have_flag(argc, argv, "ecdsa_verify_many")) run_benchmark("ecdsa_verify_many", bench_verify_many, NULL, NULL, &data, 10, iters);
+    data.precomp = secp256k1_pubkey_precomp_create(data.ctx, &pubkey);
+    CHECK(data.precomp != NULL);
+    if (d || have_flag(argc, argv, "ecdsa") || have_flag(argc, argv, "verify") || have_flag(argc, argv, "ecdsa_verify_precomp")) run_benchmark("ecdsa_verify_precomp", bench_verify_precomp, NULL, NULL, &data, 10, iters);
+    secp256k1_pubkey_precomp_destroy(data.ctx, data.precomp);
+    data.cache = secp256k1_sigcache_create(data.ctx, 1 << 20, data.key);
+    CHECK(data.cache != NULL);
+    if (d || have_flag(argc, argv, "ecdsa") || have_flag(argc, argv, "verify") || have_flag(argc, argv, "ecdsa_verify_cached")) run_benchmark("ecdsa_verify_cached", bench_verify_cached, NULL, NULL, &data, 10, iters);
+    secp256k1_sigcache_destroy(data.ctx, data.cache);
+    data.pubkey_cache = secp256k1_pubkey_cache_create(data.ctx, 1 << 20, data.key);
+    CHECK(data.pubkey_cache != NULL);
+    if (d || have_flag(argc, argv, "ec_pubkey_parse")) run_benchmark("ec_pubkey_parse", bench_pubkey_parse, NULL, NULL, &data, 10, iters);
+    if (d || have_flag(argc, argv, "ec_pubkey_parse")) run_benchmark("ec_pubkey_parse_cached", bench_pubkey_parse_cached, NULL, NULL, &data, 10, iters);
+    secp256k1_pubkey_cache_destroy(data.ctx, data.pubkey_cache);
+    if (d || have_flag(argc, argv, "tagged_sha256")) run_benchmark("tagged_sha256", bench_tagged_sha256, NULL, NULL, &data, 10, iters);
+    if (d || have_flag(argc, argv, "tagged_sha256")) run_benchmark("tagged_hasher_hash", bench_tagged_hasher_hash, NULL, NULL, &data, 10, iters);
 
     secp256k1_context_destroy(data.ctx);
 
@@ -212,6 +519,16 @@ int main(int argc, char** argv) {
     data.ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN);
 
     if (d || have_flag(argc, argv, "ecdsa") || have_flag(argc, argv, "sign") || have_flag(argc, argv, "ecdsa_sign")) run_benchmark("ecdsa_sign", bench_sign_run, bench_sign_setup, NULL, &data, 10, iters);
+    if (d || have_flag(argc, argv, "ecdsa") || have_flag(argc, argv, "sign") || have_flag(argc, argv, "ecdsa_sign_with_key")) run_benchmark("ecdsa_sign_with_key", bench_sign_with_key_run, bench_sign_setup, NULL, &data, 10, iters);
+    if (d || have_flag(argc, argv, "ecdsa") || have_flag(argc, argv, "sign") || have_flag(argc, argv, "ecdsa_sign_low_r")) run_benchmark("ecdsa_sign_grind", bench_sign_grind_run, bench_sign_setup, NULL, &data, 10, iters);
+    if (d || have_flag(argc, argv, "ecdsa") || have_flag(argc, argv, "sign") || have_flag(argc, argv, "ecdsa_sign_low_r")) run_benchmark("ecdsa_sign_low_r", bench_sign_low_r_run, bench_sign_setup, NULL, &data, 10, iters);
+    sign_batch_data.ctx = data.ctx;
+    if (d || have_flag(argc, argv, "ecdsa") || have_flag(argc, argv, "sign") || have_flag(argc, argv, "ecdsa_sign_batch")) run_benchmark("ecdsa_sign_batch", bench_sign_batch_run, bench_sign_batch_setup, NULL, &sign_batch_data, 10, iters);
+
+    pubkey_create_data.ctx = data.ctx;
+    if (d || have_flag(argc, argv, "ec_pubkey_create")) run_benchmark("ec_pubkey_create", bench_pubkey_create, bench_pubkey_create_setup, NULL, &pubkey_create_data, 10, iters);
+    if (d || have_flag(argc, argv, "ec_pubkey_create")) run_benchmark("ec_pubkey_create_batch", bench_pubkey_create_batch, bench_pubkey_create_setup, NULL, &pubkey_create_data, 10, iters);
+    if (d || have_flag(argc, argv, "ec_pubkey_create")) run_benchmark("ec_pubkey_create_sequence", bench_pubkey_create_sequence, bench_pubkey_create_setup, NULL, &pubkey_create_data, 10, iters);
 
     secp256k1_context_destroy(data.ctx);
 
@@ -230,5 +547,10 @@ int main(int argc, char** argv) {
     run_schnorrsig_bench(iters, argc, argv);
 #endif
 
+#ifdef ENABLE_MODULE_ECMULT
+    /* Multi-scalar multiplication benchmarks */
+    run_ecmult_bench(iters, argc, argv);
+#endif
+
     return 0;
 }
@@ -17,11 +17,12 @@
 #include "bench.h"
 
 #define POINTS 32768
+#define LARGE_POINTS ((size_t)1 << 20)
 
 void help(char **argv) {
     printf("Benchmark EC multiplication algorithms\n");
     printf("\n");
-    printf("Usage: %s <help|pippenger_wnaf|strauss_wnaf|simple>\n", argv[0]);
+    printf("Usage: %s <help|pippenger_wnaf|pippenger_jacobian|strauss_wnaf|simple|gen> [large]\n", argv[0]);
     printf("The output shows the number of multiplied and summed points right after the\n");
     printf("function name. The letter 'g' indicates that one of the points is the generator.\n");
     printf("The benchmarks are divided by the number of points.\n");
@@ -29,8 +30,20 @@ void help(char **argv) {
     printf("default (ecmult_multi): picks pippenger_wnaf or strauss_wnaf depending on the\n");
     printf("                        batch size\n");
     printf("pippenger_wnaf:         for all batch sizes\n");
+    printf("pippenger_jacobian:     pippenger_wnaf, but always accumulating the buckets in\n");
+    printf("                        Jacobian instead of affine coordinates\n");
     printf("strauss_wnaf:           for all batch sizes\n");
     printf("simple:                 multiply and sum each point individually\n");
+    printf("gen:                    only benchmark ecmult_gen, and show the configuration\n");
+    printf("                        of its precomputed table (see --with-ecmult-gen-kb),\n");
+    printf("                        also with the table of SECP256K1_CONTEXT_LARGE_GEN_TABLE\n");
+    printf("\n");
+    printf("large:                  benchmark batch sizes from 2^10 to 2^20 points (not\n");
+    printf("                        supported with strauss_wnaf)\n");
+}
+
+static int secp256k1_ecmult_pippenger_jacobian_batch_single(const secp256k1_callback* error_callback, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n) {
+    return secp256k1_ecmult_pippenger_batch_strategy(error_callback, scratch, r, inp_g_sc, cb, cbdata, n, 0, 0);
 }
 
 typedef struct {
@@ -192,8 +205,10 @@ static int bench_ecmult_multi_callback(secp256k1_scalar* sc, secp256k1_ge* ge, s
         *sc = data->scalars[data->offset1];
         *ge = secp256k1_ge_const_g;
     } else {
+        /* Shift the public keys after every POINTS points such that no pair
+         * of scalar and public key repeats in large batches. */
         *sc = data->scalars[(data->offset1 + idx) % POINTS];
-        *ge = data->pubkeys[(data->offset2 + idx - 1) % POINTS];
+        *ge = data->pubkeys[(data->offset2 + idx - 1 + (idx - 1) / POINTS) % POINTS];
     }
     return 1;
 }
@@ -262,7 +277,7 @@ static void run_ecmult_multi_bench(bench_data* data, size_t count, int includes_
         secp256k1_scalar total = data->scalars[(data->offset1++) % POINTS];
         size_t i = 0;
         for (i = 0; i + 1 < count; ++i) {
-            secp256k1_scalar_mul(&tmp, &data->seckeys[(data->offset2++) % POINTS], &data->scalars[(data->offset1++) % POINTS]);
+            secp256k1_scalar_mul(&tmp, &data->seckeys[(data->offset2++ + i / POINTS) % POINTS], &data->scalars[(data->offset1++) % POINTS]);
             secp256k1_scalar_add(&total, &total, &tmp);
         }
         secp256k1_scalar_negate(&total, &total);
@@ -284,6 +299,8 @@ int main(int argc, char **argv) {
     size_t scratch_size;
 
     int iters = get_iters(10000);
+    int large = have_flag(argc, argv, "large");
+    int gen_only = 0;
 
     data.ecmult_multi = secp256k1_ecmult_multi_var;
 
@@ -296,12 +313,25 @@ int main(int argc, char **argv) {
         } else if(have_flag(argc, argv, "pippenger_wnaf")) {
             printf("Using pippenger_wnaf:\n");
             data.ecmult_multi = secp256k1_ecmult_pippenger_batch_single;
+        } else if(have_flag(argc, argv, "pippenger_jacobian")) {
+            printf("Using pippenger_wnaf with Jacobian buckets:\n");
+            data.ecmult_multi = secp256k1_ecmult_pippenger_jacobian_batch_single;
         } else if(have_flag(argc, argv, "strauss_wnaf")) {
+            if (large) {
+                fprintf(stderr, "%s: large is not supported with strauss_wnaf.\n\n", argv[0]);
+                help(argv);
+                return 1;
+            }
             printf("Using strauss_wnaf:\n");
             data.ecmult_multi = secp256k1_ecmult_strauss_batch_single;
         } else if(have_flag(argc, argv, "simple")) {
             printf("Using simple algorithm:\n");
-        } else {
+        } else if(have_flag(argc, argv, "gen")) {
+            printf("Using ecmult_gen with COMB_BLOCKS=%d, COMB_TEETH=%d, COMB_SPACING=%d (%d additions, %d doublings, %lu byte table):\n",
+                   COMB_BLOCKS, COMB_TEETH, COMB_SPACING, COMB_BLOCKS * COMB_SPACING, COMB_SPACING - 1,
+                   (unsigned long)sizeof(secp256k1_ecmult_gen_prec_table));
+            gen_only = 1;
+        } else if(!large) {
             fprintf(stderr, "%s: unrecognized argument '%s'.\n\n", argv[0], argv[1]);
             help(argv);
             return 1;
@@ -309,7 +339,11 @@ int main(int argc, char **argv) {
     }
 
     data.ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
-    scratch_size = secp256k1_strauss_scratch_size(POINTS) + STRAUSS_SCRATCH_OBJECTS*16;
+    if (large) {
+        scratch_size = secp256k1_pippenger_scratch_size_for_points(LARGE_POINTS);
+    } else {
+        scratch_size = secp256k1_strauss_scratch_size(POINTS) + STRAUSS_SCRATCH_OBJECTS*16;
+    }
     if (!have_flag(argc, argv, "simple")) {
         data.scratch = secp256k1_scratch_space_create(data.ctx, scratch_size);
     } else {
@@ -340,19 +374,33 @@ int main(int argc, char **argv) {
     print_output_table_header_row();
     /* Initialize offset1 and offset2 */
     hash_into_offset(&data, 0);
-    run_ecmult_bench(&data, iters);
+    if (gen_only) {
+        secp256k1_context *ctx = data.ctx;
+        run_benchmark("ecmult_gen", bench_ecmult_gen, bench_ecmult_setup, bench_ecmult_gen_teardown, &data, 10, iters);
+        data.ctx = secp256k1_context_create(SECP256K1_CONTEXT_LARGE_GEN_TABLE);
+        run_benchmark("ecmult_gen_large_table", bench_ecmult_gen, bench_ecmult_setup, bench_ecmult_gen_teardown, &data, 10, iters);
+        secp256k1_context_destroy(data.ctx);
+        data.ctx = ctx;
+    } else {
+        run_ecmult_bench(&data, iters);
 
-    for (i = 1; i <= 8; ++i) {
-        run_ecmult_multi_bench(&data, i, 1, iters);
-    }
+        for (i = 1; i <= 8; ++i) {
+            run_ecmult_multi_bench(&data, i, 1, iters);
+        }
 
-    /* This is disabled with low count of iterations because the loop runs 77 times even with iters=1
-    * and the higher it goes the longer the computation takes(more points)
-    * So we don't run this benchmark with low iterations to prevent slow down */
-     if (iters > 2) {
-        for (p = 0; p <= 11; ++p) {
-            for (i = 9; i <= 16; ++i) {
-                run_ecmult_multi_bench(&data, i << p, 1, iters);
+        /* This is disabled with low count of iterations because the loop runs 77 times even with iters=1
+        * and the higher it goes the longer the computation takes(more points)
+        * So we don't run this benchmark with low iterations to prevent slow down */
+         if (iters > 2 && !large) {
+            for (p = 0; p <= 11; ++p) {
+                for (i = 9; i <= 16; ++i) {
+                    run_ecmult_multi_bench(&data, i << p, 1, iters);
+                }
+            }
+        }
+        if (large) {
+            for (p = 10; p <= 20; ++p) {
+                run_ecmult_multi_bench(&data, (size_t)1 << p, 1, iters);
             }
         }
     }
@@ -22,7 +22,7 @@ typedef struct {
     secp256k1_scalar scalar[2];
     secp256k1_fe fe[4];
     secp256k1_ge ge[2];
-    secp256k1_gej gej[2];
+    secp256k1_gej gej[4];
     unsigned char data[64];
     int wnaf[256];
 } bench_inv;
@@ -75,6 +75,8 @@ void bench_setup(void* arg) {
     secp256k1_gej_rescale(&data->gej[0], &data->fe[2]);
     secp256k1_gej_set_ge(&data->gej[1], &data->ge[1]);
     secp256k1_gej_rescale(&data->gej[1], &data->fe[3]);
+    data->gej[2] = data->gej[0];
+    data->gej[3] = data->gej[1];
     memcpy(data->data, init[0], 32);
     memcpy(data->data + 32, init[1], 32);
 }
@@ -176,6 +178,49 @@ void bench_field_mul(void* arg, int iters) {
     }
 }
 
+/* The _x4 benchmarks process four lanes per call and count each lane as an iteration, so
+ * the reported time is per lane. */
+#ifdef USE_X86_SIMD
+SECP256K1_TARGET_AVX2
+void bench_field_mul_x4(void* arg, int iters) {
+    int i;
+    bench_inv *data = (bench_inv*)arg;
+    const secp256k1_fe *in[4];
+    secp256k1_fe *out[4];
+    secp256k1_fe4 a, b;
+
+    for (i = 0; i < 4; i++) {
+        in[i] = &data->fe[i];
+        out[i] = &data->fe[i];
+    }
+    secp256k1_fe4_load(&a, in);
+    secp256k1_fe4_load(&b, in);
+    for (i = 0; i < iters; i += 4) {
+        secp256k1_fe4_mul(&a, &a, &b);
+    }
+    secp256k1_fe4_store(out, &a);
+}
+
+SECP256K1_TARGET_AVX2
+void bench_field_sqr_x4(void* arg, int iters) {
+    int i;
+    bench_inv *data = (bench_inv*)arg;
+    const secp256k1_fe *in[4];
+    secp256k1_fe *out[4];
+    secp256k1_fe4 a;
+
+    for (i = 0; i < 4; i++) {
+        in[i] = &data->fe[i];
+        out[i] = &data->fe[i];
+    }
+    secp256k1_fe4_load(&a, in);
+    for (i = 0; i < iters; i += 4) {
+        secp256k1_fe4_sqr(&a, &a);
+    }
+    secp256k1_fe4_store(out, &a);
+}
+#endif
+
 void bench_field_sqr(void* arg, int iters) {
     int i;
     bench_inv *data = (bench_inv*)arg;
@@ -227,6 +272,19 @@ void bench_group_double_var(void* arg, int iters) {
     }
 }
 
+void bench_group_double_var_x4(void* arg, int iters) {
+    int i;
+    bench_inv *data = (bench_inv*)arg;
+    secp256k1_gej *r[4];
+
+    for (i = 0; i < 4; i++) {
+        r[i] = &data->gej[i];
+    }
+    for (i = 0; i < iters; i += 4) {
+        secp256k1_gej_double_var_x4(r, (const secp256k1_gej *const *)r);
+    }
+}
+
 void bench_group_add_var(void* arg, int iters) {
     int i;
     bench_inv *data = (bench_inv*)arg;
@@ -254,6 +312,21 @@ void bench_group_add_affine_var(void* arg, int iters) {
     }
 }
 
+void bench_group_add_affine_var_x4(void* arg, int iters) {
+    int i;
+    bench_inv *data = (bench_inv*)arg;
+    secp256k1_gej *r[4];
+    const secp256k1_ge *b[4];
+
+    for (i = 0; i < 4; i++) {
+        r[i] = &data->gej[i];
+        b[i] = &data->ge[1];
+    }
+    for (i = 0; i < iters; i += 4) {
+        secp256k1_gej_add_ge_var_x4(r, (const secp256k1_gej *const *)r, b);
+    }
+}
+
 void bench_group_add_zinv_var(void* arg, int iters) {
     int i;
     bench_inv *data = (bench_inv*)arg;
@@ -295,6 +368,32 @@ void bench_ecmult_wnaf(void* arg, int iters) {
     CHECK(bits <= 256*iters);
 }
 
+void bench_group_table_select(void* arg, int iters) {
+    int i, idx = 0;
+    secp256k1_ge_storage r;
+    bench_inv *data = (bench_inv*)arg;
+
+    /* Select from a block of the table used by ecmult_gen, with indices that depend on the
+       previous result. */
+    for (i = 0; i < iters; i++) {
+        secp256k1_ge_storage_table_select(&r, secp256k1_ecmult_gen_prec_table[0], COMB_POINTS, idx);
+        idx = (idx + 1 + ((unsigned char *)&r)[0]) & (COMB_POINTS - 1);
+    }
+    data->data[0] ^= idx;
+}
+
+void bench_group_table_select_portable(void* arg, int iters) {
+    int i, idx = 0;
+    secp256k1_ge_storage r;
+    bench_inv *data = (bench_inv*)arg;
+
+    for (i = 0; i < iters; i++) {
+        secp256k1_ge_storage_table_select_portable(&r, secp256k1_ecmult_gen_prec_table[0], COMB_POINTS, idx);
+        idx = (idx + 1 + ((unsigned char *)&r)[0]) & (COMB_POINTS - 1);
+    }
+    data->data[0] ^= idx;
+}
+
 void bench_wnaf_const(void* arg, int iters) {
     int i, bits = 0, overflow = 0;
     bench_inv *data = (bench_inv*)arg;
@@ -320,6 +419,74 @@ void bench_sha256(void* arg, int iters) {
     }
 }
 
+void bench_sha256_many(void* arg, int iters) {
+    int i, j;
+    bench_inv *data = (bench_inv*)arg;
+    secp256k1_sha256 sha;
+    unsigned char out[8][32];
+    unsigned char *out32s[8];
+    const unsigned char *msgs[8];
+
+    for (j = 0; j < 8; j++) {
+        out32s[j] = out[j];
+        msgs[j] = data->data;
+    }
+    secp256k1_sha256_initialize(&sha);
+    /* Each iteration computes one of the eight hashes. */
+    for (i = 0; i < iters; i += 8) {
+        secp256k1_sha256_many(out32s, &sha, msgs, 32, 8);
+        memcpy(data->data, out[0], 32);
+    }
+}
+
+void bench_sha256_transform(void* arg, int iters) {
+    int i;
+    bench_inv *data = (bench_inv*)arg;
+    uint32_t s[8] = {0};
+
+    for (i = 0; i < iters; i++) {
+        secp256k1_sha256_transform(s, data->data);
+    }
+    memcpy(data->data, s, sizeof(s));
+}
+
+void bench_sha256_transform_portable(void* arg, int iters) {
+    int i;
+    bench_inv *data = (bench_inv*)arg;
+    uint32_t s[8] = {0};
+
+    for (i = 0; i < iters; i++) {
+        secp256k1_sha256_transform_portable(s, data->data);
+    }
+    memcpy(data->data, s, sizeof(s));
+}
+
+#ifdef USE_X86_SIMD
+void bench_sha256_transform_sse4(void* arg, int iters) {
+    int i;
+    bench_inv *data = (bench_inv*)arg;
+    uint32_t s[8] = {0};
+
+    for (i = 0; i < iters; i++) {
+        secp256k1_sha256_transform_sse4(s, data->data);
+    }
+    memcpy(data->data, s, sizeof(s));
+}
+#endif
+
+#ifdef USE_X86_SHANI
+void bench_sha256_transform_shani(void* arg, int iters) {
+    int i;
+    bench_inv *data = (bench_inv*)arg;
+    uint32_t s[8] = {0};
+
+    for (i = 0; i < iters; i++) {
+        secp256k1_sha256_transform_shani(s, data->data);
+    }
+    memcpy(data->data, s, sizeof(s));
+}
+#endif
+
 void bench_hmac_sha256(void* arg, int iters) {
     int i;
     bench_inv *data = (bench_inv*)arg;
@@ -377,21 +544,44 @@ int main(int argc, char **argv) {
     if (d || have_flag(argc, argv, "field") || have_flag(argc, argv, "normalize")) run_benchmark("field_normalize_weak", bench_field_normalize_weak, bench_setup, NULL, &data, 10, iters*100);
     if (d || have_flag(argc, argv, "field") || have_flag(argc, argv, "sqr")) run_benchmark("field_sqr", bench_field_sqr, bench_setup, NULL, &data, 10, iters*10);
     if (d || have_flag(argc, argv, "field") || have_flag(argc, argv, "mul")) run_benchmark("field_mul", bench_field_mul, bench_setup, NULL, &data, 10, iters*10);
+#ifdef USE_X86_SIMD
+    if (secp256k1_cpu_has_avx2()) {
+        if (d || have_flag(argc, argv, "field") || have_flag(argc, argv, "sqr")) run_benchmark("field_sqr_x4", bench_field_sqr_x4, bench_setup, NULL, &data, 10, iters*10);
+        if (d || have_flag(argc, argv, "field") || have_flag(argc, argv, "mul")) run_benchmark("field_mul_x4", bench_field_mul_x4, bench_setup, NULL, &data, 10, iters*10);
+    }
+#endif
     if (d || have_flag(argc, argv, "field") || have_flag(argc, argv, "inverse")) run_benchmark("field_inverse", bench_field_inverse, bench_setup, NULL, &data, 10, iters);
     if (d || have_flag(argc, argv, "field") || have_flag(argc, argv, "inverse")) run_benchmark("field_inverse_var", bench_field_inverse_var, bench_setup, NULL, &data, 10, iters);
     if (d || have_flag(argc, argv, "field") || have_flag(argc, argv, "sqrt")) run_benchmark("field_sqrt", bench_field_sqrt, bench_setup, NULL, &data, 10, iters);
 
     if (d || have_flag(argc, argv, "group") || have_flag(argc, argv, "double")) run_benchmark("group_double_var", bench_group_double_var, bench_setup, NULL, &data, 10, iters*10);
+    if (d || have_flag(argc, argv, "group") || have_flag(argc, argv, "double")) run_benchmark("group_double_var_x4", bench_group_double_var_x4, bench_setup, NULL, &data, 10, iters*10);
     if (d || have_flag(argc, argv, "group") || have_flag(argc, argv, "add")) run_benchmark("group_add_var", bench_group_add_var, bench_setup, NULL, &data, 10, iters*10);
     if (d || have_flag(argc, argv, "group") || have_flag(argc, argv, "add")) run_benchmark("group_add_affine", bench_group_add_affine, bench_setup, NULL, &data, 10, iters*10);
     if (d || have_flag(argc, argv, "group") || have_flag(argc, argv, "add")) run_benchmark("group_add_affine_var", bench_group_add_affine_var, bench_setup, NULL, &data, 10, iters*10);
+    if (d || have_flag(argc, argv, "group") || have_flag(argc, argv, "add")) run_benchmark("group_add_affine_var_x4", bench_group_add_affine_var_x4, bench_setup, NULL, &data, 10, iters*10);
     if (d || have_flag(argc, argv, "group") || have_flag(argc, argv, "add")) run_benchmark("group_add_zinv_var", bench_group_add_zinv_var, bench_setup, NULL, &data, 10, iters*10);
     if (d || have_flag(argc, argv, "group") || have_flag(argc, argv, "to_affine")) run_benchmark("group_to_affine_var", bench_group_to_affine_var, bench_setup, NULL, &data, 10, iters);
+    if (d || have_flag(argc, argv, "group") || have_flag(argc, argv, "table_select")) run_benchmark("group_table_select", bench_group_table_select, bench_setup, NULL, &data, 10, iters*10);
+    if (d || have_flag(argc, argv, "group") || have_flag(argc, argv, "table_select")) run_benchmark("group_table_select_portable", bench_group_table_select_portable, bench_setup, NULL, &data, 10, iters*10);
 
     if (d || have_flag(argc, argv, "ecmult") || have_flag(argc, argv, "wnaf")) run_benchmark("wnaf_const", bench_wnaf_const, bench_setup, NULL, &data, 10, iters);
     if (d || have_flag(argc, argv, "ecmult") || have_flag(argc, argv, "wnaf")) run_benchmark("ecmult_wnaf", bench_ecmult_wnaf, bench_setup, NULL, &data, 10, iters);
 
     if (d || have_flag(argc, argv, "hash") || have_flag(argc, argv, "sha256")) run_benchmark("hash_sha256", bench_sha256, bench_setup, NULL, &data, 10, iters);
+    if (d || have_flag(argc, argv, "hash") || have_flag(argc, argv, "sha256")) run_benchmark("hash_sha256_many", bench_sha256_many, bench_setup, NULL, &data, 10, iters);
+    if (d || have_flag(argc, argv, "hash") || have_flag(argc, argv, "sha256")) run_benchmark("hash_sha256_transform", bench_sha256_transform, bench_setup, NULL, &data, 10, iters);
+    if (d || have_flag(argc, argv, "hash") || have_flag(argc, argv, "sha256")) run_benchmark("hash_sha256_transform_portable", bench_sha256_transform_portable, bench_setup, NULL, &data, 10, iters);
+#ifdef USE_X86_SIMD
+    if (secp256k1_cpu_has_sse4()) {
+        if (d || have_flag(argc, argv, "hash") || have_flag(argc, argv, "sha256")) run_benchmark("hash_sha256_transform_sse4", bench_sha256_transform_sse4, bench_setup, NULL, &data, 10, iters);
+    }
+#endif
+#ifdef USE_X86_SHANI
+    if (secp256k1_cpu_has_shani()) {
+        if (d || have_flag(argc, argv, "hash") || have_flag(argc, argv, "sha256")) run_benchmark("hash_sha256_transform_shani", bench_sha256_transform_shani, bench_setup, NULL, &data, 10, iters);
+    }
+#endif
     if (d || have_flag(argc, argv, "hash") || have_flag(argc, argv, "hmac")) run_benchmark("hash_hmac_sha256", bench_hmac_sha256, bench_setup, NULL, &data, 10, iters);
     if (d || have_flag(argc, argv, "hash") || have_flag(argc, argv, "rng6979")) run_benchmark("hash_rfc6979_hmac_sha256", bench_rfc6979_hmac_sha256, bench_setup, NULL, &data, 10, iters);
 
@@ -0,0 +1,68 @@
+/***********************************************************************
+ * Copyright (c) 2023 The libsecp256k1 developers                      *
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_CPU_FEATURES_H
+#define SECP256K1_CPU_FEATURES_H
+
+#include "util.h"
+
+#ifdef USE_X86_SIMD
+
+/* Runtime detection of x86 instruction set extensions, used to select between the SIMD
+ * implementations (which are compiled with a target attribute, so the rest of the library
+ * does not require these extensions) and the portable ones.
+ *
+ * The compiler's CPU model is initialized by a constructor of the runtime library, so that
+ * secp256k1_cpu_features_init only needs to be called before the detection functions may
+ * be used from other constructors. Before initialization, all features are reported as
+ * unavailable, which is safe. */
+static SECP256K1_INLINE void secp256k1_cpu_features_init(void) {
+    __builtin_cpu_init();
+}
+
+/* Attribute for functions that use AVX2 intrinsics. */
+#define SECP256K1_TARGET_AVX2 __attribute__((target("avx2")))
+
+/** Whether the CPU and the operating system support AVX2. */
+static SECP256K1_INLINE int secp256k1_cpu_has_avx2(void) {
+    return __builtin_cpu_supports("avx2");
+}
+
+/* Attribute for functions that use SSE4.1 (and SSSE3) intrinsics. */
+#define SECP256K1_TARGET_SSE4 __attribute__((target("sse4.1")))
+
+/** Whether the CPU supports SSE4.1. */
+static SECP256K1_INLINE int secp256k1_cpu_has_sse4(void) {
+    return __builtin_cpu_supports("sse4.1");
+}
+
+#ifdef USE_X86_SHANI
+
+/* Attribute for functions that use the SHA extensions (and SSE4.1 for shuffling the state). */
+#define SECP256K1_TARGET_SHANI __attribute__((target("sha,sse4.1")))
+
+/** Whether the CPU supports the SHA extensions and SSE4.1. */
+static SECP256K1_INLINE int secp256k1_cpu_has_shani(void) {
+    return __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1");
+}
+
+#else
+
+/* The compiler cannot detect the SHA extensions, so they are never used. */
+static SECP256K1_INLINE int secp256k1_cpu_has_shani(void) {
+    return 0;
+}
+
+#endif
+
+#else
+
+static SECP256K1_INLINE void secp256k1_cpu_features_init(void) {
+}
+
+#endif
+
+#endif /* SECP256K1_CPU_FEATURES_H */
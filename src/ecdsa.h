@@ -16,6 +16,13 @@
 static int secp256k1_ecdsa_sig_parse(secp256k1_scalar *r, secp256k1_scalar *s, const unsigned char *sig, size_t size);
 static int secp256k1_ecdsa_sig_serialize(unsigned char *sig, size_t *size, const secp256k1_scalar *r, const secp256k1_scalar *s);
 static int secp256k1_ecdsa_sig_verify(const secp256k1_scalar* r, const secp256k1_scalar* s, const secp256k1_ge *pubkey, const secp256k1_scalar *message);
+/** Same as secp256k1_ecdsa_sig_verify, but with the tables for the public key
+ *  precomputed by secp256k1_ecmult_pubkey_precomp_table. */
+static int secp256k1_ecdsa_sig_verify_precomp(const secp256k1_scalar* r, const secp256k1_scalar* s, const secp256k1_ge_storage *pre, const secp256k1_ge_storage *pre_lam, const secp256k1_scalar *message);
 static int secp256k1_ecdsa_sig_sign(const secp256k1_ecmult_gen_context *ctx, secp256k1_scalar* r, secp256k1_scalar* s, const secp256k1_scalar *seckey, const secp256k1_scalar *message, const secp256k1_scalar *nonce, int *recid);
+/** Same as secp256k1_ecdsa_sig_sign, but with the nonce point nonce*G (in
+ *  affine coordinates, which are normalized in place) and the inverse of the
+ *  nonce computed by the caller. */
+static int secp256k1_ecdsa_sig_sign_finish(secp256k1_scalar* r, secp256k1_scalar* s, secp256k1_ge *rp, const secp256k1_scalar *seckey, const secp256k1_scalar *message, const secp256k1_scalar *nonce_inv, int *recid);
 
 #endif /* SECP256K1_ECDSA_H */
@@ -204,33 +204,37 @@ static int secp256k1_ecdsa_sig_serialize(unsigned char *sig, size_t *size, const
     return 1;
 }
 
-static int secp256k1_ecdsa_sig_verify(const secp256k1_scalar *sigr, const secp256k1_scalar *sigs, const secp256k1_ge *pubkey, const secp256k1_scalar *message) {
-    unsigned char c[32];
-    secp256k1_scalar sn, u1, u2;
-#if !defined(EXHAUSTIVE_TEST_ORDER)
-    secp256k1_fe xr;
-#endif
-    secp256k1_gej pubkeyj;
-    secp256k1_gej pr;
+/* Compute u1 = message/sigs and u2 = sigr/sigs. Returns 0 if sigr or sigs is zero. */
+static int secp256k1_ecdsa_sig_verify_prepare(secp256k1_scalar *u1, secp256k1_scalar *u2, const secp256k1_scalar *sigr, const secp256k1_scalar *sigs, const secp256k1_scalar *message) {
+    secp256k1_scalar sn;
 
     if (secp256k1_scalar_is_zero(sigr) || secp256k1_scalar_is_zero(sigs)) {
         return 0;
     }
 
     secp256k1_scalar_inverse_var(&sn, sigs);
-    secp256k1_scalar_mul(&u1, &sn, message);
-    secp256k1_scalar_mul(&u2, &sn, sigr);
-    secp256k1_gej_set_ge(&pubkeyj, pubkey);
-    secp256k1_ecmult(&pr, &pubkeyj, &u2, &u1);
-    if (secp256k1_gej_is_infinity(&pr)) {
+    secp256k1_scalar_mul(u1, &sn, message);
+    secp256k1_scalar_mul(u2, &sn, sigr);
+    return 1;
+}
+
+/* Check that the x coordinate of pr = u1*G + u2*pubkey is sigr modulo the group order. */
+static int secp256k1_ecdsa_sig_verify_check(const secp256k1_scalar *sigr, const secp256k1_gej *pr) {
+    unsigned char c[32];
+#if !defined(EXHAUSTIVE_TEST_ORDER)
+    secp256k1_fe xr;
+#endif
+
+    if (secp256k1_gej_is_infinity(pr)) {
         return 0;
     }
 
 #if defined(EXHAUSTIVE_TEST_ORDER)
 {
     secp256k1_scalar computed_r;
+    secp256k1_gej prj = *pr;
     secp256k1_ge pr_ge;
-    secp256k1_ge_set_gej(&pr_ge, &pr);
+    secp256k1_ge_set_gej(&pr_ge, &prj);
     secp256k1_fe_normalize(&pr_ge.x);
 
     secp256k1_fe_get_b32(c, &pr_ge.x);
@@ -257,7 +261,7 @@ static int secp256k1_ecdsa_sig_verify(const secp256k1_scalar *sigr, const secp25
      *  Thus, we can avoid the inversion, but we have to check both cases separately.
      *  secp256k1_gej_eq_x implements the (xr * pr.z^2 mod p == pr.x) test.
      */
-    if (secp256k1_gej_eq_x_var(&xr, &pr)) {
+    if (secp256k1_gej_eq_x_var(&xr, pr)) {
         /* xr * pr.z^2 mod p == pr.x, so the signature is valid. */
         return 1;
     }
@@ -266,7 +270,7 @@ static int secp256k1_ecdsa_sig_verify(const secp256k1_scalar *sigr, const secp25
         return 0;
     }
     secp256k1_fe_add(&xr, &secp256k1_ecdsa_const_order_as_fe);
-    if (secp256k1_gej_eq_x_var(&xr, &pr)) {
+    if (secp256k1_gej_eq_x_var(&xr, pr)) {
         /* (xr + n) * pr.z^2 mod p == pr.x, so the signature is valid. */
         return 1;
     }
@@ -274,33 +278,50 @@ static int secp256k1_ecdsa_sig_verify(const secp256k1_scalar *sigr, const secp25
 #endif
 }
 
-static int secp256k1_ecdsa_sig_sign(const secp256k1_ecmult_gen_context *ctx, secp256k1_scalar *sigr, secp256k1_scalar *sigs, const secp256k1_scalar *seckey, const secp256k1_scalar *message, const secp256k1_scalar *nonce, int *recid) {
+static int secp256k1_ecdsa_sig_verify(const secp256k1_scalar *sigr, const secp256k1_scalar *sigs, const secp256k1_ge *pubkey, const secp256k1_scalar *message) {
+    secp256k1_scalar u1, u2;
+    secp256k1_gej pubkeyj;
+    secp256k1_gej pr;
+
+    if (!secp256k1_ecdsa_sig_verify_prepare(&u1, &u2, sigr, sigs, message)) {
+        return 0;
+    }
+    secp256k1_gej_set_ge(&pubkeyj, pubkey);
+    secp256k1_ecmult(&pr, &pubkeyj, &u2, &u1);
+    return secp256k1_ecdsa_sig_verify_check(sigr, &pr);
+}
+
+static int secp256k1_ecdsa_sig_verify_precomp(const secp256k1_scalar *sigr, const secp256k1_scalar *sigs, const secp256k1_ge_storage *pre, const secp256k1_ge_storage *pre_lam, const secp256k1_scalar *message) {
+    secp256k1_scalar u1, u2;
+    secp256k1_gej pr;
+
+    if (!secp256k1_ecdsa_sig_verify_prepare(&u1, &u2, sigr, sigs, message)) {
+        return 0;
+    }
+    secp256k1_ecmult_pubkey_precomp(&pr, pre, pre_lam, &u2, &u1);
+    return secp256k1_ecdsa_sig_verify_check(sigr, &pr);
+}
+
+static int secp256k1_ecdsa_sig_sign_finish(secp256k1_scalar *sigr, secp256k1_scalar *sigs, secp256k1_ge *r, const secp256k1_scalar *seckey, const secp256k1_scalar *message, const secp256k1_scalar *nonce_inv, int *recid) {
     unsigned char b[32];
-    secp256k1_gej rp;
-    secp256k1_ge r;
     secp256k1_scalar n;
     int overflow = 0;
     int high;
 
-    secp256k1_ecmult_gen(ctx, &rp, nonce);
-    secp256k1_ge_set_gej(&r, &rp);
-    secp256k1_fe_normalize(&r.x);
-    secp256k1_fe_normalize(&r.y);
-    secp256k1_fe_get_b32(b, &r.x);
+    secp256k1_fe_normalize(&r->x);
+    secp256k1_fe_normalize(&r->y);
+    secp256k1_fe_get_b32(b, &r->x);
     secp256k1_scalar_set_b32(sigr, b, &overflow);
     if (recid) {
         /* The overflow condition is cryptographically unreachable as hitting it requires finding the discrete log
          * of some P where P.x >= order, and only 1 in about 2^127 points meet this criteria.
          */
-        *recid = (overflow << 1) | secp256k1_fe_is_odd(&r.y);
+        *recid = (overflow << 1) | secp256k1_fe_is_odd(&r->y);
     }
     secp256k1_scalar_mul(&n, sigr, seckey);
     secp256k1_scalar_add(&n, &n, message);
-    secp256k1_scalar_inverse(sigs, nonce);
-    secp256k1_scalar_mul(sigs, sigs, &n);
+    secp256k1_scalar_mul(sigs, nonce_inv, &n);
     secp256k1_scalar_clear(&n);
-    secp256k1_gej_clear(&rp);
-    secp256k1_ge_clear(&r);
     high = secp256k1_scalar_is_high(sigs);
     secp256k1_scalar_cond_negate(sigs, high);
     if (recid) {
@@ -312,4 +333,20 @@ static int secp256k1_ecdsa_sig_sign(const secp256k1_ecmult_gen_context *ctx, sec
     return (int)(!secp256k1_scalar_is_zero(sigr)) & (int)(!secp256k1_scalar_is_zero(sigs));
 }
 
+static int secp256k1_ecdsa_sig_sign(const secp256k1_ecmult_gen_context *ctx, secp256k1_scalar *sigr, secp256k1_scalar *sigs, const secp256k1_scalar *seckey, const secp256k1_scalar *message, const secp256k1_scalar *nonce, int *recid) {
+    secp256k1_gej rp;
+    secp256k1_ge r;
+    secp256k1_scalar nonce_inv;
+    int ret;
+
+    secp256k1_ecmult_gen(ctx, &rp, nonce);
+    secp256k1_ge_set_gej(&r, &rp);
+    secp256k1_scalar_inverse(&nonce_inv, nonce);
+    ret = secp256k1_ecdsa_sig_sign_finish(sigr, sigs, &r, seckey, message, &nonce_inv, recid);
+    secp256k1_scalar_clear(&nonce_inv);
+    secp256k1_gej_clear(&rp);
+    secp256k1_ge_clear(&r);
+    return ret;
+}
+
 #endif /* SECP256K1_ECDSA_IMPL_H */
@@ -43,6 +43,27 @@
 /** Double multiply: R = na*A + ng*G */
 static void secp256k1_ecmult(secp256k1_gej *r, const secp256k1_gej *a, const secp256k1_scalar *na, const secp256k1_scalar *ng);
 
+/** Double multiply of up to four inputs: R[k] = na[k]*A[k] + ng[k]*G for 0 <= k < num,
+ *  where 0 < num <= 4. Same as num calls of secp256k1_ecmult, but the multiplications
+ *  share one pass over the scalar bits, so that their doublings and additions can be
+ *  computed side by side with secp256k1_gej_double_var_x4 and
+ *  secp256k1_gej_add_ge_var_x4. */
+static void secp256k1_ecmult_many(secp256k1_gej *r, const secp256k1_gej *a, const secp256k1_scalar *na, const secp256k1_scalar *ng, size_t num);
+
+/** Window size for the precomputed tables of a fixed point A. Since the
+ *  tables are computed only once, it can be much larger than WINDOW_A. */
+#define ECMULT_PUBKEY_PRECOMP_WINDOW 8
+#define ECMULT_PUBKEY_PRECOMP_TABLE_SIZE ECMULT_TABLE_SIZE(ECMULT_PUBKEY_PRECOMP_WINDOW)
+
+/** Fill pre with the odd multiples [1*A, 3*A, ..., (2^(w-1)-1)*A] and pre_lam
+ *  with the same multiples of lambda*A, for w = ECMULT_PUBKEY_PRECOMP_WINDOW.
+ *  Both tables have ECMULT_PUBKEY_PRECOMP_TABLE_SIZE entries. */
+static void secp256k1_ecmult_pubkey_precomp_table(secp256k1_ge_storage *pre, secp256k1_ge_storage *pre_lam, const secp256k1_ge *a);
+
+/** Double multiply: R = na*A + ng*G, with the tables for A computed by
+ *  secp256k1_ecmult_pubkey_precomp_table. */
+static void secp256k1_ecmult_pubkey_precomp(secp256k1_gej *r, const secp256k1_ge_storage *pre, const secp256k1_ge_storage *pre_lam, const secp256k1_scalar *na, const secp256k1_scalar *ng);
+
 typedef int (secp256k1_ecmult_multi_callback)(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *data);
 
 /**
@@ -58,4 +79,22 @@ typedef int (secp256k1_ecmult_multi_callback)(secp256k1_scalar *sc, secp256k1_ge
  */
 static int secp256k1_ecmult_multi_var(const secp256k1_callback* error_callback, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n);
 
+/** Runs task(task_data, i) for every i in [0, n_tasks), possibly concurrently,
+ *  and returns once all of them have completed. Returns 1 on success and 0
+ *  if the tasks could not be run. */
+typedef int (secp256k1_ecmult_multi_run_tasks)(void (*task)(void *task_data, size_t idx), void *task_data, size_t n_tasks, void *data);
+
+/**
+ * Same as secp256k1_ecmult_multi_var, but splits the points into n_tasks
+ * ranges of (almost) equal size, which are run as independent tasks by
+ * run_tasks. Each task gets an equal share of the scratch space and computes
+ * a partial sum, which are added up at the end. The callback cb must be safe
+ * to call concurrently. Falls back to secp256k1_ecmult_multi_var if n_tasks
+ * is at most 1 or the scratch space cannot be split.
+ * Returns: 1 on success
+ *          0 if secp256k1_ecmult_multi_var fails for any range or run_tasks
+ *          returns 0
+ */
+static int secp256k1_ecmult_multi_var_parallel(const secp256k1_callback* error_callback, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n, size_t n_tasks, secp256k1_ecmult_multi_run_tasks run_tasks, void *run_tasks_data);
+
 #endif /* SECP256K1_ECMULT_H */
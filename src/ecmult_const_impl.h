@@ -25,30 +25,21 @@ static void secp256k1_ecmult_odd_multiples_table_globalz_windowa(secp256k1_ge *p
     secp256k1_ge_table_set_globalz(ECMULT_TABLE_SIZE(WINDOW_A), pre, zr);
 }
 
-/* This is like `ECMULT_TABLE_GET_GE` but is constant time */
+/* This is like `ECMULT_TABLE_GET_GE` but is constant time, and takes a table of
+ * secp256k1_ge_storage entries. */
 #define ECMULT_CONST_TABLE_GET_GE(r,pre,n,w) do { \
-    int m = 0; \
     /* Extract the sign-bit for a constant time absolute-value. */ \
     int mask = (n) >> (sizeof(n) * CHAR_BIT - 1); \
     int abs_n = ((n) + mask) ^ mask; \
     int idx_n = abs_n >> 1; \
+    secp256k1_ge_storage adds; \
     secp256k1_fe neg_y; \
     VERIFY_CHECK(((n) & 1) == 1); \
     VERIFY_CHECK((n) >= -((1 << ((w)-1)) - 1)); \
     VERIFY_CHECK((n) <=  ((1 << ((w)-1)) - 1)); \
-    VERIFY_SETUP(secp256k1_fe_clear(&(r)->x)); \
-    VERIFY_SETUP(secp256k1_fe_clear(&(r)->y)); \
-    /* Unconditionally set r->x = (pre)[m].x. r->y = (pre)[m].y. because it's either the correct one \
-     * or will get replaced in the later iterations, this is needed to make sure `r` is initialized. */ \
-    (r)->x = (pre)[m].x; \
-    (r)->y = (pre)[m].y; \
-    for (m = 1; m < ECMULT_TABLE_SIZE(w); m++) { \
-        /* This loop is used to avoid secret data in array indices. See
-         * the comment in ecmult_gen_impl.h for rationale. */ \
-        secp256k1_fe_cmov(&(r)->x, &(pre)[m].x, m == idx_n); \
-        secp256k1_fe_cmov(&(r)->y, &(pre)[m].y, m == idx_n); \
-    } \
-    (r)->infinity = 0; \
+    /* This avoids secret data in array indices, see secp256k1_ge_storage_table_select. */ \
+    secp256k1_ge_storage_table_select(&adds, (pre), ECMULT_TABLE_SIZE(w), idx_n); \
+    secp256k1_ge_from_storage((r), &adds); \
     secp256k1_fe_negate(&neg_y, &(r)->y, 1); \
     secp256k1_fe_cmov(&(r)->y, &neg_y, (n) != abs_n); \
 } while(0)
@@ -130,33 +121,43 @@ static int secp256k1_wnaf_const(int *wnaf, const secp256k1_scalar *scalar, int w
     return skew;
 }
 
-static void secp256k1_ecmult_const(secp256k1_gej *r, const secp256k1_ge *a, const secp256k1_scalar *scalar, int size) {
-    secp256k1_ge pre_a[ECMULT_TABLE_SIZE(WINDOW_A)];
-    secp256k1_ge tmpa;
-    secp256k1_fe Z;
-
-    int skew_1;
-    secp256k1_ge pre_a_lam[ECMULT_TABLE_SIZE(WINDOW_A)];
+/** The wNAF recoding of a scalar for secp256k1_ecmult_const. It does not
+ *  depend on the point, so it can be reused to multiply several points by
+ *  the same scalar. */
+typedef struct {
+    int wnaf_1[1 + WNAF_SIZE(WINDOW_A - 1)];
     int wnaf_lam[1 + WNAF_SIZE(WINDOW_A - 1)];
+    int skew_1;
     int skew_lam;
-    secp256k1_scalar q_1, q_lam;
-    int wnaf_1[1 + WNAF_SIZE(WINDOW_A - 1)];
+    int size;
+} secp256k1_ecmult_const_recoding;
 
-    int i;
+static void secp256k1_ecmult_const_recode(secp256k1_ecmult_const_recoding *rec, const secp256k1_scalar *scalar, int size) {
+    secp256k1_scalar q_1, q_lam;
 
-    /* build wnaf representation for q. */
-    int rsize = size;
+    rec->size = size;
     if (size > 128) {
-        rsize = 128;
         /* split q into q_1 and q_lam (where q = q_1 + q_lam*lambda, and q_1 and q_lam are ~128 bit) */
         secp256k1_scalar_split_lambda(&q_1, &q_lam, scalar);
-        skew_1   = secp256k1_wnaf_const(wnaf_1,   &q_1,   WINDOW_A - 1, 128);
-        skew_lam = secp256k1_wnaf_const(wnaf_lam, &q_lam, WINDOW_A - 1, 128);
+        rec->skew_1   = secp256k1_wnaf_const(rec->wnaf_1,   &q_1,   WINDOW_A - 1, 128);
+        rec->skew_lam = secp256k1_wnaf_const(rec->wnaf_lam, &q_lam, WINDOW_A - 1, 128);
     } else
     {
-        skew_1   = secp256k1_wnaf_const(wnaf_1, scalar, WINDOW_A - 1, size);
-        skew_lam = 0;
+        rec->skew_1   = secp256k1_wnaf_const(rec->wnaf_1, scalar, WINDOW_A - 1, size);
+        rec->skew_lam = 0;
     }
+}
+
+static void secp256k1_ecmult_const_recoded(secp256k1_gej *r, const secp256k1_ge *a, const secp256k1_ecmult_const_recoding *rec) {
+    secp256k1_ge pre_a[ECMULT_TABLE_SIZE(WINDOW_A)];
+    secp256k1_ge tmpa;
+    secp256k1_fe Z;
+    secp256k1_ge pre_a_lam[ECMULT_TABLE_SIZE(WINDOW_A)];
+    secp256k1_ge_storage pre_a_st[ECMULT_TABLE_SIZE(WINDOW_A)];
+    secp256k1_ge_storage pre_a_lam_st[ECMULT_TABLE_SIZE(WINDOW_A)];
+    int size = rec->size;
+    int rsize = size > 128 ? 128 : size;
+    int i;
 
     /* Calculate odd multiples of a.
      * All multiples are brought to the same Z 'denominator', which is stored
@@ -167,27 +168,29 @@ static void secp256k1_ecmult_const(secp256k1_gej *r, const secp256k1_ge *a, cons
     VERIFY_CHECK(!a->infinity);
     secp256k1_gej_set_ge(r, a);
     secp256k1_ecmult_odd_multiples_table_globalz_windowa(pre_a, &Z, r);
+    /* The lookups below select from tables of 64-byte storage entries. */
     for (i = 0; i < ECMULT_TABLE_SIZE(WINDOW_A); i++) {
         secp256k1_fe_normalize_weak(&pre_a[i].y);
+        secp256k1_ge_to_storage(&pre_a_st[i], &pre_a[i]);
     }
     if (size > 128) {
         for (i = 0; i < ECMULT_TABLE_SIZE(WINDOW_A); i++) {
             secp256k1_ge_mul_lambda(&pre_a_lam[i], &pre_a[i]);
+            secp256k1_ge_to_storage(&pre_a_lam_st[i], &pre_a_lam[i]);
         }
-
     }
 
     /* first loop iteration (separated out so we can directly set r, rather
      * than having it start at infinity, get doubled several times, then have
      * its new value added to it) */
-    i = wnaf_1[WNAF_SIZE_BITS(rsize, WINDOW_A - 1)];
+    i = rec->wnaf_1[WNAF_SIZE_BITS(rsize, WINDOW_A - 1)];
     VERIFY_CHECK(i != 0);
-    ECMULT_CONST_TABLE_GET_GE(&tmpa, pre_a, i, WINDOW_A);
+    ECMULT_CONST_TABLE_GET_GE(&tmpa, pre_a_st, i, WINDOW_A);
     secp256k1_gej_set_ge(r, &tmpa);
     if (size > 128) {
-        i = wnaf_lam[WNAF_SIZE_BITS(rsize, WINDOW_A - 1)];
+        i = rec->wnaf_lam[WNAF_SIZE_BITS(rsize, WINDOW_A - 1)];
         VERIFY_CHECK(i != 0);
-        ECMULT_CONST_TABLE_GET_GE(&tmpa, pre_a_lam, i, WINDOW_A);
+        ECMULT_CONST_TABLE_GET_GE(&tmpa, pre_a_lam_st, i, WINDOW_A);
         secp256k1_gej_add_ge(r, r, &tmpa);
     }
     /* remaining loop iterations */
@@ -198,13 +201,13 @@ static void secp256k1_ecmult_const(secp256k1_gej *r, const secp256k1_ge *a, cons
             secp256k1_gej_double(r, r);
         }
 
-        n = wnaf_1[i];
-        ECMULT_CONST_TABLE_GET_GE(&tmpa, pre_a, n, WINDOW_A);
+        n = rec->wnaf_1[i];
+        ECMULT_CONST_TABLE_GET_GE(&tmpa, pre_a_st, n, WINDOW_A);
         VERIFY_CHECK(n != 0);
         secp256k1_gej_add_ge(r, r, &tmpa);
         if (size > 128) {
-            n = wnaf_lam[i];
-            ECMULT_CONST_TABLE_GET_GE(&tmpa, pre_a_lam, n, WINDOW_A);
+            n = rec->wnaf_lam[i];
+            ECMULT_CONST_TABLE_GET_GE(&tmpa, pre_a_lam_st, n, WINDOW_A);
             VERIFY_CHECK(n != 0);
             secp256k1_gej_add_ge(r, r, &tmpa);
         }
@@ -216,16 +219,23 @@ static void secp256k1_ecmult_const(secp256k1_gej *r, const secp256k1_ge *a, cons
 
         secp256k1_ge_neg(&tmpa, &pre_a[0]);
         secp256k1_gej_add_ge(&tmpj, r, &tmpa);
-        secp256k1_gej_cmov(r, &tmpj, skew_1);
+        secp256k1_gej_cmov(r, &tmpj, rec->skew_1);
 
         if (size > 128) {
             secp256k1_ge_neg(&tmpa, &pre_a_lam[0]);
             secp256k1_gej_add_ge(&tmpj, r, &tmpa);
-            secp256k1_gej_cmov(r, &tmpj, skew_lam);
+            secp256k1_gej_cmov(r, &tmpj, rec->skew_lam);
         }
     }
 
     secp256k1_fe_mul(&r->z, &r->z, &Z);
 }
 
+static void secp256k1_ecmult_const(secp256k1_gej *r, const secp256k1_ge *a, const secp256k1_scalar *scalar, int size) {
+    secp256k1_ecmult_const_recoding rec;
+
+    secp256k1_ecmult_const_recode(&rec, scalar, size);
+    secp256k1_ecmult_const_recoded(r, a, &rec);
+}
+
 #endif /* SECP256K1_ECMULT_CONST_IMPL_H */
@@ -7,37 +7,173 @@
 #ifndef SECP256K1_ECMULT_GEN_H
 #define SECP256K1_ECMULT_GEN_H
 
+#include "util.h"
 #include "scalar.h"
 #include "group.h"
 
-#ifndef ECMULT_GEN_PREC_BITS
-#  define ECMULT_GEN_PREC_BITS 4
+/* Configuration parameters for the signed-digit multi-comb algorithm:
+ *
+ * - COMB_BLOCKS is the number of blocks the input is split into. Each
+ *   has a corresponding table.
+ * - COMB_TEETH is the number of bits simultaneously covered by one table.
+ * - COMB_RANGE is the number of bits in supported scalars. For production
+ *   purposes, only 256 is reasonable, but smaller numbers are supported for
+ *   exhaustive test mode.
+ *
+ * The comb's spacing (COMB_SPACING), or the distance between the teeth,
+ * is defined as ceil(COMB_RANGE / (COMB_BLOCKS * COMB_TEETH)). Each block covers
+ * COMB_SPACING * COMB_TEETH consecutive bits in the input.
+ *
+ * The size of the precomputed table is COMB_BLOCKS * (1 << (COMB_TEETH - 1))
+ * secp256k1_ge_storages.
+ *
+ * The number of point additions equals COMB_BLOCKS * COMB_SPACING. Each point
+ * addition involves a cmov from (1 << (COMB_TEETH - 1)) table entries and a
+ * conditional negation.
+ *
+ * The number of point doublings is COMB_SPACING - 1. */
+
+#if defined(EXHAUSTIVE_TEST_ORDER)
+/* We need to control these values for exhaustive tests because
+ * the table cannot have infinities in them (this breaks the
+ * affine-isomorphism stuff which tracks z-ratios). This overrides
+ * the configured values. */
+#  undef COMB_BLOCKS
+#  undef COMB_TEETH
+#  if EXHAUSTIVE_TEST_ORDER == 13
+#    define COMB_RANGE 4
+#    define COMB_BLOCKS 1
+#    define COMB_TEETH 2
+#  elif EXHAUSTIVE_TEST_ORDER == 199
+#    define COMB_RANGE 8
+#    define COMB_BLOCKS 2
+#    define COMB_TEETH 3
+#  else
+#    error "Unknown exhaustive test order"
+#  endif
+#  if (COMB_RANGE >= 32) || ((EXHAUSTIVE_TEST_ORDER >> (COMB_RANGE - 1)) != 1)
+#    error "COMB_RANGE != ceil(log2(EXHAUSTIVE_TEST_ORDER+1))"
+#  endif
+#else /* !defined(EXHAUSTIVE_TEST_ORDER) */
+#  define COMB_RANGE 256
+#endif /* defined(EXHAUSTIVE_TEST_ORDER) */
+
+/* Use (11, 6) as default configuration, which results in a 22 kB table. */
+#ifndef COMB_BLOCKS
+#  define COMB_BLOCKS 11
+#  ifdef DEBUG_CONFIG
+#    pragma message DEBUG_CONFIG_MSG("COMB_BLOCKS undefined, assuming default value")
+#  endif
+#endif
+#ifndef COMB_TEETH
+#  define COMB_TEETH 6
 #  ifdef DEBUG_CONFIG
-#     pragma message DEBUG_CONFIG_MSG("ECMULT_GEN_PREC_BITS undefined, assuming default value")
+#    pragma message DEBUG_CONFIG_MSG("COMB_TEETH undefined, assuming default value")
 #  endif
 #endif
+/* Use ceil(COMB_RANGE / (COMB_BLOCKS * COMB_TEETH)) as COMB_SPACING. */
+#define COMB_SPACING CEIL_DIV(COMB_RANGE, COMB_BLOCKS * COMB_TEETH)
+
+/* The remaining COMB_* parameters are derived values, don't modify these. */
+/* - The number of bits covered by all the blocks; must be at least COMB_RANGE. */
+#define COMB_BITS (COMB_BLOCKS * COMB_TEETH * COMB_SPACING)
+/* - The number of entries per table. */
+#define COMB_POINTS (1 << (COMB_TEETH - 1))
+
+/* Sanity checks. */
+#if !(1 <= COMB_BLOCKS && COMB_BLOCKS <= 256)
+#  error "COMB_BLOCKS must be in the range [1, 256]"
+#endif
+#if !(1 <= COMB_TEETH && COMB_TEETH <= 8)
+#  error "COMB_TEETH must be in the range [1, 8]"
+#endif
+#if COMB_BITS < COMB_RANGE
+#  error "COMB_BLOCKS * COMB_TEETH * COMB_SPACING is too low"
+#endif
+
+/* These last 2 checks are not strictly required, but prevent gratuitously inefficient
+ * configurations, i.e., ones in which a block or a comb offset covers no bit of the
+ * scalar at all. */
+#if (COMB_BLOCKS - 1) * COMB_TEETH * COMB_SPACING >= COMB_RANGE
+#  error "COMB_BLOCKS is larger than necessary"
+#endif
+#if COMB_BLOCKS * COMB_TEETH * (COMB_SPACING - 1) >= COMB_RANGE
+#  error "COMB_SPACING is larger than necessary"
+#endif
 
 #ifdef DEBUG_CONFIG
-#  pragma message DEBUG_CONFIG_DEF(ECMULT_GEN_PREC_BITS)
+#  pragma message DEBUG_CONFIG_DEF(COMB_RANGE)
+#  pragma message DEBUG_CONFIG_DEF(COMB_BLOCKS)
+#  pragma message DEBUG_CONFIG_DEF(COMB_TEETH)
+#  pragma message DEBUG_CONFIG_DEF(COMB_SPACING)
+#endif
+
+/* Configuration of the larger table that contexts can build at runtime instead of using the
+ * compiled-in secp256k1_ecmult_gen_prec_table (see SECP256K1_CONTEXT_LARGE_GEN_TABLE). The
+ * parameters have the same meaning as the COMB_* parameters. Use (32, 8) by default, which
+ * results in a 256 kB table that needs no doublings. In exhaustive test mode, the runtime table
+ * has the same configuration as the compiled-in one. */
+#if defined(EXHAUSTIVE_TEST_ORDER)
+#  undef ECMULT_GEN_LARGE_BLOCKS
+#  undef ECMULT_GEN_LARGE_TEETH
+#  define ECMULT_GEN_LARGE_BLOCKS COMB_BLOCKS
+#  define ECMULT_GEN_LARGE_TEETH COMB_TEETH
+#else
+#  ifndef ECMULT_GEN_LARGE_BLOCKS
+#    define ECMULT_GEN_LARGE_BLOCKS 32
+#  endif
+#  ifndef ECMULT_GEN_LARGE_TEETH
+#    define ECMULT_GEN_LARGE_TEETH 8
+#  endif
 #endif
+#define ECMULT_GEN_LARGE_SPACING CEIL_DIV(COMB_RANGE, ECMULT_GEN_LARGE_BLOCKS * ECMULT_GEN_LARGE_TEETH)
+#define ECMULT_GEN_LARGE_BITS (ECMULT_GEN_LARGE_BLOCKS * ECMULT_GEN_LARGE_TEETH * ECMULT_GEN_LARGE_SPACING)
+#define ECMULT_GEN_LARGE_POINTS (1 << (ECMULT_GEN_LARGE_TEETH - 1))
+/* The number of secp256k1_ge_storage entries of the runtime table. */
+#define ECMULT_GEN_LARGE_TABLE_SIZE (ECMULT_GEN_LARGE_BLOCKS * ECMULT_GEN_LARGE_POINTS)
+/* Whether the runtime table is larger than the compiled-in one. If it is not, it would not be
+ * faster, and SECP256K1_CONTEXT_LARGE_GEN_TABLE has no effect. */
+#define ECMULT_GEN_LARGE_TABLE_ENABLED (ECMULT_GEN_LARGE_TABLE_SIZE > COMB_BLOCKS * COMB_POINTS)
 
-#if ECMULT_GEN_PREC_BITS != 2 && ECMULT_GEN_PREC_BITS != 4 && ECMULT_GEN_PREC_BITS != 8
-#  error "Set ECMULT_GEN_PREC_BITS to 2, 4 or 8."
+#if !(1 <= ECMULT_GEN_LARGE_BLOCKS && ECMULT_GEN_LARGE_BLOCKS <= 256)
+#  error "ECMULT_GEN_LARGE_BLOCKS must be in the range [1, 256]"
+#endif
+#if !(1 <= ECMULT_GEN_LARGE_TEETH && ECMULT_GEN_LARGE_TEETH <= 8)
+#  error "ECMULT_GEN_LARGE_TEETH must be in the range [1, 8]"
 #endif
 
-#define ECMULT_GEN_PREC_G(bits) (1 << bits)
-#define ECMULT_GEN_PREC_N(bits) (256 / bits)
+#ifdef DEBUG_CONFIG
+#  pragma message DEBUG_CONFIG_DEF(ECMULT_GEN_LARGE_BLOCKS)
+#  pragma message DEBUG_CONFIG_DEF(ECMULT_GEN_LARGE_TEETH)
+#endif
 
 typedef struct {
     /* Whether the context has been built. */
     int built;
 
-    /* Blinding values used when computing (n-b)G + bG. */
-    secp256k1_scalar blind; /* -b */
-    secp256k1_gej initial;  /* bG */
+    /* Values chosen such that
+     *
+     *   n*G == comb(n-scalar_offset, G/2) + ge_offset.
+     *
+     * This expression lets us use scalar blinding and optimize the comb precomputation. See
+     * ecmult_gen_impl.h for more details. */
+    secp256k1_scalar scalar_offset;
+    secp256k1_ge ge_offset;
+
+    /* Factor used for projective blinding. This value is used to rescale the Z
+     * coordinate of the first table lookup. */
+    secp256k1_fe proj_blind;
+
+    /* The table with ECMULT_GEN_LARGE_TABLE_SIZE entries built at runtime, or NULL if the
+     * compiled-in secp256k1_ecmult_gen_prec_table is used. The memory is not owned by
+     * this object. */
+    secp256k1_ge_storage *large_table;
 } secp256k1_ecmult_gen_context;
 
-static void secp256k1_ecmult_gen_context_build(secp256k1_ecmult_gen_context* ctx);
+/** Build the context. If large_table is not NULL, it must point to memory for
+ *  ECMULT_GEN_LARGE_TABLE_SIZE entries, which is filled with the runtime table and used
+ *  instead of the compiled-in table. */
+static void secp256k1_ecmult_gen_context_build(secp256k1_ecmult_gen_context* ctx, secp256k1_ge_storage *large_table);
 static void secp256k1_ecmult_gen_context_clear(secp256k1_ecmult_gen_context* ctx);
 
 /** Multiply with the generator: R = a*G */
@@ -9,6 +9,8 @@
 
 #include "ecmult_gen.h"
 
-static void secp256k1_ecmult_gen_compute_table(secp256k1_ge_storage* table, const secp256k1_ge* gen, int bits);
+/** Compute the signed-digit multi-comb table for secp256k1_ecmult_gen, with blocks*2^(teeth-1)
+ *  entries, for the given generator and comb parameters (see ecmult_gen.h). */
+static void secp256k1_ecmult_gen_compute_table(secp256k1_ge_storage* table, const secp256k1_ge* gen, int blocks, int teeth, int spacing);
 
 #endif /* SECP256K1_ECMULT_GEN_COMPUTE_TABLE_H */
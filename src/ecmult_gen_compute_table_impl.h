@@ -10,72 +10,108 @@
 #include "ecmult_gen_compute_table.h"
 #include "group_impl.h"
 #include "field_impl.h"
+#include "scalar_impl.h"
 #include "ecmult_gen.h"
 #include "util.h"
 
-static void secp256k1_ecmult_gen_compute_table(secp256k1_ge_storage* table, const secp256k1_ge* gen, int bits) {
-    int g = ECMULT_GEN_PREC_G(bits);
-    int n = ECMULT_GEN_PREC_N(bits);
+/* The number of table entries that are converted to affine coordinates at once. */
+#define ECMULT_GEN_COMPUTE_TABLE_BATCH 16
 
-    secp256k1_ge* prec = checked_malloc(&default_error_callback, n * g * sizeof(*prec));
-    secp256k1_gej gj;
-    secp256k1_gej nums_gej;
-    int i, j;
+static void secp256k1_ecmult_gen_compute_table(secp256k1_ge_storage* table, const secp256k1_ge* gen, int blocks, int teeth, int spacing) {
+    size_t points = ((size_t)1) << (teeth - 1);
+    secp256k1_gej ds[8];
+    secp256k1_ge ds_ge[8];
+    secp256k1_gej vs[ECMULT_GEN_COMPUTE_TABLE_BATCH];
+    secp256k1_ge prec[ECMULT_GEN_COMPUTE_TABLE_BATCH];
+    secp256k1_gej u;
+    secp256k1_scalar two, half;
+    int block, i;
 
-    /* get the generator */
-    secp256k1_gej_set_ge(&gj, gen);
+    /* The work space is kept on the stack, so that contexts can build their table without
+     * allocating memory (see secp256k1_ecmult_gen_context_build). */
+    VERIFY_CHECK(1 <= teeth && teeth <= 8);
+    VERIFY_CHECK(blocks > 0);
 
-    /* Construct a group element with no known corresponding scalar (nothing up my sleeve). */
+    /* u is the running power of two times gen we're working with, initially gen/2. */
+    secp256k1_scalar_set_int(&two, 2);
+    secp256k1_scalar_inverse_var(&half, &two);
+    secp256k1_gej_set_infinity(&u);
+    for (i = 255; i >= 0; --i) {
+        /* Use a very simple multiplication ladder to avoid dependency on ecmult. */
+        secp256k1_gej_double_var(&u, &u, NULL);
+        if (secp256k1_scalar_get_bits(&half, i, 1)) {
+            secp256k1_gej_add_ge_var(&u, &u, gen, NULL);
+        }
+    }
+#ifdef VERIFY
     {
-        static const unsigned char nums_b32[33] = "The scalar for this x is unknown";
-        secp256k1_fe nums_x;
-        secp256k1_ge nums_ge;
-        int r;
-        r = secp256k1_fe_set_b32(&nums_x, nums_b32);
-        (void)r;
-        VERIFY_CHECK(r);
-        r = secp256k1_ge_set_xo_var(&nums_ge, &nums_x, 0);
-        (void)r;
-        VERIFY_CHECK(r);
-        secp256k1_gej_set_ge(&nums_gej, &nums_ge);
-        /* Add G to make the bits in x uniformly distributed. */
-        secp256k1_gej_add_ge_var(&nums_gej, &nums_gej, gen, NULL);
+        /* Verify that u*2 = gen. */
+        secp256k1_gej double_u;
+        secp256k1_ge double_u_ge;
+        secp256k1_gej_double_var(&double_u, &u, NULL);
+        secp256k1_ge_set_gej_var(&double_u_ge, &double_u);
+        VERIFY_CHECK(secp256k1_fe_equal_var(&double_u_ge.x, &gen->x));
+        VERIFY_CHECK(secp256k1_fe_equal_var(&double_u_ge.y, &gen->y));
     }
+#endif
 
-    /* compute prec. */
-    {
-        secp256k1_gej gbase;
-        secp256k1_gej numsbase;
-        secp256k1_gej* precj = checked_malloc(&default_error_callback, n * g * sizeof(*precj));  /* Jacobian versions of prec. */
-        gbase = gj; /* PREC_G^j * G */
-        numsbase = nums_gej; /* 2^j * nums. */
-        for (j = 0; j < n; j++) {
-            /* Set precj[j*PREC_G .. j*PREC_G+(PREC_G-1)] to (numsbase, numsbase + gbase, ..., numsbase + (PREC_G-1)*gbase). */
-            precj[j*g] = numsbase;
-            for (i = 1; i < g; i++) {
-                secp256k1_gej_add_var(&precj[j*g + i], &precj[j*g + i - 1], &gbase, NULL);
-            }
-            /* Multiply gbase by PREC_G. */
-            for (i = 0; i < bits; i++) {
-                secp256k1_gej_double_var(&gbase, &gbase, NULL);
-            }
-            /* Multiply numbase by 2. */
-            secp256k1_gej_double_var(&numsbase, &numsbase, NULL);
-            if (j == n - 2) {
-                /* In the last iteration, numsbase is (1 - 2^j) * nums instead. */
-                secp256k1_gej_neg(&numsbase, &numsbase);
-                secp256k1_gej_add_var(&numsbase, &numsbase, &nums_gej, NULL);
+    for (block = 0; block < blocks; ++block) {
+        secp256k1_ge_storage* block_table = &table[block * points];
+        secp256k1_gej sum;
+        secp256k1_ge first;
+        int tooth;
+        /* Here u = 2^(block*teeth*spacing) * gen/2. */
+        secp256k1_gej_set_infinity(&sum);
+        for (tooth = 0; tooth < teeth; ++tooth) {
+            /* Here u = 2^((block*teeth + tooth)*spacing) * gen/2. */
+            /* Make sum = sum(2^((block*teeth + t)*spacing), t=0..tooth) * gen/2. */
+            secp256k1_gej_add_var(&sum, &sum, &u, NULL);
+            /* Make u = 2^((block*teeth + tooth)*spacing + 1) * gen/2. */
+            secp256k1_gej_double_var(&u, &u, NULL);
+            /* Make ds[tooth] = u = 2^((block*teeth + tooth)*spacing + 1) * gen/2. */
+            ds[tooth] = u;
+            /* Make u = 2^((block*teeth + tooth + 1)*spacing) * gen/2, unless at the end. */
+            if (block + tooth != blocks + teeth - 2) {
+                int bit_off;
+                for (bit_off = 1; bit_off < spacing; ++bit_off) {
+                    secp256k1_gej_double_var(&u, &u, NULL);
+                }
             }
         }
-        secp256k1_ge_set_all_gej_var(prec, precj, n * g);
-        free(precj);
-    }
-    for (j = 0; j < n; j++) {
-        for (i = 0; i < g; i++) {
-            secp256k1_ge_to_storage(&table[j*g + i], &prec[j*g + i]);
+        /* Now u = 2^((block*teeth + teeth)*spacing) * gen/2
+         *       = 2^((block+1)*teeth*spacing) * gen/2       */
+        secp256k1_ge_set_all_gej_var(ds_ge, ds, teeth);
+
+        /* Next, compute the table entries for block number block. The entries will occupy
+         * block_table[i] for i=0..points-1. We start by computing the first (i=0) value
+         * corresponding to all summed powers of two times G being negative. */
+        secp256k1_gej_neg(&sum, &sum);
+        secp256k1_ge_set_gej_var(&first, &sum);
+        VERIFY_CHECK(!secp256k1_ge_is_infinity(&first));
+        secp256k1_ge_to_storage(&block_table[0], &first);
+        /* And then teeth-1 times "double" the range of i values for which the table
+         * is computed: in each iteration, double the table by taking an existing
+         * table entry and adding ds[tooth]. The new entries are converted to affine
+         * coordinates in batches. */
+        for (tooth = 0; tooth < teeth - 1; ++tooth) {
+            size_t stride = ((size_t)1) << tooth;
+            size_t index, j;
+            for (index = 0; index < stride; index += ECMULT_GEN_COMPUTE_TABLE_BATCH) {
+                size_t batch = stride - index < ECMULT_GEN_COMPUTE_TABLE_BATCH ? stride - index : ECMULT_GEN_COMPUTE_TABLE_BATCH;
+                for (j = 0; j < batch; ++j) {
+                    secp256k1_ge prev;
+                    secp256k1_ge_from_storage(&prev, &block_table[index + j]);
+                    secp256k1_gej_set_ge(&vs[j], &prev);
+                    secp256k1_gej_add_ge_var(&vs[j], &vs[j], &ds_ge[tooth], NULL);
+                }
+                secp256k1_ge_set_all_gej_var(prec, vs, batch);
+                for (j = 0; j < batch; ++j) {
+                    VERIFY_CHECK(!secp256k1_ge_is_infinity(&prec[j]));
+                    secp256k1_ge_to_storage(&block_table[stride + index + j], &prec[j]);
+                }
+            }
         }
     }
-    free(prec);
 }
 
 #endif /* SECP256K1_ECMULT_GEN_COMPUTE_TABLE_IMPL_H */
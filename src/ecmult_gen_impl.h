@@ -13,8 +13,13 @@
 #include "ecmult_gen.h"
 #include "hash_impl.h"
 #include "precomputed_ecmult_gen.h"
+#include "ecmult_gen_compute_table_impl.h"
 
-static void secp256k1_ecmult_gen_context_build(secp256k1_ecmult_gen_context *ctx) {
+static void secp256k1_ecmult_gen_context_build(secp256k1_ecmult_gen_context *ctx, secp256k1_ge_storage *large_table) {
+    if (large_table != NULL) {
+        secp256k1_ecmult_gen_compute_table(large_table, &secp256k1_ge_const_g, ECMULT_GEN_LARGE_BLOCKS, ECMULT_GEN_LARGE_TEETH, ECMULT_GEN_LARGE_SPACING);
+    }
+    ctx->large_table = large_table;
     secp256k1_ecmult_gen_blind(ctx, NULL);
     ctx->built = 1;
 }
@@ -25,79 +30,207 @@ static int secp256k1_ecmult_gen_context_is_built(const secp256k1_ecmult_gen_cont
 
 static void secp256k1_ecmult_gen_context_clear(secp256k1_ecmult_gen_context *ctx) {
     ctx->built = 0;
-    secp256k1_scalar_clear(&ctx->blind);
-    secp256k1_gej_clear(&ctx->initial);
+    secp256k1_scalar_clear(&ctx->scalar_offset);
+    secp256k1_ge_clear(&ctx->ge_offset);
+    secp256k1_fe_clear(&ctx->proj_blind);
+    ctx->large_table = NULL;
 }
 
-/* For accelerating the computation of a*G:
- * To harden against timing attacks, use the following mechanism:
- * * Break up the multiplicand into groups of PREC_BITS bits, called n_0, n_1, n_2, ..., n_(PREC_N-1).
- * * Compute sum(n_i * (PREC_G)^i * G + U_i, i=0 ... PREC_N-1), where:
- *   * U_i = U * 2^i, for i=0 ... PREC_N-2
- *   * U_i = U * (1-2^(PREC_N-1)), for i=PREC_N-1
- *   where U is a point with no known corresponding scalar. Note that sum(U_i, i=0 ... PREC_N-1) = 0.
- * For each i, and each of the PREC_G possible values of n_i, (n_i * (PREC_G)^i * G + U_i) is
- * precomputed (call it prec(i, n_i)). The formula now becomes sum(prec(i, n_i), i=0 ... PREC_N-1).
- * None of the resulting prec group elements have a known scalar, and neither do any of
- * the intermediate sums while computing a*G.
- * The prec values are stored in secp256k1_ecmult_gen_prec_table[i][n_i] = n_i * (PREC_G)^i * G + U_i.
- */
-static void secp256k1_ecmult_gen(const secp256k1_ecmult_gen_context *ctx, secp256k1_gej *r, const secp256k1_scalar *gn) {
-    int bits = ECMULT_GEN_PREC_BITS;
-    int g = ECMULT_GEN_PREC_G(bits);
-    int n = ECMULT_GEN_PREC_N(bits);
+/* Compute the scalar (2^bits - 1) / 2, the difference between the gn argument to
+ * secp256k1_ecmult_gen, and the scalar whose encoding the table lookup bits are drawn
+ * from (before applying blinding). bits is COMB_BITS, or ECMULT_GEN_LARGE_BITS if the
+ * context uses the runtime table. */
+static void secp256k1_ecmult_gen_scalar_diff(secp256k1_scalar* diff, int bits) {
+    int i;
+
+    /* Compute scalar -1/2. */
+    secp256k1_scalar two, neghalf;
+    secp256k1_scalar_set_int(&two, 2);
+    secp256k1_scalar_inverse_var(&neghalf, &two);
+    secp256k1_scalar_negate(&neghalf, &neghalf);
+
+    /* Compute offset = 2^(bits - 1). */
+    secp256k1_scalar_set_int(diff, 1);
+    for (i = 0; i < bits - 1; ++i) {
+        secp256k1_scalar_add(diff, diff, diff);
+    }
 
+    /* The result is the sum 2^(bits - 1) + (-1/2). */
+    secp256k1_scalar_add(diff, diff, &neghalf);
+}
+
+/* Add comb(d, G/2) to r (see secp256k1_ecmult_gen), where the bits of d are given in
+ * recoded, using a table with blocks*2^(teeth-1) entries computed by
+ * secp256k1_ecmult_gen_compute_table with the given parameters. r is set rather than added
+ * to by the first table lookup. This is inlined into both call sites, so that the loops
+ * for the compiled-in table are specialized to the constant COMB_* parameters. */
+static SECP256K1_INLINE void secp256k1_ecmult_gen_comb(const secp256k1_ecmult_gen_context *ctx, secp256k1_gej *r, const uint32_t *recoded, const secp256k1_ge_storage *table, uint32_t blocks, uint32_t teeth, uint32_t spacing) {
+    uint32_t points = ((uint32_t)1) << (teeth - 1);
+    uint32_t comb_off;
     secp256k1_ge add;
+    secp256k1_fe neg;
     secp256k1_ge_storage adds;
-    secp256k1_scalar gnb;
-    int i, j, n_i;
-    
-    memset(&adds, 0, sizeof(adds));
-    *r = ctx->initial;
-    /* Blind scalar/point multiplication by computing (n-b)G + bG instead of nG. */
-    secp256k1_scalar_add(&gnb, gn, &ctx->blind);
-    add.infinity = 0;
-    for (i = 0; i < n; i++) {
-        n_i = secp256k1_scalar_get_bits(&gnb, i * bits, bits);
-        for (j = 0; j < g; j++) {
-            /** This uses a conditional move to avoid any secret data in array indexes.
-             *   _Any_ use of secret indexes has been demonstrated to result in timing
-             *   sidechannels, even when the cache-line access patterns are uniform.
-             *  See also:
-             *   "A word of warning", CHES 2013 Rump Session, by Daniel J. Bernstein and Peter Schwabe
-             *    (https://cryptojedi.org/peter/data/chesrump-20130822.pdf) and
-             *   "Cache Attacks and Countermeasures: the Case of AES", RSA 2006,
-             *    by Dag Arne Osvik, Adi Shamir, and Eran Tromer
-             *    (https://www.tau.ac.il/~tromer/papers/cache.pdf)
+    int first = 1;
+
+    comb_off = spacing - 1;
+    while (1) {
+        uint32_t block;
+        uint32_t bit_pos = comb_off;
+        /* Inner loop: for each block, add table entries to the result. */
+        for (block = 0; block < blocks; ++block) {
+            /* Gather the mask(block)-selected bits of d into bits. They're packed:
+             * bits[tooth] = d[(block*teeth + tooth)*spacing + comb_off]. */
+            uint32_t bits = 0, sign, abs, tooth;
+            /* Instead of reading individual bits here to construct the bits variable,
+             * build up the result by xoring rotated reads together. In every iteration,
+             * one additional bit is made correct, starting at the bottom. The bits
+             * above that contain junk. This reduces leakage by avoiding computations
+             * on variables that can have only a low number of possible values (e.g.,
+             * just two values when reading a single bit into a variable.) See:
+             * https://www.usenix.org/system/files/conference/usenixsecurity18/sec18-alam.pdf
              */
-            secp256k1_ge_storage_cmov(&adds, &secp256k1_ecmult_gen_prec_table[i][j], j == n_i);
+            for (tooth = 0; tooth < teeth; ++tooth) {
+                /* Construct bitdata s.t. the bottom bit is the bit we'd like to read.
+                 *
+                 * We could just set bitdata = recoded[bit_pos >> 5] >> (bit_pos & 0x1f)
+                 * but this would simply discard the bits that fall off at the bottom,
+                 * and thus, for example, bitdata could still have only two values if we
+                 * happen to shift by exactly 31 positions. We use a rotation instead,
+                 * which ensures that bitdata doesn't lose entropy. This relies on the
+                 * rotation being atomic, i.e., the compiler emitting an actual rot
+                 * instruction. */
+                uint32_t bitdata = secp256k1_rotr32(recoded[bit_pos >> 5], bit_pos & 0x1f);
+
+                /* Clear the bit at position tooth, but sssh, don't tell clang. */
+                uint32_t volatile vmask = ~(1 << tooth);
+                bits &= vmask;
+
+                /* Write the bit into position tooth (and junk into higher bits). */
+                bits ^= bitdata << tooth;
+                bit_pos += spacing;
+            }
+
+            /* If the top bit of bits is 1, flip them all (corresponding to looking up
+             * the negated table value), and remember to negate the result in sign. */
+            sign = (bits >> (teeth - 1)) & 1;
+            abs = (bits ^ -sign) & (points - 1);
+            VERIFY_CHECK(sign == 0 || sign == 1);
+            VERIFY_CHECK(abs < points);
+
+            /* Look up the entry in constant time (see secp256k1_ge_storage_table_select). */
+            secp256k1_ge_storage_table_select(&adds, &table[block * points], points, abs);
+
+            /* Set add=adds or add=-adds, in constant time, based on sign. */
+            secp256k1_ge_from_storage(&add, &adds);
+            secp256k1_fe_negate(&neg, &add.y, 1);
+            secp256k1_fe_cmov(&add.y, &neg, sign);
+
+            /* Add the looked up and conditionally negated value to r. */
+            if (EXPECT(first, 0)) {
+                /* If this is the first table lookup, we can skip addition. */
+                secp256k1_gej_set_ge(r, &add);
+                /* Give the entry a random Z coordinate to blind intermediary results. */
+                secp256k1_gej_rescale(r, &ctx->proj_blind);
+                first = 0;
+            } else {
+                secp256k1_gej_add_ge(r, r, &add);
+            }
         }
-        secp256k1_ge_from_storage(&add, &adds);
-        secp256k1_gej_add_ge(r, r, &add);
+
+        /* Double the result, except in the last iteration. */
+        if (comb_off-- == 0) break;
+        secp256k1_gej_double(r, r);
     }
-    n_i = 0;
+
+    /* Cleanup. */
+    secp256k1_fe_clear(&neg);
     secp256k1_ge_clear(&add);
-    secp256k1_scalar_clear(&gnb);
+    memset(&adds, 0, sizeof(adds));
+}
+
+static void secp256k1_ecmult_gen(const secp256k1_ecmult_gen_context *ctx, secp256k1_gej *r, const secp256k1_scalar *gn) {
+    secp256k1_scalar d;
+    /* Array of uint32_t values large enough to store COMB_BITS or ECMULT_GEN_LARGE_BITS
+     * bits. Only the bottom 8 are ever nonzero, but having the zero padding at the end if
+     * the number of bits exceeds 256 avoids the need to deal with out-of-bounds reads from
+     * a scalar. */
+    uint32_t recoded[((COMB_BITS > ECMULT_GEN_LARGE_BITS ? COMB_BITS : ECMULT_GEN_LARGE_BITS) + 31) >> 5] = {0};
+    int i;
+
+    /* We want to compute R = gn*G.
+     *
+     * We'll rewrite this as R = (gn-b)*G + b*G, where b is a blinding value, chosen
+     * at random when the context is randomized, and b*G is precomputed as ge_offset.
+     *
+     * The comb multiplication below computes sum((2*d_i-1) * 2^(i-1) * G, i=0..COMB_BITS-1)
+     * for the bits d_i of a scalar d, which equals (d - (2^COMB_BITS - 1)/2)*G. We call this
+     * comb(d, G/2), because the table entries are sums of +-2^i * G/2. To compute
+     * (gn-b)*G with it, we need d = gn - b + (2^COMB_BITS - 1)/2, so we precompute
+     * scalar_offset = (2^COMB_BITS - 1)/2 - b (see secp256k1_ecmult_gen_scalar_diff) and
+     * obtain
+     *
+     *   gn*G = comb(gn + scalar_offset, G/2) + ge_offset.
+     *
+     * The bits of d are split into COMB_BLOCKS blocks of COMB_TEETH*COMB_SPACING bits. For
+     * every comb offset comb_off in [0, COMB_SPACING) and every block, the COMB_TEETH bits
+     * d[(block*COMB_TEETH + tooth)*COMB_SPACING + comb_off] for tooth in [0, COMB_TEETH)
+     * select a precomputed sum of +-2^((block*COMB_TEETH + tooth)*COMB_SPACING) * G/2
+     * terms. Since negating all signs of such a sum negates the point, only the half of
+     * the entries with a negative top term is stored, and the others are obtained by
+     * negating the lookup result. The contributions of the different comb offsets are
+     * combined by doubling in between, like in a double-and-add ladder.
+     *
+     * If the context has built a runtime table, the same applies with the ECMULT_GEN_LARGE_*
+     * parameters in place of the COMB_* ones (including the scalar_offset, which is computed
+     * for ECMULT_GEN_LARGE_BITS then).
+     */
+
+    /* Compute the scalar d = (gn + ctx->scalar_offset). */
+    secp256k1_scalar_add(&d, &ctx->scalar_offset, gn);
+    /* Convert to recoded array. */
+    for (i = 0; i < 8 && i < (int)(sizeof(recoded) / sizeof(recoded[0])); ++i) {
+        recoded[i] = secp256k1_scalar_get_bits_limb32(&d, 32 * i, 32);
+    }
+    secp256k1_scalar_clear(&d);
+
+    if (ctx->large_table != NULL) {
+        secp256k1_ecmult_gen_comb(ctx, r, recoded, ctx->large_table, ECMULT_GEN_LARGE_BLOCKS, ECMULT_GEN_LARGE_TEETH, ECMULT_GEN_LARGE_SPACING);
+    } else {
+        secp256k1_ecmult_gen_comb(ctx, r, recoded, &secp256k1_ecmult_gen_prec_table[0][0], COMB_BLOCKS, COMB_TEETH, COMB_SPACING);
+    }
+
+    /* Correct for the scalar_offset added at the start (ge_offset = b*G, while b was
+     * subtracted from the input scalar gn). */
+    secp256k1_gej_add_ge(r, r, &ctx->ge_offset);
+
+    /* Cleanup. */
+    memset(&recoded, 0, sizeof(recoded));
 }
 
 /* Setup blinding values for secp256k1_ecmult_gen. */
 static void secp256k1_ecmult_gen_blind(secp256k1_ecmult_gen_context *ctx, const unsigned char *seed32) {
     secp256k1_scalar b;
+    secp256k1_scalar diff;
     secp256k1_gej gb;
-    secp256k1_fe s;
+    secp256k1_fe f;
     unsigned char nonce32[32];
     secp256k1_rfc6979_hmac_sha256 rng;
     int overflow;
     unsigned char keydata[64];
+
+    /* Compute the (2^bits - 1)/2 term once. */
+    secp256k1_ecmult_gen_scalar_diff(&diff, ctx->large_table != NULL ? ECMULT_GEN_LARGE_BITS : COMB_BITS);
+
     if (seed32 == NULL) {
-        /* When seed is NULL, reset the initial point and blinding value. */
-        secp256k1_gej_set_ge(&ctx->initial, &secp256k1_ge_const_g);
-        secp256k1_gej_neg(&ctx->initial, &ctx->initial);
-        secp256k1_scalar_set_int(&ctx->blind, 1);
+        /* When seed is NULL, reset the final point and blinding value. */
+        secp256k1_ge_neg(&ctx->ge_offset, &secp256k1_ge_const_g);
+        secp256k1_fe_normalize_weak(&ctx->ge_offset.y);
+        secp256k1_scalar_add(&ctx->scalar_offset, &secp256k1_scalar_one, &diff);
+        ctx->proj_blind = secp256k1_fe_one;
         return;
     }
     /* The prior blinding value (if not reset) is chained forward by including it in the hash. */
-    secp256k1_scalar_get_b32(keydata, &ctx->blind);
+    secp256k1_scalar_get_b32(keydata, &ctx->scalar_offset);
     /** Using a CSPRNG allows a failure free interface, avoids needing large amounts of random data,
      *   and guards against weak or adversarial seeds.  This is a simpler and safer interface than
      *   asking the caller for blinding values directly and expecting them to retry on failure.
@@ -106,28 +239,32 @@ static void secp256k1_ecmult_gen_blind(secp256k1_ecmult_gen_context *ctx, const
     memcpy(keydata + 32, seed32, 32);
     secp256k1_rfc6979_hmac_sha256_initialize(&rng, keydata, 64);
     memset(keydata, 0, sizeof(keydata));
-    /* Accept unobservably small non-uniformity. */
+
+    /* Compute projective blinding factor (cannot be 0). Accept unobservably small
+     * non-uniformity. */
     secp256k1_rfc6979_hmac_sha256_generate(&rng, nonce32, 32);
-    overflow = !secp256k1_fe_set_b32(&s, nonce32);
-    overflow |= secp256k1_fe_is_zero(&s);
-    secp256k1_fe_cmov(&s, &secp256k1_fe_one, overflow);
-    /* Randomize the projection to defend against multiplier sidechannels.
-       Do this before our own call to secp256k1_ecmult_gen below. */
-    secp256k1_gej_rescale(&ctx->initial, &s);
-    secp256k1_fe_clear(&s);
+    overflow = !secp256k1_fe_set_b32(&f, nonce32);
+    overflow |= secp256k1_fe_is_zero(&f);
+    secp256k1_fe_cmov(&f, &secp256k1_fe_one, overflow);
+    ctx->proj_blind = f;
+
+    /* For a random blinding value b, set scalar_offset=diff-b, ge_offset=bG */
     secp256k1_rfc6979_hmac_sha256_generate(&rng, nonce32, 32);
     secp256k1_scalar_set_b32(&b, nonce32, NULL);
-    /* A blinding value of 0 works, but would undermine the projection hardening. */
+    /* The blinding value cannot be zero, as that would mean ge_offset = infinity,
+     * which secp256k1_gej_add_ge cannot handle. */
     secp256k1_scalar_cmov(&b, &secp256k1_scalar_one, secp256k1_scalar_is_zero(&b));
     secp256k1_rfc6979_hmac_sha256_finalize(&rng);
     memset(nonce32, 0, 32);
-    /* The random projection in ctx->initial ensures that gb will have a random projection. */
     secp256k1_ecmult_gen(ctx, &gb, &b);
     secp256k1_scalar_negate(&b, &b);
-    ctx->blind = b;
-    ctx->initial = gb;
+    secp256k1_scalar_add(&ctx->scalar_offset, &b, &diff);
+    secp256k1_ge_set_gej(&ctx->ge_offset, &gb);
+
+    /* Clean up. */
     secp256k1_scalar_clear(&b);
     secp256k1_gej_clear(&gb);
+    secp256k1_fe_clear(&f);
 }
 
 #endif /* SECP256K1_ECMULT_GEN_IMPL_H */
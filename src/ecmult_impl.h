@@ -46,10 +46,22 @@
 #define WNAF_SIZE(w) WNAF_SIZE_BITS(WNAF_BITS, w)
 
 /* The number of objects allocated on the scratch space for ecmult_multi algorithms */
-#define PIPPENGER_SCRATCH_OBJECTS 6
+#define PIPPENGER_SCRATCH_OBJECTS 8
 #define STRAUSS_SCRATCH_OBJECTS 5
 
-#define PIPPENGER_MAX_BUCKET_WINDOW 12
+#define PIPPENGER_MAX_BUCKET_WINDOW 15
+
+/* Minimum bucket_window for which Pippenger's algorithm accumulates the
+ * buckets in affine coordinates (see pippenger_wnaf_affine). For smaller
+ * windows, the Jacobian accumulation with gej_add_ge_var_x4 is as fast or
+ * faster, so only the largest window (more than 750000 points) is affine. */
+#define PIPPENGER_AFFINE_MIN_WINDOW PIPPENGER_MAX_BUCKET_WINDOW
+
+/* Minimum and maximum number of affine additions that share a field
+ * inversion. If fewer additions can be batched, the points are added to the
+ * buckets in Jacobian coordinates. */
+#define PIPPENGER_AFFINE_MIN_BATCH 32
+#define PIPPENGER_AFFINE_MAX_BATCH 512
 
 /* Minimum number of points for which pippenger_wnaf is faster than strauss wnaf */
 #define ECMULT_PIPPENGER_THRESHOLD 88
@@ -228,25 +240,25 @@ struct secp256k1_strauss_state {
     struct secp256k1_strauss_point_state* ps;
 };
 
-static void secp256k1_ecmult_strauss_wnaf(const struct secp256k1_strauss_state *state, secp256k1_gej *r, size_t num, const secp256k1_gej *a, const secp256k1_scalar *na, const secp256k1_scalar *ng) {
-    secp256k1_ge tmpa;
-    secp256k1_fe Z;
-    /* Split G factors. */
-    secp256k1_scalar ng_1, ng_128;
-    int wnaf_ng_1[129];
-    int bits_ng_1 = 0;
-    int wnaf_ng_128[129];
-    int bits_ng_128 = 0;
-    int i;
-    int bits = 0;
+/* Whether secp256k1_ecmult_strauss_prepare builds a table for the point a with scalar na. */
+static SECP256K1_INLINE int secp256k1_ecmult_strauss_has_table(const secp256k1_gej *a, const secp256k1_scalar *na) {
+    return !secp256k1_scalar_is_zero(na) && !secp256k1_gej_is_infinity(a);
+}
+
+/* Build the wNAFs of the scalars na[np] and the tables of odd multiples of the points
+ * a[np] for which secp256k1_ecmult_strauss_has_table is true, in state->ps and
+ * state->pre_a, and return their number. All table entries share the Z denominator Z.
+ * bits is raised to the length of the longest wNAF. */
+static size_t secp256k1_ecmult_strauss_prepare(const struct secp256k1_strauss_state *state, secp256k1_fe *Z, int *bits, const secp256k1_gej *a, const secp256k1_scalar *na, size_t num) {
     size_t np;
     size_t no = 0;
+    int i;
 
-    secp256k1_fe_set_int(&Z, 1);
+    secp256k1_fe_set_int(Z, 1);
     for (np = 0; np < num; ++np) {
         secp256k1_gej tmp;
         secp256k1_scalar na_1, na_lam;
-        if (secp256k1_scalar_is_zero(&na[np]) || secp256k1_gej_is_infinity(&a[np])) {
+        if (!secp256k1_ecmult_strauss_has_table(&a[np], &na[np])) {
             continue;
         }
         /* split na into na_1 and na_lam (where na = na_1 + na_lam*lambda, and na_1 and na_lam are ~128 bit) */
@@ -257,11 +269,11 @@ static void secp256k1_ecmult_strauss_wnaf(const struct secp256k1_strauss_state *
         state->ps[no].bits_na_lam = secp256k1_ecmult_wnaf(state->ps[no].wnaf_na_lam, 129, &na_lam, WINDOW_A);
         VERIFY_CHECK(state->ps[no].bits_na_1 <= 129);
         VERIFY_CHECK(state->ps[no].bits_na_lam <= 129);
-        if (state->ps[no].bits_na_1 > bits) {
-            bits = state->ps[no].bits_na_1;
+        if (state->ps[no].bits_na_1 > *bits) {
+            *bits = state->ps[no].bits_na_1;
         }
-        if (state->ps[no].bits_na_lam > bits) {
-            bits = state->ps[no].bits_na_lam;
+        if (state->ps[no].bits_na_lam > *bits) {
+            *bits = state->ps[no].bits_na_lam;
         }
 
         /* Calculate odd multiples of a.
@@ -277,11 +289,11 @@ static void secp256k1_ecmult_strauss_wnaf(const struct secp256k1_strauss_state *
         tmp = a[np];
         if (no) {
 #ifdef VERIFY
-            secp256k1_fe_normalize_var(&Z);
+            secp256k1_fe_normalize_var(Z);
 #endif
-            secp256k1_gej_rescale(&tmp, &Z);
+            secp256k1_gej_rescale(&tmp, Z);
         }
-        secp256k1_ecmult_odd_multiples_table(ECMULT_TABLE_SIZE(WINDOW_A), state->pre_a + no * ECMULT_TABLE_SIZE(WINDOW_A), state->aux + no * ECMULT_TABLE_SIZE(WINDOW_A), &Z, &tmp);
+        secp256k1_ecmult_odd_multiples_table(ECMULT_TABLE_SIZE(WINDOW_A), state->pre_a + no * ECMULT_TABLE_SIZE(WINDOW_A), state->aux + no * ECMULT_TABLE_SIZE(WINDOW_A), Z, &tmp);
         if (no) secp256k1_fe_mul(state->aux + no * ECMULT_TABLE_SIZE(WINDOW_A), state->aux + no * ECMULT_TABLE_SIZE(WINDOW_A), &(a[np].z));
 
         ++no;
@@ -295,6 +307,24 @@ static void secp256k1_ecmult_strauss_wnaf(const struct secp256k1_strauss_state *
             secp256k1_fe_mul(&state->aux[np * ECMULT_TABLE_SIZE(WINDOW_A) + i], &state->pre_a[np * ECMULT_TABLE_SIZE(WINDOW_A) + i].x, &secp256k1_const_beta);
         }
     }
+    return no;
+}
+
+static void secp256k1_ecmult_strauss_wnaf(const struct secp256k1_strauss_state *state, secp256k1_gej *r, size_t num, const secp256k1_gej *a, const secp256k1_scalar *na, const secp256k1_scalar *ng) {
+    secp256k1_ge tmpa;
+    secp256k1_fe Z;
+    /* Split G factors. */
+    secp256k1_scalar ng_1, ng_128;
+    int wnaf_ng_1[129];
+    int bits_ng_1 = 0;
+    int wnaf_ng_128[129];
+    int bits_ng_128 = 0;
+    int i;
+    int bits = 0;
+    size_t np;
+    size_t no;
+
+    no = secp256k1_ecmult_strauss_prepare(state, &Z, &bits, a, na, num);
 
     if (ng) {
         /* split ng into ng_1 and ng_128 (where gn = gn_1 + gn_128*2^128, and gn_1 and gn_128 are ~128 bit) */
@@ -353,6 +383,233 @@ static void secp256k1_ecmult(secp256k1_gej *r, const secp256k1_gej *a, const sec
     secp256k1_ecmult_strauss_wnaf(&state, r, 1, a, na, ng);
 }
 
+/* How many bits ahead secp256k1_ecmult_many prefetches the G table entries. */
+#define ECMULT_MANY_PREFETCH_DISTANCE 2
+
+static void secp256k1_ecmult_many(secp256k1_gej *r, const secp256k1_gej *a, const secp256k1_scalar *na, const secp256k1_scalar *ng, size_t num) {
+    secp256k1_fe aux[4 * ECMULT_TABLE_SIZE(WINDOW_A)];
+    secp256k1_ge pre_a[4 * ECMULT_TABLE_SIZE(WINDOW_A)];
+    struct secp256k1_strauss_point_state ps[4];
+    struct secp256k1_strauss_state state;
+    int wnaf_ng_1[4][129], wnaf_ng_128[4][129];
+    int bits_ng_1[4], bits_ng_128[4];
+    /* Index of the table of a[k] in state, or -1 if it has none. */
+    int table[4];
+    /* The additions of a bit, at most four per result, of which the G table entries
+     * (is_g) have Z ratio 1/Z to the others. */
+    secp256k1_ge adds[4][4];
+    int is_g[4][4];
+    int n_adds[4];
+    /* Points at infinity that fill up the inputs of the x4 functions. */
+    secp256k1_gej pad[4];
+    secp256k1_gej *rp[4];
+    secp256k1_fe Z, Z2, Z3;
+    int bits = 0;
+    int i, j, n;
+    size_t k, no = 0;
+
+    VERIFY_CHECK(num > 0 && num <= 4);
+
+    state.aux = aux;
+    state.pre_a = pre_a;
+    state.ps = ps;
+    secp256k1_ecmult_strauss_prepare(&state, &Z, &bits, a, na, num);
+    secp256k1_fe_sqr(&Z2, &Z);
+    secp256k1_fe_mul(&Z3, &Z2, &Z);
+
+    for (k = 0; k < 4; k++) {
+        if (k < num) {
+            secp256k1_scalar ng_1, ng_128;
+            table[k] = secp256k1_ecmult_strauss_has_table(&a[k], &na[k]) ? (int)no++ : -1;
+            secp256k1_scalar_split_128(&ng_1, &ng_128, &ng[k]);
+            bits_ng_1[k]   = secp256k1_ecmult_wnaf(wnaf_ng_1[k],   129, &ng_1,   WINDOW_G);
+            bits_ng_128[k] = secp256k1_ecmult_wnaf(wnaf_ng_128[k], 129, &ng_128, WINDOW_G);
+            if (bits_ng_1[k] > bits) {
+                bits = bits_ng_1[k];
+            }
+            if (bits_ng_128[k] > bits) {
+                bits = bits_ng_128[k];
+            }
+            rp[k] = &r[k];
+        } else {
+            rp[k] = &pad[k];
+        }
+        secp256k1_gej_set_infinity(rp[k]);
+    }
+
+    /* The multiplications run in lockstep: all results are doubled at once, and the
+     * additions of a bit are grouped into rounds of one addition per result. Doublings
+     * and rounds with at least three results use the x4 functions, in which the padding
+     * results stay infinity and are cheap. */
+    for (i = bits - 1; i >= 0; i--) {
+        if (num >= 3) {
+            for (k = num; k < 4; k++) {
+                secp256k1_gej_set_infinity(&pad[k]);
+            }
+            secp256k1_gej_double_var_x4(rp, (const secp256k1_gej *const *)rp);
+        } else {
+            for (k = 0; k < num; k++) {
+                secp256k1_gej_double_var(&r[k], &r[k], NULL);
+            }
+        }
+
+        /* The G tables are too large for the cache, so fetch the entries for the next
+         * bits while the current one is computed. */
+        if (i >= ECMULT_MANY_PREFETCH_DISTANCE) {
+            int ip = i - ECMULT_MANY_PREFETCH_DISTANCE;
+            for (k = 0; k < num; k++) {
+                if (ip < bits_ng_1[k] && (n = wnaf_ng_1[k][ip])) {
+                    SECP256K1_PREFETCH(&secp256k1_pre_g[((n > 0 ? n : -n) - 1) / 2]);
+                }
+                if (ip < bits_ng_128[k] && (n = wnaf_ng_128[k][ip])) {
+                    SECP256K1_PREFETCH(&secp256k1_pre_g_128[((n > 0 ? n : -n) - 1) / 2]);
+                }
+            }
+        }
+
+        for (k = 0; k < num; k++) {
+            n_adds[k] = 0;
+            if (table[k] >= 0) {
+                const struct secp256k1_strauss_point_state *p = &ps[table[k]];
+                if (i < p->bits_na_1 && (n = p->wnaf_na_1[i])) {
+                    secp256k1_ecmult_table_get_ge(&adds[k][n_adds[k]], pre_a + table[k] * ECMULT_TABLE_SIZE(WINDOW_A), n, WINDOW_A);
+                    is_g[k][n_adds[k]++] = 0;
+                }
+                if (i < p->bits_na_lam && (n = p->wnaf_na_lam[i])) {
+                    secp256k1_ecmult_table_get_ge_lambda(&adds[k][n_adds[k]], pre_a + table[k] * ECMULT_TABLE_SIZE(WINDOW_A), aux + table[k] * ECMULT_TABLE_SIZE(WINDOW_A), n, WINDOW_A);
+                    is_g[k][n_adds[k]++] = 0;
+                }
+            }
+            if (i < bits_ng_1[k] && (n = wnaf_ng_1[k][i])) {
+                secp256k1_ecmult_table_get_ge_storage(&adds[k][n_adds[k]], secp256k1_pre_g, n, WINDOW_G);
+                is_g[k][n_adds[k]++] = 1;
+            }
+            if (i < bits_ng_128[k] && (n = wnaf_ng_128[k][i])) {
+                secp256k1_ecmult_table_get_ge_storage(&adds[k][n_adds[k]], secp256k1_pre_g_128, n, WINDOW_G);
+                is_g[k][n_adds[k]++] = 1;
+            }
+        }
+
+        for (j = 0; j < 4; j++) {
+            size_t count = 0;
+            for (k = 0; k < num; k++) {
+                count += n_adds[k] > j;
+            }
+            if (count == 0) {
+                break;
+            }
+            if (count >= 3) {
+                secp256k1_gej *ra[4];
+                const secp256k1_ge *b[4];
+                for (k = 0; k < 4; k++) {
+                    if (k < num && n_adds[k] > j) {
+                        if (is_g[k][j]) {
+                            /* Bring the entry to the Z denominator of the others. */
+                            secp256k1_fe_mul(&adds[k][j].x, &adds[k][j].x, &Z2);
+                            secp256k1_fe_mul(&adds[k][j].y, &adds[k][j].y, &Z3);
+                        }
+                        ra[k] = &r[k];
+                        b[k] = &adds[k][j];
+                    } else {
+                        secp256k1_gej_set_infinity(&pad[k]);
+                        ra[k] = &pad[k];
+                        b[k] = &secp256k1_ge_const_g;
+                    }
+                }
+                secp256k1_gej_add_ge_var_x4(ra, (const secp256k1_gej *const *)ra, b);
+            } else {
+                for (k = 0; k < num; k++) {
+                    if (n_adds[k] <= j) {
+                        continue;
+                    }
+                    if (is_g[k][j]) {
+                        secp256k1_gej_add_zinv_var(&r[k], &r[k], &adds[k][j], &Z);
+                    } else {
+                        secp256k1_gej_add_ge_var(&r[k], &r[k], &adds[k][j], NULL);
+                    }
+                }
+            }
+        }
+    }
+
+    for (k = 0; k < num; k++) {
+        if (!r[k].infinity) {
+            secp256k1_fe_mul(&r[k].z, &r[k].z, &Z);
+        }
+    }
+}
+
+static void secp256k1_ecmult_pubkey_precomp_table(secp256k1_ge_storage *pre, secp256k1_ge_storage *pre_lam, const secp256k1_ge *a) {
+    secp256k1_gej prej[ECMULT_PUBKEY_PRECOMP_TABLE_SIZE];
+    secp256k1_ge tmp[ECMULT_PUBKEY_PRECOMP_TABLE_SIZE];
+    secp256k1_gej d;
+    int i;
+
+    VERIFY_CHECK(!secp256k1_ge_is_infinity(a));
+
+    secp256k1_gej_set_ge(&prej[0], a);
+    secp256k1_gej_double_var(&d, &prej[0], NULL);
+    for (i = 1; i < ECMULT_PUBKEY_PRECOMP_TABLE_SIZE; i++) {
+        secp256k1_gej_add_var(&prej[i], &prej[i - 1], &d, NULL);
+    }
+    secp256k1_ge_set_all_gej_var(tmp, prej, ECMULT_PUBKEY_PRECOMP_TABLE_SIZE);
+    for (i = 0; i < ECMULT_PUBKEY_PRECOMP_TABLE_SIZE; i++) {
+        secp256k1_ge_to_storage(&pre[i], &tmp[i]);
+        secp256k1_ge_mul_lambda(&tmp[i], &tmp[i]);
+        secp256k1_ge_to_storage(&pre_lam[i], &tmp[i]);
+    }
+}
+
+static void secp256k1_ecmult_pubkey_precomp(secp256k1_gej *r, const secp256k1_ge_storage *pre, const secp256k1_ge_storage *pre_lam, const secp256k1_scalar *na, const secp256k1_scalar *ng) {
+    secp256k1_ge tmpa;
+    secp256k1_scalar na_1, na_lam, ng_1, ng_128;
+    int wnaf_na_1[129], wnaf_na_lam[129], wnaf_ng_1[129], wnaf_ng_128[129];
+    int bits_na_1, bits_na_lam, bits_ng_1, bits_ng_128;
+    int bits;
+    int i;
+
+    secp256k1_scalar_split_lambda(&na_1, &na_lam, na);
+    bits_na_1 = secp256k1_ecmult_wnaf(wnaf_na_1, 129, &na_1, ECMULT_PUBKEY_PRECOMP_WINDOW);
+    bits_na_lam = secp256k1_ecmult_wnaf(wnaf_na_lam, 129, &na_lam, ECMULT_PUBKEY_PRECOMP_WINDOW);
+    secp256k1_scalar_split_128(&ng_1, &ng_128, ng);
+    bits_ng_1 = secp256k1_ecmult_wnaf(wnaf_ng_1, 129, &ng_1, WINDOW_G);
+    bits_ng_128 = secp256k1_ecmult_wnaf(wnaf_ng_128, 129, &ng_128, WINDOW_G);
+
+    bits = bits_na_1;
+    if (bits_na_lam > bits) {
+        bits = bits_na_lam;
+    }
+    if (bits_ng_1 > bits) {
+        bits = bits_ng_1;
+    }
+    if (bits_ng_128 > bits) {
+        bits = bits_ng_128;
+    }
+
+    secp256k1_gej_set_infinity(r);
+
+    for (i = bits - 1; i >= 0; i--) {
+        int n;
+        secp256k1_gej_double_var(r, r, NULL);
+        if (i < bits_na_1 && (n = wnaf_na_1[i])) {
+            secp256k1_ecmult_table_get_ge_storage(&tmpa, pre, n, ECMULT_PUBKEY_PRECOMP_WINDOW);
+            secp256k1_gej_add_ge_var(r, r, &tmpa, NULL);
+        }
+        if (i < bits_na_lam && (n = wnaf_na_lam[i])) {
+            secp256k1_ecmult_table_get_ge_storage(&tmpa, pre_lam, n, ECMULT_PUBKEY_PRECOMP_WINDOW);
+            secp256k1_gej_add_ge_var(r, r, &tmpa, NULL);
+        }
+        if (i < bits_ng_1 && (n = wnaf_ng_1[i])) {
+            secp256k1_ecmult_table_get_ge_storage(&tmpa, secp256k1_pre_g, n, WINDOW_G);
+            secp256k1_gej_add_ge_var(r, r, &tmpa, NULL);
+        }
+        if (i < bits_ng_128 && (n = wnaf_ng_128[i])) {
+            secp256k1_ecmult_table_get_ge_storage(&tmpa, secp256k1_pre_g_128, n, WINDOW_G);
+            secp256k1_gej_add_ge_var(r, r, &tmpa, NULL);
+        }
+    }
+}
+
 static size_t secp256k1_strauss_scratch_size(size_t n_points) {
     static const size_t point_size = (sizeof(secp256k1_ge) + sizeof(secp256k1_fe)) * ECMULT_TABLE_SIZE(WINDOW_A) + sizeof(struct secp256k1_strauss_point_state) + sizeof(secp256k1_gej) + sizeof(secp256k1_scalar);
     return n_points*point_size;
@@ -485,6 +742,62 @@ struct secp256k1_pippenger_state {
     struct secp256k1_pippenger_point_state* ps;
 };
 
+/* A queue of up to four pending additions of affine points to distinct Jacobian
+ * points, which are computed together with secp256k1_gej_add_ge_var_x4 once the
+ * queue is full. */
+struct secp256k1_ecmult_add_queue {
+    secp256k1_gej *r[4];
+    secp256k1_ge b[4];
+    int n;
+};
+
+static void secp256k1_ecmult_add_queue_init(struct secp256k1_ecmult_add_queue *queue) {
+    queue->n = 0;
+}
+
+/* Compute all pending additions. */
+static void secp256k1_ecmult_add_queue_flush(struct secp256k1_ecmult_add_queue *queue) {
+    int k;
+
+    if (queue->n == 4) {
+        const secp256k1_ge *b[4];
+        for (k = 0; k < 4; k++) {
+            b[k] = &queue->b[k];
+        }
+        secp256k1_gej_add_ge_var_x4(queue->r, (const secp256k1_gej *const *)queue->r, b);
+    } else {
+        for (k = 0; k < queue->n; k++) {
+            secp256k1_gej_add_ge_var(queue->r[k], queue->r[k], &queue->b[k], NULL);
+        }
+    }
+    queue->n = 0;
+}
+
+/* Queue the addition r += b. If an addition to r is already pending, the queue is
+ * flushed first, so that r is only read after all earlier additions to it. r must not
+ * be read or written elsewhere until the queue has been flushed. */
+static void secp256k1_ecmult_add_queue_push(struct secp256k1_ecmult_add_queue *queue, secp256k1_gej *r, const secp256k1_ge *b) {
+    int k;
+
+    for (k = 0; k < queue->n; k++) {
+        if (queue->r[k] == r) {
+            secp256k1_ecmult_add_queue_flush(queue);
+            break;
+        }
+    }
+    if (secp256k1_gej_is_infinity(r)) {
+        /* Nothing to compute, e.g., for the first addition to an empty bucket. */
+        secp256k1_gej_set_ge(r, b);
+        return;
+    }
+    queue->r[queue->n] = r;
+    queue->b[queue->n] = *b;
+    queue->n++;
+    if (queue->n == 4) {
+        secp256k1_ecmult_add_queue_flush(queue);
+    }
+}
+
 /*
  * pippenger_wnaf computes the result of a multi-point multiplication as
  * follows: The scalars are brought into wnaf with n_wnaf elements each. Then
@@ -515,11 +828,15 @@ static int secp256k1_ecmult_pippenger_wnaf(secp256k1_gej *buckets, int bucket_wi
 
     for (i = n_wnaf - 1; i >= 0; i--) {
         secp256k1_gej running_sum;
+        struct secp256k1_ecmult_add_queue queue;
 
         for(j = 0; j < ECMULT_TABLE_SIZE(bucket_window+2); j++) {
             secp256k1_gej_set_infinity(&buckets[j]);
         }
 
+        /* The additions to the buckets are independent unless they go to the same
+         * bucket, so they are queued and computed four at a time. */
+        secp256k1_ecmult_add_queue_init(&queue);
         for (np = 0; np < no; ++np) {
             int n = state->wnaf_na[np*n_wnaf + i];
             struct secp256k1_pippenger_point_state point_state = state->ps[np];
@@ -531,18 +848,19 @@ static int secp256k1_ecmult_pippenger_wnaf(secp256k1_gej *buckets, int bucket_wi
                 int skew = point_state.skew_na;
                 if (skew) {
                     secp256k1_ge_neg(&tmp, &pt[point_state.input_pos]);
-                    secp256k1_gej_add_ge_var(&buckets[0], &buckets[0], &tmp, NULL);
+                    secp256k1_ecmult_add_queue_push(&queue, &buckets[0], &tmp);
                 }
             }
             if (n > 0) {
                 idx = (n - 1)/2;
-                secp256k1_gej_add_ge_var(&buckets[idx], &buckets[idx], &pt[point_state.input_pos], NULL);
+                secp256k1_ecmult_add_queue_push(&queue, &buckets[idx], &pt[point_state.input_pos]);
             } else if (n < 0) {
                 idx = -(n + 1)/2;
                 secp256k1_ge_neg(&tmp, &pt[point_state.input_pos]);
-                secp256k1_gej_add_ge_var(&buckets[idx], &buckets[idx], &tmp, NULL);
+                secp256k1_ecmult_add_queue_push(&queue, &buckets[idx], &tmp);
             }
         }
+        secp256k1_ecmult_add_queue_flush(&queue);
 
         for(j = 0; j < bucket_window; j++) {
             secp256k1_gej_double_var(r, r, NULL);
@@ -569,6 +887,262 @@ static int secp256k1_ecmult_pippenger_wnaf(secp256k1_gej *buckets, int bucket_wi
     return 1;
 }
 
+/* A bucket of pippenger_wnaf_affine. Its value is the sum of the affine part
+ * ge and the Jacobian part gej. */
+struct secp256k1_pippenger_affine_bucket {
+    secp256k1_ge ge;
+    secp256k1_gej gej;
+    /* Whether an addition to ge is pending in the current round. */
+    int busy;
+};
+
+/* A pending addition of the point pt to the affine part of bucket idx. */
+struct secp256k1_pippenger_affine_add {
+    secp256k1_ge pt;
+    /* Denominator of the slope of the line through both points. */
+    secp256k1_fe den;
+    /* Product of the denominators of this and all previous additions. */
+    secp256k1_fe prod;
+    int idx;
+    int dbl;
+};
+
+/* A point that has to be added to bucket idx. */
+struct secp256k1_pippenger_affine_item {
+    size_t input_pos;
+    int idx;
+    int neg;
+};
+
+/* Returns the maximum number of additions in a round of
+ * secp256k1_ecmult_pippenger_affine_accumulate, which has at most one
+ * addition per bucket. */
+static size_t secp256k1_pippenger_affine_max_adds(int bucket_window) {
+    size_t n_buckets = ECMULT_TABLE_SIZE(bucket_window+2);
+    return n_buckets < PIPPENGER_AFFINE_MAX_BATCH ? n_buckets : PIPPENGER_AFFINE_MAX_BATCH;
+}
+
+static void secp256k1_ecmult_pippenger_affine_load(secp256k1_ge *r, const secp256k1_ge *pt, int neg) {
+    *r = *pt;
+    secp256k1_fe_normalize_weak(&r->x);
+    secp256k1_fe_normalize_weak(&r->y);
+    if (neg) {
+        secp256k1_fe_negate(&r->y, &r->y, 1);
+        secp256k1_fe_normalize_weak(&r->y);
+    }
+}
+
+/* Adds the points of the n_items items to the affine parts of their buckets.
+ * The additions are done in rounds of at most PIPPENGER_AFFINE_MAX_BATCH
+ * additions, at most one per bucket, which share a single field inversion
+ * (Montgomery's trick). Items whose bucket already has a pending addition are
+ * deferred to the next round. If a round contains fewer than
+ * PIPPENGER_AFFINE_MIN_BATCH additions, its additions and the deferred items
+ * are added to the Jacobian parts of the buckets instead. The items array is
+ * overwritten. */
+static void secp256k1_ecmult_pippenger_affine_accumulate(struct secp256k1_pippenger_affine_bucket *buckets, struct secp256k1_pippenger_affine_add *adds, struct secp256k1_pippenger_affine_item *items, size_t n_items, const secp256k1_ge *pt) {
+    /* items[0..n_deferred) have been deferred, items[pos..n_items) have not
+     * been processed yet. Deferred items never overwrite unprocessed ones
+     * because n_deferred <= pos. */
+    size_t n_deferred = 0;
+    size_t pos = 0;
+
+    while (n_deferred > 0 || pos < n_items) {
+        size_t n_prev_deferred = n_deferred;
+        size_t n_adds = 0;
+        size_t k = 0;
+        secp256k1_fe inv;
+
+        n_deferred = 0;
+        while (k < n_prev_deferred || (pos < n_items && n_adds < PIPPENGER_AFFINE_MAX_BATCH && n_deferred < PIPPENGER_AFFINE_MAX_BATCH)) {
+            struct secp256k1_pippenger_affine_item item = k < n_prev_deferred ? items[k++] : items[pos++];
+            struct secp256k1_pippenger_affine_bucket *bucket = &buckets[item.idx];
+            struct secp256k1_pippenger_affine_add *add = &adds[n_adds];
+
+            if (bucket->busy) {
+                items[n_deferred++] = item;
+                continue;
+            }
+            secp256k1_ecmult_pippenger_affine_load(&add->pt, &pt[item.input_pos], item.neg);
+            if (secp256k1_ge_is_infinity(&bucket->ge)) {
+                bucket->ge = add->pt;
+                continue;
+            }
+            /* den = x2 - x1 */
+            secp256k1_fe_negate(&add->den, &bucket->ge.x, 1);
+            secp256k1_fe_add(&add->den, &add->pt.x);
+            add->dbl = secp256k1_fe_normalizes_to_zero_var(&add->den);
+            if (add->dbl) {
+                secp256k1_fe dy;
+                secp256k1_fe_negate(&dy, &bucket->ge.y, 1);
+                secp256k1_fe_add(&dy, &add->pt.y);
+                if (!secp256k1_fe_normalizes_to_zero_var(&dy)) {
+                    /* The points are negations of each other. */
+                    secp256k1_ge_set_infinity(&bucket->ge);
+                    continue;
+                }
+                /* The points are equal, so the tangent is used: den = 2*y1 */
+                add->den = bucket->ge.y;
+                secp256k1_fe_mul_int(&add->den, 2);
+            }
+            add->idx = item.idx;
+            bucket->busy = 1;
+            n_adds++;
+        }
+
+        if (n_adds < PIPPENGER_AFFINE_MIN_BATCH) {
+            /* Not worth an inversion. */
+            struct secp256k1_ecmult_add_queue queue;
+            secp256k1_ecmult_add_queue_init(&queue);
+            for (k = 0; k < n_adds; k++) {
+                struct secp256k1_pippenger_affine_bucket *bucket = &buckets[adds[k].idx];
+                secp256k1_ecmult_add_queue_push(&queue, &bucket->gej, &adds[k].pt);
+                bucket->busy = 0;
+            }
+            for (k = 0; k < n_deferred; k++) {
+                struct secp256k1_pippenger_affine_bucket *bucket = &buckets[items[k].idx];
+                secp256k1_ge tmp;
+                secp256k1_ecmult_pippenger_affine_load(&tmp, &pt[items[k].input_pos], items[k].neg);
+                secp256k1_ecmult_add_queue_push(&queue, &bucket->gej, &tmp);
+            }
+            secp256k1_ecmult_add_queue_flush(&queue);
+            n_deferred = 0;
+            continue;
+        }
+
+        adds[0].prod = adds[0].den;
+        for (k = 1; k < n_adds; k++) {
+            secp256k1_fe_mul(&adds[k].prod, &adds[k - 1].prod, &adds[k].den);
+        }
+        secp256k1_fe_inv_var(&inv, &adds[n_adds - 1].prod);
+        for (k = n_adds; k-- > 0; ) {
+            struct secp256k1_pippenger_affine_add *add = &adds[k];
+            struct secp256k1_pippenger_affine_bucket *bucket = &buckets[add->idx];
+            const secp256k1_fe *x2 = &add->pt.x;
+            secp256k1_fe inv_den, lambda, x3, y3, t;
+
+            /* inv_den = 1/den, inv = 1/prod of the previous addition */
+            if (k > 0) {
+                secp256k1_fe_mul(&inv_den, &inv, &adds[k - 1].prod);
+                secp256k1_fe_mul(&inv, &inv, &add->den);
+            } else {
+                inv_den = inv;
+            }
+            if (add->dbl) {
+                /* lambda = 3*x1^2/(2*y1) */
+                secp256k1_fe_sqr(&lambda, &bucket->ge.x);
+                secp256k1_fe_mul_int(&lambda, 3);
+            } else {
+                /* lambda = (y2 - y1)/(x2 - x1) */
+                secp256k1_fe_negate(&lambda, &bucket->ge.y, 1);
+                secp256k1_fe_add(&lambda, &add->pt.y);
+            }
+            secp256k1_fe_mul(&lambda, &lambda, &inv_den);
+            /* x3 = lambda^2 - x1 - x2 */
+            secp256k1_fe_sqr(&x3, &lambda);
+            secp256k1_fe_negate(&t, &bucket->ge.x, 1);
+            secp256k1_fe_add(&x3, &t);
+            secp256k1_fe_negate(&t, x2, 1);
+            secp256k1_fe_add(&x3, &t);
+            secp256k1_fe_normalize_weak(&x3);
+            /* y3 = lambda*(x1 - x3) - y1 */
+            secp256k1_fe_negate(&t, &x3, 1);
+            secp256k1_fe_add(&t, &bucket->ge.x);
+            secp256k1_fe_mul(&y3, &t, &lambda);
+            secp256k1_fe_negate(&t, &bucket->ge.y, 1);
+            secp256k1_fe_add(&y3, &t);
+            secp256k1_fe_normalize_weak(&y3);
+            secp256k1_ge_set_xy(&bucket->ge, &x3, &y3);
+            bucket->busy = 0;
+        }
+    }
+}
+
+/*
+ * pippenger_wnaf_affine computes the same result as pippenger_wnaf, but
+ * accumulates the buckets mostly in affine coordinates. An affine addition
+ * with a shared inversion is considerably cheaper than a Jacobian one, which
+ * pays off if there are many more points than buckets. The items array must
+ * have space for num elements and the adds array for
+ * secp256k1_pippenger_affine_max_adds(bucket_window) elements.
+ */
+static int secp256k1_ecmult_pippenger_wnaf_affine(struct secp256k1_pippenger_affine_bucket *buckets, struct secp256k1_pippenger_affine_add *adds, struct secp256k1_pippenger_affine_item *items, int bucket_window, struct secp256k1_pippenger_state *state, secp256k1_gej *r, const secp256k1_scalar *sc, const secp256k1_ge *pt, size_t num) {
+    size_t n_wnaf = WNAF_SIZE(bucket_window+1);
+    size_t np;
+    size_t no = 0;
+    size_t n_items;
+    int i;
+    int j;
+
+    for (np = 0; np < num; ++np) {
+        if (secp256k1_scalar_is_zero(&sc[np]) || secp256k1_ge_is_infinity(&pt[np])) {
+            continue;
+        }
+        state->ps[no].input_pos = np;
+        state->ps[no].skew_na = secp256k1_wnaf_fixed(&state->wnaf_na[no*n_wnaf], &sc[np], bucket_window+1);
+        no++;
+    }
+    secp256k1_gej_set_infinity(r);
+
+    if (no == 0) {
+        return 1;
+    }
+
+    for (i = n_wnaf - 1; i >= 0; i--) {
+        secp256k1_gej running_sum;
+
+        for(j = 0; j < ECMULT_TABLE_SIZE(bucket_window+2); j++) {
+            secp256k1_ge_set_infinity(&buckets[j].ge);
+            secp256k1_gej_set_infinity(&buckets[j].gej);
+            buckets[j].busy = 0;
+        }
+
+        n_items = 0;
+        for (np = 0; np < no; ++np) {
+            int n = state->wnaf_na[np*n_wnaf + i];
+            if (n != 0) {
+                items[n_items].input_pos = state->ps[np].input_pos;
+                items[n_items].idx = n > 0 ? (n - 1)/2 : -(n + 1)/2;
+                items[n_items].neg = n < 0;
+                n_items++;
+            }
+        }
+        secp256k1_ecmult_pippenger_affine_accumulate(buckets, adds, items, n_items, pt);
+
+        if (i == 0) {
+            /* correct for wnaf skew */
+            n_items = 0;
+            for (np = 0; np < no; ++np) {
+                if (state->ps[np].skew_na) {
+                    items[n_items].input_pos = state->ps[np].input_pos;
+                    items[n_items].idx = 0;
+                    items[n_items].neg = 1;
+                    n_items++;
+                }
+            }
+            secp256k1_ecmult_pippenger_affine_accumulate(buckets, adds, items, n_items, pt);
+        }
+
+        for(j = 0; j < bucket_window; j++) {
+            secp256k1_gej_double_var(r, r, NULL);
+        }
+
+        secp256k1_gej_set_infinity(&running_sum);
+        /* See pippenger_wnaf for how the buckets are summed up. */
+        for(j = ECMULT_TABLE_SIZE(bucket_window+2) - 1; j > 0; j--) {
+            secp256k1_gej_add_ge_var(&running_sum, &running_sum, &buckets[j].ge, NULL);
+            secp256k1_gej_add_var(&running_sum, &running_sum, &buckets[j].gej, NULL);
+            secp256k1_gej_add_var(r, r, &running_sum, NULL);
+        }
+
+        secp256k1_gej_add_ge_var(&running_sum, &running_sum, &buckets[0].ge, NULL);
+        secp256k1_gej_add_var(&running_sum, &running_sum, &buckets[0].gej, NULL);
+        secp256k1_gej_double_var(r, r, NULL);
+        secp256k1_gej_add_var(r, r, &running_sum, NULL);
+    }
+    return 1;
+}
+
 /**
  * Returns optimal bucket_window (number of bits of a scalar represented by a
  * set of buckets) for a given number of points.
@@ -594,13 +1168,18 @@ static int secp256k1_pippenger_bucket_window(size_t n) {
         return 10;
     } else if (n <= 16050) {
         return 11;
+    } else if (n <= 750000) {
+        return 12;
     } else {
         return PIPPENGER_MAX_BUCKET_WINDOW;
     }
 }
 
 /**
- * Returns the maximum optimal number of points for a bucket_window.
+ * Returns the maximum optimal number of points for a bucket_window, or 0 if
+ * secp256k1_pippenger_bucket_window never returns bucket_window. Windows 8, 13
+ * and 14 are not used because a neighbouring window was faster at every point
+ * count that was benchmarked; secp256k1_pippenger_max_points skips them.
  */
 static size_t secp256k1_pippenger_bucket_window_inv(int bucket_window) {
     switch(bucket_window) {
@@ -611,10 +1190,10 @@ static size_t secp256k1_pippenger_bucket_window_inv(int bucket_window) {
         case 5: return 136;
         case 6: return 235;
         case 7: return 1260;
-        case 8: return 1260;
         case 9: return 4420;
         case 10: return 7880;
         case 11: return 16050;
+        case 12: return 750000;
         case PIPPENGER_MAX_BUCKET_WINDOW: return SIZE_MAX;
     }
     return 0;
@@ -636,17 +1215,51 @@ SECP256K1_INLINE static void secp256k1_ecmult_endo_split(secp256k1_scalar *s1, s
     }
 }
 
+/**
+ * Returns whether pippenger_wnaf_affine is used for a bucket_window.
+ */
+static int secp256k1_pippenger_affine(int bucket_window) {
+    return bucket_window >= PIPPENGER_AFFINE_MIN_WINDOW;
+}
+
+/**
+ * Returns the scratch size required per entry, i.e., per point after the
+ * endomorphism split, without considering alignment.
+ */
+static size_t secp256k1_pippenger_entry_size(int bucket_window, int affine) {
+    size_t entry_size = sizeof(secp256k1_ge) + sizeof(secp256k1_scalar) + sizeof(struct secp256k1_pippenger_point_state) + (WNAF_SIZE(bucket_window+1)+1)*sizeof(int);
+    if (affine) {
+        entry_size += sizeof(struct secp256k1_pippenger_affine_item);
+    }
+    return entry_size;
+}
+
+/**
+ * Returns the scratch size required for the buckets without considering
+ * alignment.
+ */
+static size_t secp256k1_pippenger_buckets_size(int bucket_window, int affine) {
+    if (affine) {
+        return (sizeof(struct secp256k1_pippenger_affine_bucket) << bucket_window) + secp256k1_pippenger_affine_max_adds(bucket_window) * sizeof(struct secp256k1_pippenger_affine_add);
+    }
+    return sizeof(secp256k1_gej) << bucket_window;
+}
+
 /**
  * Returns the scratch size required for a given number of points (excluding
  * base point G) without considering alignment.
  */
 static size_t secp256k1_pippenger_scratch_size(size_t n_points, int bucket_window) {
     size_t entries = 2*n_points + 2;
-    size_t entry_size = sizeof(secp256k1_ge) + sizeof(secp256k1_scalar) + sizeof(struct secp256k1_pippenger_point_state) + (WNAF_SIZE(bucket_window+1)+1)*sizeof(int);
-    return (sizeof(secp256k1_gej) << bucket_window) + sizeof(struct secp256k1_pippenger_state) + entries * entry_size;
+    int affine = secp256k1_pippenger_affine(bucket_window);
+    return secp256k1_pippenger_buckets_size(bucket_window, affine) + sizeof(struct secp256k1_pippenger_state) + entries * secp256k1_pippenger_entry_size(bucket_window, affine);
 }
 
-static int secp256k1_ecmult_pippenger_batch(const secp256k1_callback* error_callback, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n_points, size_t cb_offset) {
+/* Computes a batch of Pippenger's algorithm. If affine is set,
+ * pippenger_wnaf_affine is used, which requires a scratch space of
+ * secp256k1_pippenger_scratch_size for a bucket_window of at least
+ * PIPPENGER_AFFINE_MIN_WINDOW. */
+static int secp256k1_ecmult_pippenger_batch_strategy(const secp256k1_callback* error_callback, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n_points, size_t cb_offset, int affine) {
     const size_t scratch_checkpoint = secp256k1_scratch_checkpoint(error_callback, scratch);
     /* Use 2(n+1) with the endomorphism, when calculating batch
      * sizes. The reason for +1 is that we add the G scalar to the list of
@@ -654,7 +1267,10 @@ static int secp256k1_ecmult_pippenger_batch(const secp256k1_callback* error_call
     size_t entries = 2*n_points + 2;
     secp256k1_ge *points;
     secp256k1_scalar *scalars;
-    secp256k1_gej *buckets;
+    secp256k1_gej *buckets = NULL;
+    struct secp256k1_pippenger_affine_bucket *affine_buckets = NULL;
+    struct secp256k1_pippenger_affine_add *adds = NULL;
+    struct secp256k1_pippenger_affine_item *items = NULL;
     struct secp256k1_pippenger_state *state_space;
     size_t idx = 0;
     size_t point_idx = 0;
@@ -680,8 +1296,18 @@ static int secp256k1_ecmult_pippenger_batch(const secp256k1_callback* error_call
     }
     state_space->ps = (struct secp256k1_pippenger_point_state *) secp256k1_scratch_alloc(error_callback, scratch, entries * sizeof(*state_space->ps));
     state_space->wnaf_na = (int *) secp256k1_scratch_alloc(error_callback, scratch, entries*(WNAF_SIZE(bucket_window+1)) * sizeof(int));
-    buckets = (secp256k1_gej *) secp256k1_scratch_alloc(error_callback, scratch, (1<<bucket_window) * sizeof(*buckets));
-    if (state_space->ps == NULL || state_space->wnaf_na == NULL || buckets == NULL) {
+    if (affine) {
+        affine_buckets = (struct secp256k1_pippenger_affine_bucket *) secp256k1_scratch_alloc(error_callback, scratch, (1<<bucket_window) * sizeof(*affine_buckets));
+        adds = (struct secp256k1_pippenger_affine_add *) secp256k1_scratch_alloc(error_callback, scratch, secp256k1_pippenger_affine_max_adds(bucket_window) * sizeof(*adds));
+        items = (struct secp256k1_pippenger_affine_item *) secp256k1_scratch_alloc(error_callback, scratch, entries * sizeof(*items));
+        if (affine_buckets == NULL || adds == NULL || items == NULL) {
+            secp256k1_scratch_apply_checkpoint(error_callback, scratch, scratch_checkpoint);
+            return 0;
+        }
+    } else {
+        buckets = (secp256k1_gej *) secp256k1_scratch_alloc(error_callback, scratch, (1<<bucket_window) * sizeof(*buckets));
+    }
+    if (state_space->ps == NULL || state_space->wnaf_na == NULL || (buckets == NULL && affine_buckets == NULL)) {
         secp256k1_scratch_apply_checkpoint(error_callback, scratch, scratch_checkpoint);
         return 0;
     }
@@ -705,7 +1331,11 @@ static int secp256k1_ecmult_pippenger_batch(const secp256k1_callback* error_call
         point_idx++;
     }
 
-    secp256k1_ecmult_pippenger_wnaf(buckets, bucket_window, state_space, r, scalars, points, idx);
+    if (affine) {
+        secp256k1_ecmult_pippenger_wnaf_affine(affine_buckets, adds, items, bucket_window, state_space, r, scalars, points, idx);
+    } else {
+        secp256k1_ecmult_pippenger_wnaf(buckets, bucket_window, state_space, r, scalars, points, idx);
+    }
 
     /* Clear data */
     for(i = 0; (size_t)i < idx; i++) {
@@ -716,12 +1346,22 @@ static int secp256k1_ecmult_pippenger_batch(const secp256k1_callback* error_call
         }
     }
     for(i = 0; i < 1<<bucket_window; i++) {
-        secp256k1_gej_clear(&buckets[i]);
+        if (affine) {
+            secp256k1_ge_clear(&affine_buckets[i].ge);
+            secp256k1_gej_clear(&affine_buckets[i].gej);
+        } else {
+            secp256k1_gej_clear(&buckets[i]);
+        }
     }
     secp256k1_scratch_apply_checkpoint(error_callback, scratch, scratch_checkpoint);
     return 1;
 }
 
+static int secp256k1_ecmult_pippenger_batch(const secp256k1_callback* error_callback, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n_points, size_t cb_offset) {
+    int affine = secp256k1_pippenger_affine(secp256k1_pippenger_bucket_window(n_points));
+    return secp256k1_ecmult_pippenger_batch_strategy(error_callback, scratch, r, inp_g_sc, cb, cbdata, n_points, cb_offset, affine);
+}
+
 /* Wrapper for secp256k1_ecmult_multi_func interface */
 static int secp256k1_ecmult_pippenger_batch_single(const secp256k1_callback* error_callback, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n) {
     return secp256k1_ecmult_pippenger_batch(error_callback, scratch, r, inp_g_sc, cb, cbdata, n, 0);
@@ -742,10 +1382,14 @@ static size_t secp256k1_pippenger_max_points(const secp256k1_callback* error_cal
         size_t max_points = secp256k1_pippenger_bucket_window_inv(bucket_window);
         size_t space_for_points;
         size_t space_overhead;
-        size_t entry_size = sizeof(secp256k1_ge) + sizeof(secp256k1_scalar) + sizeof(struct secp256k1_pippenger_point_state) + (WNAF_SIZE(bucket_window+1)+1)*sizeof(int);
+        int affine = secp256k1_pippenger_affine(bucket_window);
+        size_t entry_size = 2*secp256k1_pippenger_entry_size(bucket_window, affine);
 
-        entry_size = 2*entry_size;
-        space_overhead = (sizeof(secp256k1_gej) << bucket_window) + entry_size + sizeof(struct secp256k1_pippenger_state);
+        if (max_points == 0) {
+            /* Unused bucket_window */
+            continue;
+        }
+        space_overhead = secp256k1_pippenger_buckets_size(bucket_window, affine) + entry_size + sizeof(struct secp256k1_pippenger_state);
         if (space_overhead > max_alloc) {
             break;
         }
@@ -766,6 +1410,35 @@ static size_t secp256k1_pippenger_max_points(const secp256k1_callback* error_cal
     return res;
 }
 
+/**
+ * Returns the smallest scratch space size for which
+ * secp256k1_pippenger_max_points returns at least n_points, i.e., for which
+ * secp256k1_ecmult_multi_var processes n_points points in a single batch of
+ * Pippenger's algorithm (if n_points is at least ECMULT_PIPPENGER_THRESHOLD).
+ */
+static size_t secp256k1_pippenger_scratch_size_for_points(size_t n_points) {
+    int bucket_window = secp256k1_pippenger_bucket_window(n_points);
+    size_t res = 0;
+    int w;
+
+    /* secp256k1_pippenger_max_points only moves on to a bucket_window if the
+     * scratch space suffices for the maximum number of points of all smaller
+     * windows. */
+    for (w = 1; w <= bucket_window; w++) {
+        size_t n = w < bucket_window ? secp256k1_pippenger_bucket_window_inv(w) : n_points;
+        size_t size;
+        if (w < bucket_window && n == 0) {
+            /* Unused bucket_window, skipped by secp256k1_pippenger_max_points */
+            continue;
+        }
+        size = secp256k1_pippenger_scratch_size(n, w);
+        if (size > res) {
+            res = size;
+        }
+    }
+    return res + PIPPENGER_SCRATCH_OBJECTS * (ALIGNMENT - 1);
+}
+
 /* Computes ecmult_multi by simply multiplying and adding each point. Does not
  * require a scratch space */
 static int secp256k1_ecmult_multi_simple_var(secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n_points) {
@@ -862,4 +1535,200 @@ static int secp256k1_ecmult_multi_var(const secp256k1_callback* error_callback,
     return 1;
 }
 
+struct secp256k1_ecmult_multi_parallel_state {
+    const secp256k1_callback* error_callback;
+    const secp256k1_scalar *inp_g_sc;
+    secp256k1_ecmult_multi_callback *cb;
+    void *cbdata;
+    size_t n;
+    size_t n_tasks;
+    /* per-task scratch spaces, results and return values */
+    secp256k1_scratch **scratch;
+    secp256k1_gej *r;
+    int *ret;
+};
+
+struct secp256k1_ecmult_multi_offset_data {
+    secp256k1_ecmult_multi_callback *cb;
+    void *cbdata;
+    size_t offset;
+};
+
+static int secp256k1_ecmult_multi_offset_callback(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *cbdata) {
+    struct secp256k1_ecmult_multi_offset_data *data = (struct secp256k1_ecmult_multi_offset_data *) cbdata;
+    return data->cb(sc, pt, data->offset + idx, data->cbdata);
+}
+
+static void secp256k1_ecmult_multi_parallel_task(void *task_data, size_t idx) {
+    struct secp256k1_ecmult_multi_parallel_state *state = (struct secp256k1_ecmult_multi_parallel_state *) task_data;
+    struct secp256k1_ecmult_multi_offset_data data;
+    size_t n_per_task = state->n / state->n_tasks;
+    size_t n_rem = state->n % state->n_tasks;
+    size_t n_points = n_per_task + (idx < n_rem);
+
+    data.cb = state->cb;
+    data.cbdata = state->cbdata;
+    data.offset = idx * n_per_task + (idx < n_rem ? idx : n_rem);
+    state->ret[idx] = secp256k1_ecmult_multi_var(state->error_callback, state->scratch[idx], &state->r[idx], idx == 0 ? state->inp_g_sc : NULL, secp256k1_ecmult_multi_offset_callback, &data, n_points);
+}
+
+static int secp256k1_ecmult_multi_var_parallel(const secp256k1_callback* error_callback, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n, size_t n_tasks, secp256k1_ecmult_multi_run_tasks run_tasks, void *run_tasks_data) {
+    struct secp256k1_ecmult_multi_parallel_state state;
+    size_t scratch_checkpoint;
+    size_t max_alloc;
+    size_t i;
+    int ret = 1;
+
+    if (n_tasks > n) {
+        n_tasks = n;
+    }
+    if (scratch == NULL || n_tasks <= 1 || n_tasks > SIZE_MAX / sizeof(secp256k1_gej)) {
+        return secp256k1_ecmult_multi_var(error_callback, scratch, r, inp_g_sc, cb, cbdata, n);
+    }
+
+    scratch_checkpoint = secp256k1_scratch_checkpoint(error_callback, scratch);
+    state.scratch = (secp256k1_scratch **)secp256k1_scratch_alloc(error_callback, scratch, n_tasks * sizeof(secp256k1_scratch *));
+    state.r = (secp256k1_gej *)secp256k1_scratch_alloc(error_callback, scratch, n_tasks * sizeof(secp256k1_gej));
+    state.ret = (int *)secp256k1_scratch_alloc(error_callback, scratch, n_tasks * sizeof(int));
+    /* Every child scratch space takes two objects */
+    max_alloc = secp256k1_scratch_max_allocation(error_callback, scratch, 2 * n_tasks) / n_tasks;
+    if (state.scratch == NULL || state.r == NULL || state.ret == NULL || max_alloc <= sizeof(secp256k1_scratch)) {
+        secp256k1_scratch_apply_checkpoint(error_callback, scratch, scratch_checkpoint);
+        return secp256k1_ecmult_multi_var(error_callback, scratch, r, inp_g_sc, cb, cbdata, n);
+    }
+    for (i = 0; i < n_tasks; i++) {
+        state.scratch[i] = secp256k1_scratch_alloc_child(error_callback, scratch, max_alloc - sizeof(secp256k1_scratch));
+        VERIFY_CHECK(state.scratch[i] != NULL);
+    }
+
+    state.error_callback = error_callback;
+    state.inp_g_sc = inp_g_sc;
+    state.cb = cb;
+    state.cbdata = cbdata;
+    state.n = n;
+    state.n_tasks = n_tasks;
+    if (!run_tasks(secp256k1_ecmult_multi_parallel_task, &state, n_tasks, run_tasks_data)) {
+        ret = 0;
+    }
+    secp256k1_gej_set_infinity(r);
+    for (i = 0; ret && i < n_tasks; i++) {
+        ret = state.ret[i];
+        secp256k1_gej_add_var(r, r, &state.r[i], NULL);
+    }
+    secp256k1_scratch_apply_checkpoint(error_callback, scratch, scratch_checkpoint);
+    return ret;
+}
+
+/* Fixed-base multi-scalar multiplication with precomputed tables. For every
+ * point P, the tables hold the odd multiples [1*Q, 3*Q, ..., (2^(w-1)-1)*Q],
+ * for w = ECMULT_PRECOMP_WINDOW, of Q = 2^(j*ECMULT_PRECOMP_CHUNK_BITS)*P for
+ * every j < ECMULT_PRECOMP_CHUNKS. The 129-bit wNAFs of the two halves of a
+ * scalar after the endomorphism split are cut into ECMULT_PRECOMP_CHUNKS
+ * chunks, each of which uses its own table, so that only
+ * ECMULT_PRECOMP_CHUNK_BITS doublings are needed in total. */
+#define ECMULT_PRECOMP_WINDOW 7
+#define ECMULT_PRECOMP_CHUNKS 4
+#define ECMULT_PRECOMP_CHUNK_BITS WNAF_SIZE_BITS(129, ECMULT_PRECOMP_CHUNKS)
+/* The number of table entries per point */
+#define ECMULT_PRECOMP_TABLE_SIZE (ECMULT_PRECOMP_CHUNKS * ECMULT_TABLE_SIZE(ECMULT_PRECOMP_WINDOW))
+
+/* Fill the tables of the n points p[0..n-1], where 0 < n <= 4, each with the
+ * ECMULT_PRECOMP_TABLE_SIZE entries for the point. The table of p[k] starts at
+ * tables[k * ECMULT_PRECOMP_TABLE_SIZE]. The doublings of the different points are
+ * computed together with secp256k1_gej_double_var_x4. */
+static void secp256k1_ecmult_precomp_tables(secp256k1_ge_storage *tables, const secp256k1_ge *p, int n) {
+    secp256k1_gej prej[ECMULT_PRECOMP_TABLE_SIZE];
+    secp256k1_ge pre[ECMULT_PRECOMP_TABLE_SIZE];
+    /* q[j][k] = 2^(j*ECMULT_PRECOMP_CHUNK_BITS)*p[k] and d[j][k] = 2*q[j][k] */
+    secp256k1_gej q[ECMULT_PRECOMP_CHUNKS][4], d[ECMULT_PRECOMP_CHUNKS][4];
+    secp256k1_gej *r[4];
+    const secp256k1_gej *a[4];
+    int i, j, k;
+
+    VERIFY_CHECK(n > 0 && n <= 4);
+
+    /* Unused lanes repeat the first point. */
+    for (k = 0; k < 4; k++) {
+        VERIFY_CHECK(k >= n || !secp256k1_ge_is_infinity(&p[k]));
+        secp256k1_gej_set_ge(&q[0][k], &p[k < n ? k : 0]);
+    }
+    for (j = 0; j < ECMULT_PRECOMP_CHUNKS; j++) {
+        for (k = 0; k < 4; k++) {
+            r[k] = &d[j][k];
+            a[k] = &q[j][k];
+        }
+        secp256k1_gej_double_var_x4(r, a);
+        if (j + 1 < ECMULT_PRECOMP_CHUNKS) {
+            for (k = 0; k < 4; k++) {
+                q[j + 1][k] = d[j][k];
+                r[k] = &q[j + 1][k];
+            }
+            for (i = 1; i < ECMULT_PRECOMP_CHUNK_BITS; i++) {
+                secp256k1_gej_double_var_x4(r, (const secp256k1_gej *const *)r);
+            }
+        }
+    }
+
+    for (k = 0; k < n; k++) {
+        secp256k1_ge_storage *table = &tables[k * ECMULT_PRECOMP_TABLE_SIZE];
+        for (j = 0; j < ECMULT_PRECOMP_CHUNKS; j++) {
+            secp256k1_gej *t = &prej[j * ECMULT_TABLE_SIZE(ECMULT_PRECOMP_WINDOW)];
+            t[0] = q[j][k];
+            for (i = 1; i < ECMULT_TABLE_SIZE(ECMULT_PRECOMP_WINDOW); i++) {
+                secp256k1_gej_add_var(&t[i], &t[i - 1], &d[j][k], NULL);
+            }
+        }
+        secp256k1_ge_set_all_gej_var(pre, prej, ECMULT_PRECOMP_TABLE_SIZE);
+        for (i = 0; i < ECMULT_PRECOMP_TABLE_SIZE; i++) {
+            secp256k1_ge_to_storage(&table[i], &pre[i]);
+        }
+    }
+}
+
+/* Add s*P to the ECMULT_PRECOMP_CHUNK_BITS accumulators acc, where table
+ * holds the entries for P. The accumulators are combined with
+ * secp256k1_ecmult_precomp_finish. */
+static void secp256k1_ecmult_precomp_accumulate(secp256k1_gej *acc, const secp256k1_ge_storage *table, const secp256k1_scalar *s) {
+    struct secp256k1_ecmult_add_queue queue;
+    secp256k1_scalar s_1, s_lam;
+    int wnaf_1[129];
+    int wnaf_lam[129];
+    int bits_1, bits_lam;
+    int i;
+
+    secp256k1_scalar_split_lambda(&s_1, &s_lam, s);
+    bits_1 = secp256k1_ecmult_wnaf(wnaf_1, 129, &s_1, ECMULT_PRECOMP_WINDOW);
+    bits_lam = secp256k1_ecmult_wnaf(wnaf_lam, 129, &s_lam, ECMULT_PRECOMP_WINDOW);
+    /* Consecutive digits go to different accumulators, so the additions are queued and
+     * mostly computed four at a time. */
+    secp256k1_ecmult_add_queue_init(&queue);
+    for (i = 0; i < bits_1 || i < bits_lam; i++) {
+        const secp256k1_ge_storage *pre = &table[(i / ECMULT_PRECOMP_CHUNK_BITS) * ECMULT_TABLE_SIZE(ECMULT_PRECOMP_WINDOW)];
+        secp256k1_gej *r = &acc[i % ECMULT_PRECOMP_CHUNK_BITS];
+        secp256k1_ge tmp;
+
+        if (i < bits_1 && wnaf_1[i]) {
+            secp256k1_ecmult_table_get_ge_storage(&tmp, pre, wnaf_1[i], ECMULT_PRECOMP_WINDOW);
+            secp256k1_ecmult_add_queue_push(&queue, r, &tmp);
+        }
+        if (i < bits_lam && wnaf_lam[i]) {
+            secp256k1_ecmult_table_get_ge_storage(&tmp, pre, wnaf_lam[i], ECMULT_PRECOMP_WINDOW);
+            secp256k1_ge_mul_lambda(&tmp, &tmp);
+            secp256k1_ecmult_add_queue_push(&queue, r, &tmp);
+        }
+    }
+    secp256k1_ecmult_add_queue_flush(&queue);
+}
+
+/* Set r to sum(2^i * acc[i]) for i < ECMULT_PRECOMP_CHUNK_BITS. */
+static void secp256k1_ecmult_precomp_finish(secp256k1_gej *r, const secp256k1_gej *acc) {
+    int i;
+
+    *r = acc[ECMULT_PRECOMP_CHUNK_BITS - 1];
+    for (i = ECMULT_PRECOMP_CHUNK_BITS - 2; i >= 0; i--) {
+        secp256k1_gej_double_var(r, r, NULL);
+        secp256k1_gej_add_var(r, r, &acc[i], NULL);
+    }
+}
+
 #endif /* SECP256K1_ECMULT_IMPL_H */
@@ -0,0 +1,527 @@
+/***********************************************************************
+ * Copyright (c) 2023 The libsecp256k1 developers                      *
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_FIELD_AVX2_IMPL_H
+#define SECP256K1_FIELD_AVX2_IMPL_H
+
+#include <immintrin.h>
+
+#include "field.h"
+#include "cpu_features.h"
+
+/* Four field elements in a vertical layout: lane k of n[i] holds limb i of element k.
+ *
+ * X = sum(i=0..9, n[i]*2^(i*26)) mod p, in every lane
+ * where p = 2^256 - 0x1000003D1
+ *
+ * This is the radix-2^26 representation of field_10x26.h with 64-bit lanes, so that
+ * _mm256_mul_epu32 computes four 26x26-bit limb products at once and the column sums
+ * of a multiplication fit into a lane without intermediate carries.
+ *
+ * The magnitude of an element has the same meaning as in field_10x26.h: the limbs are
+ * at most 2*m*(2^26-1) (2*m*(2^22-1) for the top one). The multiplication requires
+ * magnitudes of at most 8, and its output has magnitude 1.
+ *
+ * These functions are only compiled with a target attribute and must only be called if
+ * secp256k1_cpu_has_avx2 returns true. */
+typedef struct {
+    __m256i n[10];
+} secp256k1_fe4;
+
+#define SECP256K1_FE4_MUL(x, y) _mm256_mul_epu32(x, y)
+#define SECP256K1_FE4_ADD(x, y) _mm256_add_epi64(x, y)
+#define SECP256K1_FE4_CARRY(t, i) do { \
+    t[(i) + 1] = _mm256_add_epi64(t[(i) + 1], _mm256_srli_epi64(t[i], 26)); \
+    t[i] = _mm256_and_si256(t[i], M); \
+} while(0)
+
+/* Set r to the four elements a[0..3], which must have magnitude at most 8. The magnitude
+ * of r is the largest of their magnitudes. */
+static SECP256K1_INLINE SECP256K1_TARGET_AVX2 void secp256k1_fe4_load(secp256k1_fe4 *r, const secp256k1_fe *const *a) {
+#if defined(SECP256K1_WIDEMUL_INT128)
+    const __m256i M = _mm256_set1_epi64x(0x3FFFFFFUL);
+    __m256i v;
+#endif
+#ifdef VERIFY
+    int k;
+    for (k = 0; k < 4; k++) {
+        VERIFY_CHECK(a[k]->magnitude <= 8);
+    }
+#endif
+
+#if defined(SECP256K1_WIDEMUL_INT128)
+    /* Split every 52-bit limb into two 26-bit limbs. The upper half keeps the excess of a
+     * limb, which preserves the magnitude. */
+    v = _mm256_set_epi64x(a[3]->n[0], a[2]->n[0], a[1]->n[0], a[0]->n[0]);
+    r->n[0] = _mm256_and_si256(v, M);
+    r->n[1] = _mm256_srli_epi64(v, 26);
+    v = _mm256_set_epi64x(a[3]->n[1], a[2]->n[1], a[1]->n[1], a[0]->n[1]);
+    r->n[2] = _mm256_and_si256(v, M);
+    r->n[3] = _mm256_srli_epi64(v, 26);
+    v = _mm256_set_epi64x(a[3]->n[2], a[2]->n[2], a[1]->n[2], a[0]->n[2]);
+    r->n[4] = _mm256_and_si256(v, M);
+    r->n[5] = _mm256_srli_epi64(v, 26);
+    v = _mm256_set_epi64x(a[3]->n[3], a[2]->n[3], a[1]->n[3], a[0]->n[3]);
+    r->n[6] = _mm256_and_si256(v, M);
+    r->n[7] = _mm256_srli_epi64(v, 26);
+    v = _mm256_set_epi64x(a[3]->n[4], a[2]->n[4], a[1]->n[4], a[0]->n[4]);
+    r->n[8] = _mm256_and_si256(v, M);
+    r->n[9] = _mm256_srli_epi64(v, 26);
+#else
+    r->n[0] = _mm256_set_epi64x(a[3]->n[0], a[2]->n[0], a[1]->n[0], a[0]->n[0]);
+    r->n[1] = _mm256_set_epi64x(a[3]->n[1], a[2]->n[1], a[1]->n[1], a[0]->n[1]);
+    r->n[2] = _mm256_set_epi64x(a[3]->n[2], a[2]->n[2], a[1]->n[2], a[0]->n[2]);
+    r->n[3] = _mm256_set_epi64x(a[3]->n[3], a[2]->n[3], a[1]->n[3], a[0]->n[3]);
+    r->n[4] = _mm256_set_epi64x(a[3]->n[4], a[2]->n[4], a[1]->n[4], a[0]->n[4]);
+    r->n[5] = _mm256_set_epi64x(a[3]->n[5], a[2]->n[5], a[1]->n[5], a[0]->n[5]);
+    r->n[6] = _mm256_set_epi64x(a[3]->n[6], a[2]->n[6], a[1]->n[6], a[0]->n[6]);
+    r->n[7] = _mm256_set_epi64x(a[3]->n[7], a[2]->n[7], a[1]->n[7], a[0]->n[7]);
+    r->n[8] = _mm256_set_epi64x(a[3]->n[8], a[2]->n[8], a[1]->n[8], a[0]->n[8]);
+    r->n[9] = _mm256_set_epi64x(a[3]->n[9], a[2]->n[9], a[1]->n[9], a[0]->n[9]);
+#endif
+}
+
+#ifdef VERIFY
+/* Check that the limbs of all four elements of a are less than 2^bits, and the top limbs
+ * less than 2^top_bits. */
+static SECP256K1_TARGET_AVX2 void secp256k1_fe4_verify_bits(const secp256k1_fe4 *a, int bits, int top_bits) {
+    uint64_t l[4];
+    int i, k;
+    for (i = 0; i < 10; i++) {
+        _mm256_storeu_si256((__m256i *)(void *)l, a->n[i]);
+        for (k = 0; k < 4; k++) {
+            VERIFY_CHECK((l[k] >> (i == 9 ? top_bits : bits)) == 0);
+        }
+    }
+}
+#endif
+
+/* Reduce the top limb of r so that r has magnitude 1. The input limbs must be less than 2^62,
+ * and the top limb less than 2^54, because only the low 32 bits of the part of it above 2^22
+ * enter the multiplication with 0x3D1. */
+static SECP256K1_INLINE SECP256K1_TARGET_AVX2 void secp256k1_fe4_normalize_weak(secp256k1_fe4 *r) {
+    const __m256i M = _mm256_set1_epi64x(0x3FFFFFFUL);
+    __m256i x;
+
+#ifdef VERIFY
+    secp256k1_fe4_verify_bits(r, 62, 54);
+#endif
+
+    /* Reduce t9 at the start so there will be at most a single carry from the first pass */
+    x = _mm256_srli_epi64(r->n[9], 22);
+    r->n[9] = _mm256_and_si256(r->n[9], _mm256_set1_epi64x(0x3FFFFFUL));
+    r->n[0] = SECP256K1_FE4_ADD(r->n[0], SECP256K1_FE4_MUL(x, _mm256_set1_epi64x(0x3D1UL)));
+    r->n[1] = SECP256K1_FE4_ADD(r->n[1], _mm256_slli_epi64(x, 6));
+    SECP256K1_FE4_CARRY(r->n, 0);
+    SECP256K1_FE4_CARRY(r->n, 1);
+    SECP256K1_FE4_CARRY(r->n, 2);
+    SECP256K1_FE4_CARRY(r->n, 3);
+    SECP256K1_FE4_CARRY(r->n, 4);
+    SECP256K1_FE4_CARRY(r->n, 5);
+    SECP256K1_FE4_CARRY(r->n, 6);
+    SECP256K1_FE4_CARRY(r->n, 7);
+    SECP256K1_FE4_CARRY(r->n, 8);
+}
+
+/* Store the four elements of a into r[0..3], with magnitude 1. */
+static SECP256K1_INLINE SECP256K1_TARGET_AVX2 void secp256k1_fe4_store(secp256k1_fe *const *r, const secp256k1_fe4 *a) {
+    secp256k1_fe4 t = *a;
+    uint64_t l[10][4];
+    int k;
+
+    secp256k1_fe4_normalize_weak(&t);
+    _mm256_storeu_si256((__m256i *)(void *)l[0], t.n[0]);
+    _mm256_storeu_si256((__m256i *)(void *)l[1], t.n[1]);
+    _mm256_storeu_si256((__m256i *)(void *)l[2], t.n[2]);
+    _mm256_storeu_si256((__m256i *)(void *)l[3], t.n[3]);
+    _mm256_storeu_si256((__m256i *)(void *)l[4], t.n[4]);
+    _mm256_storeu_si256((__m256i *)(void *)l[5], t.n[5]);
+    _mm256_storeu_si256((__m256i *)(void *)l[6], t.n[6]);
+    _mm256_storeu_si256((__m256i *)(void *)l[7], t.n[7]);
+    _mm256_storeu_si256((__m256i *)(void *)l[8], t.n[8]);
+    _mm256_storeu_si256((__m256i *)(void *)l[9], t.n[9]);
+    for (k = 0; k < 4; k++) {
+#if defined(SECP256K1_WIDEMUL_INT128)
+        r[k]->n[0] = l[0][k] + (l[1][k] << 26);
+        r[k]->n[1] = l[2][k] + (l[3][k] << 26);
+        r[k]->n[2] = l[4][k] + (l[5][k] << 26);
+        r[k]->n[3] = l[6][k] + (l[7][k] << 26);
+        r[k]->n[4] = l[8][k] + (l[9][k] << 26);
+#else
+        r[k]->n[0] = l[0][k];
+        r[k]->n[1] = l[1][k];
+        r[k]->n[2] = l[2][k];
+        r[k]->n[3] = l[3][k];
+        r[k]->n[4] = l[4][k];
+        r[k]->n[5] = l[5][k];
+        r[k]->n[6] = l[6][k];
+        r[k]->n[7] = l[7][k];
+        r[k]->n[8] = l[8][k];
+        r[k]->n[9] = l[9][k];
+#endif
+#ifdef VERIFY
+        r[k]->magnitude = 1;
+        r[k]->normalized = 0;
+        secp256k1_fe_verify(r[k]);
+#endif
+    }
+}
+
+/* Reduce the 19 column sums t[0..18] (each less than 2^63.5) of a product to r, with
+ * magnitude 1. t is clobbered. The loops are written out, as compilers do not unroll
+ * them by default, which would keep t in memory. */
+static SECP256K1_INLINE SECP256K1_TARGET_AVX2 void secp256k1_fe4_reduce(secp256k1_fe4 *r, __m256i *t) {
+    const __m256i M = _mm256_set1_epi64x(0x3FFFFFFUL);
+    const __m256i R0 = _mm256_set1_epi64x(0x3D10UL);
+    __m256i x;
+
+    /* Bring t[9..18] below 2^26. The lower limbs can absorb the folded upper limbs
+     * without carrying first. */
+    t[19] = _mm256_setzero_si256();
+    SECP256K1_FE4_CARRY(t, 9);
+    SECP256K1_FE4_CARRY(t, 10);
+    SECP256K1_FE4_CARRY(t, 11);
+    SECP256K1_FE4_CARRY(t, 12);
+    SECP256K1_FE4_CARRY(t, 13);
+    SECP256K1_FE4_CARRY(t, 14);
+    SECP256K1_FE4_CARRY(t, 15);
+    SECP256K1_FE4_CARRY(t, 16);
+    SECP256K1_FE4_CARRY(t, 17);
+    SECP256K1_FE4_CARRY(t, 18);
+    /* Fold t[19] (less than 2^38) into t[9..11], using 2^260 = 0x3D10 + (2^10 << 26) (mod p).
+     * It is split into two 26-bit halves first, as the multiplier only uses 32 bits. */
+    x = _mm256_srli_epi64(t[19], 26);
+    t[19] = _mm256_and_si256(t[19], M);
+    t[9] = SECP256K1_FE4_ADD(t[9], SECP256K1_FE4_MUL(t[19], R0));
+    t[10] = SECP256K1_FE4_ADD(t[10], SECP256K1_FE4_ADD(SECP256K1_FE4_MUL(x, R0), _mm256_slli_epi64(t[19], 10)));
+    t[11] = SECP256K1_FE4_ADD(t[11], _mm256_slli_epi64(x, 10));
+    SECP256K1_FE4_CARRY(t, 10);
+    /* Fold t[10..18] (less than 2^27) into t[0..9]. */
+    t[0] = SECP256K1_FE4_ADD(t[0], SECP256K1_FE4_MUL(t[10], R0));
+    t[1] = SECP256K1_FE4_ADD(t[1], _mm256_slli_epi64(t[10], 10));
+    t[1] = SECP256K1_FE4_ADD(t[1], SECP256K1_FE4_MUL(t[11], R0));
+    t[2] = SECP256K1_FE4_ADD(t[2], _mm256_slli_epi64(t[11], 10));
+    t[2] = SECP256K1_FE4_ADD(t[2], SECP256K1_FE4_MUL(t[12], R0));
+    t[3] = SECP256K1_FE4_ADD(t[3], _mm256_slli_epi64(t[12], 10));
+    t[3] = SECP256K1_FE4_ADD(t[3], SECP256K1_FE4_MUL(t[13], R0));
+    t[4] = SECP256K1_FE4_ADD(t[4], _mm256_slli_epi64(t[13], 10));
+    t[4] = SECP256K1_FE4_ADD(t[4], SECP256K1_FE4_MUL(t[14], R0));
+    t[5] = SECP256K1_FE4_ADD(t[5], _mm256_slli_epi64(t[14], 10));
+    t[5] = SECP256K1_FE4_ADD(t[5], SECP256K1_FE4_MUL(t[15], R0));
+    t[6] = SECP256K1_FE4_ADD(t[6], _mm256_slli_epi64(t[15], 10));
+    t[6] = SECP256K1_FE4_ADD(t[6], SECP256K1_FE4_MUL(t[16], R0));
+    t[7] = SECP256K1_FE4_ADD(t[7], _mm256_slli_epi64(t[16], 10));
+    t[7] = SECP256K1_FE4_ADD(t[7], SECP256K1_FE4_MUL(t[17], R0));
+    t[8] = SECP256K1_FE4_ADD(t[8], _mm256_slli_epi64(t[17], 10));
+    t[8] = SECP256K1_FE4_ADD(t[8], SECP256K1_FE4_MUL(t[18], R0));
+    t[9] = SECP256K1_FE4_ADD(t[9], _mm256_slli_epi64(t[18], 10));
+    SECP256K1_FE4_CARRY(t, 0);
+    SECP256K1_FE4_CARRY(t, 1);
+    SECP256K1_FE4_CARRY(t, 2);
+    SECP256K1_FE4_CARRY(t, 3);
+    SECP256K1_FE4_CARRY(t, 4);
+    SECP256K1_FE4_CARRY(t, 5);
+    SECP256K1_FE4_CARRY(t, 6);
+    SECP256K1_FE4_CARRY(t, 7);
+    SECP256K1_FE4_CARRY(t, 8);
+    /* t[9] is less than 2^42 here. */
+    x = _mm256_srli_epi64(t[9], 22);
+    t[9] = _mm256_and_si256(t[9], _mm256_set1_epi64x(0x3FFFFFUL));
+    t[0] = SECP256K1_FE4_ADD(t[0], SECP256K1_FE4_MUL(x, _mm256_set1_epi64x(0x3D1UL)));
+    t[1] = SECP256K1_FE4_ADD(t[1], _mm256_slli_epi64(x, 6));
+    SECP256K1_FE4_CARRY(t, 0);
+    SECP256K1_FE4_CARRY(t, 1);
+    r->n[0] = t[0];
+    r->n[1] = t[1];
+    r->n[2] = t[2];
+    r->n[3] = t[3];
+    r->n[4] = t[4];
+    r->n[5] = t[5];
+    r->n[6] = t[6];
+    r->n[7] = t[7];
+    r->n[8] = t[8];
+    r->n[9] = t[9];
+}
+
+/* Set r to a*b. */
+static SECP256K1_INLINE SECP256K1_TARGET_AVX2 void secp256k1_fe4_mul(secp256k1_fe4 *r, const secp256k1_fe4 *a, const secp256k1_fe4 *b) {
+    __m256i t[20];
+
+    t[0] = SECP256K1_FE4_MUL(a->n[0], b->n[0]);
+    t[1] = SECP256K1_FE4_MUL(a->n[0], b->n[1]);
+    t[1] = SECP256K1_FE4_ADD(t[1], SECP256K1_FE4_MUL(a->n[1], b->n[0]));
+    t[2] = SECP256K1_FE4_MUL(a->n[0], b->n[2]);
+    t[2] = SECP256K1_FE4_ADD(t[2], SECP256K1_FE4_MUL(a->n[1], b->n[1]));
+    t[2] = SECP256K1_FE4_ADD(t[2], SECP256K1_FE4_MUL(a->n[2], b->n[0]));
+    t[3] = SECP256K1_FE4_MUL(a->n[0], b->n[3]);
+    t[3] = SECP256K1_FE4_ADD(t[3], SECP256K1_FE4_MUL(a->n[1], b->n[2]));
+    t[3] = SECP256K1_FE4_ADD(t[3], SECP256K1_FE4_MUL(a->n[2], b->n[1]));
+    t[3] = SECP256K1_FE4_ADD(t[3], SECP256K1_FE4_MUL(a->n[3], b->n[0]));
+    t[4] = SECP256K1_FE4_MUL(a->n[0], b->n[4]);
+    t[4] = SECP256K1_FE4_ADD(t[4], SECP256K1_FE4_MUL(a->n[1], b->n[3]));
+    t[4] = SECP256K1_FE4_ADD(t[4], SECP256K1_FE4_MUL(a->n[2], b->n[2]));
+    t[4] = SECP256K1_FE4_ADD(t[4], SECP256K1_FE4_MUL(a->n[3], b->n[1]));
+    t[4] = SECP256K1_FE4_ADD(t[4], SECP256K1_FE4_MUL(a->n[4], b->n[0]));
+    t[5] = SECP256K1_FE4_MUL(a->n[0], b->n[5]);
+    t[5] = SECP256K1_FE4_ADD(t[5], SECP256K1_FE4_MUL(a->n[1], b->n[4]));
+    t[5] = SECP256K1_FE4_ADD(t[5], SECP256K1_FE4_MUL(a->n[2], b->n[3]));
+    t[5] = SECP256K1_FE4_ADD(t[5], SECP256K1_FE4_MUL(a->n[3], b->n[2]));
+    t[5] = SECP256K1_FE4_ADD(t[5], SECP256K1_FE4_MUL(a->n[4], b->n[1]));
+    t[5] = SECP256K1_FE4_ADD(t[5], SECP256K1_FE4_MUL(a->n[5], b->n[0]));
+    t[6] = SECP256K1_FE4_MUL(a->n[0], b->n[6]);
+    t[6] = SECP256K1_FE4_ADD(t[6], SECP256K1_FE4_MUL(a->n[1], b->n[5]));
+    t[6] = SECP256K1_FE4_ADD(t[6], SECP256K1_FE4_MUL(a->n[2], b->n[4]));
+    t[6] = SECP256K1_FE4_ADD(t[6], SECP256K1_FE4_MUL(a->n[3], b->n[3]));
+    t[6] = SECP256K1_FE4_ADD(t[6], SECP256K1_FE4_MUL(a->n[4], b->n[2]));
+    t[6] = SECP256K1_FE4_ADD(t[6], SECP256K1_FE4_MUL(a->n[5], b->n[1]));
+    t[6] = SECP256K1_FE4_ADD(t[6], SECP256K1_FE4_MUL(a->n[6], b->n[0]));
+    t[7] = SECP256K1_FE4_MUL(a->n[0], b->n[7]);
+    t[7] = SECP256K1_FE4_ADD(t[7], SECP256K1_FE4_MUL(a->n[1], b->n[6]));
+    t[7] = SECP256K1_FE4_ADD(t[7], SECP256K1_FE4_MUL(a->n[2], b->n[5]));
+    t[7] = SECP256K1_FE4_ADD(t[7], SECP256K1_FE4_MUL(a->n[3], b->n[4]));
+    t[7] = SECP256K1_FE4_ADD(t[7], SECP256K1_FE4_MUL(a->n[4], b->n[3]));
+    t[7] = SECP256K1_FE4_ADD(t[7], SECP256K1_FE4_MUL(a->n[5], b->n[2]));
+    t[7] = SECP256K1_FE4_ADD(t[7], SECP256K1_FE4_MUL(a->n[6], b->n[1]));
+    t[7] = SECP256K1_FE4_ADD(t[7], SECP256K1_FE4_MUL(a->n[7], b->n[0]));
+    t[8] = SECP256K1_FE4_MUL(a->n[0], b->n[8]);
+    t[8] = SECP256K1_FE4_ADD(t[8], SECP256K1_FE4_MUL(a->n[1], b->n[7]));
+    t[8] = SECP256K1_FE4_ADD(t[8], SECP256K1_FE4_MUL(a->n[2], b->n[6]));
+    t[8] = SECP256K1_FE4_ADD(t[8], SECP256K1_FE4_MUL(a->n[3], b->n[5]));
+    t[8] = SECP256K1_FE4_ADD(t[8], SECP256K1_FE4_MUL(a->n[4], b->n[4]));
+    t[8] = SECP256K1_FE4_ADD(t[8], SECP256K1_FE4_MUL(a->n[5], b->n[3]));
+    t[8] = SECP256K1_FE4_ADD(t[8], SECP256K1_FE4_MUL(a->n[6], b->n[2]));
+    t[8] = SECP256K1_FE4_ADD(t[8], SECP256K1_FE4_MUL(a->n[7], b->n[1]));
+    t[8] = SECP256K1_FE4_ADD(t[8], SECP256K1_FE4_MUL(a->n[8], b->n[0]));
+    t[9] = SECP256K1_FE4_MUL(a->n[0], b->n[9]);
+    t[9] = SECP256K1_FE4_ADD(t[9], SECP256K1_FE4_MUL(a->n[1], b->n[8]));
+    t[9] = SECP256K1_FE4_ADD(t[9], SECP256K1_FE4_MUL(a->n[2], b->n[7]));
+    t[9] = SECP256K1_FE4_ADD(t[9], SECP256K1_FE4_MUL(a->n[3], b->n[6]));
+    t[9] = SECP256K1_FE4_ADD(t[9], SECP256K1_FE4_MUL(a->n[4], b->n[5]));
+    t[9] = SECP256K1_FE4_ADD(t[9], SECP256K1_FE4_MUL(a->n[5], b->n[4]));
+    t[9] = SECP256K1_FE4_ADD(t[9], SECP256K1_FE4_MUL(a->n[6], b->n[3]));
+    t[9] = SECP256K1_FE4_ADD(t[9], SECP256K1_FE4_MUL(a->n[7], b->n[2]));
+    t[9] = SECP256K1_FE4_ADD(t[9], SECP256K1_FE4_MUL(a->n[8], b->n[1]));
+    t[9] = SECP256K1_FE4_ADD(t[9], SECP256K1_FE4_MUL(a->n[9], b->n[0]));
+    t[10] = SECP256K1_FE4_MUL(a->n[1], b->n[9]);
+    t[10] = SECP256K1_FE4_ADD(t[10], SECP256K1_FE4_MUL(a->n[2], b->n[8]));
+    t[10] = SECP256K1_FE4_ADD(t[10], SECP256K1_FE4_MUL(a->n[3], b->n[7]));
+    t[10] = SECP256K1_FE4_ADD(t[10], SECP256K1_FE4_MUL(a->n[4], b->n[6]));
+    t[10] = SECP256K1_FE4_ADD(t[10], SECP256K1_FE4_MUL(a->n[5], b->n[5]));
+    t[10] = SECP256K1_FE4_ADD(t[10], SECP256K1_FE4_MUL(a->n[6], b->n[4]));
+    t[10] = SECP256K1_FE4_ADD(t[10], SECP256K1_FE4_MUL(a->n[7], b->n[3]));
+    t[10] = SECP256K1_FE4_ADD(t[10], SECP256K1_FE4_MUL(a->n[8], b->n[2]));
+    t[10] = SECP256K1_FE4_ADD(t[10], SECP256K1_FE4_MUL(a->n[9], b->n[1]));
+    t[11] = SECP256K1_FE4_MUL(a->n[2], b->n[9]);
+    t[11] = SECP256K1_FE4_ADD(t[11], SECP256K1_FE4_MUL(a->n[3], b->n[8]));
+    t[11] = SECP256K1_FE4_ADD(t[11], SECP256K1_FE4_MUL(a->n[4], b->n[7]));
+    t[11] = SECP256K1_FE4_ADD(t[11], SECP256K1_FE4_MUL(a->n[5], b->n[6]));
+    t[11] = SECP256K1_FE4_ADD(t[11], SECP256K1_FE4_MUL(a->n[6], b->n[5]));
+    t[11] = SECP256K1_FE4_ADD(t[11], SECP256K1_FE4_MUL(a->n[7], b->n[4]));
+    t[11] = SECP256K1_FE4_ADD(t[11], SECP256K1_FE4_MUL(a->n[8], b->n[3]));
+    t[11] = SECP256K1_FE4_ADD(t[11], SECP256K1_FE4_MUL(a->n[9], b->n[2]));
+    t[12] = SECP256K1_FE4_MUL(a->n[3], b->n[9]);
+    t[12] = SECP256K1_FE4_ADD(t[12], SECP256K1_FE4_MUL(a->n[4], b->n[8]));
+    t[12] = SECP256K1_FE4_ADD(t[12], SECP256K1_FE4_MUL(a->n[5], b->n[7]));
+    t[12] = SECP256K1_FE4_ADD(t[12], SECP256K1_FE4_MUL(a->n[6], b->n[6]));
+    t[12] = SECP256K1_FE4_ADD(t[12], SECP256K1_FE4_MUL(a->n[7], b->n[5]));
+    t[12] = SECP256K1_FE4_ADD(t[12], SECP256K1_FE4_MUL(a->n[8], b->n[4]));
+    t[12] = SECP256K1_FE4_ADD(t[12], SECP256K1_FE4_MUL(a->n[9], b->n[3]));
+    t[13] = SECP256K1_FE4_MUL(a->n[4], b->n[9]);
+    t[13] = SECP256K1_FE4_ADD(t[13], SECP256K1_FE4_MUL(a->n[5], b->n[8]));
+    t[13] = SECP256K1_FE4_ADD(t[13], SECP256K1_FE4_MUL(a->n[6], b->n[7]));
+    t[13] = SECP256K1_FE4_ADD(t[13], SECP256K1_FE4_MUL(a->n[7], b->n[6]));
+    t[13] = SECP256K1_FE4_ADD(t[13], SECP256K1_FE4_MUL(a->n[8], b->n[5]));
+    t[13] = SECP256K1_FE4_ADD(t[13], SECP256K1_FE4_MUL(a->n[9], b->n[4]));
+    t[14] = SECP256K1_FE4_MUL(a->n[5], b->n[9]);
+    t[14] = SECP256K1_FE4_ADD(t[14], SECP256K1_FE4_MUL(a->n[6], b->n[8]));
+    t[14] = SECP256K1_FE4_ADD(t[14], SECP256K1_FE4_MUL(a->n[7], b->n[7]));
+    t[14] = SECP256K1_FE4_ADD(t[14], SECP256K1_FE4_MUL(a->n[8], b->n[6]));
+    t[14] = SECP256K1_FE4_ADD(t[14], SECP256K1_FE4_MUL(a->n[9], b->n[5]));
+    t[15] = SECP256K1_FE4_MUL(a->n[6], b->n[9]);
+    t[15] = SECP256K1_FE4_ADD(t[15], SECP256K1_FE4_MUL(a->n[7], b->n[8]));
+    t[15] = SECP256K1_FE4_ADD(t[15], SECP256K1_FE4_MUL(a->n[8], b->n[7]));
+    t[15] = SECP256K1_FE4_ADD(t[15], SECP256K1_FE4_MUL(a->n[9], b->n[6]));
+    t[16] = SECP256K1_FE4_MUL(a->n[7], b->n[9]);
+    t[16] = SECP256K1_FE4_ADD(t[16], SECP256K1_FE4_MUL(a->n[8], b->n[8]));
+    t[16] = SECP256K1_FE4_ADD(t[16], SECP256K1_FE4_MUL(a->n[9], b->n[7]));
+    t[17] = SECP256K1_FE4_MUL(a->n[8], b->n[9]);
+    t[17] = SECP256K1_FE4_ADD(t[17], SECP256K1_FE4_MUL(a->n[9], b->n[8]));
+    t[18] = SECP256K1_FE4_MUL(a->n[9], b->n[9]);
+    secp256k1_fe4_reduce(r, t);
+}
+
+/* Set r to a^2. */
+static SECP256K1_INLINE SECP256K1_TARGET_AVX2 void secp256k1_fe4_sqr(secp256k1_fe4 *r, const secp256k1_fe4 *a) {
+    __m256i t[20], a2[9];
+
+    a2[0] = SECP256K1_FE4_ADD(a->n[0], a->n[0]);
+    a2[1] = SECP256K1_FE4_ADD(a->n[1], a->n[1]);
+    a2[2] = SECP256K1_FE4_ADD(a->n[2], a->n[2]);
+    a2[3] = SECP256K1_FE4_ADD(a->n[3], a->n[3]);
+    a2[4] = SECP256K1_FE4_ADD(a->n[4], a->n[4]);
+    a2[5] = SECP256K1_FE4_ADD(a->n[5], a->n[5]);
+    a2[6] = SECP256K1_FE4_ADD(a->n[6], a->n[6]);
+    a2[7] = SECP256K1_FE4_ADD(a->n[7], a->n[7]);
+    a2[8] = SECP256K1_FE4_ADD(a->n[8], a->n[8]);
+    t[0] = SECP256K1_FE4_MUL(a->n[0], a->n[0]);
+    t[1] = SECP256K1_FE4_MUL(a2[0], a->n[1]);
+    t[2] = SECP256K1_FE4_MUL(a2[0], a->n[2]);
+    t[2] = SECP256K1_FE4_ADD(t[2], SECP256K1_FE4_MUL(a->n[1], a->n[1]));
+    t[3] = SECP256K1_FE4_MUL(a2[0], a->n[3]);
+    t[3] = SECP256K1_FE4_ADD(t[3], SECP256K1_FE4_MUL(a2[1], a->n[2]));
+    t[4] = SECP256K1_FE4_MUL(a2[0], a->n[4]);
+    t[4] = SECP256K1_FE4_ADD(t[4], SECP256K1_FE4_MUL(a2[1], a->n[3]));
+    t[4] = SECP256K1_FE4_ADD(t[4], SECP256K1_FE4_MUL(a->n[2], a->n[2]));
+    t[5] = SECP256K1_FE4_MUL(a2[0], a->n[5]);
+    t[5] = SECP256K1_FE4_ADD(t[5], SECP256K1_FE4_MUL(a2[1], a->n[4]));
+    t[5] = SECP256K1_FE4_ADD(t[5], SECP256K1_FE4_MUL(a2[2], a->n[3]));
+    t[6] = SECP256K1_FE4_MUL(a2[0], a->n[6]);
+    t[6] = SECP256K1_FE4_ADD(t[6], SECP256K1_FE4_MUL(a2[1], a->n[5]));
+    t[6] = SECP256K1_FE4_ADD(t[6], SECP256K1_FE4_MUL(a2[2], a->n[4]));
+    t[6] = SECP256K1_FE4_ADD(t[6], SECP256K1_FE4_MUL(a->n[3], a->n[3]));
+    t[7] = SECP256K1_FE4_MUL(a2[0], a->n[7]);
+    t[7] = SECP256K1_FE4_ADD(t[7], SECP256K1_FE4_MUL(a2[1], a->n[6]));
+    t[7] = SECP256K1_FE4_ADD(t[7], SECP256K1_FE4_MUL(a2[2], a->n[5]));
+    t[7] = SECP256K1_FE4_ADD(t[7], SECP256K1_FE4_MUL(a2[3], a->n[4]));
+    t[8] = SECP256K1_FE4_MUL(a2[0], a->n[8]);
+    t[8] = SECP256K1_FE4_ADD(t[8], SECP256K1_FE4_MUL(a2[1], a->n[7]));
+    t[8] = SECP256K1_FE4_ADD(t[8], SECP256K1_FE4_MUL(a2[2], a->n[6]));
+    t[8] = SECP256K1_FE4_ADD(t[8], SECP256K1_FE4_MUL(a2[3], a->n[5]));
+    t[8] = SECP256K1_FE4_ADD(t[8], SECP256K1_FE4_MUL(a->n[4], a->n[4]));
+    t[9] = SECP256K1_FE4_MUL(a2[0], a->n[9]);
+    t[9] = SECP256K1_FE4_ADD(t[9], SECP256K1_FE4_MUL(a2[1], a->n[8]));
+    t[9] = SECP256K1_FE4_ADD(t[9], SECP256K1_FE4_MUL(a2[2], a->n[7]));
+    t[9] = SECP256K1_FE4_ADD(t[9], SECP256K1_FE4_MUL(a2[3], a->n[6]));
+    t[9] = SECP256K1_FE4_ADD(t[9], SECP256K1_FE4_MUL(a2[4], a->n[5]));
+    t[10] = SECP256K1_FE4_MUL(a2[1], a->n[9]);
+    t[10] = SECP256K1_FE4_ADD(t[10], SECP256K1_FE4_MUL(a2[2], a->n[8]));
+    t[10] = SECP256K1_FE4_ADD(t[10], SECP256K1_FE4_MUL(a2[3], a->n[7]));
+    t[10] = SECP256K1_FE4_ADD(t[10], SECP256K1_FE4_MUL(a2[4], a->n[6]));
+    t[10] = SECP256K1_FE4_ADD(t[10], SECP256K1_FE4_MUL(a->n[5], a->n[5]));
+    t[11] = SECP256K1_FE4_MUL(a2[2], a->n[9]);
+    t[11] = SECP256K1_FE4_ADD(t[11], SECP256K1_FE4_MUL(a2[3], a->n[8]));
+    t[11] = SECP256K1_FE4_ADD(t[11], SECP256K1_FE4_MUL(a2[4], a->n[7]));
+    t[11] = SECP256K1_FE4_ADD(t[11], SECP256K1_FE4_MUL(a2[5], a->n[6]));
+    t[12] = SECP256K1_FE4_MUL(a2[3], a->n[9]);
+    t[12] = SECP256K1_FE4_ADD(t[12], SECP256K1_FE4_MUL(a2[4], a->n[8]));
+    t[12] = SECP256K1_FE4_ADD(t[12], SECP256K1_FE4_MUL(a2[5], a->n[7]));
+    t[12] = SECP256K1_FE4_ADD(t[12], SECP256K1_FE4_MUL(a->n[6], a->n[6]));
+    t[13] = SECP256K1_FE4_MUL(a2[4], a->n[9]);
+    t[13] = SECP256K1_FE4_ADD(t[13], SECP256K1_FE4_MUL(a2[5], a->n[8]));
+    t[13] = SECP256K1_FE4_ADD(t[13], SECP256K1_FE4_MUL(a2[6], a->n[7]));
+    t[14] = SECP256K1_FE4_MUL(a2[5], a->n[9]);
+    t[14] = SECP256K1_FE4_ADD(t[14], SECP256K1_FE4_MUL(a2[6], a->n[8]));
+    t[14] = SECP256K1_FE4_ADD(t[14], SECP256K1_FE4_MUL(a->n[7], a->n[7]));
+    t[15] = SECP256K1_FE4_MUL(a2[6], a->n[9]);
+    t[15] = SECP256K1_FE4_ADD(t[15], SECP256K1_FE4_MUL(a2[7], a->n[8]));
+    t[16] = SECP256K1_FE4_MUL(a2[7], a->n[9]);
+    t[16] = SECP256K1_FE4_ADD(t[16], SECP256K1_FE4_MUL(a->n[8], a->n[8]));
+    t[17] = SECP256K1_FE4_MUL(a2[8], a->n[9]);
+    t[18] = SECP256K1_FE4_MUL(a->n[9], a->n[9]);
+    secp256k1_fe4_reduce(r, t);
+}
+
+/* Set r to r + a. */
+static SECP256K1_INLINE SECP256K1_TARGET_AVX2 void secp256k1_fe4_add(secp256k1_fe4 *r, const secp256k1_fe4 *a) {
+    r->n[0] = SECP256K1_FE4_ADD(r->n[0], a->n[0]);
+    r->n[1] = SECP256K1_FE4_ADD(r->n[1], a->n[1]);
+    r->n[2] = SECP256K1_FE4_ADD(r->n[2], a->n[2]);
+    r->n[3] = SECP256K1_FE4_ADD(r->n[3], a->n[3]);
+    r->n[4] = SECP256K1_FE4_ADD(r->n[4], a->n[4]);
+    r->n[5] = SECP256K1_FE4_ADD(r->n[5], a->n[5]);
+    r->n[6] = SECP256K1_FE4_ADD(r->n[6], a->n[6]);
+    r->n[7] = SECP256K1_FE4_ADD(r->n[7], a->n[7]);
+    r->n[8] = SECP256K1_FE4_ADD(r->n[8], a->n[8]);
+    r->n[9] = SECP256K1_FE4_ADD(r->n[9], a->n[9]);
+}
+
+/* Set r to -a, where a has magnitude at most m. The result has magnitude m + 1. */
+static SECP256K1_INLINE SECP256K1_TARGET_AVX2 void secp256k1_fe4_negate(secp256k1_fe4 *r, const secp256k1_fe4 *a, int m) {
+    const uint64_t f = 2 * (m + 1);
+    const __m256i p0 = _mm256_set1_epi64x(0x3FFFC2FUL * f);
+    const __m256i p1 = _mm256_set1_epi64x(0x3FFFFBFUL * f);
+    const __m256i p2 = _mm256_set1_epi64x(0x3FFFFFFUL * f);
+    const __m256i p9 = _mm256_set1_epi64x(0x03FFFFFUL * f);
+
+    r->n[0] = _mm256_sub_epi64(p0, a->n[0]);
+    r->n[1] = _mm256_sub_epi64(p1, a->n[1]);
+    r->n[2] = _mm256_sub_epi64(p2, a->n[2]);
+    r->n[3] = _mm256_sub_epi64(p2, a->n[3]);
+    r->n[4] = _mm256_sub_epi64(p2, a->n[4]);
+    r->n[5] = _mm256_sub_epi64(p2, a->n[5]);
+    r->n[6] = _mm256_sub_epi64(p2, a->n[6]);
+    r->n[7] = _mm256_sub_epi64(p2, a->n[7]);
+    r->n[8] = _mm256_sub_epi64(p2, a->n[8]);
+    r->n[9] = _mm256_sub_epi64(p9, a->n[9]);
+}
+
+/* Set r to r/2. The magnitude m of r becomes m/2 + 1. */
+static SECP256K1_INLINE SECP256K1_TARGET_AVX2 void secp256k1_fe4_half(secp256k1_fe4 *r) {
+    const __m256i one = _mm256_set1_epi64x(1);
+    /* mask is 2^26 - 1 in the lanes where r is odd, and 0 in the others */
+    const __m256i mask = _mm256_srli_epi64(_mm256_sub_epi64(_mm256_setzero_si256(), _mm256_and_si256(r->n[0], one)), 38);
+
+    /* Add p if r is odd, which makes it even without changing its value mod p. */
+    r->n[0] = SECP256K1_FE4_ADD(r->n[0], _mm256_and_si256(mask, _mm256_set1_epi64x(0x3FFFC2FUL)));
+    r->n[1] = SECP256K1_FE4_ADD(r->n[1], _mm256_and_si256(mask, _mm256_set1_epi64x(0x3FFFFBFUL)));
+    r->n[2] = SECP256K1_FE4_ADD(r->n[2], mask);
+    r->n[3] = SECP256K1_FE4_ADD(r->n[3], mask);
+    r->n[4] = SECP256K1_FE4_ADD(r->n[4], mask);
+    r->n[5] = SECP256K1_FE4_ADD(r->n[5], mask);
+    r->n[6] = SECP256K1_FE4_ADD(r->n[6], mask);
+    r->n[7] = SECP256K1_FE4_ADD(r->n[7], mask);
+    r->n[8] = SECP256K1_FE4_ADD(r->n[8], mask);
+    r->n[9] = SECP256K1_FE4_ADD(r->n[9], _mm256_srli_epi64(mask, 4));
+    r->n[0] = SECP256K1_FE4_ADD(_mm256_srli_epi64(r->n[0], 1), _mm256_slli_epi64(_mm256_and_si256(r->n[1], one), 25));
+    r->n[1] = SECP256K1_FE4_ADD(_mm256_srli_epi64(r->n[1], 1), _mm256_slli_epi64(_mm256_and_si256(r->n[2], one), 25));
+    r->n[2] = SECP256K1_FE4_ADD(_mm256_srli_epi64(r->n[2], 1), _mm256_slli_epi64(_mm256_and_si256(r->n[3], one), 25));
+    r->n[3] = SECP256K1_FE4_ADD(_mm256_srli_epi64(r->n[3], 1), _mm256_slli_epi64(_mm256_and_si256(r->n[4], one), 25));
+    r->n[4] = SECP256K1_FE4_ADD(_mm256_srli_epi64(r->n[4], 1), _mm256_slli_epi64(_mm256_and_si256(r->n[5], one), 25));
+    r->n[5] = SECP256K1_FE4_ADD(_mm256_srli_epi64(r->n[5], 1), _mm256_slli_epi64(_mm256_and_si256(r->n[6], one), 25));
+    r->n[6] = SECP256K1_FE4_ADD(_mm256_srli_epi64(r->n[6], 1), _mm256_slli_epi64(_mm256_and_si256(r->n[7], one), 25));
+    r->n[7] = SECP256K1_FE4_ADD(_mm256_srli_epi64(r->n[7], 1), _mm256_slli_epi64(_mm256_and_si256(r->n[8], one), 25));
+    r->n[8] = SECP256K1_FE4_ADD(_mm256_srli_epi64(r->n[8], 1), _mm256_slli_epi64(_mm256_and_si256(r->n[9], one), 25));
+    r->n[9] = _mm256_srli_epi64(r->n[9], 1);
+}
+
+/* Return a bit mask of the lanes of a that are zero mod p. a must have magnitude at most 8. */
+static SECP256K1_INLINE SECP256K1_TARGET_AVX2 int secp256k1_fe4_normalizes_to_zero(const secp256k1_fe4 *a) {
+    const __m256i p2 = _mm256_set1_epi64x(0x3FFFFFFUL);
+    secp256k1_fe4 t = *a;
+    __m256i z0, z1;
+
+    /* After a weak normalization, the value is less than 2p, so it is zero mod p iff it
+     * is 0 or p. These are the only such values whose lower limbs are less than 2^26. */
+    secp256k1_fe4_normalize_weak(&t);
+    z0 = t.n[0];
+    z1 = _mm256_xor_si256(t.n[0], _mm256_set1_epi64x(0x3FFFC2FUL));
+    z0 = _mm256_or_si256(z0, t.n[1]);
+    z1 = _mm256_or_si256(z1, _mm256_xor_si256(t.n[1], _mm256_set1_epi64x(0x3FFFFBFUL)));
+    z0 = _mm256_or_si256(z0, t.n[2]);
+    z1 = _mm256_or_si256(z1, _mm256_xor_si256(t.n[2], p2));
+    z0 = _mm256_or_si256(z0, t.n[3]);
+    z1 = _mm256_or_si256(z1, _mm256_xor_si256(t.n[3], p2));
+    z0 = _mm256_or_si256(z0, t.n[4]);
+    z1 = _mm256_or_si256(z1, _mm256_xor_si256(t.n[4], p2));
+    z0 = _mm256_or_si256(z0, t.n[5]);
+    z1 = _mm256_or_si256(z1, _mm256_xor_si256(t.n[5], p2));
+    z0 = _mm256_or_si256(z0, t.n[6]);
+    z1 = _mm256_or_si256(z1, _mm256_xor_si256(t.n[6], p2));
+    z0 = _mm256_or_si256(z0, t.n[7]);
+    z1 = _mm256_or_si256(z1, _mm256_xor_si256(t.n[7], p2));
+    z0 = _mm256_or_si256(z0, t.n[8]);
+    z1 = _mm256_or_si256(z1, _mm256_xor_si256(t.n[8], p2));
+    z0 = _mm256_or_si256(z0, t.n[9]);
+    z1 = _mm256_or_si256(z1, _mm256_xor_si256(t.n[9], _mm256_set1_epi64x(0x03FFFFFUL)));
+    z0 = _mm256_or_si256(_mm256_cmpeq_epi64(z0, _mm256_setzero_si256()), _mm256_cmpeq_epi64(z1, _mm256_setzero_si256()));
+    return _mm256_movemask_pd(_mm256_castsi256_pd(z0));
+}
+
+#undef SECP256K1_FE4_MUL
+#undef SECP256K1_FE4_ADD
+#undef SECP256K1_FE4_CARRY
+
+#endif /* SECP256K1_FIELD_AVX2_IMPL_H */
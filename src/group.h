@@ -66,6 +66,10 @@ static void secp256k1_ge_set_gej(secp256k1_ge *r, secp256k1_gej *a);
 /** Set a group element equal to another which is given in jacobian coordinates. */
 static void secp256k1_ge_set_gej_var(secp256k1_ge *r, secp256k1_gej *a);
 
+/** Set a batch of group elements equal to the inputs given in jacobian coordinates. Constant
+ *  time. None of the inputs may be infinity. */
+static void secp256k1_ge_set_all_gej(secp256k1_ge *r, const secp256k1_gej *a, size_t len);
+
 /** Set a batch of group elements equal to the inputs given in jacobian coordinates */
 static void secp256k1_ge_set_all_gej_var(secp256k1_ge *r, const secp256k1_gej *a, size_t len);
 
@@ -123,6 +127,16 @@ static void secp256k1_gej_add_ge(secp256k1_gej *r, const secp256k1_gej *a, const
     guarantee, and b is allowed to be infinity. If rzr is non-NULL this sets *rzr such that r->z == a->z * *rzr (a cannot be infinity in that case). */
 static void secp256k1_gej_add_ge_var(secp256k1_gej *r, const secp256k1_gej *a, const secp256k1_ge *b, secp256k1_fe *rzr);
 
+/** Set r[k] equal to a[k] + b[k] for k = 0..3, like secp256k1_gej_add_ge_var without rzr. The four
+ *  additions are computed at once using AVX2 if available. r[k] may point to a[k], but must not
+ *  overlap with any other input. */
+static void secp256k1_gej_add_ge_var_x4(secp256k1_gej *const *r, const secp256k1_gej *const *a, const secp256k1_ge *const *b);
+
+/** Set r[k] equal to the double of a[k] for k = 0..3, like secp256k1_gej_double_var without rzr. The
+ *  four doublings are computed at once using AVX2 if available. r[k] may point to a[k], but must not
+ *  overlap with any other input. */
+static void secp256k1_gej_double_var_x4(secp256k1_gej *const *r, const secp256k1_gej *const *a);
+
 /** Set r equal to the sum of a and b (with the inverse of b's Z coordinate passed as bzinv). */
 static void secp256k1_gej_add_zinv_var(secp256k1_gej *r, const secp256k1_gej *a, const secp256k1_ge *b, const secp256k1_fe *bzinv);
 
@@ -147,6 +161,10 @@ static void secp256k1_gej_cmov(secp256k1_gej *r, const secp256k1_gej *a, int fla
 /** If flag is true, set *r equal to *a; otherwise leave it. Constant-time.  Both *r and *a must be initialized.*/
 static void secp256k1_ge_storage_cmov(secp256k1_ge_storage *r, const secp256k1_ge_storage *a, int flag);
 
+/** Set *r equal to table[idx], where table has n entries and 0 <= idx < n. Constant-time, i.e., neither
+ *  the memory access pattern nor the timing depend on idx. Uses AVX2 if available. */
+static void secp256k1_ge_storage_table_select(secp256k1_ge_storage *r, const secp256k1_ge_storage *table, int n, int idx);
+
 /** Rescale a jacobian point by b which must be non-zero. Constant-time. */
 static void secp256k1_gej_rescale(secp256k1_gej *r, const secp256k1_fe *b);
 
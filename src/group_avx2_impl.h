@@ -0,0 +1,205 @@
+/***********************************************************************
+ * Copyright (c) 2023 The libsecp256k1 developers                      *
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_GROUP_AVX2_IMPL_H
+#define SECP256K1_GROUP_AVX2_IMPL_H
+
+#include <immintrin.h>
+
+#include "field_avx2_impl.h"
+#include "group.h"
+#include "cpu_features.h"
+
+/* AVX2 implementation of secp256k1_ge_storage_table_select. Every 64-byte entry is loaded
+ * as two 256-bit vectors and blended into the result under a mask that is computed with
+ * vector comparisons of the entry index, so the index never appears in a branch or in an
+ * address. This is only compiled with a target attribute and must only be called if
+ * secp256k1_cpu_has_avx2 returns true. */
+SECP256K1_TARGET_AVX2
+static void secp256k1_ge_storage_table_select_avx2(secp256k1_ge_storage *r, const secp256k1_ge_storage *table, int n, int idx) {
+    const __m256i vidx = _mm256_set1_epi32(idx);
+    const __m256i two = _mm256_set1_epi32(2);
+    __m256i vi0 = _mm256_setzero_si256();
+    __m256i vi1 = _mm256_set1_epi32(1);
+    __m256i x0 = _mm256_setzero_si256(), x1 = _mm256_setzero_si256();
+    __m256i y0 = _mm256_setzero_si256(), y1 = _mm256_setzero_si256();
+    int i;
+
+    VERIFY_CHECK(sizeof(secp256k1_fe_storage) == 32);
+    /* Process two entries per iteration into separate accumulators, which shortens the
+     * dependency chains. Masking and or-ing is a blend into an all-zero accumulator. */
+    for (i = 0; i + 1 < n; i += 2) {
+        const __m256i mask0 = _mm256_cmpeq_epi32(vi0, vidx);
+        const __m256i mask1 = _mm256_cmpeq_epi32(vi1, vidx);
+        x0 = _mm256_or_si256(x0, _mm256_and_si256(mask0, _mm256_loadu_si256((const __m256i *)(const void *)&table[i].x)));
+        y0 = _mm256_or_si256(y0, _mm256_and_si256(mask0, _mm256_loadu_si256((const __m256i *)(const void *)&table[i].y)));
+        x1 = _mm256_or_si256(x1, _mm256_and_si256(mask1, _mm256_loadu_si256((const __m256i *)(const void *)&table[i + 1].x)));
+        y1 = _mm256_or_si256(y1, _mm256_and_si256(mask1, _mm256_loadu_si256((const __m256i *)(const void *)&table[i + 1].y)));
+        vi0 = _mm256_add_epi32(vi0, two);
+        vi1 = _mm256_add_epi32(vi1, two);
+    }
+    if (i < n) {
+        const __m256i mask0 = _mm256_cmpeq_epi32(vi0, vidx);
+        x0 = _mm256_or_si256(x0, _mm256_and_si256(mask0, _mm256_loadu_si256((const __m256i *)(const void *)&table[i].x)));
+        y0 = _mm256_or_si256(y0, _mm256_and_si256(mask0, _mm256_loadu_si256((const __m256i *)(const void *)&table[i].y)));
+    }
+    _mm256_storeu_si256((__m256i *)(void *)&r->x, _mm256_or_si256(x0, x1));
+    _mm256_storeu_si256((__m256i *)(void *)&r->y, _mm256_or_si256(y0, y1));
+}
+
+/* AVX2 implementation of secp256k1_gej_add_ge_var_x4, which uses the formulas of
+ * secp256k1_gej_add_ge_var in all four lanes. The lanes in which a point is infinity or in
+ * which the points have the same x coordinate are recomputed with secp256k1_gej_add_ge_var. */
+SECP256K1_TARGET_AVX2
+static void secp256k1_gej_add_ge_var_x4_avx2(secp256k1_gej *const *r, const secp256k1_gej *const *a, const secp256k1_ge *const *b) {
+    secp256k1_fe4 ax, ay, az, bx, by, z12, u1, u2, s1, s2, h, i, h2, h3, t, rx, ry, rz;
+    secp256k1_fe x[4], y[4], z[4];
+    const secp256k1_fe *in[4];
+    secp256k1_fe *out[4];
+    int special = 0;
+    int k;
+
+    for (k = 0; k < 4; k++) {
+        special |= (a[k]->infinity | b[k]->infinity) << k;
+    }
+#define SECP256K1_FE4_LOAD(v, p, f) do { \
+    for (k = 0; k < 4; k++) { \
+        in[k] = &p[k]->f; \
+    } \
+    secp256k1_fe4_load(&v, in); \
+} while(0)
+    SECP256K1_FE4_LOAD(ax, a, x);
+    SECP256K1_FE4_LOAD(ay, a, y);
+    SECP256K1_FE4_LOAD(az, a, z);
+    SECP256K1_FE4_LOAD(bx, b, x);
+    SECP256K1_FE4_LOAD(by, b, y);
+#undef SECP256K1_FE4_LOAD
+
+    secp256k1_fe4_sqr(&z12, &az);
+    u1 = ax; secp256k1_fe4_normalize_weak(&u1);
+    secp256k1_fe4_mul(&u2, &bx, &z12);
+    s1 = ay; secp256k1_fe4_normalize_weak(&s1);
+    secp256k1_fe4_mul(&s2, &by, &z12); secp256k1_fe4_mul(&s2, &s2, &az);
+    secp256k1_fe4_negate(&h, &u1, 1); secp256k1_fe4_add(&h, &u2);
+    secp256k1_fe4_negate(&i, &s2, 1); secp256k1_fe4_add(&i, &s1);
+    special |= secp256k1_fe4_normalizes_to_zero(&h);
+
+    if (special != 15) {
+        secp256k1_fe4_mul(&rz, &az, &h);
+
+        secp256k1_fe4_sqr(&h2, &h);
+        secp256k1_fe4_negate(&h2, &h2, 1);
+        secp256k1_fe4_mul(&h3, &h2, &h);
+        secp256k1_fe4_mul(&t, &u1, &h2);
+
+        secp256k1_fe4_sqr(&rx, &i);
+        secp256k1_fe4_add(&rx, &h3);
+        secp256k1_fe4_add(&rx, &t);
+        secp256k1_fe4_add(&rx, &t);
+
+        secp256k1_fe4_add(&t, &rx);
+        secp256k1_fe4_mul(&ry, &t, &i);
+        secp256k1_fe4_mul(&h3, &h3, &s1);
+        secp256k1_fe4_add(&ry, &h3);
+
+        for (k = 0; k < 4; k++) {
+            out[k] = &x[k];
+        }
+        secp256k1_fe4_store(out, &rx);
+        for (k = 0; k < 4; k++) {
+            out[k] = &y[k];
+        }
+        secp256k1_fe4_store(out, &ry);
+        for (k = 0; k < 4; k++) {
+            out[k] = &z[k];
+        }
+        secp256k1_fe4_store(out, &rz);
+    }
+
+    for (k = 0; k < 4; k++) {
+        if ((special >> k) & 1) {
+            secp256k1_gej_add_ge_var(r[k], a[k], b[k], NULL);
+        } else {
+            r[k]->x = x[k];
+            r[k]->y = y[k];
+            r[k]->z = z[k];
+            r[k]->infinity = 0;
+        }
+    }
+}
+
+/* AVX2 implementation of secp256k1_gej_double_var_x4, which uses the formulas of
+ * secp256k1_gej_double in all four lanes. The lanes in which the point is infinity are
+ * recomputed with secp256k1_gej_double_var. */
+SECP256K1_TARGET_AVX2
+static void secp256k1_gej_double_var_x4_avx2(secp256k1_gej *const *r, const secp256k1_gej *const *a) {
+    secp256k1_fe4 ax, ay, az, l, s, t, rx, ry, rz;
+    secp256k1_fe x[4], y[4], z[4];
+    const secp256k1_fe *in[4];
+    secp256k1_fe *out[4];
+    int special = 0;
+    int k;
+
+    for (k = 0; k < 4; k++) {
+        special |= a[k]->infinity << k;
+    }
+    if (special != 15) {
+#define SECP256K1_FE4_LOAD(v, f) do { \
+    for (k = 0; k < 4; k++) { \
+        in[k] = &a[k]->f; \
+    } \
+    secp256k1_fe4_load(&v, in); \
+} while(0)
+        SECP256K1_FE4_LOAD(ax, x);
+        SECP256K1_FE4_LOAD(ay, y);
+        SECP256K1_FE4_LOAD(az, z);
+#undef SECP256K1_FE4_LOAD
+
+        secp256k1_fe4_mul(&rz, &az, &ay);   /* Z3 = Y1*Z1 (1) */
+        secp256k1_fe4_sqr(&s, &ay);         /* S = Y1^2 (1) */
+        secp256k1_fe4_sqr(&l, &ax);         /* L = X1^2 (1) */
+        t = l;
+        secp256k1_fe4_add(&l, &t);
+        secp256k1_fe4_add(&l, &t);          /* L = 3*X1^2 (3) */
+        secp256k1_fe4_half(&l);             /* L = 3/2*X1^2 (2) */
+        secp256k1_fe4_negate(&t, &s, 1);    /* T = -S (2) */
+        secp256k1_fe4_mul(&t, &t, &ax);     /* T = -X1*S (1) */
+        secp256k1_fe4_sqr(&rx, &l);         /* X3 = L^2 (1) */
+        secp256k1_fe4_add(&rx, &t);         /* X3 = L^2 + T (2) */
+        secp256k1_fe4_add(&rx, &t);         /* X3 = L^2 + 2*T (3) */
+        secp256k1_fe4_sqr(&s, &s);          /* S' = S^2 (1) */
+        secp256k1_fe4_add(&t, &rx);         /* T' = X3 + T (4) */
+        secp256k1_fe4_mul(&ry, &t, &l);     /* Y3 = L*(X3 + T) (1) */
+        secp256k1_fe4_add(&ry, &s);         /* Y3 = L*(X3 + T) + S^2 (2) */
+        secp256k1_fe4_negate(&ry, &ry, 2);  /* Y3 = -(L*(X3 + T) + S^2) (3) */
+
+        for (k = 0; k < 4; k++) {
+            out[k] = &x[k];
+        }
+        secp256k1_fe4_store(out, &rx);
+        for (k = 0; k < 4; k++) {
+            out[k] = &y[k];
+        }
+        secp256k1_fe4_store(out, &ry);
+        for (k = 0; k < 4; k++) {
+            out[k] = &z[k];
+        }
+        secp256k1_fe4_store(out, &rz);
+    }
+
+    for (k = 0; k < 4; k++) {
+        if ((special >> k) & 1) {
+            secp256k1_gej_double_var(r[k], a[k], NULL);
+        } else {
+            r[k]->x = x[k];
+            r[k]->y = y[k];
+            r[k]->z = z[k];
+            r[k]->infinity = 0;
+        }
+    }
+}
+
+#endif /* SECP256K1_GROUP_AVX2_IMPL_H */
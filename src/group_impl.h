@@ -9,6 +9,11 @@
 
 #include "field.h"
 #include "group.h"
+#include "cpu_features.h"
+
+#ifdef USE_X86_SIMD
+#include "group_avx2_impl.h"
+#endif
 
 #define SECP256K1_G_ORDER_13 SECP256K1_GE_CONST(\
     0xc3459c3d, 0x35326167, 0xcd86cce8, 0x07a2417f,\
@@ -119,6 +124,33 @@ static void secp256k1_ge_set_gej_var(secp256k1_ge *r, secp256k1_gej *a) {
     secp256k1_ge_set_xy(r, &a->x, &a->y);
 }
 
+static void secp256k1_ge_set_all_gej(secp256k1_ge *r, const secp256k1_gej *a, size_t len) {
+    secp256k1_fe u;
+    size_t i;
+
+    if (len == 0) {
+        return;
+    }
+    /* Use destination's x coordinates as scratch space for the products of
+     * the z coordinates, so that a single inversion suffices. */
+    r[0].x = a[0].z;
+    for (i = 1; i < len; i++) {
+        VERIFY_CHECK(!a[i].infinity);
+        secp256k1_fe_mul(&r[i].x, &r[i - 1].x, &a[i].z);
+    }
+    secp256k1_fe_inv(&u, &r[len - 1].x);
+
+    for (i = len - 1; i > 0; i--) {
+        secp256k1_fe_mul(&r[i].x, &r[i - 1].x, &u);
+        secp256k1_fe_mul(&u, &u, &a[i].z);
+    }
+    r[0].x = u;
+
+    for (i = 0; i < len; i++) {
+        secp256k1_ge_set_gej_zinv(&r[i], &a[i], &r[i].x);
+    }
+}
+
 static void secp256k1_ge_set_all_gej_var(secp256k1_ge *r, const secp256k1_gej *a, size_t len) {
     secp256k1_fe u;
     size_t i;
@@ -446,6 +478,32 @@ static void secp256k1_gej_add_ge_var(secp256k1_gej *r, const secp256k1_gej *a, c
     secp256k1_fe_add(&r->y, &h3);
 }
 
+static void secp256k1_gej_add_ge_var_x4(secp256k1_gej *const *r, const secp256k1_gej *const *a, const secp256k1_ge *const *b) {
+    int k;
+#ifdef USE_X86_SIMD
+    if (secp256k1_cpu_has_avx2()) {
+        secp256k1_gej_add_ge_var_x4_avx2(r, a, b);
+        return;
+    }
+#endif
+    for (k = 0; k < 4; k++) {
+        secp256k1_gej_add_ge_var(r[k], a[k], b[k], NULL);
+    }
+}
+
+static void secp256k1_gej_double_var_x4(secp256k1_gej *const *r, const secp256k1_gej *const *a) {
+    int k;
+#ifdef USE_X86_SIMD
+    if (secp256k1_cpu_has_avx2()) {
+        secp256k1_gej_double_var_x4_avx2(r, a);
+        return;
+    }
+#endif
+    for (k = 0; k < 4; k++) {
+        secp256k1_gej_double_var(r[k], a[k], NULL);
+    }
+}
+
 static void secp256k1_gej_add_zinv_var(secp256k1_gej *r, const secp256k1_gej *a, const secp256k1_ge *b, const secp256k1_fe *bzinv) {
     /* 9 mul, 3 sqr, 13 add/negate/normalize_weak/normalizes_to_zero (ignoring special cases) */
     secp256k1_fe az, z12, u1, u2, s1, s2, h, i, h2, h3, t;
@@ -669,6 +727,37 @@ static SECP256K1_INLINE void secp256k1_ge_storage_cmov(secp256k1_ge_storage *r,
     secp256k1_fe_storage_cmov(&r->y, &a->y, flag);
 }
 
+/* Portable implementation of secp256k1_ge_storage_table_select. */
+static SECP256K1_INLINE void secp256k1_ge_storage_table_select_portable(secp256k1_ge_storage *r, const secp256k1_ge_storage *table, int n, int idx) {
+    int i;
+    /** This uses a conditional move to avoid any secret data in array indexes.
+     *   _Any_ use of secret indexes has been demonstrated to result in timing
+     *   sidechannels, even when the cache-line access patterns are uniform.
+     *  See also:
+     *   "A word of warning", CHES 2013 Rump Session, by Daniel J. Bernstein and Peter Schwabe
+     *    (https://cryptojedi.org/peter/data/chesrump-20130822.pdf) and
+     *   "Cache Attacks and Countermeasures: the Case of AES", RSA 2006,
+     *    by Dag Arne Osvik, Adi Shamir, and Eran Tromer
+     *    (https://www.tau.ac.il/~tromer/papers/cache.pdf)
+     */
+    *r = table[0];
+    for (i = 1; i < n; i++) {
+        secp256k1_ge_storage_cmov(r, &table[i], i == idx);
+    }
+}
+
+static SECP256K1_INLINE void secp256k1_ge_storage_table_select(secp256k1_ge_storage *r, const secp256k1_ge_storage *table, int n, int idx) {
+    VERIFY_CHECK(n > 0);
+    VERIFY_CHECK(idx >= 0 && idx < n);
+#ifdef USE_X86_SIMD
+    if (secp256k1_cpu_has_avx2()) {
+        secp256k1_ge_storage_table_select_avx2(r, table, n, idx);
+        return;
+    }
+#endif
+    secp256k1_ge_storage_table_select_portable(r, table, n, idx);
+}
+
 static void secp256k1_ge_mul_lambda(secp256k1_ge *r, const secp256k1_ge *a) {
     *r = *a;
     secp256k1_fe_mul(&r->x, &r->x, &secp256k1_const_beta);
@@ -20,6 +20,11 @@ static void secp256k1_sha256_initialize(secp256k1_sha256 *hash);
 static void secp256k1_sha256_write(secp256k1_sha256 *hash, const unsigned char *data, size_t size);
 static void secp256k1_sha256_finalize(secp256k1_sha256 *hash, unsigned char *out32);
 
+/* Computes the hashes of n messages of msglen bytes each, which all continue from the state
+ * mid (e.g., a tagged hash midstate), and writes them to out32s[0..n-1]. mid is not modified.
+ * Multiple messages are hashed in parallel if the CPU supports it. */
+static void secp256k1_sha256_many(unsigned char * const *out32s, const secp256k1_sha256 *mid, const unsigned char * const *msgs, size_t msglen, size_t n);
+
 typedef struct {
     secp256k1_sha256 inner, outer;
 } secp256k1_hmac_sha256;
@@ -35,6 +40,13 @@ typedef struct {
 } secp256k1_rfc6979_hmac_sha256;
 
 static void secp256k1_rfc6979_hmac_sha256_initialize(secp256k1_rfc6979_hmac_sha256 *rng, const unsigned char *key, size_t keylen);
+/* The first HMAC of the initialization only depends on the key, so it can be computed
+ * partially ahead of time: secp256k1_rfc6979_hmac_sha256_start writes everything up to the
+ * first len bytes of the key into hmac, and secp256k1_rfc6979_hmac_sha256_initialize_from
+ * does the same as secp256k1_rfc6979_hmac_sha256_initialize for a key that starts with
+ * those bytes, but continues from hmac. */
+static void secp256k1_rfc6979_hmac_sha256_start(secp256k1_hmac_sha256 *hmac, const unsigned char *key, size_t len);
+static void secp256k1_rfc6979_hmac_sha256_initialize_from(secp256k1_rfc6979_hmac_sha256 *rng, const secp256k1_hmac_sha256 *start, const unsigned char *key, size_t keylen);
 static void secp256k1_rfc6979_hmac_sha256_generate(secp256k1_rfc6979_hmac_sha256 *rng, unsigned char *out, size_t outlen);
 static void secp256k1_rfc6979_hmac_sha256_finalize(secp256k1_rfc6979_hmac_sha256 *rng);
 
@@ -0,0 +1,339 @@
+/***********************************************************************
+ * Copyright (c) 2023 The libsecp256k1 developers                      *
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_HASH_X86_IMPL_H
+#define SECP256K1_HASH_X86_IMPL_H
+
+#include <immintrin.h>
+
+#include "hash.h"
+#include "cpu_features.h"
+
+/* The SHA-256 round constants, in the order in which they are added to the message words. */
+static const uint32_t secp256k1_sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#ifdef USE_X86_SHANI
+
+/* Four rounds with the message words m (in order of increasing index), starting at round i. */
+#define SECP256K1_SHA256_SHANI_ROUNDS(m, i) do { \
+    msg = _mm_add_epi32((m), _mm_loadu_si128((const __m128i *)(const void *)&secp256k1_sha256_k[i])); \
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg); \
+    msg = _mm_shuffle_epi32(msg, 0x0E); \
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg); \
+} while(0)
+
+/* Given the message words m0, m1, m2, m3 of the last four groups of rounds, where m0 has
+ * already been through _mm_sha256msg1_epu32, compute the words of the next group in m0. */
+#define SECP256K1_SHA256_SHANI_SCHEDULE(m0, m1, m2, m3) do { \
+    m0 = _mm_add_epi32(m0, _mm_alignr_epi8(m3, m2, 4)); \
+    m0 = _mm_sha256msg2_epu32(m0, m3); \
+} while(0)
+
+/* Implementation of secp256k1_sha256_transform with the SHA extensions. The state is kept
+ * in the two registers that _mm_sha256rnds2_epu32 operates on (ABEF and CDGH), and the
+ * message schedule is computed by _mm_sha256msg1_epu32 and _mm_sha256msg2_epu32, four
+ * words at a time. This is only compiled with a target attribute and must only be called
+ * if secp256k1_cpu_has_shani returns true. */
+SECP256K1_TARGET_SHANI
+static void secp256k1_sha256_transform_shani(uint32_t *s, const unsigned char *buf) {
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+    __m128i state0, state1, save0, save1, msg, tmp;
+    __m128i m0, m1, m2, m3;
+
+    tmp = _mm_loadu_si128((const __m128i *)(const void *)&s[0]);    /* DCBA */
+    state1 = _mm_loadu_si128((const __m128i *)(const void *)&s[4]); /* HGFE */
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);                              /* CDAB */
+    state1 = _mm_shuffle_epi32(state1, 0x1B);                        /* EFGH */
+    state0 = _mm_alignr_epi8(tmp, state1, 8);                        /* ABEF */
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);                     /* CDGH */
+    save0 = state0;
+    save1 = state1;
+
+    m0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)&buf[0]), bswap);
+    m1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)&buf[16]), bswap);
+    m2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)&buf[32]), bswap);
+    m3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)&buf[48]), bswap);
+
+    SECP256K1_SHA256_SHANI_ROUNDS(m0, 0);
+    SECP256K1_SHA256_SHANI_ROUNDS(m1, 4);
+    m0 = _mm_sha256msg1_epu32(m0, m1);
+    SECP256K1_SHA256_SHANI_ROUNDS(m2, 8);
+    m1 = _mm_sha256msg1_epu32(m1, m2);
+    SECP256K1_SHA256_SHANI_ROUNDS(m3, 12);
+    SECP256K1_SHA256_SHANI_SCHEDULE(m0, m1, m2, m3);
+    m2 = _mm_sha256msg1_epu32(m2, m3);
+    SECP256K1_SHA256_SHANI_ROUNDS(m0, 16);
+    SECP256K1_SHA256_SHANI_SCHEDULE(m1, m2, m3, m0);
+    m3 = _mm_sha256msg1_epu32(m3, m0);
+    SECP256K1_SHA256_SHANI_ROUNDS(m1, 20);
+    SECP256K1_SHA256_SHANI_SCHEDULE(m2, m3, m0, m1);
+    m0 = _mm_sha256msg1_epu32(m0, m1);
+    SECP256K1_SHA256_SHANI_ROUNDS(m2, 24);
+    SECP256K1_SHA256_SHANI_SCHEDULE(m3, m0, m1, m2);
+    m1 = _mm_sha256msg1_epu32(m1, m2);
+    SECP256K1_SHA256_SHANI_ROUNDS(m3, 28);
+    SECP256K1_SHA256_SHANI_SCHEDULE(m0, m1, m2, m3);
+    m2 = _mm_sha256msg1_epu32(m2, m3);
+    SECP256K1_SHA256_SHANI_ROUNDS(m0, 32);
+    SECP256K1_SHA256_SHANI_SCHEDULE(m1, m2, m3, m0);
+    m3 = _mm_sha256msg1_epu32(m3, m0);
+    SECP256K1_SHA256_SHANI_ROUNDS(m1, 36);
+    SECP256K1_SHA256_SHANI_SCHEDULE(m2, m3, m0, m1);
+    m0 = _mm_sha256msg1_epu32(m0, m1);
+    SECP256K1_SHA256_SHANI_ROUNDS(m2, 40);
+    SECP256K1_SHA256_SHANI_SCHEDULE(m3, m0, m1, m2);
+    m1 = _mm_sha256msg1_epu32(m1, m2);
+    SECP256K1_SHA256_SHANI_ROUNDS(m3, 44);
+    SECP256K1_SHA256_SHANI_SCHEDULE(m0, m1, m2, m3);
+    m2 = _mm_sha256msg1_epu32(m2, m3);
+    SECP256K1_SHA256_SHANI_ROUNDS(m0, 48);
+    SECP256K1_SHA256_SHANI_SCHEDULE(m1, m2, m3, m0);
+    m3 = _mm_sha256msg1_epu32(m3, m0);
+    SECP256K1_SHA256_SHANI_ROUNDS(m1, 52);
+    SECP256K1_SHA256_SHANI_SCHEDULE(m2, m3, m0, m1);
+    SECP256K1_SHA256_SHANI_ROUNDS(m2, 56);
+    SECP256K1_SHA256_SHANI_SCHEDULE(m3, m0, m1, m2);
+    SECP256K1_SHA256_SHANI_ROUNDS(m3, 60);
+
+    state0 = _mm_add_epi32(state0, save0);
+    state1 = _mm_add_epi32(state1, save1);
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);                           /* FEBA */
+    state1 = _mm_shuffle_epi32(state1, 0xB1);                        /* DCHG */
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);                     /* DCBA */
+    state1 = _mm_alignr_epi8(state1, tmp, 8);                        /* HGFE */
+    _mm_storeu_si128((__m128i *)(void *)&s[0], state0);
+    _mm_storeu_si128((__m128i *)(void *)&s[4], state1);
+}
+
+#endif
+
+/* The small sigma functions of SHA-256 on four words at a time. */
+#define SECP256K1_SHA256_SSE4_SIGMA0(x) _mm_xor_si128(_mm_xor_si128( \
+    _mm_or_si128(_mm_srli_epi32(x, 7), _mm_slli_epi32(x, 25)), \
+    _mm_or_si128(_mm_srli_epi32(x, 18), _mm_slli_epi32(x, 14))), _mm_srli_epi32(x, 3))
+#define SECP256K1_SHA256_SSE4_SIGMA1(x) _mm_xor_si128(_mm_xor_si128( \
+    _mm_or_si128(_mm_srli_epi32(x, 17), _mm_slli_epi32(x, 15)), \
+    _mm_or_si128(_mm_srli_epi32(x, 19), _mm_slli_epi32(x, 13))), _mm_srli_epi32(x, 10))
+
+/* Given the message words w0, w1, w2, w3 of the last four groups of four rounds, compute
+ * the words of the next group in w0. The sigma1 terms of its last two words depend on its
+ * first two words, so they are computed in two halves. */
+#define SECP256K1_SHA256_SSE4_SCHEDULE(w0, w1, w2, w3) do { \
+    __m128i t_ = _mm_add_epi32(_mm_add_epi32(w0, _mm_alignr_epi8(w3, w2, 4)), \
+        SECP256K1_SHA256_SSE4_SIGMA0(_mm_alignr_epi8(w1, w0, 4))); \
+    __m128i u_ = _mm_srli_si128(w3, 8); \
+    t_ = _mm_add_epi32(t_, SECP256K1_SHA256_SSE4_SIGMA1(u_)); \
+    u_ = _mm_slli_si128(t_, 8); \
+    w0 = _mm_add_epi32(t_, _mm_and_si128(SECP256K1_SHA256_SSE4_SIGMA1(u_), \
+        _mm_set_epi32(-1, -1, 0, 0))); \
+} while(0)
+
+/* Implementation of secp256k1_sha256_transform for CPUs without the SHA extensions. The
+ * message schedule is computed four words at a time with SSE instructions, which run in
+ * parallel with the scalar rounds. This is only compiled with a target attribute and must
+ * only be called if secp256k1_cpu_has_sse4 returns true. */
+SECP256K1_TARGET_SSE4
+static void secp256k1_sha256_transform_sse4(uint32_t *s, const unsigned char *buf) {
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+    uint32_t a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+    /* The message words plus the round constants of the next 16 rounds. */
+    uint32_t wk[16];
+    __m128i w0, w1, w2, w3;
+    int i;
+
+    w0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)&buf[0]), bswap);
+    w1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)&buf[16]), bswap);
+    w2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)&buf[32]), bswap);
+    w3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)&buf[48]), bswap);
+
+    for (i = 0; i < 64; i += 16) {
+        _mm_storeu_si128((__m128i *)(void *)&wk[0], _mm_add_epi32(w0, _mm_loadu_si128((const __m128i *)(const void *)&secp256k1_sha256_k[i])));
+        _mm_storeu_si128((__m128i *)(void *)&wk[4], _mm_add_epi32(w1, _mm_loadu_si128((const __m128i *)(const void *)&secp256k1_sha256_k[i + 4])));
+        _mm_storeu_si128((__m128i *)(void *)&wk[8], _mm_add_epi32(w2, _mm_loadu_si128((const __m128i *)(const void *)&secp256k1_sha256_k[i + 8])));
+        _mm_storeu_si128((__m128i *)(void *)&wk[12], _mm_add_epi32(w3, _mm_loadu_si128((const __m128i *)(const void *)&secp256k1_sha256_k[i + 12])));
+        if (i < 48) {
+            SECP256K1_SHA256_SSE4_SCHEDULE(w0, w1, w2, w3);
+            SECP256K1_SHA256_SSE4_SCHEDULE(w1, w2, w3, w0);
+            SECP256K1_SHA256_SSE4_SCHEDULE(w2, w3, w0, w1);
+            SECP256K1_SHA256_SSE4_SCHEDULE(w3, w0, w1, w2);
+        }
+        Round(a, b, c, d, e, f, g, h, 0, wk[0]);
+        Round(h, a, b, c, d, e, f, g, 0, wk[1]);
+        Round(g, h, a, b, c, d, e, f, 0, wk[2]);
+        Round(f, g, h, a, b, c, d, e, 0, wk[3]);
+        Round(e, f, g, h, a, b, c, d, 0, wk[4]);
+        Round(d, e, f, g, h, a, b, c, 0, wk[5]);
+        Round(c, d, e, f, g, h, a, b, 0, wk[6]);
+        Round(b, c, d, e, f, g, h, a, 0, wk[7]);
+        Round(a, b, c, d, e, f, g, h, 0, wk[8]);
+        Round(h, a, b, c, d, e, f, g, 0, wk[9]);
+        Round(g, h, a, b, c, d, e, f, 0, wk[10]);
+        Round(f, g, h, a, b, c, d, e, 0, wk[11]);
+        Round(e, f, g, h, a, b, c, d, 0, wk[12]);
+        Round(d, e, f, g, h, a, b, c, 0, wk[13]);
+        Round(c, d, e, f, g, h, a, b, 0, wk[14]);
+        Round(b, c, d, e, f, g, h, a, 0, wk[15]);
+    }
+
+    s[0] += a;
+    s[1] += b;
+    s[2] += c;
+    s[3] += d;
+    s[4] += e;
+    s[5] += f;
+    s[6] += g;
+    s[7] += h;
+}
+
+/* Operations of SHA-256 on eight words at a time, one from each of eight independent states. */
+#define SECP256K1_SHA256_AVX2_ROR(x, n) _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+#define SECP256K1_SHA256_AVX2_ADD(x, y) _mm256_add_epi32(x, y)
+#define SECP256K1_SHA256_AVX2_XOR3(x, y, z) _mm256_xor_si256(_mm256_xor_si256(x, y), z)
+#define SECP256K1_SHA256_AVX2_SIGMA0(x) SECP256K1_SHA256_AVX2_XOR3(SECP256K1_SHA256_AVX2_ROR(x, 7), SECP256K1_SHA256_AVX2_ROR(x, 18), _mm256_srli_epi32(x, 3))
+#define SECP256K1_SHA256_AVX2_SIGMA1(x) SECP256K1_SHA256_AVX2_XOR3(SECP256K1_SHA256_AVX2_ROR(x, 17), SECP256K1_SHA256_AVX2_ROR(x, 19), _mm256_srli_epi32(x, 10))
+
+#define SECP256K1_SHA256_AVX2_ROUND(a, b, c, d, e, f, g, h, i) do { \
+    __m256i t1_ = SECP256K1_SHA256_AVX2_ADD(SECP256K1_SHA256_AVX2_ADD(h, \
+        SECP256K1_SHA256_AVX2_XOR3(SECP256K1_SHA256_AVX2_ROR(e, 6), SECP256K1_SHA256_AVX2_ROR(e, 11), SECP256K1_SHA256_AVX2_ROR(e, 25))), \
+        SECP256K1_SHA256_AVX2_ADD(_mm256_xor_si256(g, _mm256_and_si256(e, _mm256_xor_si256(f, g))), \
+        SECP256K1_SHA256_AVX2_ADD(w[(i) & 15], _mm256_set1_epi32((int)secp256k1_sha256_k[i])))); \
+    __m256i t2_ = SECP256K1_SHA256_AVX2_ADD( \
+        SECP256K1_SHA256_AVX2_XOR3(SECP256K1_SHA256_AVX2_ROR(a, 2), SECP256K1_SHA256_AVX2_ROR(a, 13), SECP256K1_SHA256_AVX2_ROR(a, 22)), \
+        _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)))); \
+    d = SECP256K1_SHA256_AVX2_ADD(d, t1_); \
+    h = SECP256K1_SHA256_AVX2_ADD(t1_, t2_); \
+} while(0)
+
+/* Perform one SHA-256 transformation on each of eight states. s[j] holds word j of all
+ * states, and w[j] holds the (host endian) message word j of all blocks. This is only
+ * compiled with a target attribute and must only be called if secp256k1_cpu_has_avx2
+ * returns true. */
+SECP256K1_TARGET_AVX2
+static void secp256k1_sha256_transform_avx2x8(__m256i *s, const uint32_t (*words)[8]) {
+    __m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+    __m256i w[16];
+    int i, j;
+
+    for (j = 0; j < 16; j++) {
+        w[j] = _mm256_loadu_si256((const __m256i *)(const void *)words[j]);
+    }
+    for (i = 0; i < 64; i += 8) {
+        if (i >= 16) {
+            for (j = i; j < i + 8; j++) {
+                w[j & 15] = SECP256K1_SHA256_AVX2_ADD(SECP256K1_SHA256_AVX2_ADD(w[j & 15], SECP256K1_SHA256_AVX2_SIGMA1(w[(j - 2) & 15])),
+                    SECP256K1_SHA256_AVX2_ADD(w[(j - 7) & 15], SECP256K1_SHA256_AVX2_SIGMA0(w[(j - 15) & 15])));
+            }
+        }
+        SECP256K1_SHA256_AVX2_ROUND(a, b, c, d, e, f, g, h, i);
+        SECP256K1_SHA256_AVX2_ROUND(h, a, b, c, d, e, f, g, i + 1);
+        SECP256K1_SHA256_AVX2_ROUND(g, h, a, b, c, d, e, f, i + 2);
+        SECP256K1_SHA256_AVX2_ROUND(f, g, h, a, b, c, d, e, i + 3);
+        SECP256K1_SHA256_AVX2_ROUND(e, f, g, h, a, b, c, d, i + 4);
+        SECP256K1_SHA256_AVX2_ROUND(d, e, f, g, h, a, b, c, i + 5);
+        SECP256K1_SHA256_AVX2_ROUND(c, d, e, f, g, h, a, b, i + 6);
+        SECP256K1_SHA256_AVX2_ROUND(b, c, d, e, f, g, h, a, i + 7);
+    }
+
+    s[0] = SECP256K1_SHA256_AVX2_ADD(s[0], a);
+    s[1] = SECP256K1_SHA256_AVX2_ADD(s[1], b);
+    s[2] = SECP256K1_SHA256_AVX2_ADD(s[2], c);
+    s[3] = SECP256K1_SHA256_AVX2_ADD(s[3], d);
+    s[4] = SECP256K1_SHA256_AVX2_ADD(s[4], e);
+    s[5] = SECP256K1_SHA256_AVX2_ADD(s[5], f);
+    s[6] = SECP256K1_SHA256_AVX2_ADD(s[6], g);
+    s[7] = SECP256K1_SHA256_AVX2_ADD(s[7], h);
+}
+
+/* Write the message words of block number blk of the padded message that consists of the
+ * buffered bytes of mid followed by msglen bytes of msg into lane j of words. */
+static void secp256k1_sha256_many_block(uint32_t (*words)[8], int j, const secp256k1_sha256 *mid, const unsigned char *msg, size_t msglen, size_t blk, int last) {
+    unsigned char block[64];
+    size_t bufsize = mid->bytes & 0x3F;
+    size_t start = blk * 64, end = start + 64;
+    size_t total = bufsize + msglen;
+    size_t pos;
+    int i;
+
+    memset(block, 0, sizeof(block));
+    if (start < bufsize) {
+        memcpy(block, mid->buf + start, bufsize - start);
+    }
+    pos = start > bufsize ? start : bufsize;
+    if (pos < total && pos < end) {
+        size_t len = (total < end ? total : end) - pos;
+        memcpy(block + (pos - start), msg + (pos - bufsize), len);
+    }
+    if (total >= start && total < end) {
+        block[total - start] = 0x80;
+    }
+    if (last) {
+        secp256k1_write_be64(&block[56], (mid->bytes + msglen) << 3);
+    }
+    for (i = 0; i < 16; i++) {
+        words[i][j] = secp256k1_read_be32(&block[4*i]);
+    }
+}
+
+/* Implementation of secp256k1_sha256_many that hashes eight messages at a time. Groups of
+ * fewer than eight messages are filled up with copies of the first message of the group if
+ * they contain at least four messages, and are left to the caller otherwise. Returns the
+ * number of hashed messages. This is only compiled with a target attribute and must only be
+ * called if secp256k1_cpu_has_avx2 returns true. */
+SECP256K1_TARGET_AVX2
+static size_t secp256k1_sha256_many_avx2(unsigned char * const *out32s, const secp256k1_sha256 *mid, const unsigned char * const *msgs, size_t msglen, size_t n) {
+    uint32_t words[16][8];
+    uint32_t out[8][8];
+    __m256i s[8];
+    size_t nblocks = ((mid->bytes & 0x3F) + msglen + 9 + 63) / 64;
+    size_t i, blk;
+    int j, k, lanes;
+
+    for (i = 0; i + 4 <= n; i += lanes) {
+        lanes = n - i < 8 ? (int)(n - i) : 8;
+        for (k = 0; k < 8; k++) {
+            s[k] = _mm256_set1_epi32((int)mid->s[k]);
+        }
+        for (blk = 0; blk < nblocks; blk++) {
+            for (j = 0; j < 8; j++) {
+                secp256k1_sha256_many_block(words, j, mid, msgs[i + (j < lanes ? j : 0)], msglen, blk, blk == nblocks - 1);
+            }
+            secp256k1_sha256_transform_avx2x8(s, (const uint32_t (*)[8])words);
+        }
+        for (k = 0; k < 8; k++) {
+            _mm256_storeu_si256((__m256i *)(void *)out[k], s[k]);
+        }
+        for (j = 0; j < lanes; j++) {
+            for (k = 0; k < 8; k++) {
+                secp256k1_write_be32(&out32s[i + j][4*k], out[k][j]);
+            }
+        }
+    }
+    return i;
+}
+
+#undef SECP256K1_SHA256_SSE4_SIGMA0
+#undef SECP256K1_SHA256_SSE4_SIGMA1
+#undef SECP256K1_SHA256_SSE4_SCHEDULE
+#undef SECP256K1_SHA256_SHANI_ROUNDS
+#undef SECP256K1_SHA256_SHANI_SCHEDULE
+#undef SECP256K1_SHA256_AVX2_ROR
+#undef SECP256K1_SHA256_AVX2_ADD
+#undef SECP256K1_SHA256_AVX2_XOR3
+#undef SECP256K1_SHA256_AVX2_SIGMA0
+#undef SECP256K1_SHA256_AVX2_SIGMA1
+#undef SECP256K1_SHA256_AVX2_ROUND
+
+#endif /* SECP256K1_HASH_X86_IMPL_H */
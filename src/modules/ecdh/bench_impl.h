@@ -9,10 +9,15 @@
 
 #include "../../../include/secp256k1_ecdh.h"
 
+#define BENCH_ECDH_BATCH 64
+
 typedef struct {
     secp256k1_context *ctx;
     secp256k1_pubkey point;
     unsigned char scalar[32];
+    const secp256k1_pubkey *points[BENCH_ECDH_BATCH];
+    unsigned char res[BENCH_ECDH_BATCH][32];
+    unsigned char *outputs[BENCH_ECDH_BATCH];
 } bench_ecdh_data;
 
 static void bench_ecdh_setup(void* arg) {
@@ -30,6 +35,10 @@ static void bench_ecdh_setup(void* arg) {
         data->scalar[i] = i + 1;
     }
     CHECK(secp256k1_ec_pubkey_parse(data->ctx, &data->point, point, sizeof(point)) == 1);
+    for (i = 0; i < BENCH_ECDH_BATCH; i++) {
+        data->points[i] = &data->point;
+        data->outputs[i] = data->res[i];
+    }
 }
 
 static void bench_ecdh(void* arg, int iters) {
@@ -42,6 +51,18 @@ static void bench_ecdh(void* arg, int iters) {
     }
 }
 
+/* Computes iters ECDH secrets in batches of BENCH_ECDH_BATCH, so that the
+ * result is the time per public key. */
+static void bench_ecdh_batch(void* arg, int iters) {
+    int i;
+    bench_ecdh_data *data = (bench_ecdh_data*)arg;
+
+    for (i = 0; i < iters; i += BENCH_ECDH_BATCH) {
+        size_t n = iters - i < BENCH_ECDH_BATCH ? iters - i : BENCH_ECDH_BATCH;
+        CHECK(secp256k1_ecdh_batch(data->ctx, data->outputs, data->points, n, data->scalar, NULL, NULL) == 1);
+    }
+}
+
 void run_ecdh_bench(int iters, int argc, char** argv) {
     bench_ecdh_data data;
     int d = argc == 1;
@@ -50,6 +71,7 @@ void run_ecdh_bench(int iters, int argc, char** argv) {
     data.ctx = secp256k1_context_create(SECP256K1_FLAGS_TYPE_CONTEXT);
 
     if (d || have_flag(argc, argv, "ecdh")) run_benchmark("ecdh", bench_ecdh, bench_ecdh_setup, NULL, &data, 10, iters);
+    if (d || have_flag(argc, argv, "ecdh")) run_benchmark("ecdh_batch", bench_ecdh_batch, bench_ecdh_setup, NULL, &data, 10, iters);
 
     secp256k1_context_destroy(data.ctx);
 }
@@ -10,6 +10,10 @@
 #include "../../../include/secp256k1_ecdh.h"
 #include "../../ecmult_const_impl.h"
 
+/* The number of points that secp256k1_ecdh_batch converts to affine
+ * coordinates with a single field inversion. */
+#define ECDH_BATCH_SIZE 32
+
 static int ecdh_hash_function_sha256(unsigned char *output, const unsigned char *x32, const unsigned char *y32, void *data) {
     unsigned char version = (y32[31] & 0x01) | 0x02;
     secp256k1_sha256 sha;
@@ -68,4 +72,69 @@ int secp256k1_ecdh(const secp256k1_context* ctx, unsigned char *output, const se
     return !!ret & !overflow;
 }
 
+int secp256k1_ecdh_batch(const secp256k1_context* ctx, unsigned char * const *outputs, const secp256k1_pubkey * const *pubkeys, size_t n, const unsigned char *seckey, secp256k1_ecdh_hash_function hashfp, void *data) {
+    int ret = 1;
+    int overflow = 0;
+    secp256k1_ecmult_const_recoding rec;
+    secp256k1_gej resj[ECDH_BATCH_SIZE];
+    secp256k1_ge res[ECDH_BATCH_SIZE];
+    secp256k1_scalar s;
+    unsigned char x[32];
+    unsigned char y[32];
+    size_t i, j;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(n == 0 || outputs != NULL);
+    ARG_CHECK(n == 0 || pubkeys != NULL);
+    ARG_CHECK(seckey != NULL);
+    for (i = 0; i < n; i++) {
+        ARG_CHECK(outputs[i] != NULL);
+        ARG_CHECK(pubkeys[i] != NULL);
+    }
+
+    if (hashfp == NULL) {
+        hashfp = secp256k1_ecdh_hash_function_default;
+    }
+
+    secp256k1_scalar_set_b32(&s, seckey, &overflow);
+    overflow |= secp256k1_scalar_is_zero(&s);
+    secp256k1_scalar_cmov(&s, &secp256k1_scalar_one, overflow);
+    secp256k1_ecmult_const_recode(&rec, &s, 256);
+
+    for (i = 0; i < n; i += ECDH_BATCH_SIZE) {
+        size_t batch = n - i < ECDH_BATCH_SIZE ? n - i : ECDH_BATCH_SIZE;
+
+        for (j = 0; j < batch; j++) {
+            secp256k1_ge pt;
+            if (!secp256k1_pubkey_load(ctx, &pt, pubkeys[i + j])) {
+                ret = 0;
+                secp256k1_gej_set_ge(&resj[j], &secp256k1_ge_const_g);
+                continue;
+            }
+            secp256k1_ecmult_const_recoded(&resj[j], &pt, &rec);
+        }
+        secp256k1_ge_set_all_gej(res, resj, batch);
+
+        /* Compute a hash of every point */
+        for (j = 0; j < batch; j++) {
+            secp256k1_fe_normalize(&res[j].x);
+            secp256k1_fe_normalize(&res[j].y);
+            secp256k1_fe_get_b32(x, &res[j].x);
+            secp256k1_fe_get_b32(y, &res[j].y);
+            ret &= !!hashfp(outputs[i + j], x, y, data);
+        }
+    }
+
+    memset(x, 0, 32);
+    memset(y, 0, 32);
+    memset(&rec, 0, sizeof(rec));
+    for (j = 0; j < ECDH_BATCH_SIZE; j++) {
+        secp256k1_gej_clear(&resj[j]);
+        secp256k1_ge_clear(&res[j]);
+    }
+    secp256k1_scalar_clear(&s);
+
+    return ret & !overflow;
+}
+
 #endif /* SECP256K1_MODULE_ECDH_MAIN_H */
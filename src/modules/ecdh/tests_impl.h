@@ -155,11 +155,99 @@ void test_result_basepoint(void) {
     }
 }
 
+void test_ecdh_batch_api(void) {
+    secp256k1_context *tctx = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    secp256k1_pubkey point, point_invalid;
+    const secp256k1_pubkey *points[2];
+    unsigned char res[2][32];
+    unsigned char *outputs[2];
+    unsigned char s_one[32] = { 0 };
+    int32_t ecount = 0;
+    s_one[31] = 1;
+
+    secp256k1_context_set_illegal_callback(tctx, counting_illegal_callback_fn, &ecount);
+    CHECK(secp256k1_ec_pubkey_create(ctx, &point, s_one) == 1);
+    memset(&point_invalid, 0, sizeof(point_invalid));
+    points[0] = &point;
+    points[1] = &point;
+    outputs[0] = res[0];
+    outputs[1] = res[1];
+
+    CHECK(secp256k1_ecdh_batch(tctx, outputs, points, 2, s_one, NULL, NULL) == 1);
+    CHECK(secp256k1_ecdh_batch(tctx, NULL, NULL, 0, s_one, NULL, NULL) == 1);
+    CHECK(ecount == 0);
+    CHECK(secp256k1_ecdh_batch(tctx, NULL, points, 2, s_one, NULL, NULL) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_ecdh_batch(tctx, outputs, NULL, 2, s_one, NULL, NULL) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_ecdh_batch(tctx, outputs, points, 2, NULL, NULL, NULL) == 0);
+    CHECK(ecount == 3);
+    points[1] = NULL;
+    CHECK(secp256k1_ecdh_batch(tctx, outputs, points, 2, s_one, NULL, NULL) == 0);
+    CHECK(ecount == 4);
+    points[1] = &point;
+    outputs[1] = NULL;
+    CHECK(secp256k1_ecdh_batch(tctx, outputs, points, 2, s_one, NULL, NULL) == 0);
+    CHECK(ecount == 5);
+    outputs[1] = res[1];
+    points[0] = &point_invalid;
+    CHECK(secp256k1_ecdh_batch(tctx, outputs, points, 2, s_one, NULL, NULL) == 0);
+    CHECK(ecount == 6);
+
+    secp256k1_context_destroy(tctx);
+}
+
+/** Test that ecdh_batch agrees with ecdh for batches that span multiple
+ *  inversions. */
+void test_ecdh_batch(void) {
+    unsigned char s_zero[32] = { 0 };
+    unsigned char s_b32[32];
+    unsigned char out[2 * ECDH_BATCH_SIZE + 3][65];
+    unsigned char *outputs[2 * ECDH_BATCH_SIZE + 3];
+    unsigned char out_single[65];
+    secp256k1_pubkey points[2 * ECDH_BATCH_SIZE + 3];
+    const secp256k1_pubkey *point_ptrs[2 * ECDH_BATCH_SIZE + 3];
+    secp256k1_scalar s;
+    secp256k1_ge ge;
+    size_t n, i;
+
+    n = secp256k1_testrand_int(2 * ECDH_BATCH_SIZE + 3) + 1;
+    random_scalar_order(&s);
+    secp256k1_scalar_get_b32(s_b32, &s);
+    for (i = 0; i < 2 * ECDH_BATCH_SIZE + 3; i++) {
+        random_group_element_test(&ge);
+        secp256k1_pubkey_save(&points[i], &ge);
+        point_ptrs[i] = &points[i];
+        outputs[i] = out[i];
+    }
+
+    CHECK(secp256k1_ecdh_batch(ctx, outputs, point_ptrs, n, s_b32, NULL, NULL) == 1);
+    for (i = 0; i < n; i++) {
+        CHECK(secp256k1_ecdh(ctx, out_single, &points[i], s_b32, NULL, NULL) == 1);
+        CHECK(secp256k1_memcmp_var(out[i], out_single, 32) == 0);
+    }
+    CHECK(secp256k1_ecdh_batch(ctx, outputs, point_ptrs, n, s_b32, ecdh_hash_function_custom, NULL) == 1);
+    for (i = 0; i < n; i++) {
+        CHECK(secp256k1_ecdh(ctx, out_single, &points[i], s_b32, ecdh_hash_function_custom, NULL) == 1);
+        CHECK(secp256k1_memcmp_var(out[i], out_single, 65) == 0);
+    }
+
+    /* Bad scalars and hash function failures result in failure */
+    CHECK(secp256k1_ecdh_batch(ctx, outputs, point_ptrs, n, s_zero, NULL, NULL) == 0);
+    CHECK(secp256k1_ecdh_batch(ctx, outputs, point_ptrs, n, s_b32, ecdh_hash_function_test_fail, NULL) == 0);
+}
+
 void run_ecdh_tests(void) {
+    int i;
+
     test_ecdh_api();
+    test_ecdh_batch_api();
     test_ecdh_generator_basepoint();
     test_bad_scalar();
     test_result_basepoint();
+    for (i = 0; i < count; i++) {
+        test_ecdh_batch();
+    }
 }
 
 #endif /* SECP256K1_MODULE_ECDH_TESTS_H */
@@ -0,0 +1,102 @@
+/***********************************************************************
+ * Copyright (c) 2023 The libsecp256k1 developers                      *
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_MODULE_ECMULT_BENCH_H
+#define SECP256K1_MODULE_ECMULT_BENCH_H
+
+#include "../../../include/secp256k1_ecmult.h"
+
+typedef struct {
+    secp256k1_context *ctx;
+    secp256k1_scratch_space *scratch;
+    secp256k1_pubkey *pks;
+    unsigned char (*scalars)[32];
+    const secp256k1_pubkey **pk_ptrs;
+    const unsigned char **scalar_ptrs;
+    secp256k1_ecmult_multi_precomp *precomp;
+} bench_ecmult_multi_data;
+
+/* Number of points of the precomputation object, whose evaluation is
+ * repeated to reach the number of iterations */
+#define BENCH_ECMULT_PRECOMP_POINTS 128
+
+static void bench_ecmult_multi(void* arg, int iters) {
+    bench_ecmult_multi_data *data = (bench_ecmult_multi_data*)arg;
+    secp256k1_pubkey result;
+
+    CHECK(secp256k1_ecmult_multi(data->ctx, data->scratch, &result, NULL, data->pk_ptrs, data->scalar_ptrs, iters) == 1);
+}
+
+static void bench_ecmult_multi_fixed(void* arg, int iters) {
+    bench_ecmult_multi_data *data = (bench_ecmult_multi_data*)arg;
+    secp256k1_pubkey result;
+    int i;
+
+    for (i = 0; i < iters; i += BENCH_ECMULT_PRECOMP_POINTS) {
+        CHECK(secp256k1_ecmult_multi(data->ctx, data->scratch, &result, NULL, data->pk_ptrs, data->scalar_ptrs + i, BENCH_ECMULT_PRECOMP_POINTS) == 1);
+    }
+}
+
+static void bench_ecmult_multi_precomp(void* arg, int iters) {
+    bench_ecmult_multi_data *data = (bench_ecmult_multi_data*)arg;
+    secp256k1_pubkey result;
+    int i;
+
+    for (i = 0; i < iters; i += BENCH_ECMULT_PRECOMP_POINTS) {
+        CHECK(secp256k1_ecmult_multi_with_precomp(data->ctx, &result, NULL, data->precomp, data->scalar_ptrs + i) == 1);
+    }
+}
+
+void run_ecmult_bench(int iters, int argc, char** argv) {
+    bench_ecmult_multi_data data;
+    int d = argc == 1;
+    int i;
+
+    if (!d && !have_flag(argc, argv, "ecmult_multi") && !have_flag(argc, argv, "ecmult_multi_precomp")) {
+        return;
+    }
+    /* Round up to a multiple of the number of points of the precomputation */
+    iters = (iters + BENCH_ECMULT_PRECOMP_POINTS - 1) / BENCH_ECMULT_PRECOMP_POINTS * BENCH_ECMULT_PRECOMP_POINTS;
+
+    data.ctx = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    data.pks = (secp256k1_pubkey *)malloc(iters * sizeof(*data.pks));
+    data.scalars = (unsigned char (*)[32])malloc(iters * sizeof(*data.scalars));
+    data.pk_ptrs = (const secp256k1_pubkey **)malloc(iters * sizeof(*data.pk_ptrs));
+    data.scalar_ptrs = (const unsigned char **)malloc(iters * sizeof(*data.scalar_ptrs));
+    data.scratch = secp256k1_scratch_space_create(data.ctx, secp256k1_ecmult_multi_scratch_size(iters));
+    for (i = 0; i < iters; i++) {
+        unsigned char sk[32];
+        memset(sk, 's', 28);
+        sk[28] = i >> 24;
+        sk[29] = i >> 16;
+        sk[30] = i >> 8;
+        sk[31] = i;
+        memcpy(data.scalars[i], sk, 32);
+        data.scalars[i][0] = 't';
+        CHECK(secp256k1_ec_pubkey_create(data.ctx, &data.pks[i], sk));
+        data.pk_ptrs[i] = &data.pks[i];
+        data.scalar_ptrs[i] = data.scalars[i];
+    }
+
+    if (d || have_flag(argc, argv, "ecmult_multi")) run_benchmark("ecmult_multi", bench_ecmult_multi, NULL, NULL, &data, 10, iters);
+    if (d || have_flag(argc, argv, "ecmult_multi_precomp")) {
+        data.precomp = secp256k1_ecmult_multi_precomp_create(data.ctx, data.pk_ptrs, BENCH_ECMULT_PRECOMP_POINTS);
+        CHECK(data.precomp != NULL);
+        run_benchmark("ecmult_multi_128", bench_ecmult_multi_fixed, NULL, NULL, &data, 10, iters);
+        run_benchmark("ecmult_multi_precomp_128", bench_ecmult_multi_precomp, NULL, NULL, &data, 10, iters);
+        secp256k1_ecmult_multi_precomp_destroy(data.ctx, data.precomp);
+    }
+
+    secp256k1_scratch_space_destroy(data.ctx, data.scratch);
+    free(data.pks);
+    free(data.scalars);
+    /* Casting to (void *) avoids a stupid warning in MSVC. */
+    free((void *)data.pk_ptrs);
+    free((void *)data.scalar_ptrs);
+    secp256k1_context_destroy(data.ctx);
+}
+
+#endif /* SECP256K1_MODULE_ECMULT_BENCH_H */
@@ -0,0 +1,326 @@
+/***********************************************************************
+ * Copyright (c) 2023 The libsecp256k1 developers                      *
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_MODULE_ECMULT_MAIN_H
+#define SECP256K1_MODULE_ECMULT_MAIN_H
+
+#include "../../../include/secp256k1_ecmult.h"
+
+typedef struct {
+    const secp256k1_context *ctx;
+    const secp256k1_pubkey * const *pubkeys;
+    const unsigned char * const *scalars32;
+} secp256k1_ecmult_multi_data;
+
+static int secp256k1_ecmult_multi_callback_pubkeys(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *cbdata) {
+    secp256k1_ecmult_multi_data *data = (secp256k1_ecmult_multi_data *) cbdata;
+    int overflow;
+
+    secp256k1_scalar_set_b32(sc, data->scalars32[idx], &overflow);
+    if (overflow) {
+        return 0;
+    }
+    return secp256k1_pubkey_load(data->ctx, pt, data->pubkeys[idx]);
+}
+
+static int secp256k1_ecmult_multi_internal(const secp256k1_context* ctx, secp256k1_scratch_space *scratch, secp256k1_pubkey *result, const unsigned char *g_scalar32, const secp256k1_pubkey * const *pubkeys, const unsigned char * const *scalars32, size_t n, secp256k1_ecmult_multi_threadpool threadpool, void *threadpool_data, size_t n_tasks) {
+    secp256k1_ecmult_multi_data data;
+    secp256k1_scalar g_scalar;
+    secp256k1_gej rj;
+    secp256k1_ge r;
+    size_t i;
+    int ret;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(result != NULL);
+    memset(result, 0, sizeof(*result));
+    ARG_CHECK(n == 0 || pubkeys != NULL);
+    ARG_CHECK(n == 0 || scalars32 != NULL);
+    ARG_CHECK(n_tasks > 0);
+    for (i = 0; i < n; i++) {
+        ARG_CHECK(pubkeys[i] != NULL);
+        ARG_CHECK(scalars32[i] != NULL);
+    }
+
+    if (g_scalar32 != NULL) {
+        int overflow;
+        secp256k1_scalar_set_b32(&g_scalar, g_scalar32, &overflow);
+        if (overflow) {
+            return 0;
+        }
+    }
+
+    data.ctx = ctx;
+    data.pubkeys = pubkeys;
+    data.scalars32 = scalars32;
+    if (threadpool != NULL) {
+        ret = secp256k1_ecmult_multi_var_parallel(&ctx->error_callback, scratch, &rj, g_scalar32 != NULL ? &g_scalar : NULL, secp256k1_ecmult_multi_callback_pubkeys, &data, n, n_tasks, threadpool, threadpool_data);
+    } else {
+        ret = secp256k1_ecmult_multi_var(&ctx->error_callback, scratch, &rj, g_scalar32 != NULL ? &g_scalar : NULL, secp256k1_ecmult_multi_callback_pubkeys, &data, n);
+    }
+    if (!ret || secp256k1_gej_is_infinity(&rj)) {
+        return 0;
+    }
+    secp256k1_ge_set_gej_var(&r, &rj);
+    secp256k1_pubkey_save(result, &r);
+    return 1;
+}
+
+int secp256k1_ecmult_multi(const secp256k1_context* ctx, secp256k1_scratch_space *scratch, secp256k1_pubkey *result, const unsigned char *g_scalar32, const secp256k1_pubkey * const *pubkeys, const unsigned char * const *scalars32, size_t n) {
+    return secp256k1_ecmult_multi_internal(ctx, scratch, result, g_scalar32, pubkeys, scalars32, n, NULL, NULL, 1);
+}
+
+int secp256k1_ecmult_multi_parallel(const secp256k1_context* ctx, secp256k1_scratch_space *scratch, secp256k1_pubkey *result, const unsigned char *g_scalar32, const secp256k1_pubkey * const *pubkeys, const unsigned char * const *scalars32, size_t n, secp256k1_ecmult_multi_threadpool threadpool, void *threadpool_data, size_t n_tasks) {
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(threadpool != NULL);
+    return secp256k1_ecmult_multi_internal(ctx, scratch, result, g_scalar32, pubkeys, scalars32, n, threadpool, threadpool_data, n_tasks);
+}
+
+size_t secp256k1_ecmult_multi_scratch_size(size_t n) {
+    size_t size;
+
+    if (n > ECMULT_MAX_POINTS_PER_BATCH) {
+        return 0;
+    }
+    size = secp256k1_pippenger_scratch_size_for_points(n);
+    if (n < ECMULT_PIPPENGER_THRESHOLD) {
+        /* Strauss' algorithm is used for small batches, but the scratch space
+         * must still suffice for Pippenger's algorithm to determine the
+         * batch size. */
+        size_t strauss_size = secp256k1_strauss_scratch_size(n) + STRAUSS_SCRATCH_OBJECTS * (ALIGNMENT - 1);
+        if (strauss_size > size) {
+            size = strauss_size;
+        }
+    }
+    return size;
+}
+
+/* The serialization of a precomputation object consists of a 12-byte header
+ * (format version, window, number of chunks, a zero byte and the number of
+ * public keys as 64-bit big-endian integer), the table entries as 64-byte
+ * affine coordinates x||y and a 32-byte tagged SHA256 checksum of all
+ * preceding bytes. */
+#define ECMULT_MULTI_PRECOMP_VERSION 1
+#define ECMULT_MULTI_PRECOMP_HEADER_SIZE 12
+#define ECMULT_MULTI_PRECOMP_ENTRY_SIZE 64
+
+struct secp256k1_ecmult_multi_precomp_struct {
+    size_t n;
+    /* n tables of ECMULT_PRECOMP_TABLE_SIZE entries */
+    secp256k1_ge_storage *table;
+};
+
+static const unsigned char secp256k1_ecmult_multi_precomp_tag[20] = "ecmult_multi_precomp";
+
+/* Returns whether the size of a precomputation object for n public keys,
+ * and of its serialization, can be represented as size_t. */
+static int secp256k1_ecmult_multi_precomp_n_is_valid(size_t n) {
+    size_t entry_size = sizeof(secp256k1_ge_storage) > ECMULT_MULTI_PRECOMP_ENTRY_SIZE ? sizeof(secp256k1_ge_storage) : ECMULT_MULTI_PRECOMP_ENTRY_SIZE;
+    size_t overhead = ROUND_TO_ALIGN(sizeof(secp256k1_ecmult_multi_precomp)) + ECMULT_MULTI_PRECOMP_HEADER_SIZE + 32;
+    return n <= (SIZE_MAX - overhead) / (ECMULT_PRECOMP_TABLE_SIZE * entry_size);
+}
+
+static secp256k1_ecmult_multi_precomp *secp256k1_ecmult_multi_precomp_alloc(const secp256k1_callback* error_callback, size_t n) {
+    const size_t base_alloc = ROUND_TO_ALIGN(sizeof(secp256k1_ecmult_multi_precomp));
+    void *alloc = checked_malloc(error_callback, base_alloc + n * ECMULT_PRECOMP_TABLE_SIZE * sizeof(secp256k1_ge_storage));
+    secp256k1_ecmult_multi_precomp *ret = (secp256k1_ecmult_multi_precomp *)alloc;
+    if (ret != NULL) {
+        ret->n = n;
+        ret->table = (void *) ((char *) alloc + base_alloc);
+    }
+    return ret;
+}
+
+static void secp256k1_ecmult_multi_precomp_checksum(unsigned char *checksum32, const unsigned char *data, size_t len) {
+    secp256k1_sha256 hash;
+    secp256k1_sha256_initialize_tagged(&hash, secp256k1_ecmult_multi_precomp_tag, sizeof(secp256k1_ecmult_multi_precomp_tag));
+    secp256k1_sha256_write(&hash, data, len);
+    secp256k1_sha256_finalize(&hash, checksum32);
+}
+
+static size_t secp256k1_ecmult_multi_precomp_size(size_t n) {
+    return ECMULT_MULTI_PRECOMP_HEADER_SIZE + n * ECMULT_PRECOMP_TABLE_SIZE * ECMULT_MULTI_PRECOMP_ENTRY_SIZE + 32;
+}
+
+secp256k1_ecmult_multi_precomp *secp256k1_ecmult_multi_precomp_create(const secp256k1_context* ctx, const secp256k1_pubkey * const *pubkeys, size_t n) {
+    secp256k1_ecmult_multi_precomp *precomp;
+    size_t i;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(n == 0 || pubkeys != NULL);
+    ARG_CHECK(secp256k1_ecmult_multi_precomp_n_is_valid(n));
+    for (i = 0; i < n; i++) {
+        ARG_CHECK(pubkeys[i] != NULL);
+    }
+
+    precomp = secp256k1_ecmult_multi_precomp_alloc(&ctx->error_callback, n);
+    if (precomp == NULL) {
+        return NULL;
+    }
+    /* The tables are computed for four points at a time. */
+    for (i = 0; i < n; i += 4) {
+        secp256k1_ge p[4];
+        size_t k, n_points = n - i < 4 ? n - i : 4;
+        for (k = 0; k < n_points; k++) {
+            if (!secp256k1_pubkey_load(ctx, &p[k], pubkeys[i + k])) {
+                free(precomp);
+                return NULL;
+            }
+        }
+        secp256k1_ecmult_precomp_tables(&precomp->table[i * ECMULT_PRECOMP_TABLE_SIZE], p, n_points);
+    }
+    return precomp;
+}
+
+void secp256k1_ecmult_multi_precomp_destroy(const secp256k1_context* ctx, secp256k1_ecmult_multi_precomp *precomp) {
+    VERIFY_CHECK(ctx != NULL);
+    if (precomp != NULL) {
+        free(precomp);
+    }
+}
+
+int secp256k1_ecmult_multi_with_precomp(const secp256k1_context* ctx, secp256k1_pubkey *result, const unsigned char *g_scalar32, const secp256k1_ecmult_multi_precomp *precomp, const unsigned char * const *scalars32) {
+    secp256k1_gej acc[ECMULT_PRECOMP_CHUNK_BITS];
+    secp256k1_scalar g_scalar;
+    secp256k1_gej rj;
+    secp256k1_ge r;
+    size_t i;
+    int overflow;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(result != NULL);
+    memset(result, 0, sizeof(*result));
+    ARG_CHECK(precomp != NULL);
+    ARG_CHECK(precomp->n == 0 || scalars32 != NULL);
+    for (i = 0; i < precomp->n; i++) {
+        ARG_CHECK(scalars32[i] != NULL);
+    }
+
+    if (g_scalar32 != NULL) {
+        secp256k1_scalar_set_b32(&g_scalar, g_scalar32, &overflow);
+        if (overflow) {
+            return 0;
+        }
+    }
+
+    for (i = 0; i < ECMULT_PRECOMP_CHUNK_BITS; i++) {
+        secp256k1_gej_set_infinity(&acc[i]);
+    }
+    for (i = 0; i < precomp->n; i++) {
+        secp256k1_scalar s;
+        secp256k1_scalar_set_b32(&s, scalars32[i], &overflow);
+        if (overflow) {
+            return 0;
+        }
+        secp256k1_ecmult_precomp_accumulate(acc, &precomp->table[i * ECMULT_PRECOMP_TABLE_SIZE], &s);
+    }
+    secp256k1_ecmult_precomp_finish(&rj, acc);
+
+    if (g_scalar32 != NULL) {
+        secp256k1_scalar szero;
+        secp256k1_gej gj;
+        secp256k1_scalar_set_int(&szero, 0);
+        secp256k1_gej_set_infinity(&gj);
+        secp256k1_ecmult(&gj, &gj, &szero, &g_scalar);
+        secp256k1_gej_add_var(&rj, &rj, &gj, NULL);
+    }
+    if (secp256k1_gej_is_infinity(&rj)) {
+        return 0;
+    }
+    secp256k1_ge_set_gej_var(&r, &rj);
+    secp256k1_pubkey_save(result, &r);
+    return 1;
+}
+
+size_t secp256k1_ecmult_multi_precomp_serialized_size(const secp256k1_context* ctx, const secp256k1_ecmult_multi_precomp *precomp) {
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(precomp != NULL);
+    return secp256k1_ecmult_multi_precomp_size(precomp->n);
+}
+
+int secp256k1_ecmult_multi_precomp_serialize(const secp256k1_context* ctx, unsigned char *output, size_t *outputlen, const secp256k1_ecmult_multi_precomp *precomp) {
+    uint64_t n;
+    unsigned char *p;
+    size_t i;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(output != NULL);
+    ARG_CHECK(outputlen != NULL);
+    ARG_CHECK(precomp != NULL);
+    ARG_CHECK(*outputlen >= secp256k1_ecmult_multi_precomp_size(precomp->n));
+
+    output[0] = ECMULT_MULTI_PRECOMP_VERSION;
+    output[1] = ECMULT_PRECOMP_WINDOW;
+    output[2] = ECMULT_PRECOMP_CHUNKS;
+    output[3] = 0;
+    n = precomp->n;
+    for (i = 0; i < 8; i++) {
+        output[4 + i] = n >> (56 - 8 * i);
+    }
+    p = output + ECMULT_MULTI_PRECOMP_HEADER_SIZE;
+    for (i = 0; i < precomp->n * ECMULT_PRECOMP_TABLE_SIZE; i++) {
+        secp256k1_ge ge;
+        secp256k1_ge_from_storage(&ge, &precomp->table[i]);
+        secp256k1_fe_get_b32(p, &ge.x);
+        secp256k1_fe_get_b32(p + 32, &ge.y);
+        p += ECMULT_MULTI_PRECOMP_ENTRY_SIZE;
+    }
+    secp256k1_ecmult_multi_precomp_checksum(p, output, p - output);
+    *outputlen = secp256k1_ecmult_multi_precomp_size(precomp->n);
+    return 1;
+}
+
+secp256k1_ecmult_multi_precomp *secp256k1_ecmult_multi_precomp_parse(const secp256k1_context* ctx, const unsigned char *input, size_t inputlen) {
+    secp256k1_ecmult_multi_precomp *precomp;
+    unsigned char checksum[32];
+    uint64_t n = 0;
+    size_t i;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(input != NULL);
+
+    if (inputlen < ECMULT_MULTI_PRECOMP_HEADER_SIZE + 32
+            || input[0] != ECMULT_MULTI_PRECOMP_VERSION
+            || input[1] != ECMULT_PRECOMP_WINDOW
+            || input[2] != ECMULT_PRECOMP_CHUNKS
+            || input[3] != 0) {
+        return NULL;
+    }
+    for (i = 0; i < 8; i++) {
+        n = (n << 8) | input[4 + i];
+    }
+    if (n > SIZE_MAX || !secp256k1_ecmult_multi_precomp_n_is_valid((size_t)n) || inputlen != secp256k1_ecmult_multi_precomp_size((size_t)n)) {
+        return NULL;
+    }
+    secp256k1_ecmult_multi_precomp_checksum(checksum, input, inputlen - 32);
+    if (secp256k1_memcmp_var(checksum, input + inputlen - 32, 32) != 0) {
+        return NULL;
+    }
+
+    precomp = secp256k1_ecmult_multi_precomp_alloc(&ctx->error_callback, n);
+    if (precomp == NULL) {
+        return NULL;
+    }
+    input += ECMULT_MULTI_PRECOMP_HEADER_SIZE;
+    for (i = 0; i < n * ECMULT_PRECOMP_TABLE_SIZE; i++) {
+        secp256k1_fe x, y;
+        secp256k1_ge ge;
+        if (!secp256k1_fe_set_b32(&x, input) || !secp256k1_fe_set_b32(&y, input + 32)) {
+            free(precomp);
+            return NULL;
+        }
+        secp256k1_ge_set_xy(&ge, &x, &y);
+        if (!secp256k1_ge_is_valid_var(&ge)) {
+            free(precomp);
+            return NULL;
+        }
+        secp256k1_ge_to_storage(&precomp->table[i], &ge);
+        input += ECMULT_MULTI_PRECOMP_ENTRY_SIZE;
+    }
+    return precomp;
+}
+
+#endif /* SECP256K1_MODULE_ECMULT_MAIN_H */
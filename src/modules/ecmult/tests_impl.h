@@ -0,0 +1,408 @@
+/***********************************************************************
+ * Copyright (c) 2023 The libsecp256k1 developers                      *
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_MODULE_ECMULT_TESTS_H
+#define SECP256K1_MODULE_ECMULT_TESTS_H
+
+#include "../../../include/secp256k1_ecmult.h"
+
+/* Runs the tasks sequentially in reverse order and counts them */
+static int ecmult_module_test_threadpool(void (*task)(void *task_data, size_t idx), void *task_data, size_t n_tasks, void *data) {
+    size_t i;
+    for (i = n_tasks; i > 0; i--) {
+        task(task_data, i - 1);
+    }
+    *(size_t *)data += n_tasks;
+    return 1;
+}
+
+static int ecmult_module_test_threadpool_fail(void (*task)(void *task_data, size_t idx), void *task_data, size_t n_tasks, void *data) {
+    (void)task;
+    (void)task_data;
+    (void)n_tasks;
+    (void)data;
+    return 0;
+}
+
+void test_ecmult_module_api(void) {
+    secp256k1_context *none = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    secp256k1_scratch_space *scratch = secp256k1_scratch_space_create(none, 4096);
+    secp256k1_pubkey pk;
+    secp256k1_pubkey result;
+    unsigned char one[32] = { 0 };
+    unsigned char overflow[32];
+    const secp256k1_pubkey *pks[1];
+    const unsigned char *scalars[1];
+    size_t n_tasks_run = 0;
+    int ecount = 0;
+
+    secp256k1_context_set_illegal_callback(none, counting_illegal_callback_fn, &ecount);
+    one[31] = 1;
+    memset(overflow, 0xFF, sizeof(overflow));
+    CHECK(secp256k1_ec_pubkey_create(ctx, &pk, one) == 1);
+    pks[0] = &pk;
+    scalars[0] = one;
+
+    CHECK(secp256k1_ecmult_multi(none, scratch, &result, one, pks, scalars, 1) == 1);
+    CHECK(secp256k1_ecmult_multi(none, NULL, &result, one, pks, scalars, 1) == 1);
+    CHECK(secp256k1_ecmult_multi(none, scratch, &result, NULL, pks, scalars, 1) == 1);
+    CHECK(secp256k1_ec_pubkey_cmp(none, &result, &pk) == 0);
+    CHECK(secp256k1_ecmult_multi(none, scratch, &result, one, NULL, NULL, 0) == 1);
+    CHECK(secp256k1_ec_pubkey_cmp(none, &result, &pk) == 0);
+    CHECK(ecount == 0);
+    /* The result is the point at infinity */
+    CHECK(secp256k1_ecmult_multi(none, scratch, &result, NULL, NULL, NULL, 0) == 0);
+    CHECK(ecount == 0);
+    /* Overflowing scalars */
+    CHECK(secp256k1_ecmult_multi(none, scratch, &result, overflow, pks, scalars, 1) == 0);
+    scalars[0] = overflow;
+    CHECK(secp256k1_ecmult_multi(none, scratch, &result, one, pks, scalars, 1) == 0);
+    CHECK(ecount == 0);
+    scalars[0] = one;
+
+    CHECK(secp256k1_ecmult_multi(none, scratch, NULL, one, pks, scalars, 1) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_ecmult_multi(none, scratch, &result, one, NULL, scalars, 1) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_ecmult_multi(none, scratch, &result, one, pks, NULL, 1) == 0);
+    CHECK(ecount == 3);
+    pks[0] = NULL;
+    CHECK(secp256k1_ecmult_multi(none, scratch, &result, one, pks, scalars, 1) == 0);
+    CHECK(ecount == 4);
+    pks[0] = &pk;
+    scalars[0] = NULL;
+    CHECK(secp256k1_ecmult_multi(none, scratch, &result, one, pks, scalars, 1) == 0);
+    CHECK(ecount == 5);
+    scalars[0] = one;
+
+    CHECK(secp256k1_ecmult_multi_parallel(none, scratch, &result, one, pks, scalars, 1, ecmult_module_test_threadpool, &n_tasks_run, 1) == 1);
+    CHECK(n_tasks_run == 0); /* single task is run without the threadpool */
+    CHECK(secp256k1_ecmult_multi_parallel(none, NULL, &result, one, pks, scalars, 1, ecmult_module_test_threadpool, &n_tasks_run, 2) == 1);
+    CHECK(secp256k1_ecmult_multi_parallel(none, scratch, &result, one, pks, scalars, 1, NULL, NULL, 1) == 0);
+    CHECK(ecount == 6);
+    CHECK(secp256k1_ecmult_multi_parallel(none, scratch, &result, one, pks, scalars, 1, ecmult_module_test_threadpool, &n_tasks_run, 0) == 0);
+    CHECK(ecount == 7);
+    CHECK(n_tasks_run == 0);
+
+    CHECK(secp256k1_ecmult_multi_scratch_size(0) > 0);
+    CHECK(secp256k1_ecmult_multi_scratch_size(SIZE_MAX) == 0);
+
+    secp256k1_scratch_space_destroy(none, scratch);
+    secp256k1_context_destroy(none);
+}
+
+/* Compares secp256k1_ecmult_multi with the sum of the individual products
+ * computed with secp256k1_ec_pubkey_tweak_mul and secp256k1_ec_pubkey_combine. */
+#define N_POINTS 200
+void test_ecmult_module_random(void) {
+    static secp256k1_pubkey pk[N_POINTS];
+    static secp256k1_pubkey prod[N_POINTS + 1];
+    static unsigned char scalar[N_POINTS][32];
+    const secp256k1_pubkey *pks[N_POINTS];
+    const secp256k1_pubkey *prods[N_POINTS + 1];
+    const unsigned char *scalars[N_POINTS];
+    unsigned char g_scalar[32];
+    secp256k1_pubkey expected, result;
+    secp256k1_scratch_space *scratch;
+    size_t n = secp256k1_testrand_int(N_POINTS + 1);
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        unsigned char sk[32];
+        secp256k1_testrand256(sk);
+        secp256k1_testrand256(scalar[i]);
+        CHECK(secp256k1_ec_pubkey_create(ctx, &pk[i], sk) == 1);
+        prod[i] = pk[i];
+        CHECK(secp256k1_ec_pubkey_tweak_mul(ctx, &prod[i], scalar[i]) == 1);
+        pks[i] = &pk[i];
+        prods[i] = &prod[i];
+        scalars[i] = scalar[i];
+    }
+    secp256k1_testrand256(g_scalar);
+    CHECK(secp256k1_ec_pubkey_create(ctx, &prod[n], g_scalar) == 1);
+    prods[n] = &prod[n];
+    CHECK(secp256k1_ec_pubkey_combine(ctx, &expected, prods, n + 1) == 1);
+
+    scratch = secp256k1_scratch_space_create(ctx, secp256k1_ecmult_multi_scratch_size(n));
+    CHECK(secp256k1_ecmult_multi(ctx, scratch, &result, g_scalar, pks, scalars, n) == 1);
+    CHECK(secp256k1_ec_pubkey_cmp(ctx, &result, &expected) == 0);
+    secp256k1_scratch_space_destroy(ctx, scratch);
+    /* A smaller scratch space results in more batches */
+    scratch = secp256k1_scratch_space_create(ctx, secp256k1_ecmult_multi_scratch_size(1 + n / 4));
+    CHECK(secp256k1_ecmult_multi(ctx, scratch, &result, g_scalar, pks, scalars, n) == 1);
+    CHECK(secp256k1_ec_pubkey_cmp(ctx, &result, &expected) == 0);
+
+    /* Split into tasks, including more tasks than points and tasks whose
+     * share of the scratch space is too small for a single batch */
+    for (i = 0; i < 3; i++) {
+        size_t n_tasks_run = 0;
+        size_t n_tasks = i == 0 ? 2 : i == 1 ? 2 + secp256k1_testrand_int(8) : n + 2;
+        secp256k1_scratch_space *scratch_tasks = secp256k1_scratch_space_create(ctx, n_tasks * secp256k1_ecmult_multi_scratch_size(1 + n / n_tasks));
+        CHECK(secp256k1_ecmult_multi_parallel(ctx, scratch_tasks, &result, g_scalar, pks, scalars, n, ecmult_module_test_threadpool, &n_tasks_run, n_tasks) == 1);
+        CHECK(secp256k1_ec_pubkey_cmp(ctx, &result, &expected) == 0);
+        CHECK(n_tasks_run == (n < 2 ? 0 : n < n_tasks ? n : n_tasks));
+        CHECK(secp256k1_ecmult_multi_parallel(ctx, scratch, &result, g_scalar, pks, scalars, n, ecmult_module_test_threadpool, &n_tasks_run, n_tasks) == 1);
+        CHECK(secp256k1_ec_pubkey_cmp(ctx, &result, &expected) == 0);
+        CHECK(secp256k1_ecmult_multi_parallel(ctx, scratch_tasks, &result, g_scalar, pks, scalars, n, ecmult_module_test_threadpool_fail, NULL, n_tasks) == (n < 2));
+        secp256k1_scratch_space_destroy(ctx, scratch_tasks);
+    }
+    secp256k1_scratch_space_destroy(ctx, scratch);
+}
+#undef N_POINTS
+
+void test_ecmult_module_scratch_size(void) {
+    size_t n_points[4] = { 1, 87, 88, 0 };
+    size_t i;
+
+    n_points[3] = 1 + secp256k1_testrand_int(20000);
+    for (i = 0; i < sizeof(n_points)/sizeof(n_points[0]); i++) {
+        size_t n_batches, n_batch_points;
+        secp256k1_scratch *scratch = secp256k1_scratch_create(&ctx->error_callback, secp256k1_ecmult_multi_scratch_size(n_points[i]));
+        /* Check that the points are processed in a single batch */
+        CHECK(secp256k1_ecmult_multi_batch_size_helper(&n_batches, &n_batch_points, secp256k1_pippenger_max_points(&ctx->error_callback, scratch), n_points[i]));
+        CHECK(n_batches == 1);
+        if (n_points[i] < ECMULT_PIPPENGER_THRESHOLD) {
+            CHECK(secp256k1_strauss_max_points(&ctx->error_callback, scratch) >= n_points[i]);
+        }
+        secp256k1_scratch_destroy(&ctx->error_callback, scratch);
+    }
+}
+
+void test_ecmult_module_precomp_api(void) {
+    secp256k1_context *none = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    secp256k1_ecmult_multi_precomp *precomp, *precomp2;
+    secp256k1_pubkey pk[2];
+    secp256k1_pubkey result, expected;
+    unsigned char one[32] = { 0 };
+    unsigned char overflow[32];
+    unsigned char large[32];
+    unsigned char *ser;
+    const secp256k1_pubkey *pks[2];
+    const unsigned char *scalars[2];
+    size_t serlen, len;
+    int ecount = 0;
+
+    secp256k1_context_set_illegal_callback(none, counting_illegal_callback_fn, &ecount);
+    one[31] = 1;
+    memset(overflow, 0xFF, sizeof(overflow));
+    memset(large, 0x7F, sizeof(large));
+    CHECK(secp256k1_ec_pubkey_create(ctx, &pk[0], one) == 1);
+    pk[1] = pk[0];
+    CHECK(secp256k1_ec_pubkey_negate(ctx, &pk[1]) == 1);
+    pks[0] = &pk[0];
+    pks[1] = &pk[1];
+    scalars[0] = one;
+    scalars[1] = one;
+
+    precomp = secp256k1_ecmult_multi_precomp_create(none, pks, 2);
+    CHECK(precomp != NULL);
+    CHECK(secp256k1_ecmult_multi_with_precomp(none, &result, one, precomp, scalars) == 1);
+    CHECK(secp256k1_ec_pubkey_cmp(none, &result, &pk[0]) == 0);
+    CHECK(ecount == 0);
+    /* The public keys cancel out */
+    CHECK(secp256k1_ecmult_multi_with_precomp(none, &result, NULL, precomp, scalars) == 0);
+    CHECK(ecount == 0);
+    CHECK(secp256k1_ecmult_multi_with_precomp(none, &result, overflow, precomp, scalars) == 0);
+    scalars[1] = overflow;
+    CHECK(secp256k1_ecmult_multi_with_precomp(none, &result, one, precomp, scalars) == 0);
+    CHECK(ecount == 0);
+    scalars[1] = one;
+
+    CHECK(secp256k1_ecmult_multi_with_precomp(none, NULL, one, precomp, scalars) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_ecmult_multi_with_precomp(none, &result, one, NULL, scalars) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_ecmult_multi_with_precomp(none, &result, one, precomp, NULL) == 0);
+    CHECK(ecount == 3);
+    scalars[1] = NULL;
+    CHECK(secp256k1_ecmult_multi_with_precomp(none, &result, one, precomp, scalars) == 0);
+    CHECK(ecount == 4);
+    scalars[1] = one;
+
+    CHECK(secp256k1_ecmult_multi_precomp_create(none, NULL, 1) == NULL);
+    CHECK(ecount == 5);
+    pks[1] = NULL;
+    CHECK(secp256k1_ecmult_multi_precomp_create(none, pks, 2) == NULL);
+    CHECK(ecount == 6);
+    pks[1] = &pk[1];
+    CHECK(secp256k1_ecmult_multi_precomp_create(none, pks, SIZE_MAX) == NULL);
+    CHECK(ecount == 7);
+    memset(&pk[1], 0, sizeof(pk[1]));
+    CHECK(secp256k1_ecmult_multi_precomp_create(none, pks, 2) == NULL);
+    CHECK(ecount == 8);
+
+    /* An empty object only computes the generator part */
+    precomp2 = secp256k1_ecmult_multi_precomp_create(none, NULL, 0);
+    CHECK(precomp2 != NULL);
+    CHECK(secp256k1_ecmult_multi_with_precomp(none, &result, one, precomp2, NULL) == 1);
+    CHECK(secp256k1_ec_pubkey_cmp(none, &result, &pk[0]) == 0);
+    CHECK(secp256k1_ecmult_multi_with_precomp(none, &result, NULL, precomp2, NULL) == 0);
+    secp256k1_ecmult_multi_precomp_destroy(none, precomp2);
+    secp256k1_ecmult_multi_precomp_destroy(none, NULL);
+    CHECK(ecount == 8);
+
+    serlen = secp256k1_ecmult_multi_precomp_serialized_size(none, precomp);
+    ser = (unsigned char *)malloc(serlen);
+    len = serlen - 1;
+    CHECK(secp256k1_ecmult_multi_precomp_serialize(none, ser, &len, precomp) == 0);
+    CHECK(ecount == 9);
+    CHECK(secp256k1_ecmult_multi_precomp_serialize(none, NULL, &len, precomp) == 0);
+    CHECK(ecount == 10);
+    CHECK(secp256k1_ecmult_multi_precomp_serialize(none, ser, NULL, precomp) == 0);
+    CHECK(ecount == 11);
+    CHECK(secp256k1_ecmult_multi_precomp_serialize(none, ser, &len, NULL) == 0);
+    CHECK(ecount == 12);
+    CHECK(secp256k1_ecmult_multi_precomp_serialized_size(none, NULL) == 0);
+    CHECK(ecount == 13);
+    CHECK(secp256k1_ecmult_multi_precomp_parse(none, NULL, serlen) == NULL);
+    CHECK(ecount == 14);
+
+    len = serlen;
+    CHECK(secp256k1_ecmult_multi_precomp_serialize(none, ser, &len, precomp) == 1);
+    CHECK(len == serlen);
+    precomp2 = secp256k1_ecmult_multi_precomp_parse(none, ser, serlen);
+    CHECK(precomp2 != NULL);
+    scalars[1] = large;
+    CHECK(secp256k1_ecmult_multi_with_precomp(none, &expected, one, precomp, scalars) == 1);
+    CHECK(secp256k1_ecmult_multi_with_precomp(none, &result, one, precomp2, scalars) == 1);
+    CHECK(secp256k1_ec_pubkey_cmp(none, &result, &expected) == 0);
+    secp256k1_ecmult_multi_precomp_destroy(none, precomp2);
+
+    /* Truncated and corrupted serializations */
+    CHECK(secp256k1_ecmult_multi_precomp_parse(none, ser, serlen - 1) == NULL);
+    CHECK(secp256k1_ecmult_multi_precomp_parse(none, ser, 0) == NULL);
+    ser[secp256k1_testrand_int(serlen)] ^= 1 << secp256k1_testrand_int(8);
+    CHECK(secp256k1_ecmult_multi_precomp_parse(none, ser, serlen) == NULL);
+    CHECK(ecount == 14);
+
+    free(ser);
+    secp256k1_ecmult_multi_precomp_destroy(none, precomp);
+    secp256k1_context_destroy(none);
+}
+
+/* Checks that the parser rejects serializations with a valid checksum that
+ * contain an invalid header or table entry. */
+void test_ecmult_module_precomp_parse(void) {
+    secp256k1_ecmult_multi_precomp *precomp;
+    secp256k1_pubkey pk;
+    const secp256k1_pubkey *pks[1];
+    unsigned char sk[32];
+    unsigned char *ser, *ser2;
+    size_t serlen, pos;
+    int i;
+
+    secp256k1_testrand256(sk);
+    CHECK(secp256k1_ec_pubkey_create(ctx, &pk, sk) == 1);
+    pks[0] = &pk;
+    precomp = secp256k1_ecmult_multi_precomp_create(ctx, pks, 1);
+    CHECK(precomp != NULL);
+    serlen = secp256k1_ecmult_multi_precomp_serialized_size(ctx, precomp);
+    ser = (unsigned char *)malloc(serlen);
+    ser2 = (unsigned char *)malloc(serlen);
+    CHECK(secp256k1_ecmult_multi_precomp_serialize(ctx, ser, &serlen, precomp) == 1);
+    secp256k1_ecmult_multi_precomp_destroy(ctx, precomp);
+
+    for (i = 0; i < 4; i++) {
+        memcpy(ser2, ser, serlen);
+        switch (i) {
+        case 0:
+            /* Modify a header byte */
+            ser2[secp256k1_testrand_int(ECMULT_MULTI_PRECOMP_HEADER_SIZE)] ^= 1 << secp256k1_testrand_int(8);
+            break;
+        case 1:
+            /* Modify a coordinate of an entry such that it is not on the curve */
+            pos = ECMULT_MULTI_PRECOMP_HEADER_SIZE + secp256k1_testrand_int(ECMULT_PRECOMP_TABLE_SIZE) * ECMULT_MULTI_PRECOMP_ENTRY_SIZE;
+            ser2[pos + secp256k1_testrand_int(ECMULT_MULTI_PRECOMP_ENTRY_SIZE)] ^= 1 << secp256k1_testrand_int(8);
+            break;
+        case 2:
+            /* Set a coordinate of an entry to a value >= p */
+            pos = ECMULT_MULTI_PRECOMP_HEADER_SIZE + secp256k1_testrand_int(ECMULT_PRECOMP_TABLE_SIZE) * ECMULT_MULTI_PRECOMP_ENTRY_SIZE;
+            memset(&ser2[pos + 32 * secp256k1_testrand_int(2)], 0xFF, 32);
+            break;
+        case 3:
+            /* Claim a number of public keys that does not match the length */
+            ser2[11] ^= 2;
+            break;
+        }
+        secp256k1_ecmult_multi_precomp_checksum(&ser2[serlen - 32], ser2, serlen - 32);
+        CHECK(secp256k1_ecmult_multi_precomp_parse(ctx, ser2, serlen) == NULL);
+    }
+
+    free(ser);
+    free(ser2);
+}
+
+/* Compares secp256k1_ecmult_multi_with_precomp, also after a serialization
+ * round trip, with secp256k1_ecmult_multi. */
+#define N_POINTS 50
+void test_ecmult_module_precomp_random(void) {
+    static secp256k1_pubkey pk[N_POINTS];
+    static unsigned char scalar[N_POINTS][32];
+    const secp256k1_pubkey *pks[N_POINTS];
+    const unsigned char *scalars[N_POINTS];
+    unsigned char g_scalar[32];
+    secp256k1_ecmult_multi_precomp *precomp, *precomp2;
+    secp256k1_pubkey expected, result;
+    unsigned char *ser;
+    size_t serlen;
+    size_t n = 1 + secp256k1_testrand_int(N_POINTS);
+    size_t i, j;
+
+    for (i = 0; i < n; i++) {
+        unsigned char sk[32];
+        secp256k1_testrand256(sk);
+        CHECK(secp256k1_ec_pubkey_create(ctx, &pk[i], sk) == 1);
+        pks[i] = &pk[i];
+        scalars[i] = scalar[i];
+    }
+    precomp = secp256k1_ecmult_multi_precomp_create(ctx, pks, n);
+    CHECK(precomp != NULL);
+    serlen = secp256k1_ecmult_multi_precomp_serialized_size(ctx, precomp);
+    ser = (unsigned char *)malloc(serlen);
+    CHECK(secp256k1_ecmult_multi_precomp_serialize(ctx, ser, &serlen, precomp) == 1);
+    precomp2 = secp256k1_ecmult_multi_precomp_parse(ctx, ser, serlen);
+    CHECK(precomp2 != NULL);
+
+    for (j = 0; j < 4; j++) {
+        for (i = 0; i < n; i++) {
+            secp256k1_scalar s;
+            if (j == 0) {
+                /* Small scalars, which use few chunks of the tables */
+                memset(scalar[i], 0, 32);
+                scalar[i][31] = secp256k1_testrand_int(256);
+            } else {
+                random_scalar_order(&s);
+                secp256k1_scalar_get_b32(scalar[i], &s);
+            }
+        }
+        secp256k1_testrand256(g_scalar);
+        CHECK(secp256k1_ecmult_multi(ctx, NULL, &expected, g_scalar, pks, scalars, n) == 1);
+        CHECK(secp256k1_ecmult_multi_with_precomp(ctx, &result, g_scalar, precomp, scalars) == 1);
+        CHECK(secp256k1_ec_pubkey_cmp(ctx, &result, &expected) == 0);
+        CHECK(secp256k1_ecmult_multi_with_precomp(ctx, &result, g_scalar, precomp2, scalars) == 1);
+        CHECK(secp256k1_ec_pubkey_cmp(ctx, &result, &expected) == 0);
+    }
+
+    free(ser);
+    secp256k1_ecmult_multi_precomp_destroy(ctx, precomp);
+    secp256k1_ecmult_multi_precomp_destroy(ctx, precomp2);
+}
+#undef N_POINTS
+
+void run_ecmult_module_tests(void) {
+    int i;
+
+    test_ecmult_module_api();
+    test_ecmult_module_scratch_size();
+    test_ecmult_module_precomp_api();
+    for (i = 0; i < count; i++) {
+        test_ecmult_module_random();
+        test_ecmult_module_precomp_parse();
+        test_ecmult_module_precomp_random();
+    }
+}
+
+#endif /* SECP256K1_MODULE_ECMULT_TESTS_H */
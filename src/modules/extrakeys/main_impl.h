@@ -9,6 +9,7 @@
 
 #include "../../../include/secp256k1.h"
 #include "../../../include/secp256k1_extrakeys.h"
+#include "../../batch_verify.h"
 
 static SECP256K1_INLINE int secp256k1_xonly_pubkey_load(const secp256k1_context* ctx, secp256k1_ge *ge, const secp256k1_xonly_pubkey *pubkey) {
     return secp256k1_pubkey_load(ctx, ge, (const secp256k1_pubkey *) pubkey);
@@ -40,6 +41,39 @@ int secp256k1_xonly_pubkey_parse(const secp256k1_context* ctx, secp256k1_xonly_p
     return 1;
 }
 
+int secp256k1_xonly_pubkey_parse_cached(const secp256k1_context* ctx, secp256k1_pubkey_cache *cache, secp256k1_xonly_pubkey *pubkey, const unsigned char *input32, int store) {
+    secp256k1_ge pk;
+    secp256k1_fe x;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(cache != NULL);
+    ARG_CHECK(pubkey != NULL);
+    memset(pubkey, 0, sizeof(*pubkey));
+    ARG_CHECK(input32 != NULL);
+
+    if (!secp256k1_fe_set_b32(&x, input32)) {
+        return 0;
+    }
+    if (secp256k1_pubkey_cache_lookup(cache, &pk, &x)) {
+        secp256k1_fe_normalize_var(&pk.y);
+        if (secp256k1_fe_is_odd(&pk.y)) {
+            secp256k1_ge_neg(&pk, &pk);
+        }
+    } else {
+        if (!secp256k1_ge_set_xo_var(&pk, &x, 0)) {
+            return 0;
+        }
+        if (!secp256k1_ge_is_in_correct_subgroup(&pk)) {
+            return 0;
+        }
+        if (store) {
+            secp256k1_pubkey_cache_insert(cache, &pk);
+        }
+    }
+    secp256k1_xonly_pubkey_save(pubkey, &pk);
+    return 1;
+}
+
 int secp256k1_xonly_pubkey_serialize(const secp256k1_context* ctx, unsigned char *output32, const secp256k1_xonly_pubkey *pubkey) {
     secp256k1_ge pk;
 
@@ -152,6 +186,137 @@ int secp256k1_xonly_pubkey_tweak_add_check(const secp256k1_context* ctx, const u
             && secp256k1_fe_is_odd(&pk.y) == tweaked_pk_parity;
 }
 
+/* Tag of the hash that commits to all inputs of a batch to derive the
+ * randomizers. */
+static const unsigned char xonly_pubkey_tweak_batch_tag[25] = "extrakeys/tweak_add_batch";
+
+typedef struct {
+    secp256k1_batch_verify_state batch;
+    const unsigned char * const *tweaked_pubkey32;
+    const int *tweaked_pk_parity;
+    const secp256k1_xonly_pubkey * const *internal_pubkey;
+    const unsigned char * const *tweak32;
+} secp256k1_xonly_pubkey_tweak_add_check_batch_data;
+
+/* Returns the points P_i and Q_i of the i-th tweak in the current range with
+ * scalars a_i and -a_i respectively, where a_i is its randomizer. Q_i is
+ * lifted from its x coordinate with the claimed parity, so a wrong parity
+ * makes the batch equation fail. */
+static int secp256k1_xonly_pubkey_tweak_add_check_batch_ecmult_callback(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *cbdata) {
+    secp256k1_xonly_pubkey_tweak_add_check_batch_data *data = (secp256k1_xonly_pubkey_tweak_add_check_batch_data *) cbdata;
+    size_t i = data->batch.offset + idx / 2;
+
+    secp256k1_batch_verify_state_randomizer(sc, &data->batch, i);
+    if (idx % 2 == 0) {
+        return secp256k1_xonly_pubkey_load(data->batch.ctx, pt, data->internal_pubkey[i]);
+    } else {
+        secp256k1_fe x;
+        if (!secp256k1_fe_set_b32(&x, data->tweaked_pubkey32[i])
+            || !secp256k1_ge_set_xo_var(pt, &x, data->tweaked_pk_parity[i])) {
+            return 0;
+        }
+        secp256k1_scalar_negate(sc, sc);
+        return 1;
+    }
+}
+
+/* Checks the randomized batch equation
+ *   (sum a_i*t_i)*G + sum a_i*P_i - sum a_i*Q_i = 0
+ * for the tweaks in [offset, offset + n). */
+static int secp256k1_xonly_pubkey_tweak_add_check_batch_range(size_t offset, size_t n, void *cbdata) {
+    secp256k1_xonly_pubkey_tweak_add_check_batch_data *data = (secp256k1_xonly_pubkey_tweak_add_check_batch_data *) cbdata;
+    secp256k1_scalar t_sum = secp256k1_scalar_zero;
+    secp256k1_gej rj;
+    size_t i;
+
+    for (i = offset; i < offset + n; i++) {
+        secp256k1_scalar t, a;
+        int overflow;
+
+        if (data->tweaked_pk_parity[i] != 0 && data->tweaked_pk_parity[i] != 1) {
+            return 0;
+        }
+        secp256k1_scalar_set_b32(&t, data->tweak32[i], &overflow);
+        if (overflow) {
+            return 0;
+        }
+        secp256k1_batch_verify_state_randomizer(&a, &data->batch, i);
+        secp256k1_scalar_mul(&t, &t, &a);
+        secp256k1_scalar_add(&t_sum, &t_sum, &t);
+    }
+
+    data->batch.offset = offset;
+    if (!secp256k1_ecmult_multi_var(data->batch.error_callback, data->batch.scratch, &rj, &t_sum, secp256k1_xonly_pubkey_tweak_add_check_batch_ecmult_callback, data, 2 * n)) {
+        return 0;
+    }
+    return secp256k1_gej_is_infinity(&rj);
+}
+
+int secp256k1_xonly_pubkey_tweak_add_check_batch(const secp256k1_context* ctx, secp256k1_scratch_space *scratch, int *valid, const unsigned char * const *tweaked_pubkey32, const int *tweaked_pk_parity, const secp256k1_xonly_pubkey * const *internal_pubkey, const unsigned char * const *tweak32, size_t n) {
+    secp256k1_xonly_pubkey_tweak_add_check_batch_data data;
+    secp256k1_sha256 sha;
+    unsigned char seed[32];
+    size_t i;
+    int ret;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(scratch != NULL);
+    ARG_CHECK(n <= SIZE_MAX / 2);
+    if (valid != NULL) {
+        memset(valid, 0, n * sizeof(*valid));
+    }
+    ARG_CHECK(n == 0 || tweaked_pubkey32 != NULL);
+    ARG_CHECK(n == 0 || tweaked_pk_parity != NULL);
+    ARG_CHECK(n == 0 || internal_pubkey != NULL);
+    ARG_CHECK(n == 0 || tweak32 != NULL);
+
+    if (n == 0) {
+        return 1;
+    }
+
+    /* The randomizers are derived from a hash of all inputs, so they can't be
+     * predicted by anyone choosing the tweaks. */
+    secp256k1_sha256_initialize_tagged(&sha, xonly_pubkey_tweak_batch_tag, sizeof(xonly_pubkey_tweak_batch_tag));
+    for (i = 0; i < n; i++) {
+        secp256k1_ge pk;
+        unsigned char buf[32];
+        unsigned char parity;
+
+        ARG_CHECK(tweaked_pubkey32[i] != NULL);
+        ARG_CHECK(internal_pubkey[i] != NULL);
+        ARG_CHECK(tweak32[i] != NULL);
+        if (!secp256k1_xonly_pubkey_load(ctx, &pk, internal_pubkey[i])) {
+            return 0;
+        }
+        secp256k1_fe_get_b32(buf, &pk.x);
+        parity = tweaked_pk_parity[i] != 0;
+        secp256k1_sha256_write(&sha, tweaked_pubkey32[i], 32);
+        secp256k1_sha256_write(&sha, &parity, 1);
+        secp256k1_sha256_write(&sha, buf, sizeof(buf));
+        secp256k1_sha256_write(&sha, tweak32[i], 32);
+    }
+    secp256k1_sha256_finalize(&sha, seed);
+
+    secp256k1_batch_verify_state_init(&data.batch, ctx, &ctx->error_callback, scratch, seed, n);
+    data.tweaked_pubkey32 = tweaked_pubkey32;
+    data.tweaked_pk_parity = tweaked_pk_parity;
+    data.internal_pubkey = internal_pubkey;
+    data.tweak32 = tweak32;
+
+    ret = secp256k1_xonly_pubkey_tweak_add_check_batch_range(0, n, &data);
+    if (valid != NULL) {
+        if (ret) {
+            for (i = 0; i < n; i++) {
+                valid[i] = 1;
+            }
+        } else {
+            secp256k1_batch_verify_find_invalid(valid, n, secp256k1_xonly_pubkey_tweak_add_check_batch_range, &data);
+        }
+    }
+    secp256k1_batch_verify_state_clear(&data.batch);
+    return ret;
+}
+
 static void secp256k1_keypair_save(secp256k1_keypair *keypair, const secp256k1_scalar *sk, secp256k1_ge *pk) {
     secp256k1_scalar_get_b32(&keypair->data[0], sk);
     secp256k1_pubkey_save((secp256k1_pubkey *)&keypair->data[32], pk);
@@ -210,6 +375,39 @@ int secp256k1_keypair_create(const secp256k1_context* ctx, secp256k1_keypair *ke
     return ret;
 }
 
+int secp256k1_keypair_create_batch(const secp256k1_context* ctx, secp256k1_keypair *keypairs, const unsigned char * const *seckeys, size_t n) {
+    secp256k1_scalar sk[PUBKEY_CREATE_BATCH_SIZE];
+    secp256k1_ge pk[PUBKEY_CREATE_BATCH_SIZE];
+    int rets[PUBKEY_CREATE_BATCH_SIZE];
+    int ret = 1;
+    size_t i, j;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(n == 0 || keypairs != NULL);
+    if (n > 0) {
+        memset(keypairs, 0, n * sizeof(*keypairs));
+    }
+    ARG_CHECK(secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(n == 0 || seckeys != NULL);
+    for (i = 0; i < n; i++) {
+        ARG_CHECK(seckeys[i] != NULL);
+    }
+
+    for (i = 0; i < n; i += PUBKEY_CREATE_BATCH_SIZE) {
+        size_t batch = n - i < PUBKEY_CREATE_BATCH_SIZE ? n - i : PUBKEY_CREATE_BATCH_SIZE;
+        secp256k1_ec_pubkey_create_batch_helper(&ctx->ecmult_gen_ctx, sk, pk, rets, &seckeys[i], batch);
+        for (j = 0; j < batch; j++) {
+            secp256k1_keypair_save(&keypairs[i + j], &sk[j], &pk[j]);
+            secp256k1_memczero(&keypairs[i + j], sizeof(keypairs[i + j]), !rets[j]);
+            ret &= rets[j];
+        }
+    }
+
+    for (j = 0; j < PUBKEY_CREATE_BATCH_SIZE; j++) {
+        secp256k1_scalar_clear(&sk[j]);
+    }
+    return ret;
+}
+
 int secp256k1_keypair_sec(const secp256k1_context* ctx, unsigned char *seckey, const secp256k1_keypair *keypair) {
     VERIFY_CHECK(ctx != NULL);
     ARG_CHECK(seckey != NULL);
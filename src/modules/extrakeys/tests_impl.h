@@ -174,6 +174,51 @@ void test_xonly_pubkey_comparison(void) {
     secp256k1_context_destroy(none);
 }
 
+void test_xonly_pubkey_parse_cached(void) {
+    secp256k1_pubkey_cache *cache;
+    secp256k1_xonly_pubkey xonly_pk, xonly_pk_cached;
+    secp256k1_pubkey pk, pk_cached;
+    unsigned char salt[32];
+    unsigned char sk[32];
+    unsigned char buf33[33];
+    size_t len = 33;
+    int i;
+    int ecount = 0;
+    secp256k1_context *none = api_test_context(SECP256K1_CONTEXT_NONE, &ecount);
+
+    secp256k1_testrand256(salt);
+    cache = secp256k1_pubkey_cache_create(none, 4096, salt);
+    CHECK(cache != NULL);
+    for (i = 0; i < 16; i++) {
+        secp256k1_testrand256(sk);
+        CHECK(secp256k1_ec_pubkey_create(ctx, &pk, sk) == 1);
+        CHECK(secp256k1_ec_pubkey_serialize(ctx, buf33, &len, &pk, SECP256K1_EC_COMPRESSED) == 1);
+        CHECK(secp256k1_xonly_pubkey_parse(none, &xonly_pk, &buf33[1]) == 1);
+        /* The cache is shared with ec_pubkey_parse_cached, and the result
+         * has an even Y coordinate regardless of the cached point. */
+        if (i % 2 == 0) {
+            CHECK(secp256k1_ec_pubkey_parse_cached(none, cache, &pk_cached, buf33, 33, 1) == 1);
+        } else {
+            CHECK(secp256k1_xonly_pubkey_parse_cached(none, cache, &xonly_pk_cached, &buf33[1], 1) == 1);
+            CHECK(secp256k1_xonly_pubkey_cmp(none, &xonly_pk, &xonly_pk_cached) == 0);
+        }
+        CHECK(secp256k1_xonly_pubkey_parse_cached(none, cache, &xonly_pk_cached, &buf33[1], 0) == 1);
+        CHECK(secp256k1_memcmp_var(&xonly_pk, &xonly_pk_cached, sizeof(xonly_pk)) == 0);
+    }
+    memset(buf33, 0xFF, sizeof(buf33));
+    CHECK(secp256k1_xonly_pubkey_parse_cached(none, cache, &xonly_pk_cached, &buf33[1], 1) == 0);
+    CHECK(ecount == 0);
+    CHECK(secp256k1_xonly_pubkey_parse_cached(none, NULL, &xonly_pk_cached, &buf33[1], 1) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_xonly_pubkey_parse_cached(none, cache, NULL, &buf33[1], 1) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_xonly_pubkey_parse_cached(none, cache, &xonly_pk_cached, NULL, 1) == 0);
+    CHECK(ecount == 3);
+
+    secp256k1_pubkey_cache_destroy(none, cache);
+    secp256k1_context_destroy(none);
+}
+
 void test_xonly_pubkey_tweak(void) {
     unsigned char zeros64[64] = { 0 };
     unsigned char overflows[32];
@@ -258,6 +303,11 @@ void test_xonly_pubkey_tweak_check(void) {
     unsigned char buf32[32];
     int pk_parity;
     unsigned char tweak[32];
+    secp256k1_scratch_space *scratch;
+    const unsigned char *tweaked_pks[1];
+    const secp256k1_xonly_pubkey *internal_pks[1];
+    const unsigned char *tweaks[1];
+    int valid[1];
 
     int ecount;
     secp256k1_context *none = api_test_context(SECP256K1_CONTEXT_NONE, &ecount);
@@ -308,6 +358,38 @@ void test_xonly_pubkey_tweak_check(void) {
     CHECK(secp256k1_memcmp_var(&output_pk, zeros64, sizeof(output_pk)) == 0);
     CHECK(ecount == 3);
 
+    /* Batch checking */
+    scratch = secp256k1_scratch_space_create(none, 4096);
+    tweaked_pks[0] = output_pk32;
+    internal_pks[0] = &internal_xonly_pk;
+    tweaks[0] = tweak;
+    ecount = 0;
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(none, scratch, valid, tweaked_pks, &pk_parity, internal_pks, tweaks, 1) == 1);
+    CHECK(valid[0] == 1);
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(none, scratch, NULL, tweaked_pks, &pk_parity, internal_pks, tweaks, 1) == 1);
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(none, scratch, valid, NULL, NULL, NULL, NULL, 0) == 1);
+    CHECK(ecount == 0);
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(none, NULL, valid, tweaked_pks, &pk_parity, internal_pks, tweaks, 1) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(none, scratch, valid, NULL, &pk_parity, internal_pks, tweaks, 1) == 0);
+    CHECK(ecount == 2);
+    CHECK(valid[0] == 0);
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(none, scratch, valid, tweaked_pks, NULL, internal_pks, tweaks, 1) == 0);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(none, scratch, valid, tweaked_pks, &pk_parity, NULL, tweaks, 1) == 0);
+    CHECK(ecount == 4);
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(none, scratch, valid, tweaked_pks, &pk_parity, internal_pks, NULL, 1) == 0);
+    CHECK(ecount == 5);
+    tweaks[0] = NULL;
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(none, scratch, valid, tweaked_pks, &pk_parity, internal_pks, tweaks, 1) == 0);
+    CHECK(ecount == 6);
+    tweaks[0] = tweak;
+    /* invalid pk_parity value */
+    pk_parity = 2;
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(none, scratch, valid, tweaked_pks, &pk_parity, internal_pks, tweaks, 1) == 0);
+    CHECK(ecount == 6);
+    secp256k1_scratch_space_destroy(none, scratch);
+
     secp256k1_context_destroy(none);
     secp256k1_context_destroy(sign);
     secp256k1_context_destroy(verify);
@@ -346,6 +428,102 @@ void test_xonly_pubkey_tweak_recursive(void) {
 }
 #undef N_PUBKEYS
 
+#define N_TWEAKS 150
+void test_xonly_pubkey_tweak_check_batch(void) {
+    static unsigned char tweaked_pk32[N_TWEAKS][32];
+    static int pk_parity[N_TWEAKS];
+    static secp256k1_xonly_pubkey internal_pk[N_TWEAKS];
+    static unsigned char tweak[N_TWEAKS][32];
+    const unsigned char *tweaked_pks[N_TWEAKS];
+    const secp256k1_xonly_pubkey *internal_pks[N_TWEAKS];
+    const unsigned char *tweaks[N_TWEAKS];
+    int valid[N_TWEAKS];
+    int expected[N_TWEAKS];
+    /* Sizes that result in Strauss, Pippenger with batching, and Pippenger
+     * without batching (for at least 44 tweaks) */
+    size_t scratch_sizes[3] = { 4096, 32768, 1 << 20 };
+    size_t i, j;
+
+    for (i = 0; i < N_TWEAKS; i++) {
+        secp256k1_pubkey output_pk;
+        secp256k1_xonly_pubkey output_xonly_pk;
+        unsigned char sk[32];
+
+        secp256k1_testrand256(sk);
+        secp256k1_testrand256(tweak[i]);
+        CHECK(secp256k1_ec_pubkey_create(ctx, &output_pk, sk) == 1);
+        CHECK(secp256k1_xonly_pubkey_from_pubkey(ctx, &internal_pk[i], NULL, &output_pk) == 1);
+        CHECK(secp256k1_xonly_pubkey_tweak_add(ctx, &output_pk, &internal_pk[i], tweak[i]) == 1);
+        CHECK(secp256k1_xonly_pubkey_from_pubkey(ctx, &output_xonly_pk, &pk_parity[i], &output_pk) == 1);
+        CHECK(secp256k1_xonly_pubkey_serialize(ctx, tweaked_pk32[i], &output_xonly_pk) == 1);
+        tweaked_pks[i] = tweaked_pk32[i];
+        internal_pks[i] = &internal_pk[i];
+        tweaks[i] = tweak[i];
+    }
+
+    for (j = 0; j < sizeof(scratch_sizes)/sizeof(scratch_sizes[0]); j++) {
+        secp256k1_scratch_space *scratch = secp256k1_scratch_space_create(ctx, scratch_sizes[j]);
+        size_t n = 1 + secp256k1_testrand_int(N_TWEAKS);
+        size_t n_invalid = secp256k1_testrand_int(4);
+        int all_valid = 1;
+
+        CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(ctx, scratch, valid, tweaked_pks, pk_parity, internal_pks, tweaks, n) == 1);
+        for (i = 0; i < n; i++) {
+            CHECK(valid[i] == 1);
+        }
+
+        /* Invalidate up to 3 random items in different ways. */
+        for (i = 0; i < n_invalid; i++) {
+            size_t idx = secp256k1_testrand_int(n);
+            switch (secp256k1_testrand_int(5)) {
+            case 0:
+                pk_parity[idx] = !pk_parity[idx];
+                break;
+            case 1:
+                /* The tweaked pubkey is (most likely) not on the curve or a
+                 * different point */
+                tweaked_pk32[idx][secp256k1_testrand_int(32)] ^= 1 + secp256k1_testrand_int(255);
+                break;
+            case 2:
+                tweak[idx][secp256k1_testrand_int(32)] ^= 1 + secp256k1_testrand_int(255);
+                break;
+            case 3:
+                /* tweak overflows */
+                memset(tweak[idx], 0xFF, 32);
+                break;
+            case 4:
+                /* different internal key */
+                internal_pks[idx] = &internal_pk[(idx + 1) % N_TWEAKS];
+                break;
+            }
+        }
+        for (i = 0; i < n; i++) {
+            expected[i] = secp256k1_xonly_pubkey_tweak_add_check(ctx, tweaked_pks[i], pk_parity[i], internal_pks[i], tweaks[i]);
+            all_valid &= expected[i];
+        }
+        CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(ctx, scratch, NULL, tweaked_pks, pk_parity, internal_pks, tweaks, n) == all_valid);
+        CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(ctx, scratch, valid, tweaked_pks, pk_parity, internal_pks, tweaks, n) == all_valid);
+        for (i = 0; i < n; i++) {
+            CHECK(valid[i] == expected[i]);
+        }
+
+        /* Restore the batch */
+        for (i = 0; i < n; i++) {
+            if (!expected[i]) {
+                secp256k1_pubkey output_pk;
+                secp256k1_xonly_pubkey output_xonly_pk;
+                secp256k1_testrand256(tweak[i]);
+                internal_pks[i] = &internal_pk[i];
+                CHECK(secp256k1_xonly_pubkey_tweak_add(ctx, &output_pk, &internal_pk[i], tweak[i]) == 1);
+                CHECK(secp256k1_xonly_pubkey_from_pubkey(ctx, &output_xonly_pk, &pk_parity[i], &output_pk) == 1);
+                CHECK(secp256k1_xonly_pubkey_serialize(ctx, tweaked_pk32[i], &output_xonly_pk) == 1);
+            }
+        }
+        secp256k1_scratch_space_destroy(ctx, scratch);
+    }
+}
+#undef N_TWEAKS
+
 void test_keypair(void) {
     unsigned char sk[32];
     unsigned char sk_tmp[32];
@@ -469,6 +647,42 @@ void test_keypair(void) {
     secp256k1_context_destroy(sttc);
 }
 
+void test_keypair_create_batch(void) {
+    unsigned char sk[3][32];
+    const unsigned char *seckeys[3];
+    unsigned char zeros96[96] = { 0 };
+    secp256k1_keypair keypairs[3];
+    secp256k1_keypair keypair;
+    int i;
+    int ecount = 0;
+    secp256k1_context *none = api_test_context(SECP256K1_CONTEXT_NONE, &ecount);
+
+    for (i = 0; i < 3; i++) {
+        secp256k1_testrand256(sk[i]);
+        seckeys[i] = sk[i];
+    }
+    CHECK(secp256k1_keypair_create_batch(none, keypairs, seckeys, 3) == 1);
+    for (i = 0; i < 3; i++) {
+        CHECK(secp256k1_keypair_create(none, &keypair, sk[i]) == 1);
+        CHECK(secp256k1_memcmp_var(&keypair, &keypairs[i], sizeof(keypair)) == 0);
+    }
+    memset(sk[1], 0xFF, 32);
+    CHECK(secp256k1_keypair_create_batch(none, keypairs, seckeys, 3) == 0);
+    CHECK(secp256k1_memcmp_var(zeros96, &keypairs[1], sizeof(keypair)) == 0);
+    CHECK(secp256k1_keypair_create(none, &keypair, sk[2]) == 1);
+    CHECK(secp256k1_memcmp_var(&keypair, &keypairs[2], sizeof(keypair)) == 0);
+    CHECK(ecount == 0);
+
+    CHECK(secp256k1_keypair_create_batch(none, NULL, NULL, 0) == 1);
+    CHECK(secp256k1_keypair_create_batch(none, NULL, seckeys, 3) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_keypair_create_batch(none, keypairs, NULL, 3) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_memcmp_var(zeros96, &keypairs[0], sizeof(keypair)) == 0);
+
+    secp256k1_context_destroy(none);
+}
+
 void test_keypair_add(void) {
     unsigned char sk[32];
     secp256k1_keypair keypair;
@@ -580,15 +794,22 @@ void test_keypair_add(void) {
 }
 
 void run_extrakeys_tests(void) {
+    int i;
+
     /* xonly key test cases */
     test_xonly_pubkey();
     test_xonly_pubkey_tweak();
     test_xonly_pubkey_tweak_check();
     test_xonly_pubkey_tweak_recursive();
     test_xonly_pubkey_comparison();
+    test_xonly_pubkey_parse_cached();
+    for (i = 0; i < count / 8 + 1; i++) {
+        test_xonly_pubkey_tweak_check_batch();
+    }
 
     /* keypair tests */
     test_keypair();
+    test_keypair_create_batch();
     test_keypair_add();
 }
 
@@ -48,14 +48,71 @@ void bench_recover_setup(void* arg) {
     }
 }
 
+typedef struct {
+    secp256k1_context *ctx;
+    secp256k1_scratch_space *scratch;
+    secp256k1_ecdsa_recoverable_signature *sigs;
+    unsigned char (*msgs)[32];
+    secp256k1_pubkey *pks;
+    const secp256k1_ecdsa_recoverable_signature **sig_ptrs;
+    const unsigned char **msg_ptrs;
+    const secp256k1_pubkey **pk_ptrs;
+} bench_recover_batch_data;
+
+void bench_recover_verify_batch(void* arg, int iters) {
+    bench_recover_batch_data *data = (bench_recover_batch_data*)arg;
+
+    CHECK(secp256k1_ecdsa_recoverable_verify_batch(data->ctx, data->scratch, NULL, data->sig_ptrs, data->msg_ptrs, data->pk_ptrs, iters));
+}
+
 void run_recovery_bench(int iters, int argc, char** argv) {
     bench_recover_data data;
+    bench_recover_batch_data batch_data;
     int d = argc == 1;
+    int i;
 
     data.ctx = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY);
 
     if (d || have_flag(argc, argv, "ecdsa") || have_flag(argc, argv, "recover") || have_flag(argc, argv, "ecdsa_recover")) run_benchmark("ecdsa_recover", bench_recover, bench_recover_setup, NULL, &data, 10, iters);
 
+    if (d || have_flag(argc, argv, "ecdsa") || have_flag(argc, argv, "recover") || have_flag(argc, argv, "ecdsa_recoverable_verify_batch")) {
+        batch_data.ctx = data.ctx;
+        batch_data.sigs = (secp256k1_ecdsa_recoverable_signature *)malloc(iters * sizeof(*batch_data.sigs));
+        batch_data.msgs = (unsigned char (*)[32])malloc(iters * sizeof(*batch_data.msgs));
+        batch_data.pks = (secp256k1_pubkey *)malloc(iters * sizeof(*batch_data.pks));
+        batch_data.sig_ptrs = (const secp256k1_ecdsa_recoverable_signature **)malloc(iters * sizeof(*batch_data.sig_ptrs));
+        batch_data.msg_ptrs = (const unsigned char **)malloc(iters * sizeof(*batch_data.msg_ptrs));
+        batch_data.pk_ptrs = (const secp256k1_pubkey **)malloc(iters * sizeof(*batch_data.pk_ptrs));
+        /* Large enough to verify the whole batch with a single Pippenger run. */
+        batch_data.scratch = secp256k1_scratch_space_create(data.ctx, (size_t)iters * 1024);
+        for (i = 0; i < iters; i++) {
+            unsigned char sk[32];
+            memset(sk, 's', 28);
+            sk[28] = i >> 24;
+            sk[29] = i >> 16;
+            sk[30] = i >> 8;
+            sk[31] = i;
+            memset(batch_data.msgs[i], 'm', 32);
+            memcpy(batch_data.msgs[i], sk + 28, 4);
+            CHECK(secp256k1_ec_pubkey_create(data.ctx, &batch_data.pks[i], sk));
+            CHECK(secp256k1_ecdsa_sign_recoverable(data.ctx, &batch_data.sigs[i], batch_data.msgs[i], sk, NULL, NULL));
+            batch_data.sig_ptrs[i] = &batch_data.sigs[i];
+            batch_data.msg_ptrs[i] = batch_data.msgs[i];
+            batch_data.pk_ptrs[i] = &batch_data.pks[i];
+        }
+
+        run_benchmark("ecdsa_recoverable_verify_batch", bench_recover_verify_batch, NULL, NULL, &batch_data, 10, iters);
+
+        secp256k1_scratch_space_destroy(data.ctx, batch_data.scratch);
+        free(batch_data.sigs);
+        free(batch_data.msgs);
+        free(batch_data.pks);
+        /* Casting to (void *) avoids a stupid warning in MSVC. */
+        free((void *)batch_data.sig_ptrs);
+        free((void *)batch_data.msg_ptrs);
+        free((void *)batch_data.pk_ptrs);
+    }
+
     secp256k1_context_destroy(data.ctx);
 }
 
@@ -8,6 +8,7 @@
 #define SECP256K1_MODULE_RECOVERY_MAIN_H
 
 #include "../../../include/secp256k1_recovery.h"
+#include "../../batch_verify.h"
 
 static void secp256k1_ecdsa_recoverable_signature_load(const secp256k1_context* ctx, secp256k1_scalar* r, secp256k1_scalar* s, int* recid, const secp256k1_ecdsa_recoverable_signature* sig) {
     (void)ctx;
@@ -84,19 +85,12 @@ int secp256k1_ecdsa_recoverable_signature_convert(const secp256k1_context* ctx,
     return 1;
 }
 
-static int secp256k1_ecdsa_sig_recover(const secp256k1_scalar *sigr, const secp256k1_scalar* sigs, secp256k1_ge *pubkey, const secp256k1_scalar *message, int recid) {
+/* Reconstructs the nonce point R of a signature from sigr and recid. */
+static int secp256k1_ecdsa_sig_recover_nonce(secp256k1_ge *x, const secp256k1_scalar *sigr, int recid) {
     unsigned char brx[32];
     secp256k1_fe fx;
-    secp256k1_ge x;
-    secp256k1_gej xj;
-    secp256k1_scalar rn, u1, u2;
-    secp256k1_gej qj;
     int r;
 
-    if (secp256k1_scalar_is_zero(sigr) || secp256k1_scalar_is_zero(sigs)) {
-        return 0;
-    }
-
     secp256k1_scalar_get_b32(brx, sigr);
     r = secp256k1_fe_set_b32(&fx, brx);
     (void)r;
@@ -107,7 +101,20 @@ static int secp256k1_ecdsa_sig_recover(const secp256k1_scalar *sigr, const secp2
         }
         secp256k1_fe_add(&fx, &secp256k1_ecdsa_const_order_as_fe);
     }
-    if (!secp256k1_ge_set_xo_var(&x, &fx, recid & 1)) {
+    return secp256k1_ge_set_xo_var(x, &fx, recid & 1);
+}
+
+static int secp256k1_ecdsa_sig_recover(const secp256k1_scalar *sigr, const secp256k1_scalar* sigs, secp256k1_ge *pubkey, const secp256k1_scalar *message, int recid) {
+    secp256k1_ge x;
+    secp256k1_gej xj;
+    secp256k1_scalar rn, u1, u2;
+    secp256k1_gej qj;
+
+    if (secp256k1_scalar_is_zero(sigr) || secp256k1_scalar_is_zero(sigs)) {
+        return 0;
+    }
+
+    if (!secp256k1_ecdsa_sig_recover_nonce(&x, sigr, recid)) {
         return 0;
     }
     secp256k1_gej_set_ge(&xj, &x);
@@ -156,4 +163,141 @@ int secp256k1_ecdsa_recover(const secp256k1_context* ctx, secp256k1_pubkey *pubk
     }
 }
 
+/* Tag of the hash that commits to all inputs of a batch to derive the
+ * randomizers. */
+static const unsigned char ecdsa_recoverable_batch_tag[23] = "ECDSA/recoverable_batch";
+
+typedef struct {
+    secp256k1_batch_verify_state batch;
+    const secp256k1_ecdsa_recoverable_signature * const *sigs;
+    const unsigned char * const *msghash32;
+    const secp256k1_pubkey * const *pubkeys;
+} secp256k1_ecdsa_recoverable_verify_batch_data;
+
+/* Returns the points R_i and Q_i of the i-th signature in the current range
+ * with scalars -a_i*s_i and a_i*r_i respectively, where a_i is its
+ * randomizer. */
+static int secp256k1_ecdsa_recoverable_verify_batch_ecmult_callback(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *cbdata) {
+    secp256k1_ecdsa_recoverable_verify_batch_data *data = (secp256k1_ecdsa_recoverable_verify_batch_data *) cbdata;
+    size_t i = data->batch.offset + idx / 2;
+    secp256k1_scalar r, s, a;
+    int recid;
+
+    secp256k1_batch_verify_state_randomizer(&a, &data->batch, i);
+    secp256k1_ecdsa_recoverable_signature_load(data->batch.ctx, &r, &s, &recid, data->sigs[i]);
+    if (idx % 2 == 0) {
+        if (!secp256k1_ecdsa_sig_recover_nonce(pt, &r, recid)) {
+            return 0;
+        }
+        secp256k1_scalar_mul(sc, &a, &s);
+        secp256k1_scalar_negate(sc, sc);
+    } else {
+        if (!secp256k1_pubkey_load(data->batch.ctx, pt, data->pubkeys[i])) {
+            return 0;
+        }
+        secp256k1_scalar_mul(sc, &a, &r);
+    }
+    return 1;
+}
+
+/* A recoverable signature (r, s, recid) for message m recovers the public key
+ * Q if and only if s*R = m*G + r*Q, where R is the point reconstructed from r
+ * and recid. This function checks the randomized batch equation
+ *   (sum a_i*m_i)*G + sum a_i*r_i*Q_i - sum a_i*s_i*R_i = 0
+ * for the signatures in [offset, offset + n), which requires no scalar
+ * inversions. */
+static int secp256k1_ecdsa_recoverable_verify_batch_range(size_t offset, size_t n, void *cbdata) {
+    secp256k1_ecdsa_recoverable_verify_batch_data *data = (secp256k1_ecdsa_recoverable_verify_batch_data *) cbdata;
+    secp256k1_scalar m_sum = secp256k1_scalar_zero;
+    secp256k1_gej rj;
+    size_t i;
+
+    for (i = offset; i < offset + n; i++) {
+        secp256k1_scalar r, s, m, a;
+        int recid;
+
+        secp256k1_ecdsa_recoverable_signature_load(data->batch.ctx, &r, &s, &recid, data->sigs[i]);
+        if (secp256k1_scalar_is_zero(&r) || secp256k1_scalar_is_zero(&s)) {
+            return 0;
+        }
+        secp256k1_scalar_set_b32(&m, data->msghash32[i], NULL);
+        secp256k1_batch_verify_state_randomizer(&a, &data->batch, i);
+        secp256k1_scalar_mul(&m, &m, &a);
+        secp256k1_scalar_add(&m_sum, &m_sum, &m);
+    }
+
+    data->batch.offset = offset;
+    if (!secp256k1_ecmult_multi_var(data->batch.error_callback, data->batch.scratch, &rj, &m_sum, secp256k1_ecdsa_recoverable_verify_batch_ecmult_callback, data, 2 * n)) {
+        return 0;
+    }
+    return secp256k1_gej_is_infinity(&rj);
+}
+
+int secp256k1_ecdsa_recoverable_verify_batch(const secp256k1_context* ctx, secp256k1_scratch_space *scratch, int *valid, const secp256k1_ecdsa_recoverable_signature * const *sigs, const unsigned char * const *msghash32, const secp256k1_pubkey * const *pubkeys, size_t n_sigs) {
+    secp256k1_ecdsa_recoverable_verify_batch_data data;
+    secp256k1_sha256 sha;
+    unsigned char seed[32];
+    size_t i;
+    int ret;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(scratch != NULL);
+    ARG_CHECK(n_sigs <= SIZE_MAX / 2);
+    if (valid != NULL) {
+        memset(valid, 0, n_sigs * sizeof(*valid));
+    }
+    ARG_CHECK(n_sigs == 0 || sigs != NULL);
+    ARG_CHECK(n_sigs == 0 || msghash32 != NULL);
+    ARG_CHECK(n_sigs == 0 || pubkeys != NULL);
+
+    if (n_sigs == 0) {
+        return 1;
+    }
+
+    /* The randomizers are derived from a hash of all inputs, so they can't be
+     * predicted by anyone creating the signatures. */
+    secp256k1_sha256_initialize_tagged(&sha, ecdsa_recoverable_batch_tag, sizeof(ecdsa_recoverable_batch_tag));
+    for (i = 0; i < n_sigs; i++) {
+        secp256k1_scalar r, s;
+        secp256k1_ge q;
+        unsigned char buf[65];
+        size_t buflen = 33;
+        int recid;
+
+        ARG_CHECK(sigs[i] != NULL);
+        ARG_CHECK(msghash32[i] != NULL);
+        ARG_CHECK(pubkeys[i] != NULL);
+        if (!secp256k1_pubkey_load(ctx, &q, pubkeys[i])) {
+            return 0;
+        }
+        secp256k1_ecdsa_recoverable_signature_load(ctx, &r, &s, &recid, sigs[i]);
+        secp256k1_scalar_get_b32(&buf[0], &r);
+        secp256k1_scalar_get_b32(&buf[32], &s);
+        buf[64] = recid;
+        secp256k1_sha256_write(&sha, buf, 65);
+        secp256k1_sha256_write(&sha, msghash32[i], 32);
+        secp256k1_eckey_pubkey_serialize(&q, buf, &buflen, 1);
+        secp256k1_sha256_write(&sha, buf, buflen);
+    }
+    secp256k1_sha256_finalize(&sha, seed);
+
+    secp256k1_batch_verify_state_init(&data.batch, ctx, &ctx->error_callback, scratch, seed, n_sigs);
+    data.sigs = sigs;
+    data.msghash32 = msghash32;
+    data.pubkeys = pubkeys;
+
+    ret = secp256k1_ecdsa_recoverable_verify_batch_range(0, n_sigs, &data);
+    if (valid != NULL) {
+        if (ret) {
+            for (i = 0; i < n_sigs; i++) {
+                valid[i] = 1;
+            }
+        } else {
+            secp256k1_batch_verify_find_invalid(valid, n_sigs, secp256k1_ecdsa_recoverable_verify_batch_range, &data);
+        }
+    }
+    secp256k1_batch_verify_state_clear(&data.batch);
+    return ret;
+}
+
 #endif /* SECP256K1_MODULE_RECOVERY_MAIN_H */
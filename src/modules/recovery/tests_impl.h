@@ -112,6 +112,48 @@ void test_ecdsa_recovery_api(void) {
     CHECK(secp256k1_ecdsa_recover(both, &recpubkey, &recsig, NULL) == 0);
     CHECK(ecount == 3);
 
+    /* Check NULLs for batch verification */
+    {
+        secp256k1_scratch_space *scratch = secp256k1_scratch_space_create(both, 4096);
+        const secp256k1_ecdsa_recoverable_signature *sigs[1];
+        const unsigned char *msgs[1];
+        const secp256k1_pubkey *pks[1];
+        int valid[1];
+
+        sigs[0] = &recsig;
+        msgs[0] = message;
+        pks[0] = &recpubkey;
+        ecount = 0;
+        CHECK(secp256k1_ecdsa_recoverable_verify_batch(none, scratch, valid, sigs, msgs, pks, 1) == 1);
+        CHECK(valid[0] == 1);
+        CHECK(secp256k1_ecdsa_recoverable_verify_batch(none, scratch, NULL, sigs, msgs, pks, 1) == 1);
+        CHECK(secp256k1_ecdsa_recoverable_verify_batch(none, scratch, valid, NULL, NULL, NULL, 0) == 1);
+        CHECK(ecount == 0);
+        CHECK(secp256k1_ecdsa_recoverable_verify_batch(none, NULL, valid, sigs, msgs, pks, 1) == 0);
+        CHECK(ecount == 1);
+        CHECK(secp256k1_ecdsa_recoverable_verify_batch(none, scratch, valid, NULL, msgs, pks, 1) == 0);
+        CHECK(ecount == 2);
+        CHECK(valid[0] == 0);
+        CHECK(secp256k1_ecdsa_recoverable_verify_batch(none, scratch, valid, sigs, NULL, pks, 1) == 0);
+        CHECK(ecount == 3);
+        CHECK(secp256k1_ecdsa_recoverable_verify_batch(none, scratch, valid, sigs, msgs, NULL, 1) == 0);
+        CHECK(ecount == 4);
+        sigs[0] = NULL;
+        CHECK(secp256k1_ecdsa_recoverable_verify_batch(none, scratch, valid, sigs, msgs, pks, 1) == 0);
+        CHECK(ecount == 5);
+        sigs[0] = &recsig;
+        msgs[0] = NULL;
+        CHECK(secp256k1_ecdsa_recoverable_verify_batch(none, scratch, valid, sigs, msgs, pks, 1) == 0);
+        CHECK(ecount == 6);
+        msgs[0] = message;
+        pks[0] = NULL;
+        CHECK(secp256k1_ecdsa_recoverable_verify_batch(none, scratch, valid, sigs, msgs, pks, 1) == 0);
+        CHECK(ecount == 7);
+        CHECK(secp256k1_ecdsa_recoverable_verify_batch(none, scratch, valid, sigs, msgs, pks, SIZE_MAX) == 0);
+        CHECK(ecount == 8);
+        secp256k1_scratch_space_destroy(both, scratch);
+    }
+
     /* Check NULLs for conversion */
     CHECK(secp256k1_ecdsa_sign(both, &normal_sig, message, privkey, NULL, NULL) == 1);
     ecount = 0;
@@ -385,6 +427,108 @@ void test_ecdsa_recovery_edge_cases(void) {
     }
 }
 
+#define N_SIGS 150
+void test_ecdsa_recoverable_verify_batch(void) {
+    static secp256k1_ecdsa_recoverable_signature sig[N_SIGS];
+    static unsigned char msg[N_SIGS][32];
+    static secp256k1_pubkey pk[N_SIGS];
+    const secp256k1_ecdsa_recoverable_signature *sigs[N_SIGS];
+    const unsigned char *msgs[N_SIGS];
+    const secp256k1_pubkey *pks[N_SIGS];
+    int valid[N_SIGS];
+    int expected[N_SIGS];
+    /* Sizes that result in Strauss, Pippenger with batching, and Pippenger
+     * without batching (for at least 44 signatures) */
+    size_t scratch_sizes[3] = { 4096, 32768, 1 << 20 };
+    size_t i, j;
+
+    for (i = 0; i < N_SIGS; i++) {
+        unsigned char sk[32];
+        secp256k1_testrand256_test(sk);
+        secp256k1_testrand256(msg[i]);
+        if (!secp256k1_ec_pubkey_create(ctx, &pk[i], sk)) {
+            /* Invalid secret keys are very unlikely, but retry if so */
+            i--;
+            continue;
+        }
+        CHECK(secp256k1_ecdsa_sign_recoverable(ctx, &sig[i], msg[i], sk, NULL, NULL));
+        sigs[i] = &sig[i];
+        msgs[i] = msg[i];
+        pks[i] = &pk[i];
+    }
+
+    for (j = 0; j < sizeof(scratch_sizes)/sizeof(scratch_sizes[0]); j++) {
+        secp256k1_scratch_space *scratch = secp256k1_scratch_space_create(ctx, scratch_sizes[j]);
+        size_t n_sigs = 1 + secp256k1_testrand_int(N_SIGS);
+        size_t n_invalid = secp256k1_testrand_int(4);
+        int all_valid = 1;
+
+        CHECK(secp256k1_ecdsa_recoverable_verify_batch(ctx, scratch, valid, sigs, msgs, pks, n_sigs) == 1);
+        for (i = 0; i < n_sigs; i++) {
+            CHECK(valid[i] == 1);
+        }
+
+        /* Invalidate up to 3 random signatures in different ways. */
+        for (i = 0; i < n_invalid; i++) {
+            size_t idx = secp256k1_testrand_int(n_sigs);
+            unsigned char sig64[64];
+            int recid;
+            CHECK(secp256k1_ecdsa_recoverable_signature_serialize_compact(ctx, sig64, &recid, &sig[idx]));
+            switch (secp256k1_testrand_int(5)) {
+            case 0:
+                /* r is (most likely) not an x coordinate on the curve */
+                sig64[secp256k1_testrand_int(32)] ^= 1 + secp256k1_testrand_int(255);
+                break;
+            case 1:
+                sig64[32 + secp256k1_testrand_int(32)] ^= 1 + secp256k1_testrand_int(255);
+                break;
+            case 2:
+                /* flipping the parity of R recovers a different key */
+                recid ^= 1;
+                break;
+            case 3:
+                /* s is zero */
+                memset(&sig64[32], 0, 32);
+                break;
+            case 4:
+                /* different key */
+                pks[idx] = &pk[(idx + 1) % N_SIGS];
+                break;
+            }
+            if (!secp256k1_ecdsa_recoverable_signature_parse_compact(ctx, &sig[idx], sig64, recid)) {
+                /* The modified signature overflows, which is not our concern here */
+                memset(&sig[idx], 0, sizeof(sig[idx]));
+            }
+        }
+        for (i = 0; i < n_sigs; i++) {
+            secp256k1_pubkey recpk;
+            expected[i] = secp256k1_ecdsa_recover(ctx, &recpk, sigs[i], msgs[i]) &&
+                          secp256k1_ec_pubkey_cmp(ctx, &recpk, pks[i]) == 0;
+            all_valid &= expected[i];
+        }
+        CHECK(secp256k1_ecdsa_recoverable_verify_batch(ctx, scratch, NULL, sigs, msgs, pks, n_sigs) == all_valid);
+        CHECK(secp256k1_ecdsa_recoverable_verify_batch(ctx, scratch, valid, sigs, msgs, pks, n_sigs) == all_valid);
+        for (i = 0; i < n_sigs; i++) {
+            CHECK(valid[i] == expected[i]);
+        }
+
+        /* Restore the batch */
+        for (i = 0; i < n_sigs; i++) {
+            while (!expected[i]) {
+                unsigned char sk[32];
+                secp256k1_testrand256_test(sk);
+                expected[i] = secp256k1_ec_pubkey_create(ctx, &pk[i], sk);
+                if (expected[i]) {
+                    CHECK(secp256k1_ecdsa_sign_recoverable(ctx, &sig[i], msg[i], sk, NULL, NULL));
+                    pks[i] = &pk[i];
+                }
+            }
+        }
+        secp256k1_scratch_space_destroy(ctx, scratch);
+    }
+}
+#undef N_SIGS
+
 void run_recovery_tests(void) {
     int i;
     for (i = 0; i < count; i++) {
@@ -394,6 +538,9 @@ void run_recovery_tests(void) {
         test_ecdsa_recovery_end_to_end();
     }
     test_ecdsa_recovery_edge_cases();
+    for (i = 0; i < count / 8 + 1; i++) {
+        test_ecdsa_recoverable_verify_batch();
+    }
 }
 
 #endif /* SECP256K1_MODULE_RECOVERY_TESTS_H */
@@ -13,12 +13,18 @@
 
 typedef struct {
     secp256k1_context *ctx;
+    secp256k1_scratch_space *scratch;
     int n;
 
     const secp256k1_keypair **keypairs;
     const unsigned char **pk;
     const unsigned char **sigs;
     const unsigned char **msgs;
+    size_t *msglens;
+    secp256k1_xonly_pubkey *xonly_pks;
+    const secp256k1_xonly_pubkey **xonly_pk_ptrs;
+    int *results;
+    secp256k1_pubkey_precomp *precomp;
 } bench_schnorrsig_data;
 
 void bench_schnorrsig_sign(void* arg, int iters) {
@@ -45,6 +51,43 @@ void bench_schnorrsig_verify(void* arg, int iters) {
     }
 }
 
+void bench_schnorrsig_verify_precomp(void* arg, int iters) {
+    bench_schnorrsig_data *data = (bench_schnorrsig_data *)arg;
+    int i;
+
+    for (i = 0; i < iters; i++) {
+        CHECK(secp256k1_schnorrsig_verify_precomp(data->ctx, data->sigs[0], data->msgs[0], MSGLEN, data->precomp));
+    }
+}
+
+void bench_schnorrsig_verify_batch(void* arg, int iters) {
+    bench_schnorrsig_data *data = (bench_schnorrsig_data *)arg;
+    int i;
+
+    for (i = 0; i < iters; i++) {
+        CHECK(secp256k1_xonly_pubkey_parse(data->ctx, &data->xonly_pks[i], data->pk[i]) == 1);
+    }
+    CHECK(secp256k1_schnorrsig_verify_batch(data->ctx, data->scratch, NULL, data->sigs, data->msgs, data->msglens, data->xonly_pk_ptrs, iters));
+}
+
+void bench_schnorrsig_verify_many(void* arg, int iters) {
+    bench_schnorrsig_data *data = (bench_schnorrsig_data *)arg;
+    int i;
+
+    for (i = 0; i < iters; i++) {
+        CHECK(secp256k1_xonly_pubkey_parse(data->ctx, &data->xonly_pks[i], data->pk[i]) == 1);
+    }
+    CHECK(secp256k1_schnorrsig_verify_many(data->ctx, data->results, data->sigs, data->msgs, data->msglens, data->xonly_pk_ptrs, iters));
+}
+
+void bench_schnorrsig_sign_batch(void* arg, int iters) {
+    bench_schnorrsig_data *data = (bench_schnorrsig_data *)arg;
+
+    /* Overwrites the signatures, so this must run after the verification
+     * benchmarks. */
+    CHECK(secp256k1_schnorrsig_sign_batch(data->ctx, (unsigned char * const *)data->sigs, data->msgs, data->msglens, iters, data->keypairs[0], NULL));
+}
+
 void run_schnorrsig_bench(int iters, int argc, char** argv) {
     int i;
     bench_schnorrsig_data data;
@@ -55,6 +98,12 @@ void run_schnorrsig_bench(int iters, int argc, char** argv) {
     data.pk = (const unsigned char **)malloc(iters * sizeof(unsigned char *));
     data.msgs = (const unsigned char **)malloc(iters * sizeof(unsigned char *));
     data.sigs = (const unsigned char **)malloc(iters * sizeof(unsigned char *));
+    data.msglens = (size_t *)malloc(iters * sizeof(size_t));
+    data.xonly_pks = (secp256k1_xonly_pubkey *)malloc(iters * sizeof(secp256k1_xonly_pubkey));
+    data.xonly_pk_ptrs = (const secp256k1_xonly_pubkey **)malloc(iters * sizeof(secp256k1_xonly_pubkey *));
+    data.results = (int *)malloc(iters * sizeof(int));
+    /* Large enough to verify the whole batch with a single Pippenger run. */
+    data.scratch = secp256k1_scratch_space_create(data.ctx, (size_t)iters * 1024);
 
     CHECK(MSGLEN >= 4);
     for (i = 0; i < iters; i++) {
@@ -75,6 +124,8 @@ void run_schnorrsig_bench(int iters, int argc, char** argv) {
         data.pk[i] = pk_char;
         data.msgs[i] = msg;
         data.sigs[i] = sig;
+        data.msglens[i] = MSGLEN;
+        data.xonly_pk_ptrs[i] = &data.xonly_pks[i];
 
         CHECK(secp256k1_keypair_create(data.ctx, keypair, sk));
         CHECK(secp256k1_schnorrsig_sign_custom(data.ctx, sig, msg, MSGLEN, keypair, NULL));
@@ -84,6 +135,17 @@ void run_schnorrsig_bench(int iters, int argc, char** argv) {
 
     if (d || have_flag(argc, argv, "schnorrsig") || have_flag(argc, argv, "sign") || have_flag(argc, argv, "schnorrsig_sign")) run_benchmark("schnorrsig_sign", bench_schnorrsig_sign, NULL, NULL, (void *) &data, 10, iters);
     if (d || have_flag(argc, argv, "schnorrsig") || have_flag(argc, argv, "verify") || have_flag(argc, argv, "schnorrsig_verify")) run_benchmark("schnorrsig_verify", bench_schnorrsig_verify, NULL, NULL, (void *) &data, 10, iters);
+    if (d || have_flag(argc, argv, "schnorrsig") || have_flag(argc, argv, "verify") || have_flag(argc, argv, "schnorrsig_verify_many")) run_benchmark("schnorrsig_verify_many", bench_schnorrsig_verify_many, NULL, NULL, (void *) &data, 10, iters);
+    {
+        secp256k1_pubkey pubkey;
+        CHECK(secp256k1_keypair_pub(data.ctx, &pubkey, data.keypairs[0]));
+        data.precomp = secp256k1_pubkey_precomp_create(data.ctx, &pubkey);
+        CHECK(data.precomp != NULL);
+    }
+    if (d || have_flag(argc, argv, "schnorrsig") || have_flag(argc, argv, "verify") || have_flag(argc, argv, "schnorrsig_verify_precomp")) run_benchmark("schnorrsig_verify_precomp", bench_schnorrsig_verify_precomp, NULL, NULL, (void *) &data, 10, iters);
+    secp256k1_pubkey_precomp_destroy(data.ctx, data.precomp);
+    if (d || have_flag(argc, argv, "schnorrsig") || have_flag(argc, argv, "verify") || have_flag(argc, argv, "schnorrsig_verify_batch")) run_benchmark("schnorrsig_verify_batch", bench_schnorrsig_verify_batch, NULL, NULL, (void *) &data, 10, iters);
+    if (d || have_flag(argc, argv, "schnorrsig") || have_flag(argc, argv, "sign") || have_flag(argc, argv, "schnorrsig_sign_batch")) run_benchmark("schnorrsig_sign_batch", bench_schnorrsig_sign_batch, NULL, NULL, (void *) &data, 10, iters);
 
     for (i = 0; i < iters; i++) {
         free((void *)data.keypairs[i]);
@@ -97,6 +159,11 @@ void run_schnorrsig_bench(int iters, int argc, char** argv) {
     free((void *)data.pk);
     free((void *)data.msgs);
     free((void *)data.sigs);
+    free(data.msglens);
+    free(data.xonly_pks);
+    free((void *)data.xonly_pk_ptrs);
+    free(data.results);
+    secp256k1_scratch_space_destroy(data.ctx, data.scratch);
 
     secp256k1_context_destroy(data.ctx);
 }
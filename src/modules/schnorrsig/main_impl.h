@@ -10,6 +10,7 @@
 #include "../../../include/secp256k1.h"
 #include "../../../include/secp256k1_schnorrsig.h"
 #include "../../hash.h"
+#include "../../batch_verify.h"
 
 /* Initializes SHA256 with fixed midstate. This midstate was computed by applying
  * SHA256 to SHA256("BIP0340/nonce")||SHA256("BIP0340/nonce"). */
@@ -216,6 +217,107 @@ int secp256k1_schnorrsig_sign_custom(const secp256k1_context* ctx, unsigned char
     return secp256k1_schnorrsig_sign_internal(ctx, sig64, msg, msglen, keypair, noncefp, ndata);
 }
 
+/* The number of signatures for which secp256k1_schnorrsig_sign_batch shares
+ * the inversion of the Z coordinates of the nonce points. */
+#define SCHNORRSIG_SIGN_BATCH_SIZE 32
+
+int secp256k1_schnorrsig_sign_batch(const secp256k1_context* ctx, unsigned char * const *sig64s, const unsigned char * const *msgs, const size_t *msglens, size_t n, const secp256k1_keypair *keypair, const unsigned char * const *aux_rand32s) {
+    secp256k1_scalar k[SCHNORRSIG_SIGN_BATCH_SIZE];
+    secp256k1_gej rj[SCHNORRSIG_SIGN_BATCH_SIZE];
+    secp256k1_ge r[SCHNORRSIG_SIGN_BATCH_SIZE];
+    secp256k1_scalar sk;
+    secp256k1_scalar e;
+    secp256k1_ge pk;
+    unsigned char buf[32] = { 0 };
+    unsigned char pk_buf[32];
+    unsigned char seckey[32];
+    int ret = 1;
+    size_t i, j;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(n == 0 || sig64s != NULL);
+    ARG_CHECK(n == 0 || msgs != NULL);
+    ARG_CHECK(n == 0 || msglens != NULL);
+    ARG_CHECK(keypair != NULL);
+    for (i = 0; i < n; i++) {
+        ARG_CHECK(sig64s[i] != NULL);
+        ARG_CHECK(msgs[i] != NULL || msglens[i] == 0);
+    }
+
+    /* Load and serialize the key once for all messages (see
+     * secp256k1_schnorrsig_sign_internal). */
+    ret &= secp256k1_keypair_load(ctx, &sk, &pk, keypair);
+    if (secp256k1_fe_is_odd(&pk.y)) {
+        secp256k1_scalar_negate(&sk, &sk);
+    }
+    secp256k1_scalar_get_b32(seckey, &sk);
+    secp256k1_fe_get_b32(pk_buf, &pk.x);
+
+    for (i = 0; i < n; i += SCHNORRSIG_SIGN_BATCH_SIZE) {
+        size_t batch = n - i < SCHNORRSIG_SIGN_BATCH_SIZE ? n - i : SCHNORRSIG_SIGN_BATCH_SIZE;
+
+        for (j = 0; j < batch; j++) {
+            void *ndata = aux_rand32s != NULL ? (void *)aux_rand32s[i + j] : NULL;
+            ret &= !!secp256k1_nonce_function_bip340(buf, msgs[i + j], msglens[i + j], seckey, pk_buf, bip340_algo, sizeof(bip340_algo), ndata);
+            secp256k1_scalar_set_b32(&k[j], buf, NULL);
+            ret &= !secp256k1_scalar_is_zero(&k[j]);
+            secp256k1_scalar_cmov(&k[j], &secp256k1_scalar_one, !ret);
+            secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &rj[j], &k[j]);
+        }
+        secp256k1_ge_set_all_gej(r, rj, batch);
+
+        for (j = 0; j < batch; j++) {
+            unsigned char *sig64 = sig64s[i + j];
+            /* We declassify r to allow using it as a branch point. This is fine
+             * because r is not a secret. */
+            secp256k1_declassify(ctx, &r[j], sizeof(r[j]));
+            secp256k1_fe_normalize_var(&r[j].y);
+            if (secp256k1_fe_is_odd(&r[j].y)) {
+                secp256k1_scalar_negate(&k[j], &k[j]);
+            }
+            secp256k1_fe_normalize_var(&r[j].x);
+            secp256k1_fe_get_b32(&sig64[0], &r[j].x);
+
+            secp256k1_schnorrsig_challenge(&e, &sig64[0], msgs[i + j], msglens[i + j], pk_buf);
+            secp256k1_scalar_mul(&e, &e, &sk);
+            secp256k1_scalar_add(&e, &e, &k[j]);
+            secp256k1_scalar_get_b32(&sig64[32], &e);
+        }
+    }
+
+    /* A failure for any message clears all signatures. */
+    for (i = 0; i < n; i++) {
+        secp256k1_memczero(sig64s[i], 64, !ret);
+    }
+    for (j = 0; j < SCHNORRSIG_SIGN_BATCH_SIZE; j++) {
+        secp256k1_scalar_clear(&k[j]);
+        secp256k1_gej_clear(&rj[j]);
+    }
+    secp256k1_scalar_clear(&e);
+    secp256k1_scalar_clear(&sk);
+    memset(buf, 0, sizeof(buf));
+    memset(seckey, 0, sizeof(seckey));
+
+    return ret;
+}
+
+/* Check that rj = s*G - e*P is not infinity, has an even Y coordinate and the X
+ * coordinate rx. */
+static int secp256k1_schnorrsig_verify_check(const secp256k1_fe *rx, const secp256k1_gej *rj) {
+    secp256k1_gej tmp = *rj;
+    secp256k1_ge r;
+
+    secp256k1_ge_set_gej_var(&r, &tmp);
+    if (secp256k1_ge_is_infinity(&r)) {
+        return 0;
+    }
+
+    secp256k1_fe_normalize_var(&r.y);
+    return !secp256k1_fe_is_odd(&r.y) &&
+           secp256k1_fe_equal_var(rx, &r.x);
+}
+
 int secp256k1_schnorrsig_verify(const secp256k1_context* ctx, const unsigned char *sig64, const unsigned char *msg, size_t msglen, const secp256k1_xonly_pubkey *pubkey) {
     secp256k1_scalar s;
     secp256k1_scalar e;
@@ -223,7 +325,6 @@ int secp256k1_schnorrsig_verify(const secp256k1_context* ctx, const unsigned cha
     secp256k1_ge pk;
     secp256k1_gej pkj;
     secp256k1_fe rx;
-    secp256k1_ge r;
     unsigned char buf[32];
     int overflow;
 
@@ -254,14 +355,284 @@ int secp256k1_schnorrsig_verify(const secp256k1_context* ctx, const unsigned cha
     secp256k1_gej_set_ge(&pkj, &pk);
     secp256k1_ecmult(&rj, &pkj, &e, &s);
 
-    secp256k1_ge_set_gej_var(&r, &rj);
-    if (secp256k1_ge_is_infinity(&r)) {
+    return secp256k1_schnorrsig_verify_check(&rx, &rj);
+}
+
+int secp256k1_schnorrsig_verify_precomp(const secp256k1_context* ctx, const unsigned char *sig64, const unsigned char *msg, size_t msglen, const secp256k1_pubkey_precomp *precomp) {
+    secp256k1_scalar s;
+    secp256k1_scalar e;
+    secp256k1_gej rj;
+    secp256k1_ge pk;
+    secp256k1_fe rx;
+    unsigned char buf[32];
+    int overflow;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(sig64 != NULL);
+    ARG_CHECK(msg != NULL || msglen == 0);
+    ARG_CHECK(precomp != NULL);
+
+    if (!secp256k1_fe_set_b32(&rx, &sig64[0])) {
         return 0;
     }
 
-    secp256k1_fe_normalize_var(&r.y);
-    return !secp256k1_fe_is_odd(&r.y) &&
-           secp256k1_fe_equal_var(&rx, &r.x);
+    secp256k1_scalar_set_b32(&s, &sig64[32], &overflow);
+    if (overflow) {
+        return 0;
+    }
+
+    /* Compute e. */
+    secp256k1_ge_from_storage(&pk, &precomp->pubkey);
+    secp256k1_fe_get_b32(buf, &pk.x);
+    secp256k1_schnorrsig_challenge(&e, &sig64[0], msg, msglen, buf);
+
+    /* Compute rj =  s*G + (-e)*pkj, where the x-only public key pkj is the
+     * negation of the public key of precomp if the latter has an odd Y. */
+    if (!secp256k1_fe_is_odd(&pk.y)) {
+        secp256k1_scalar_negate(&e, &e);
+    }
+    secp256k1_ecmult_pubkey_precomp(&rj, precomp->pre, precomp->pre_lam, &e, &s);
+
+    return secp256k1_schnorrsig_verify_check(&rx, &rj);
+}
+
+int secp256k1_schnorrsig_verify_many(const secp256k1_context* ctx, int *results, const unsigned char * const *sig64, const unsigned char * const *msgs, const size_t *msglens, const secp256k1_xonly_pubkey * const *pubkeys, size_t n_sigs) {
+    secp256k1_scalar s[4], e[4];
+    secp256k1_gej pkj[4];
+    secp256k1_gej rj[4];
+    secp256k1_fe rx[4];
+    size_t idx[4];
+    size_t i, k, num;
+    int ret = 1;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(results != NULL);
+    memset(results, 0, n_sigs * sizeof(*results));
+    ARG_CHECK(n_sigs == 0 || sig64 != NULL);
+    ARG_CHECK(n_sigs == 0 || msgs != NULL);
+    ARG_CHECK(n_sigs == 0 || msglens != NULL);
+    ARG_CHECK(n_sigs == 0 || pubkeys != NULL);
+    for (i = 0; i < n_sigs; i++) {
+        ARG_CHECK(sig64[i] != NULL);
+        ARG_CHECK(msgs[i] != NULL || msglens[i] == 0);
+        ARG_CHECK(pubkeys[i] != NULL);
+    }
+
+    i = 0;
+    while (i < n_sigs) {
+        /* Gather up to four signatures that pass the checks before the
+         * multiplication, and verify them together. */
+        num = 0;
+        for (; i < n_sigs && num < 4; i++) {
+            secp256k1_ge pk;
+            unsigned char buf[32];
+            int overflow;
+
+            if (!secp256k1_fe_set_b32(&rx[num], &sig64[i][0])) {
+                ret = 0;
+                continue;
+            }
+            secp256k1_scalar_set_b32(&s[num], &sig64[i][32], &overflow);
+            if (overflow || !secp256k1_xonly_pubkey_load(ctx, &pk, pubkeys[i])) {
+                ret = 0;
+                continue;
+            }
+
+            /* Compute e, and rj = s*G + (-e)*pkj below. */
+            secp256k1_fe_get_b32(buf, &pk.x);
+            secp256k1_schnorrsig_challenge(&e[num], &sig64[i][0], msgs[i], msglens[i], buf);
+            secp256k1_scalar_negate(&e[num], &e[num]);
+            secp256k1_gej_set_ge(&pkj[num], &pk);
+            idx[num++] = i;
+        }
+        if (num == 0) {
+            break;
+        }
+        secp256k1_ecmult_many(rj, pkj, e, s, num);
+        for (k = 0; k < num; k++) {
+            results[idx[k]] = secp256k1_schnorrsig_verify_check(&rx[k], &rj[k]);
+            ret &= results[idx[k]];
+        }
+    }
+    return ret;
+}
+
+int secp256k1_schnorrsig_verify_cached(const secp256k1_context* ctx, secp256k1_sigcache *cache, secp256k1_sigcache_stats *stats, const unsigned char *sig64, const unsigned char *msg, size_t msglen, const secp256k1_xonly_pubkey *pubkey, int store) {
+    static const unsigned char type = 1;
+    secp256k1_sha256 hash;
+    unsigned char key[32];
+    unsigned char buf[32];
+    secp256k1_ge pk;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(cache != NULL);
+    ARG_CHECK(sig64 != NULL);
+    ARG_CHECK(msg != NULL || msglen == 0);
+    ARG_CHECK(pubkey != NULL);
+
+    if (!secp256k1_xonly_pubkey_load(ctx, &pk, pubkey)) {
+        return 0;
+    }
+
+    /* The key is the salted hash of the type, the signature, the message
+     * length, the message and the x-only public key. */
+    secp256k1_sigcache_hasher(cache, &hash);
+    secp256k1_sha256_write(&hash, &type, 1);
+    secp256k1_sha256_write(&hash, sig64, 64);
+    secp256k1_write_be64(buf, (uint64_t)msglen);
+    secp256k1_sha256_write(&hash, buf, 8);
+    secp256k1_sha256_write(&hash, msg, msglen);
+    secp256k1_fe_get_b32(buf, &pk.x);
+    secp256k1_sha256_write(&hash, buf, 32);
+    secp256k1_sha256_finalize(&hash, key);
+
+    if (secp256k1_sigcache_lookup_stats(cache, stats, key)) {
+        return 1;
+    }
+    if (!secp256k1_schnorrsig_verify(ctx, sig64, msg, msglen, pubkey)) {
+        return 0;
+    }
+    if (store) {
+        secp256k1_sigcache_insert(cache, key);
+    }
+    return 1;
+}
+
+/* Tag of the hash that commits to all inputs of a batch to derive the
+ * randomizers. */
+static const unsigned char schnorrsig_batch_tag[13] = "BIP0340/batch";
+
+typedef struct {
+    secp256k1_batch_verify_state batch;
+    const unsigned char * const *sig64;
+    const unsigned char * const *msgs;
+    const size_t *msglens;
+    const secp256k1_xonly_pubkey * const *pubkeys;
+} secp256k1_schnorrsig_verify_batch_data;
+
+/* Returns the points R_i and P_i of the i-th signature in the current range
+ * with scalars -a_i and -a_i*e_i respectively, where a_i is its randomizer. */
+static int secp256k1_schnorrsig_verify_batch_ecmult_callback(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *cbdata) {
+    secp256k1_schnorrsig_verify_batch_data *data = (secp256k1_schnorrsig_verify_batch_data *) cbdata;
+    size_t i = data->batch.offset + idx / 2;
+    secp256k1_scalar a;
+
+    secp256k1_batch_verify_state_randomizer(&a, &data->batch, i);
+    if (idx % 2 == 0) {
+        secp256k1_fe rx;
+        /* R_i is the point with x coordinate r and even Y. */
+        if (!secp256k1_fe_set_b32(&rx, &data->sig64[i][0])
+            || !secp256k1_ge_set_xo_var(pt, &rx, 0)) {
+            return 0;
+        }
+        *sc = a;
+    } else {
+        secp256k1_scalar e;
+        unsigned char buf[32];
+        if (!secp256k1_xonly_pubkey_load(data->batch.ctx, pt, data->pubkeys[i])) {
+            return 0;
+        }
+        secp256k1_fe_get_b32(buf, &pt->x);
+        secp256k1_schnorrsig_challenge(&e, &data->sig64[i][0], data->msgs[i], data->msglens[i], buf);
+        secp256k1_scalar_mul(sc, &a, &e);
+    }
+    secp256k1_scalar_negate(sc, sc);
+    return 1;
+}
+
+/* Checks the randomized batch equation
+ *   (sum a_i*s_i)*G - sum a_i*R_i - sum a_i*e_i*P_i = 0
+ * for the signatures in [offset, offset + n). */
+static int secp256k1_schnorrsig_verify_batch_range(size_t offset, size_t n, void *cbdata) {
+    secp256k1_schnorrsig_verify_batch_data *data = (secp256k1_schnorrsig_verify_batch_data *) cbdata;
+    secp256k1_scalar s_sum = secp256k1_scalar_zero;
+    secp256k1_gej rj;
+    size_t i;
+
+    for (i = offset; i < offset + n; i++) {
+        secp256k1_scalar s;
+        secp256k1_scalar a;
+        int overflow;
+
+        secp256k1_scalar_set_b32(&s, &data->sig64[i][32], &overflow);
+        if (overflow) {
+            return 0;
+        }
+        secp256k1_batch_verify_state_randomizer(&a, &data->batch, i);
+        secp256k1_scalar_mul(&s, &s, &a);
+        secp256k1_scalar_add(&s_sum, &s_sum, &s);
+    }
+
+    data->batch.offset = offset;
+    if (!secp256k1_ecmult_multi_var(data->batch.error_callback, data->batch.scratch, &rj, &s_sum, secp256k1_schnorrsig_verify_batch_ecmult_callback, data, 2 * n)) {
+        return 0;
+    }
+    return secp256k1_gej_is_infinity(&rj);
+}
+
+int secp256k1_schnorrsig_verify_batch(const secp256k1_context* ctx, secp256k1_scratch_space *scratch, int *valid, const unsigned char * const *sig64, const unsigned char * const *msgs, const size_t *msglens, const secp256k1_xonly_pubkey * const *pubkeys, size_t n_sigs) {
+    secp256k1_schnorrsig_verify_batch_data data;
+    secp256k1_sha256 sha;
+    unsigned char seed[32];
+    size_t i;
+    int ret;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(scratch != NULL);
+    ARG_CHECK(n_sigs <= SIZE_MAX / 2);
+    if (valid != NULL) {
+        memset(valid, 0, n_sigs * sizeof(*valid));
+    }
+    ARG_CHECK(n_sigs == 0 || sig64 != NULL);
+    ARG_CHECK(n_sigs == 0 || msgs != NULL);
+    ARG_CHECK(n_sigs == 0 || msglens != NULL);
+    ARG_CHECK(n_sigs == 0 || pubkeys != NULL);
+
+    if (n_sigs == 0) {
+        return 1;
+    }
+
+    /* The randomizers are derived from a hash of all inputs, so they can't be
+     * predicted by anyone creating the signatures. */
+    secp256k1_sha256_initialize_tagged(&sha, schnorrsig_batch_tag, sizeof(schnorrsig_batch_tag));
+    for (i = 0; i < n_sigs; i++) {
+        secp256k1_ge pk;
+        unsigned char buf[32];
+        unsigned char msglen8[8];
+
+        ARG_CHECK(sig64[i] != NULL);
+        ARG_CHECK(msgs[i] != NULL || msglens[i] == 0);
+        ARG_CHECK(pubkeys[i] != NULL);
+        if (!secp256k1_xonly_pubkey_load(ctx, &pk, pubkeys[i])) {
+            return 0;
+        }
+        secp256k1_fe_get_b32(buf, &pk.x);
+        secp256k1_write_be64(msglen8, msglens[i]);
+        secp256k1_sha256_write(&sha, sig64[i], 64);
+        secp256k1_sha256_write(&sha, buf, sizeof(buf));
+        secp256k1_sha256_write(&sha, msglen8, sizeof(msglen8));
+        secp256k1_sha256_write(&sha, msgs[i], msglens[i]);
+    }
+    secp256k1_sha256_finalize(&sha, seed);
+
+    secp256k1_batch_verify_state_init(&data.batch, ctx, &ctx->error_callback, scratch, seed, n_sigs);
+    data.sig64 = sig64;
+    data.msgs = msgs;
+    data.msglens = msglens;
+    data.pubkeys = pubkeys;
+
+    ret = secp256k1_schnorrsig_verify_batch_range(0, n_sigs, &data);
+    if (valid != NULL) {
+        if (ret) {
+            for (i = 0; i < n_sigs; i++) {
+                valid[i] = 1;
+            }
+        } else {
+            secp256k1_batch_verify_find_invalid(valid, n_sigs, secp256k1_schnorrsig_verify_batch_range, &data);
+        }
+    }
+    secp256k1_batch_verify_state_clear(&data.batch);
+    return ret;
 }
 
 #endif
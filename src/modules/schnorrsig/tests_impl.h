@@ -220,6 +220,130 @@ void test_schnorrsig_api(void) {
     CHECK(secp256k1_schnorrsig_verify(vrfy, sig, msg, sizeof(msg), &zero_pk) == 0);
     CHECK(ecount == 4);
 
+    {
+        const unsigned char *sigs[2];
+        const unsigned char *msgs[2];
+        size_t msglens[2];
+        const secp256k1_xonly_pubkey *pks[2];
+        const unsigned char *null_sigs[2] = { NULL, NULL };
+        int valid[2];
+        secp256k1_scratch_space *scratch = secp256k1_scratch_space_create(ctx, 4096);
+
+        sigs[0] = sigs[1] = sig;
+        msgs[0] = msgs[1] = msg;
+        msglens[0] = msglens[1] = sizeof(msg);
+        pks[0] = pks[1] = &pk[0];
+
+        ecount = 0;
+        CHECK(secp256k1_schnorrsig_verify_batch(none, scratch, valid, sigs, msgs, msglens, pks, 2) == 1);
+        CHECK(valid[0] == 1 && valid[1] == 1);
+        CHECK(ecount == 0);
+        CHECK(secp256k1_schnorrsig_verify_batch(vrfy, scratch, NULL, sigs, msgs, msglens, pks, 2) == 1);
+        CHECK(ecount == 0);
+        CHECK(secp256k1_schnorrsig_verify_batch(vrfy, scratch, NULL, NULL, NULL, NULL, NULL, 0) == 1);
+        CHECK(ecount == 0);
+        CHECK(secp256k1_schnorrsig_verify_batch(vrfy, NULL, valid, sigs, msgs, msglens, pks, 2) == 0);
+        CHECK(ecount == 1);
+        CHECK(secp256k1_schnorrsig_verify_batch(vrfy, scratch, valid, NULL, msgs, msglens, pks, 2) == 0);
+        CHECK(ecount == 2);
+        CHECK(secp256k1_schnorrsig_verify_batch(vrfy, scratch, valid, sigs, NULL, msglens, pks, 2) == 0);
+        CHECK(ecount == 3);
+        CHECK(secp256k1_schnorrsig_verify_batch(vrfy, scratch, valid, sigs, msgs, NULL, pks, 2) == 0);
+        CHECK(ecount == 4);
+        CHECK(secp256k1_schnorrsig_verify_batch(vrfy, scratch, valid, sigs, msgs, msglens, NULL, 2) == 0);
+        CHECK(ecount == 5);
+        CHECK(secp256k1_schnorrsig_verify_batch(vrfy, scratch, valid, null_sigs, msgs, msglens, pks, 2) == 0);
+        CHECK(ecount == 6);
+        msgs[1] = NULL;
+        CHECK(secp256k1_schnorrsig_verify_batch(vrfy, scratch, valid, sigs, msgs, msglens, pks, 2) == 0);
+        CHECK(ecount == 7);
+        msglens[1] = 0;
+        CHECK(secp256k1_schnorrsig_verify_batch(vrfy, scratch, valid, sigs, msgs, msglens, pks, 2) == 0);
+        CHECK(valid[0] == 1 && valid[1] == 0);
+        CHECK(ecount == 7);
+        msgs[1] = msg;
+        msglens[1] = sizeof(msg);
+        pks[1] = &zero_pk;
+        CHECK(secp256k1_schnorrsig_verify_batch(vrfy, scratch, valid, sigs, msgs, msglens, pks, 2) == 0);
+        CHECK(valid[0] == 0 && valid[1] == 0);
+        CHECK(ecount == 8);
+        pks[1] = NULL;
+        CHECK(secp256k1_schnorrsig_verify_batch(vrfy, scratch, valid, sigs, msgs, msglens, pks, 2) == 0);
+        CHECK(ecount == 9);
+
+        secp256k1_scratch_space_destroy(ctx, scratch);
+    }
+
+    {
+        const unsigned char *sigs[2];
+        const unsigned char *msgs[2];
+        size_t msglens[2];
+        const secp256k1_xonly_pubkey *pks[2];
+        const unsigned char *null_sigs[2] = { NULL, NULL };
+        int results[2];
+
+        sigs[0] = sigs[1] = sig;
+        msgs[0] = msgs[1] = msg;
+        msglens[0] = msglens[1] = sizeof(msg);
+        pks[0] = pks[1] = &pk[0];
+
+        ecount = 0;
+        CHECK(secp256k1_schnorrsig_verify_many(none, results, sigs, msgs, msglens, pks, 2) == 1);
+        CHECK(results[0] == 1 && results[1] == 1);
+        CHECK(ecount == 0);
+        CHECK(secp256k1_schnorrsig_verify_many(vrfy, results, NULL, NULL, NULL, NULL, 0) == 1);
+        CHECK(ecount == 0);
+        CHECK(secp256k1_schnorrsig_verify_many(vrfy, NULL, sigs, msgs, msglens, pks, 2) == 0);
+        CHECK(ecount == 1);
+        CHECK(secp256k1_schnorrsig_verify_many(vrfy, results, NULL, msgs, msglens, pks, 2) == 0);
+        CHECK(ecount == 2);
+        CHECK(results[0] == 0 && results[1] == 0);
+        CHECK(secp256k1_schnorrsig_verify_many(vrfy, results, sigs, NULL, msglens, pks, 2) == 0);
+        CHECK(ecount == 3);
+        CHECK(secp256k1_schnorrsig_verify_many(vrfy, results, sigs, msgs, NULL, pks, 2) == 0);
+        CHECK(ecount == 4);
+        CHECK(secp256k1_schnorrsig_verify_many(vrfy, results, sigs, msgs, msglens, NULL, 2) == 0);
+        CHECK(ecount == 5);
+        CHECK(secp256k1_schnorrsig_verify_many(vrfy, results, null_sigs, msgs, msglens, pks, 2) == 0);
+        CHECK(ecount == 6);
+        msgs[1] = NULL;
+        CHECK(secp256k1_schnorrsig_verify_many(vrfy, results, sigs, msgs, msglens, pks, 2) == 0);
+        CHECK(ecount == 7);
+        msglens[1] = 0;
+        CHECK(secp256k1_schnorrsig_verify_many(vrfy, results, sigs, msgs, msglens, pks, 2) == 0);
+        CHECK(results[0] == 1 && results[1] == 0);
+        CHECK(ecount == 7);
+        msgs[1] = msg;
+        msglens[1] = sizeof(msg);
+        pks[1] = &zero_pk;
+        CHECK(secp256k1_schnorrsig_verify_many(vrfy, results, sigs, msgs, msglens, pks, 2) == 0);
+        CHECK(results[0] == 1 && results[1] == 0);
+        CHECK(ecount == 8);
+    }
+
+    {
+        secp256k1_pubkey pubkey;
+        secp256k1_pubkey_precomp *precomp;
+
+        CHECK(secp256k1_keypair_pub(ctx, &pubkey, &keypairs[0]) == 1);
+        precomp = secp256k1_pubkey_precomp_create(vrfy, &pubkey);
+        CHECK(precomp != NULL);
+
+        ecount = 0;
+        CHECK(secp256k1_schnorrsig_verify_precomp(none, sig, msg, sizeof(msg), precomp) == 1);
+        CHECK(ecount == 0);
+        CHECK(secp256k1_schnorrsig_verify_precomp(vrfy, NULL, msg, sizeof(msg), precomp) == 0);
+        CHECK(ecount == 1);
+        CHECK(secp256k1_schnorrsig_verify_precomp(vrfy, sig, NULL, sizeof(msg), precomp) == 0);
+        CHECK(ecount == 2);
+        CHECK(secp256k1_schnorrsig_verify_precomp(vrfy, sig, NULL, 0, precomp) == 0);
+        CHECK(ecount == 2);
+        CHECK(secp256k1_schnorrsig_verify_precomp(vrfy, sig, msg, sizeof(msg), NULL) == 0);
+        CHECK(ecount == 3);
+
+        secp256k1_pubkey_precomp_destroy(vrfy, precomp);
+    }
+
     secp256k1_context_destroy(none);
     secp256k1_context_destroy(sign);
     secp256k1_context_destroy(vrfy);
@@ -257,12 +381,19 @@ void test_schnorrsig_bip_vectors_check_signing(const unsigned char *sk, const un
 }
 
 /* Helper function for schnorrsig_bip_vectors
- * Checks that both verify and verify_batch (TODO) return the same value as expected. */
+ * Checks that verify, verify_many and verify_batch (TODO) return the same value as expected. */
 void test_schnorrsig_bip_vectors_check_verify(const unsigned char *pk_serialized, const unsigned char *msg32, const unsigned char *sig, int expected) {
     secp256k1_xonly_pubkey pk;
 
+    const secp256k1_xonly_pubkey *pks[1];
+    size_t msglen = 32;
+    int result;
+
     CHECK(secp256k1_xonly_pubkey_parse(ctx, &pk, pk_serialized));
     CHECK(expected == secp256k1_schnorrsig_verify(ctx, sig, msg32, 32, &pk));
+    pks[0] = &pk;
+    CHECK(expected == secp256k1_schnorrsig_verify_many(ctx, &result, &sig, &msg32, &msglen, pks, 1));
+    CHECK(expected == result);
 }
 
 /* Test vectors according to BIP-340 ("Schnorr Signatures for secp256k1"). See
@@ -772,8 +903,34 @@ void test_schnorrsig_sign(void) {
 }
 
 #define N_SIGS 3
+/* Checks that verify_batch accepts the N_SIGS signatures if and only if
+ * verify accepts all of them, and that it reports the same invalid ones. */
+static void test_schnorrsig_verify_batch_eq(secp256k1_scratch_space *scratch, unsigned char (*sig)[64], unsigned char (*msg)[32], const secp256k1_xonly_pubkey *pk) {
+    const unsigned char *sigs[N_SIGS];
+    const unsigned char *msgs[N_SIGS];
+    size_t msglens[N_SIGS];
+    const secp256k1_xonly_pubkey *pks[N_SIGS];
+    int valid[N_SIGS];
+    int all_valid = 1;
+    size_t i;
+
+    for (i = 0; i < N_SIGS; i++) {
+        sigs[i] = sig[i];
+        msgs[i] = msg[i];
+        msglens[i] = 32;
+        pks[i] = pk;
+    }
+    CHECK(secp256k1_schnorrsig_verify_batch(ctx, scratch, valid, sigs, msgs, msglens, pks, N_SIGS) == secp256k1_schnorrsig_verify_batch(ctx, scratch, NULL, sigs, msgs, msglens, pks, N_SIGS));
+    for (i = 0; i < N_SIGS; i++) {
+        int expected = secp256k1_schnorrsig_verify(ctx, sig[i], msg[i], sizeof(msg[i]), pk);
+        CHECK(valid[i] == expected);
+        all_valid &= expected;
+    }
+    CHECK(secp256k1_schnorrsig_verify_batch(ctx, scratch, valid, sigs, msgs, msglens, pks, N_SIGS) == all_valid);
+}
+
 /* Creates N_SIGS valid signatures and verifies them with verify and
- * verify_batch (TODO). Then flips some bits and checks that verification now
+ * verify_batch. Then flips some bits and checks that verification now
  * fails. */
 void test_schnorrsig_sign_verify(void) {
     unsigned char sk[32];
@@ -783,6 +940,7 @@ void test_schnorrsig_sign_verify(void) {
     secp256k1_keypair keypair;
     secp256k1_xonly_pubkey pk;
     secp256k1_scalar s;
+    secp256k1_scratch_space *scratch = secp256k1_scratch_space_create(ctx, 8192);
 
     secp256k1_testrand256(sk);
     CHECK(secp256k1_keypair_create(ctx, &keypair, sk));
@@ -793,29 +951,34 @@ void test_schnorrsig_sign_verify(void) {
         CHECK(secp256k1_schnorrsig_sign32(ctx, sig[i], msg[i], &keypair, NULL));
         CHECK(secp256k1_schnorrsig_verify(ctx, sig[i], msg[i], sizeof(msg[i]), &pk));
     }
+    test_schnorrsig_verify_batch_eq(scratch, sig, msg, &pk);
 
     {
         /* Flip a few bits in the signature and in the message and check that
-         * verify and verify_batch (TODO) fail */
+         * verify and verify_batch fail */
         size_t sig_idx = secp256k1_testrand_int(N_SIGS);
         size_t byte_idx = secp256k1_testrand_bits(5);
         unsigned char xorbyte = secp256k1_testrand_int(254)+1;
         sig[sig_idx][byte_idx] ^= xorbyte;
         CHECK(!secp256k1_schnorrsig_verify(ctx, sig[sig_idx], msg[sig_idx], sizeof(msg[sig_idx]), &pk));
+        test_schnorrsig_verify_batch_eq(scratch, sig, msg, &pk);
         sig[sig_idx][byte_idx] ^= xorbyte;
 
         byte_idx = secp256k1_testrand_bits(5);
         sig[sig_idx][32+byte_idx] ^= xorbyte;
         CHECK(!secp256k1_schnorrsig_verify(ctx, sig[sig_idx], msg[sig_idx], sizeof(msg[sig_idx]), &pk));
+        test_schnorrsig_verify_batch_eq(scratch, sig, msg, &pk);
         sig[sig_idx][32+byte_idx] ^= xorbyte;
 
         byte_idx = secp256k1_testrand_bits(5);
         msg[sig_idx][byte_idx] ^= xorbyte;
         CHECK(!secp256k1_schnorrsig_verify(ctx, sig[sig_idx], msg[sig_idx], sizeof(msg[sig_idx]), &pk));
+        test_schnorrsig_verify_batch_eq(scratch, sig, msg, &pk);
         msg[sig_idx][byte_idx] ^= xorbyte;
 
         /* Check that above bitflips have been reversed correctly */
         CHECK(secp256k1_schnorrsig_verify(ctx, sig[sig_idx], msg[sig_idx], sizeof(msg[sig_idx]), &pk));
+        test_schnorrsig_verify_batch_eq(scratch, sig, msg, &pk);
     }
 
     /* Test overflowing s */
@@ -849,6 +1012,297 @@ void test_schnorrsig_sign_verify(void) {
         msglen = (msglen + (sizeof(msg_large) - 1)) % sizeof(msg_large);
         CHECK(secp256k1_schnorrsig_verify(ctx, sig[0], msg_large, msglen, &pk) == 0);
     }
+    secp256k1_scratch_space_destroy(ctx, scratch);
+}
+#undef N_SIGS
+
+/* Checks that verify_precomp agrees with verify for valid and invalid
+ * signatures, with precomputation objects for both public keys that have
+ * the same x-only public key. */
+void test_schnorrsig_verify_precomp(void) {
+    unsigned char sk[32];
+    unsigned char msg[32];
+    unsigned char sig[64];
+    secp256k1_keypair keypair;
+    secp256k1_xonly_pubkey pk;
+    secp256k1_pubkey pubkey;
+    secp256k1_pubkey_precomp *precomp[2];
+    int i, j;
+
+    secp256k1_testrand256(sk);
+    CHECK(secp256k1_keypair_create(ctx, &keypair, sk));
+    CHECK(secp256k1_keypair_xonly_pub(ctx, &pk, NULL, &keypair));
+    CHECK(secp256k1_keypair_pub(ctx, &pubkey, &keypair));
+    precomp[0] = secp256k1_pubkey_precomp_create(ctx, &pubkey);
+    CHECK(secp256k1_ec_pubkey_negate(ctx, &pubkey));
+    precomp[1] = secp256k1_pubkey_precomp_create(ctx, &pubkey);
+    CHECK(precomp[0] != NULL && precomp[1] != NULL);
+
+    for (i = 0; i < 3; i++) {
+        int expected = i == 0;
+        secp256k1_testrand256(msg);
+        CHECK(secp256k1_schnorrsig_sign32(ctx, sig, msg, &keypair, NULL));
+        if (i == 1) {
+            sig[secp256k1_testrand_int(64)] ^= 1 << secp256k1_testrand_int(8);
+        } else if (i == 2) {
+            msg[secp256k1_testrand_int(32)] ^= 1 << secp256k1_testrand_int(8);
+        }
+        CHECK(secp256k1_schnorrsig_verify(ctx, sig, msg, sizeof(msg), &pk) == expected);
+        for (j = 0; j < 2; j++) {
+            CHECK(secp256k1_schnorrsig_verify_precomp(ctx, sig, msg, sizeof(msg), precomp[j]) == expected);
+        }
+    }
+
+    secp256k1_pubkey_precomp_destroy(ctx, precomp[0]);
+    secp256k1_pubkey_precomp_destroy(ctx, precomp[1]);
+}
+
+void test_schnorrsig_verify_cached(void) {
+    secp256k1_context *none = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    secp256k1_sigcache *cache;
+    secp256k1_sigcache_stats stats = { 0, 0 };
+    secp256k1_keypair keypair;
+    secp256k1_xonly_pubkey pk, zero_pk;
+    unsigned char salt[32];
+    unsigned char sk[32];
+    unsigned char msg[32];
+    unsigned char sig[64];
+    int ecount = 0;
+
+    secp256k1_context_set_illegal_callback(none, counting_illegal_callback_fn, &ecount);
+    secp256k1_testrand256(salt);
+    secp256k1_testrand256(sk);
+    secp256k1_testrand256(msg);
+    CHECK(secp256k1_keypair_create(ctx, &keypair, sk));
+    CHECK(secp256k1_keypair_xonly_pub(ctx, &pk, NULL, &keypair));
+    CHECK(secp256k1_schnorrsig_sign32(ctx, sig, msg, &keypair, NULL));
+    memset(&zero_pk, 0, sizeof(zero_pk));
+    cache = secp256k1_sigcache_create(none, 4096, salt);
+    CHECK(cache != NULL);
+
+    CHECK(secp256k1_schnorrsig_verify_cached(none, cache, &stats, sig, msg, sizeof(msg), &pk, 0) == 1);
+    CHECK(secp256k1_schnorrsig_verify_cached(none, cache, &stats, sig, msg, sizeof(msg), &pk, 1) == 1);
+    CHECK(secp256k1_schnorrsig_verify_cached(none, cache, &stats, sig, msg, sizeof(msg), &pk, 1) == 1);
+    CHECK(stats.hits == 1 && stats.misses == 2);
+    /* A different message length is a different cache entry */
+    CHECK(secp256k1_schnorrsig_verify_cached(none, cache, &stats, sig, msg, sizeof(msg) - 1, &pk, 1) == 0);
+    sig[63] ^= 1;
+    CHECK(secp256k1_schnorrsig_verify_cached(none, cache, &stats, sig, msg, sizeof(msg), &pk, 1) == 0);
+    CHECK(secp256k1_schnorrsig_verify_cached(none, cache, &stats, sig, msg, sizeof(msg), &pk, 1) == 0);
+    sig[63] ^= 1;
+    CHECK(stats.hits == 1 && stats.misses == 5);
+    /* Lookups without storing find stored entries */
+    CHECK(secp256k1_schnorrsig_verify_cached(none, cache, &stats, sig, msg, sizeof(msg), &pk, 0) == 1);
+    CHECK(stats.hits == 2 && stats.misses == 5);
+    CHECK(ecount == 0);
+
+    CHECK(secp256k1_schnorrsig_verify_cached(none, NULL, &stats, sig, msg, sizeof(msg), &pk, 1) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_schnorrsig_verify_cached(none, cache, &stats, NULL, msg, sizeof(msg), &pk, 1) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_schnorrsig_verify_cached(none, cache, &stats, sig, NULL, sizeof(msg), &pk, 1) == 0);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_schnorrsig_verify_cached(none, cache, &stats, sig, msg, sizeof(msg), NULL, 1) == 0);
+    CHECK(ecount == 4);
+    CHECK(secp256k1_schnorrsig_verify_cached(none, cache, &stats, sig, msg, sizeof(msg), &zero_pk, 1) == 0);
+    CHECK(ecount == 5);
+    CHECK(stats.hits == 2 && stats.misses == 5);
+
+    secp256k1_sigcache_destroy(none, cache);
+    secp256k1_context_destroy(none);
+}
+
+#define N_SIGS 150
+/* Creates batches of up to N_SIGS signatures under different keys with
+ * varying message lengths, invalidates a random subset of them and checks
+ * that verify_batch and verify_many report exactly the invalid ones. */
+void test_schnorrsig_verify_batch(void) {
+    static unsigned char sig[N_SIGS][64];
+    static unsigned char msg[N_SIGS][64];
+    static secp256k1_xonly_pubkey pk[N_SIGS];
+    const unsigned char *sigs[N_SIGS];
+    const unsigned char *msgs[N_SIGS];
+    size_t msglens[N_SIGS];
+    const secp256k1_xonly_pubkey *pks[N_SIGS];
+    int valid[N_SIGS];
+    int expected[N_SIGS];
+    /* Sizes that result in Strauss, Pippenger with batching, and Pippenger
+     * without batching (for at least 44 signatures) */
+    size_t scratch_sizes[3] = { 4096, 32768, 1 << 20 };
+    size_t i, j;
+
+    for (i = 0; i < N_SIGS; i++) {
+        unsigned char sk[32];
+        secp256k1_keypair keypair;
+        secp256k1_testrand256(sk);
+        secp256k1_testrand256(msg[i]);
+        secp256k1_testrand256(&msg[i][32]);
+        msglens[i] = secp256k1_testrand_int(sizeof(msg[i]) + 1);
+        CHECK(secp256k1_keypair_create(ctx, &keypair, sk));
+        CHECK(secp256k1_keypair_xonly_pub(ctx, &pk[i], NULL, &keypair));
+        CHECK(secp256k1_schnorrsig_sign_custom(ctx, sig[i], msg[i], msglens[i], &keypair, NULL));
+        sigs[i] = sig[i];
+        msgs[i] = msg[i];
+        pks[i] = &pk[i];
+    }
+
+    for (j = 0; j < sizeof(scratch_sizes)/sizeof(scratch_sizes[0]); j++) {
+        secp256k1_scratch_space *scratch = secp256k1_scratch_space_create(ctx, scratch_sizes[j]);
+        size_t n_sigs = 1 + secp256k1_testrand_int(N_SIGS);
+        size_t n_invalid = secp256k1_testrand_int(4);
+        int all_valid = 1;
+
+        CHECK(secp256k1_schnorrsig_verify_batch(ctx, scratch, valid, sigs, msgs, msglens, pks, n_sigs) == 1);
+        for (i = 0; i < n_sigs; i++) {
+            CHECK(valid[i] == 1);
+        }
+
+        /* Invalidate up to 3 random signatures in different ways. */
+        for (i = 0; i < n_invalid; i++) {
+            size_t idx = secp256k1_testrand_int(n_sigs);
+            switch (secp256k1_testrand_int(4)) {
+            case 0:
+                /* s overflows */
+                memset(&sig[idx][32], 0xFF, 32);
+                break;
+            case 1:
+                /* r is (most likely) not an x coordinate on the curve */
+                sig[idx][secp256k1_testrand_int(32)] ^= 1 + secp256k1_testrand_int(255);
+                break;
+            case 2:
+                sig[idx][32 + secp256k1_testrand_int(32)] ^= 1 + secp256k1_testrand_int(255);
+                break;
+            case 3:
+                /* different key */
+                pks[idx] = &pk[(idx + 1) % N_SIGS];
+                break;
+            }
+        }
+        for (i = 0; i < n_sigs; i++) {
+            expected[i] = secp256k1_schnorrsig_verify(ctx, sigs[i], msgs[i], msglens[i], pks[i]);
+            all_valid &= expected[i];
+        }
+        CHECK(secp256k1_schnorrsig_verify_batch(ctx, scratch, NULL, sigs, msgs, msglens, pks, n_sigs) == all_valid);
+        CHECK(secp256k1_schnorrsig_verify_batch(ctx, scratch, valid, sigs, msgs, msglens, pks, n_sigs) == all_valid);
+        for (i = 0; i < n_sigs; i++) {
+            CHECK(valid[i] == expected[i]);
+        }
+        CHECK(secp256k1_schnorrsig_verify_many(ctx, valid, sigs, msgs, msglens, pks, n_sigs) == all_valid);
+        for (i = 0; i < n_sigs; i++) {
+            CHECK(valid[i] == expected[i]);
+        }
+
+        /* Restore the batch */
+        for (i = 0; i < n_sigs; i++) {
+            if (!expected[i]) {
+                secp256k1_keypair keypair;
+                unsigned char sk[32];
+                secp256k1_testrand256(sk);
+                CHECK(secp256k1_keypair_create(ctx, &keypair, sk));
+                CHECK(secp256k1_keypair_xonly_pub(ctx, &pk[i], NULL, &keypair));
+                CHECK(secp256k1_schnorrsig_sign_custom(ctx, sig[i], msg[i], msglens[i], &keypair, NULL));
+                pks[i] = &pk[i];
+            }
+        }
+        secp256k1_scratch_space_destroy(ctx, scratch);
+    }
+}
+#undef N_SIGS
+
+void test_schnorrsig_sign_batch_api(void) {
+    unsigned char sk[32];
+    unsigned char msg[2][32];
+    unsigned char sig[2][64];
+    unsigned char *sigs[2];
+    const unsigned char *msgs[2];
+    size_t msglens[2] = { 32, 32 };
+    secp256k1_keypair keypair;
+    secp256k1_keypair invalid_keypair = {{ 0 }};
+    unsigned char zeros64[64] = { 0 };
+    secp256k1_context *none = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    int ecount = 0;
+
+    secp256k1_context_set_illegal_callback(none, counting_illegal_callback_fn, &ecount);
+    secp256k1_testrand256(sk);
+    secp256k1_testrand256(msg[0]);
+    secp256k1_testrand256(msg[1]);
+    CHECK(secp256k1_keypair_create(ctx, &keypair, sk) == 1);
+    sigs[0] = sig[0];
+    sigs[1] = sig[1];
+    msgs[0] = msg[0];
+    msgs[1] = msg[1];
+
+    CHECK(secp256k1_schnorrsig_sign_batch(none, sigs, msgs, msglens, 2, &keypair, NULL) == 1);
+    CHECK(ecount == 0);
+    CHECK(secp256k1_schnorrsig_sign_batch(none, NULL, NULL, NULL, 0, &keypair, NULL) == 1);
+    CHECK(ecount == 0);
+    CHECK(secp256k1_schnorrsig_sign_batch(none, NULL, msgs, msglens, 2, &keypair, NULL) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_schnorrsig_sign_batch(none, sigs, NULL, msglens, 2, &keypair, NULL) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_schnorrsig_sign_batch(none, sigs, msgs, NULL, 2, &keypair, NULL) == 0);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_schnorrsig_sign_batch(none, sigs, msgs, msglens, 2, NULL, NULL) == 0);
+    CHECK(ecount == 4);
+    sigs[1] = NULL;
+    CHECK(secp256k1_schnorrsig_sign_batch(none, sigs, msgs, msglens, 2, &keypair, NULL) == 0);
+    CHECK(ecount == 5);
+    sigs[1] = sig[1];
+    msgs[1] = NULL;
+    CHECK(secp256k1_schnorrsig_sign_batch(none, sigs, msgs, msglens, 2, &keypair, NULL) == 0);
+    CHECK(ecount == 6);
+    msglens[1] = 0;
+    CHECK(secp256k1_schnorrsig_sign_batch(none, sigs, msgs, msglens, 2, &keypair, NULL) == 1);
+    CHECK(ecount == 6);
+    /* An invalid keypair clears all signatures */
+    CHECK(secp256k1_schnorrsig_sign_batch(none, sigs, msgs, msglens, 2, &invalid_keypair, NULL) == 0);
+    CHECK(ecount == 7);
+    CHECK(secp256k1_memcmp_var(sig[0], zeros64, 64) == 0);
+    CHECK(secp256k1_memcmp_var(sig[1], zeros64, 64) == 0);
+
+    secp256k1_context_destroy(none);
+}
+
+#define N_SIGS 70
+/* Checks that sign_batch creates the same signatures as sign_custom for
+ * varying numbers of messages, message lengths and auxiliary randomness. */
+void test_schnorrsig_sign_batch(void) {
+    unsigned char sk[32];
+    unsigned char msg[N_SIGS][40];
+    unsigned char aux_rand[N_SIGS][32];
+    unsigned char sig[N_SIGS][64];
+    unsigned char sig_expected[64];
+    unsigned char *sigs[N_SIGS];
+    const unsigned char *msgs[N_SIGS];
+    size_t msglens[N_SIGS];
+    const unsigned char *aux_rand32s[N_SIGS];
+    secp256k1_keypair keypair;
+    secp256k1_xonly_pubkey pk;
+    secp256k1_schnorrsig_extraparams extraparams = SECP256K1_SCHNORRSIG_EXTRAPARAMS_INIT;
+    size_t n = secp256k1_testrand_int(N_SIGS + 1);
+    int use_aux = secp256k1_testrand_bits(1);
+    size_t i;
+
+    secp256k1_testrand256(sk);
+    CHECK(secp256k1_keypair_create(ctx, &keypair, sk) == 1);
+    CHECK(secp256k1_keypair_xonly_pub(ctx, &pk, NULL, &keypair) == 1);
+    for (i = 0; i < N_SIGS; i++) {
+        secp256k1_testrand_bytes_test(msg[i], sizeof(msg[i]));
+        secp256k1_testrand256(aux_rand[i]);
+        msglens[i] = secp256k1_testrand_int(sizeof(msg[i]) + 1);
+        sigs[i] = sig[i];
+        msgs[i] = msg[i];
+        /* Individual entries of aux_rand32s can be NULL */
+        aux_rand32s[i] = secp256k1_testrand_bits(3) == 0 ? NULL : aux_rand[i];
+    }
+
+    CHECK(secp256k1_schnorrsig_sign_batch(ctx, sigs, msgs, msglens, n, &keypair, use_aux ? aux_rand32s : NULL) == 1);
+    for (i = 0; i < n; i++) {
+        extraparams.ndata = use_aux ? (unsigned char*)aux_rand32s[i] : NULL;
+        CHECK(secp256k1_schnorrsig_sign_custom(ctx, sig_expected, msg[i], msglens[i], &keypair, &extraparams) == 1);
+        CHECK(secp256k1_memcmp_var(sig[i], sig_expected, 64) == 0);
+        CHECK(secp256k1_schnorrsig_verify(ctx, sig[i], msg[i], msglens[i], &pk) == 1);
+    }
 }
 #undef N_SIGS
 
@@ -893,11 +1347,18 @@ void run_schnorrsig_tests(void) {
     run_nonce_function_bip340_tests();
 
     test_schnorrsig_api();
+    test_schnorrsig_verify_cached();
+    test_schnorrsig_sign_batch_api();
     test_schnorrsig_sha256_tagged();
     test_schnorrsig_bip_vectors();
     for (i = 0; i < count; i++) {
         test_schnorrsig_sign();
         test_schnorrsig_sign_verify();
+        test_schnorrsig_verify_precomp();
+        test_schnorrsig_sign_batch();
+    }
+    for (i = 0; i < count / 8 + 1; i++) {
+        test_schnorrsig_verify_batch();
     }
     test_schnorrsig_taproot();
 }
@@ -17,10 +17,49 @@
 #include "ecmult_gen.h"
 #include "ecmult_gen_compute_table_impl.h"
 
+/* The (COMB_BLOCKS, COMB_TEETH) configurations for which tables are generated. They correspond
+ * to the table sizes supported by ./configure --with-ecmult-gen-kb (2, 22, 86 and 256 kB). */
+static const int CONFIGS[][2] = {
+    {2, 5},
+    {11, 6},
+    {43, 6},
+    {32, 8}
+};
+
+static void print_table(FILE* fp, int blocks, int teeth) {
+    int spacing = CEIL_DIV(256, blocks * teeth);
+    size_t points = ((size_t)1) << (teeth - 1);
+    int outer;
+    size_t inner;
+
+    secp256k1_ge_storage* table = checked_malloc(&default_error_callback, blocks * points * sizeof(secp256k1_ge_storage));
+    secp256k1_ecmult_gen_compute_table(table, &secp256k1_ge_const_g, blocks, teeth, spacing);
+
+    fprintf(fp, "#elif (COMB_BLOCKS == %d) && (COMB_TEETH == %d) && (COMB_SPACING == %d)\n", blocks, teeth, spacing);
+    for (outer = 0; outer != blocks; outer++) {
+        fprintf(fp,"{");
+        for (inner = 0; inner != points; inner++) {
+            fprintf(fp, "S(%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32
+                        ",%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32")",
+                    SECP256K1_GE_STORAGE_CONST_GET(table[outer * points + inner]));
+            if (inner != points - 1) {
+                fprintf(fp,",\n");
+            }
+        }
+        if (outer != blocks - 1) {
+            fprintf(fp,"},\n");
+        } else {
+            fprintf(fp,"}\n");
+        }
+    }
+    free(table);
+}
+
 int main(int argc, char **argv) {
     const char outfile[] = "src/precomputed_ecmult_gen.c";
     FILE* fp;
-    int bits;
+    size_t config;
+    int did_current_config = 0;
 
     (void)argc;
     (void)argv;
@@ -44,36 +83,20 @@ int main(int argc, char **argv) {
     fprintf(fp, "#    error Cannot compile precomputed_ecmult_gen.c in exhaustive test mode\n");
     fprintf(fp, "#endif /* EXHAUSTIVE_TEST_ORDER */\n");
     fprintf(fp, "#define S(a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p) SECP256K1_GE_STORAGE_CONST(0x##a##u,0x##b##u,0x##c##u,0x##d##u,0x##e##u,0x##f##u,0x##g##u,0x##h##u,0x##i##u,0x##j##u,0x##k##u,0x##l##u,0x##m##u,0x##n##u,0x##o##u,0x##p##u)\n");
-    fprintf(fp, "const secp256k1_ge_storage secp256k1_ecmult_gen_prec_table[ECMULT_GEN_PREC_N(ECMULT_GEN_PREC_BITS)][ECMULT_GEN_PREC_G(ECMULT_GEN_PREC_BITS)] = {\n");
-
-    for (bits = 2; bits <= 8; bits *= 2) {
-        int g = ECMULT_GEN_PREC_G(bits);
-        int n = ECMULT_GEN_PREC_N(bits);
-        int inner, outer;
-
-        secp256k1_ge_storage* table = checked_malloc(&default_error_callback, n * g * sizeof(secp256k1_ge_storage));
-        secp256k1_ecmult_gen_compute_table(table, &secp256k1_ge_const_g, bits);
-
-        fprintf(fp, "#if ECMULT_GEN_PREC_BITS == %d\n", bits);
-        for(outer = 0; outer != n; outer++) {
-            fprintf(fp,"{");
-            for(inner = 0; inner != g; inner++) {
-                fprintf(fp, "S(%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32
-                            ",%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32",%"PRIx32")",
-                        SECP256K1_GE_STORAGE_CONST_GET(table[outer * g + inner]));
-                if (inner != g - 1) {
-                    fprintf(fp,",\n");
-                } 
-            }
-            if (outer != n - 1) {
-                fprintf(fp,"},\n");
-            } else {
-                fprintf(fp,"}\n");
-            }
+    fprintf(fp, "const secp256k1_ge_storage secp256k1_ecmult_gen_prec_table[COMB_BLOCKS][COMB_POINTS] = {\n");
+    fprintf(fp, "#if 0\n");
+    for (config = 0; config < sizeof(CONFIGS) / sizeof(*CONFIGS); ++config) {
+        print_table(fp, CONFIGS[config][0], CONFIGS[config][1]);
+        if (CONFIGS[config][0] == COMB_BLOCKS && CONFIGS[config][1] == COMB_TEETH) {
+            did_current_config = 1;
         }
-        fprintf(fp, "#endif\n");
-        free(table);
     }
+    if (!did_current_config) {
+        print_table(fp, COMB_BLOCKS, COMB_TEETH);
+    }
+    fprintf(fp, "#else\n");
+    fprintf(fp, "#    error Configuration mismatch, invalid COMB_* parameters. Try deleting precomputed_ecmult_gen.c before the build.\n");
+    fprintf(fp, "#endif\n");
 
     fprintf(fp, "};\n");
     fprintf(fp, "#undef S\n");
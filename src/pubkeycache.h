@@ -0,0 +1,46 @@
+/***********************************************************************
+ * Copyright (c) 2023 The libsecp256k1 developers                      *
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_PUBKEYCACHE_H
+#define SECP256K1_PUBKEYCACHE_H
+
+#include "group.h"
+#include "hash.h"
+#include "util.h"
+
+/** The number of entries in a set of the set-associative cache. */
+#define PUBKEYCACHE_WAYS 4
+
+/* The struct name is used in the public API. The cache maps the X coordinate
+ * of a point to the point. The point with X coordinate x is stored in one of
+ * the PUBKEYCACHE_WAYS entries of the set that is selected by a salted hash
+ * of x. An all-zero entry marks an empty slot. */
+struct secp256k1_pubkey_cache_struct {
+    /** SHA256 state after writing the tag and the salt */
+    secp256k1_sha256 hasher;
+    uint32_t n_sets;
+    secp256k1_ge_storage *entries;
+};
+
+/** Returns the number of sets that fit into size bytes, or 0 if not even a
+ *  single set fits. */
+static uint32_t secp256k1_pubkey_cache_n_sets(size_t size);
+
+/** Initializes an empty cache with n_sets sets in the memory pointed to by
+ *  entries, and with a hasher salted by salt32. */
+static void secp256k1_pubkey_cache_init(struct secp256k1_pubkey_cache_struct *cache, void *entries, uint32_t n_sets, const unsigned char *salt32);
+
+/** If the cache contains a point with X coordinate x, sets r to it and returns
+ *  1 (the Y coordinate can have either parity). Otherwise returns 0. Only
+ *  reads the cache, so it is safe to call concurrently with other lookups.
+ *  x must be normalized. */
+static int secp256k1_pubkey_cache_lookup(const struct secp256k1_pubkey_cache_struct *cache, secp256k1_ge *r, const secp256k1_fe *x);
+
+/** Inserts the point a into the cache, possibly replacing another entry. Must
+ *  not be called concurrently with any other function using the cache. */
+static void secp256k1_pubkey_cache_insert(struct secp256k1_pubkey_cache_struct *cache, const secp256k1_ge *a);
+
+#endif /* SECP256K1_PUBKEYCACHE_H */
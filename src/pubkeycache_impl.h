@@ -0,0 +1,92 @@
+/***********************************************************************
+ * Copyright (c) 2023 The libsecp256k1 developers                      *
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_PUBKEYCACHE_IMPL_H
+#define SECP256K1_PUBKEYCACHE_IMPL_H
+
+#include "pubkeycache.h"
+#include "group_impl.h"
+#include "hash_impl.h"
+#include "util.h"
+
+static const unsigned char secp256k1_pubkey_cache_tag[21] = "secp256k1/pubkeycache";
+
+static uint32_t secp256k1_pubkey_cache_n_sets(size_t size) {
+    size_t n = size / (PUBKEYCACHE_WAYS * sizeof(secp256k1_ge_storage));
+    return n > UINT32_MAX ? UINT32_MAX : (uint32_t)n;
+}
+
+static void secp256k1_pubkey_cache_init(struct secp256k1_pubkey_cache_struct *cache, void *entries, uint32_t n_sets, const unsigned char *salt32) {
+    VERIFY_CHECK(n_sets > 0);
+    secp256k1_sha256_initialize_tagged(&cache->hasher, secp256k1_pubkey_cache_tag, sizeof(secp256k1_pubkey_cache_tag));
+    secp256k1_sha256_write(&cache->hasher, salt32, 32);
+    cache->n_sets = n_sets;
+    cache->entries = (secp256k1_ge_storage *)entries;
+    memset(entries, 0, (size_t)n_sets * PUBKEYCACHE_WAYS * sizeof(secp256k1_ge_storage));
+}
+
+/* Returns a pointer to the set of entries for x, and sets way to the entry
+ * that is replaced on insertion if the set is full. */
+static secp256k1_ge_storage *secp256k1_pubkey_cache_set(const struct secp256k1_pubkey_cache_struct *cache, int *way, const secp256k1_fe *x) {
+    secp256k1_sha256 hash = cache->hasher;
+    unsigned char buf[32];
+    uint32_t set;
+
+    secp256k1_fe_get_b32(buf, x);
+    secp256k1_sha256_write(&hash, buf, 32);
+    secp256k1_sha256_finalize(&hash, buf);
+    /* Map to [0, n_sets) by a multiplication instead of a modular reduction */
+    set = ((uint64_t)secp256k1_read_be32(buf) * cache->n_sets) >> 32;
+    *way = buf[4] % PUBKEYCACHE_WAYS;
+    return &cache->entries[(size_t)set * PUBKEYCACHE_WAYS];
+}
+
+static int secp256k1_pubkey_cache_lookup(const struct secp256k1_pubkey_cache_struct *cache, secp256k1_ge *r, const secp256k1_fe *x) {
+    const secp256k1_ge_storage *set;
+    secp256k1_fe_storage xs;
+    int way, i;
+
+    /* All-zero entries are empty, so X = 0 must not be looked up. There is
+     * no point with X = 0 anyway. */
+    if (secp256k1_fe_is_zero(x)) {
+        return 0;
+    }
+    secp256k1_fe_to_storage(&xs, x);
+    set = secp256k1_pubkey_cache_set(cache, &way, x);
+    for (i = 0; i < PUBKEYCACHE_WAYS; i++) {
+        if (secp256k1_memcmp_var(&set[i].x, &xs, sizeof(xs)) == 0) {
+            secp256k1_ge_from_storage(r, &set[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void secp256k1_pubkey_cache_insert(struct secp256k1_pubkey_cache_struct *cache, const secp256k1_ge *a) {
+    static const secp256k1_ge_storage zero = {{{ 0 }}, {{ 0 }}};
+    secp256k1_ge_storage *set;
+    secp256k1_ge_storage as;
+    secp256k1_fe x = a->x;
+    int way, i;
+
+    secp256k1_fe_normalize_var(&x);
+    secp256k1_ge_to_storage(&as, a);
+    set = secp256k1_pubkey_cache_set(cache, &way, &x);
+    for (i = 0; i < PUBKEYCACHE_WAYS; i++) {
+        if (secp256k1_memcmp_var(&set[i].x, &as.x, sizeof(as.x)) == 0) {
+            return;
+        }
+    }
+    for (i = 0; i < PUBKEYCACHE_WAYS; i++) {
+        if (secp256k1_memcmp_var(&set[i], &zero, sizeof(zero)) == 0) {
+            way = i;
+            break;
+        }
+    }
+    set[way] = as;
+}
+
+#endif /* SECP256K1_PUBKEYCACHE_IMPL_H */
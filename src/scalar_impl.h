@@ -37,6 +37,28 @@ static int secp256k1_scalar_set_b32_seckey(secp256k1_scalar *r, const unsigned c
     return (!overflow) & (!secp256k1_scalar_is_zero(r));
 }
 
+static void secp256k1_scalar_inverse_all(secp256k1_scalar *r, const secp256k1_scalar *a, size_t len) {
+    secp256k1_scalar u;
+    size_t i;
+
+    if (len == 0) {
+        return;
+    }
+    /* Use r as scratch space for the products of the inputs */
+    r[0] = a[0];
+    for (i = 1; i < len; i++) {
+        secp256k1_scalar_mul(&r[i], &r[i - 1], &a[i]);
+    }
+    secp256k1_scalar_inverse(&u, &r[len - 1]);
+
+    for (i = len - 1; i > 0; i--) {
+        secp256k1_scalar_mul(&r[i], &r[i - 1], &u);
+        secp256k1_scalar_mul(&u, &u, &a[i]);
+    }
+    r[0] = u;
+    secp256k1_scalar_clear(&u);
+}
+
 /* These parameters are generated using sage/gen_exhaustive_groups.sage. */
 #if defined(EXHAUSTIVE_TEST_ORDER)
 #  if EXHAUSTIVE_TEST_ORDER == 13
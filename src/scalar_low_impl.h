@@ -25,6 +25,14 @@ SECP256K1_INLINE static unsigned int secp256k1_scalar_get_bits(const secp256k1_s
         return 0;
 }
 
+SECP256K1_INLINE static uint32_t secp256k1_scalar_get_bits_limb32(const secp256k1_scalar *a, unsigned int offset, unsigned int count) {
+    VERIFY_CHECK(count > 0 && count <= 32);
+    if (offset < 32)
+        return ((*a >> offset) & (0xFFFFFFFF >> (32 - count)));
+    else
+        return 0;
+}
+
 SECP256K1_INLINE static unsigned int secp256k1_scalar_get_bits_var(const secp256k1_scalar *a, unsigned int offset, unsigned int count) {
     return secp256k1_scalar_get_bits(a, offset, count);
 }
@@ -39,4 +39,11 @@ static size_t secp256k1_scratch_max_allocation(const secp256k1_callback* error_c
 /** Returns a pointer into the most recently allocated frame, or NULL if there is insufficient available space */
 static void *secp256k1_scratch_alloc(const secp256k1_callback* error_callback, secp256k1_scratch* scratch, size_t n);
 
+/** Allocates a scratch space with max_size bytes inside the most recently
+ *  allocated frame. The child can be used independently of the parent, e.g.,
+ *  by another thread, and is freed together with the frame. Requires two
+ *  objects worth of alignment padding. Returns NULL if there is insufficient
+ *  available space. */
+static secp256k1_scratch *secp256k1_scratch_alloc_child(const secp256k1_callback* error_callback, secp256k1_scratch* scratch, size_t max_size);
+
 #endif
@@ -96,4 +96,19 @@ static void *secp256k1_scratch_alloc(const secp256k1_callback* error_callback, s
     return ret;
 }
 
+static secp256k1_scratch *secp256k1_scratch_alloc_child(const secp256k1_callback* error_callback, secp256k1_scratch* scratch, size_t max_size) {
+    const size_t checkpoint = secp256k1_scratch_checkpoint(error_callback, scratch);
+    secp256k1_scratch *ret = (secp256k1_scratch *)secp256k1_scratch_alloc(error_callback, scratch, sizeof(secp256k1_scratch));
+    void *data = secp256k1_scratch_alloc(error_callback, scratch, max_size);
+
+    if (ret == NULL || data == NULL) {
+        secp256k1_scratch_apply_checkpoint(error_callback, scratch, checkpoint);
+        return NULL;
+    }
+    memcpy(ret->magic, "scratch", 8);
+    ret->data = data;
+    ret->max_size = max_size;
+    return ret;
+}
+
 #endif
@@ -32,8 +32,11 @@
 #include "ecdsa_impl.h"
 #include "eckey_impl.h"
 #include "hash_impl.h"
+#include "batch_verify_impl.h"
 #include "int128_impl.h"
 #include "scratch_impl.h"
+#include "sigcache_impl.h"
+#include "pubkeycache_impl.h"
 #include "selftest.h"
 
 #ifdef SECP256K1_NO_BUILD
@@ -79,6 +82,14 @@ void secp256k1_selftest(void) {
     }
 }
 
+/* The runtime generator table of a context created with SECP256K1_CONTEXT_LARGE_GEN_TABLE is
+ * stored in the same allocation, directly after the (aligned) context object. */
+static secp256k1_ge_storage *secp256k1_context_large_gen_table(secp256k1_context *ctx) {
+    return (secp256k1_ge_storage *)(void *)((char *)ctx + ROUND_TO_ALIGN(sizeof(secp256k1_context)));
+}
+
+static const size_t SECP256K1_CONTEXT_LARGE_GEN_TABLE_SIZE = ECMULT_GEN_LARGE_TABLE_SIZE * sizeof(secp256k1_ge_storage);
+
 size_t secp256k1_context_preallocated_size(unsigned int flags) {
     size_t ret = sizeof(secp256k1_context);
     /* A return value of 0 is reserved as an indicator for errors when we call this function internally. */
@@ -90,12 +101,19 @@ size_t secp256k1_context_preallocated_size(unsigned int flags) {
             return 0;
     }
 
+    if ((flags & SECP256K1_FLAGS_BIT_CONTEXT_LARGE_GEN_TABLE) && ECMULT_GEN_LARGE_TABLE_ENABLED) {
+        ret = ROUND_TO_ALIGN(sizeof(secp256k1_context)) + SECP256K1_CONTEXT_LARGE_GEN_TABLE_SIZE;
+    }
+
     return ret;
 }
 
 size_t secp256k1_context_preallocated_clone_size(const secp256k1_context* ctx) {
     size_t ret = sizeof(secp256k1_context);
     VERIFY_CHECK(ctx != NULL);
+    if (ctx->ecmult_gen_ctx.large_table != NULL) {
+        ret = ROUND_TO_ALIGN(sizeof(secp256k1_context)) + SECP256K1_CONTEXT_LARGE_GEN_TABLE_SIZE;
+    }
     return ret;
 }
 
@@ -104,6 +122,7 @@ secp256k1_context* secp256k1_context_preallocated_create(void* prealloc, unsigne
     secp256k1_context* ret;
 
     secp256k1_selftest();
+    secp256k1_cpu_features_init();
 
     prealloc_size = secp256k1_context_preallocated_size(flags);
     if (prealloc_size == 0) {
@@ -116,7 +135,8 @@ secp256k1_context* secp256k1_context_preallocated_create(void* prealloc, unsigne
 
     /* Flags have been checked by secp256k1_context_preallocated_size. */
     VERIFY_CHECK((flags & SECP256K1_FLAGS_TYPE_MASK) == SECP256K1_FLAGS_TYPE_CONTEXT);
-    secp256k1_ecmult_gen_context_build(&ret->ecmult_gen_ctx);
+    secp256k1_ecmult_gen_context_build(&ret->ecmult_gen_ctx,
+        ((flags & SECP256K1_FLAGS_BIT_CONTEXT_LARGE_GEN_TABLE) && ECMULT_GEN_LARGE_TABLE_ENABLED) ? secp256k1_context_large_gen_table(ret) : NULL);
     ret->declassify = !!(flags & SECP256K1_FLAGS_BIT_CONTEXT_DECLASSIFY);
 
     return ret;
@@ -140,6 +160,10 @@ secp256k1_context* secp256k1_context_preallocated_clone(const secp256k1_context*
 
     ret = (secp256k1_context*)prealloc;
     *ret = *ctx;
+    if (ctx->ecmult_gen_ctx.large_table != NULL) {
+        ret->ecmult_gen_ctx.large_table = secp256k1_context_large_gen_table(ret);
+        memcpy(ret->ecmult_gen_ctx.large_table, ctx->ecmult_gen_ctx.large_table, SECP256K1_CONTEXT_LARGE_GEN_TABLE_SIZE);
+    }
     return ret;
 }
 
@@ -261,6 +285,72 @@ int secp256k1_ec_pubkey_parse(const secp256k1_context* ctx, secp256k1_pubkey* pu
     return 1;
 }
 
+secp256k1_pubkey_cache *secp256k1_pubkey_cache_create(const secp256k1_context* ctx, size_t size, const unsigned char *salt32) {
+    const size_t base_alloc = ROUND_TO_ALIGN(sizeof(secp256k1_pubkey_cache));
+    const size_t set_size = PUBKEYCACHE_WAYS * sizeof(secp256k1_ge_storage);
+    uint32_t n_sets = secp256k1_pubkey_cache_n_sets(size);
+    secp256k1_pubkey_cache *cache;
+    void *alloc;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(salt32 != NULL);
+
+    if (n_sets == 0 || (size_t)n_sets > (SIZE_MAX - base_alloc) / set_size) {
+        return NULL;
+    }
+    alloc = checked_malloc(&ctx->error_callback, base_alloc + (size_t)n_sets * set_size);
+    if (alloc == NULL) {
+        return NULL;
+    }
+    cache = (secp256k1_pubkey_cache *)alloc;
+    secp256k1_pubkey_cache_init(cache, (char *)alloc + base_alloc, n_sets, salt32);
+    return cache;
+}
+
+void secp256k1_pubkey_cache_destroy(const secp256k1_context* ctx, secp256k1_pubkey_cache *cache) {
+    VERIFY_CHECK(ctx != NULL);
+    if (cache != NULL) {
+        free(cache);
+    }
+}
+
+int secp256k1_ec_pubkey_parse_cached(const secp256k1_context* ctx, secp256k1_pubkey_cache *cache, secp256k1_pubkey* pubkey, const unsigned char *input, size_t inputlen, int store) {
+    secp256k1_ge Q;
+    secp256k1_fe x;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(cache != NULL);
+    ARG_CHECK(pubkey != NULL);
+    memset(pubkey, 0, sizeof(*pubkey));
+    ARG_CHECK(input != NULL);
+    if (inputlen != 33 || (input[0] != SECP256K1_TAG_PUBKEY_EVEN && input[0] != SECP256K1_TAG_PUBKEY_ODD)) {
+        return secp256k1_ec_pubkey_parse(ctx, pubkey, input, inputlen);
+    }
+    if (!secp256k1_fe_set_b32(&x, input + 1)) {
+        return 0;
+    }
+    if (secp256k1_pubkey_cache_lookup(cache, &Q, &x)) {
+        /* The cached point has the right X coordinate, but not necessarily
+         * the right Y coordinate. */
+        secp256k1_fe_normalize_var(&Q.y);
+        if (secp256k1_fe_is_odd(&Q.y) != (input[0] == SECP256K1_TAG_PUBKEY_ODD)) {
+            secp256k1_ge_neg(&Q, &Q);
+        }
+    } else {
+        if (!secp256k1_eckey_pubkey_parse(&Q, input, inputlen)) {
+            return 0;
+        }
+        if (!secp256k1_ge_is_in_correct_subgroup(&Q)) {
+            return 0;
+        }
+        if (store) {
+            secp256k1_pubkey_cache_insert(cache, &Q);
+        }
+    }
+    secp256k1_pubkey_save(pubkey, &Q);
+    return 1;
+}
+
 int secp256k1_ec_pubkey_serialize(const secp256k1_context* ctx, unsigned char *output, size_t *outputlen, const secp256k1_pubkey* pubkey, unsigned int flags) {
     secp256k1_ge Q;
     size_t len;
@@ -431,12 +521,198 @@ int secp256k1_ecdsa_verify(const secp256k1_context* ctx, const secp256k1_ecdsa_s
             secp256k1_ecdsa_sig_verify(&r, &s, &q, &m));
 }
 
+int secp256k1_ecdsa_verify_many(const secp256k1_context* ctx, int *results, const secp256k1_ecdsa_signature * const *sigs, const unsigned char * const *msghash32s, const secp256k1_pubkey * const *pubkeys, size_t n) {
+    secp256k1_gej pubkeyj[4];
+    secp256k1_gej pr[4];
+    secp256k1_scalar sigr[4], u1[4], u2[4];
+    size_t idx[4];
+    size_t i, k, num;
+    int ret = 1;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(results != NULL);
+    memset(results, 0, n * sizeof(*results));
+    ARG_CHECK(n == 0 || sigs != NULL);
+    ARG_CHECK(n == 0 || msghash32s != NULL);
+    ARG_CHECK(n == 0 || pubkeys != NULL);
+    for (i = 0; i < n; i++) {
+        ARG_CHECK(sigs[i] != NULL);
+        ARG_CHECK(msghash32s[i] != NULL);
+        ARG_CHECK(pubkeys[i] != NULL);
+    }
+
+    i = 0;
+    while (i < n) {
+        /* Gather up to four signatures that pass the checks before the
+         * multiplication, and verify them together. */
+        num = 0;
+        for (; i < n && num < 4; i++) {
+            secp256k1_ge q;
+            secp256k1_scalar s, m;
+            secp256k1_scalar_set_b32(&m, msghash32s[i], NULL);
+            secp256k1_ecdsa_signature_load(ctx, &sigr[num], &s, sigs[i]);
+            if (secp256k1_scalar_is_high(&s) ||
+                !secp256k1_pubkey_load(ctx, &q, pubkeys[i]) ||
+                !secp256k1_ecdsa_sig_verify_prepare(&u1[num], &u2[num], &sigr[num], &s, &m)) {
+                ret = 0;
+                continue;
+            }
+            secp256k1_gej_set_ge(&pubkeyj[num], &q);
+            idx[num++] = i;
+        }
+        if (num == 0) {
+            break;
+        }
+        secp256k1_ecmult_many(pr, pubkeyj, u2, u1, num);
+        for (k = 0; k < num; k++) {
+            results[idx[k]] = secp256k1_ecdsa_sig_verify_check(&sigr[k], &pr[k]);
+            ret &= results[idx[k]];
+        }
+    }
+    return ret;
+}
+
+struct secp256k1_pubkey_precomp_struct {
+    secp256k1_ge_storage pubkey;
+    secp256k1_ge_storage pre[ECMULT_PUBKEY_PRECOMP_TABLE_SIZE];
+    secp256k1_ge_storage pre_lam[ECMULT_PUBKEY_PRECOMP_TABLE_SIZE];
+};
+
+secp256k1_pubkey_precomp *secp256k1_pubkey_precomp_create(const secp256k1_context* ctx, const secp256k1_pubkey *pubkey) {
+    secp256k1_pubkey_precomp *precomp;
+    secp256k1_ge q;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(pubkey != NULL);
+
+    if (!secp256k1_pubkey_load(ctx, &q, pubkey)) {
+        return NULL;
+    }
+    precomp = (secp256k1_pubkey_precomp *)checked_malloc(&ctx->error_callback, sizeof(*precomp));
+    if (precomp == NULL) {
+        return NULL;
+    }
+    secp256k1_ge_to_storage(&precomp->pubkey, &q);
+    secp256k1_ecmult_pubkey_precomp_table(precomp->pre, precomp->pre_lam, &q);
+    return precomp;
+}
+
+void secp256k1_pubkey_precomp_destroy(const secp256k1_context* ctx, secp256k1_pubkey_precomp *precomp) {
+    VERIFY_CHECK(ctx != NULL);
+    if (precomp != NULL) {
+        free(precomp);
+    }
+}
+
+int secp256k1_ecdsa_verify_precomp(const secp256k1_context* ctx, const secp256k1_ecdsa_signature *sig, const unsigned char *msghash32, const secp256k1_pubkey_precomp *precomp) {
+    secp256k1_scalar r, s;
+    secp256k1_scalar m;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(msghash32 != NULL);
+    ARG_CHECK(sig != NULL);
+    ARG_CHECK(precomp != NULL);
+
+    secp256k1_scalar_set_b32(&m, msghash32, NULL);
+    secp256k1_ecdsa_signature_load(ctx, &r, &s, sig);
+    return (!secp256k1_scalar_is_high(&s) &&
+            secp256k1_ecdsa_sig_verify_precomp(&r, &s, precomp->pre, precomp->pre_lam, &m));
+}
+
+secp256k1_sigcache *secp256k1_sigcache_create(const secp256k1_context* ctx, size_t size, const unsigned char *salt32) {
+    const size_t base_alloc = ROUND_TO_ALIGN(sizeof(secp256k1_sigcache));
+    uint32_t n_entries = secp256k1_sigcache_n_entries(size);
+    secp256k1_sigcache *cache;
+    void *alloc;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(salt32 != NULL);
+
+    if (n_entries == 0 || (size_t)n_entries * SIGCACHE_ENTRY_SIZE > SIZE_MAX - base_alloc) {
+        return NULL;
+    }
+    alloc = checked_malloc(&ctx->error_callback, base_alloc + (size_t)n_entries * SIGCACHE_ENTRY_SIZE);
+    if (alloc == NULL) {
+        return NULL;
+    }
+    cache = (secp256k1_sigcache *)alloc;
+    secp256k1_sigcache_init(cache, (char *)alloc + base_alloc, n_entries, salt32);
+    return cache;
+}
+
+void secp256k1_sigcache_destroy(const secp256k1_context* ctx, secp256k1_sigcache *cache) {
+    VERIFY_CHECK(ctx != NULL);
+    if (cache != NULL) {
+        free(cache);
+    }
+}
+
+/* Looks up key32 in the cache and updates the counters. */
+static int secp256k1_sigcache_lookup_stats(const secp256k1_sigcache *cache, secp256k1_sigcache_stats *stats, const unsigned char *key32) {
+    int found = secp256k1_sigcache_lookup(cache, key32);
+    if (stats != NULL) {
+        if (found) {
+            stats->hits++;
+        } else {
+            stats->misses++;
+        }
+    }
+    return found;
+}
+
+int secp256k1_ecdsa_verify_cached(const secp256k1_context* ctx, secp256k1_sigcache *cache, secp256k1_sigcache_stats *stats, const secp256k1_ecdsa_signature *sig, const unsigned char *msghash32, const secp256k1_pubkey *pubkey, int store) {
+    static const unsigned char type = 0;
+    secp256k1_sha256 hash;
+    unsigned char key[32];
+    unsigned char buf[32];
+    secp256k1_ge q;
+    secp256k1_scalar r, s;
+    secp256k1_scalar m;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(cache != NULL);
+    ARG_CHECK(msghash32 != NULL);
+    ARG_CHECK(sig != NULL);
+    ARG_CHECK(pubkey != NULL);
+
+    secp256k1_ecdsa_signature_load(ctx, &r, &s, sig);
+    if (secp256k1_scalar_is_high(&s) || !secp256k1_pubkey_load(ctx, &q, pubkey)) {
+        return 0;
+    }
+
+    /* The key is the salted hash of the type, the signature, the message and
+     * the public key. */
+    secp256k1_sigcache_hasher(cache, &hash);
+    secp256k1_sha256_write(&hash, &type, 1);
+    secp256k1_scalar_get_b32(buf, &r);
+    secp256k1_sha256_write(&hash, buf, 32);
+    secp256k1_scalar_get_b32(buf, &s);
+    secp256k1_sha256_write(&hash, buf, 32);
+    secp256k1_sha256_write(&hash, msghash32, 32);
+    secp256k1_fe_get_b32(buf, &q.x);
+    secp256k1_sha256_write(&hash, buf, 32);
+    secp256k1_fe_get_b32(buf, &q.y);
+    secp256k1_sha256_write(&hash, buf, 32);
+    secp256k1_sha256_finalize(&hash, key);
+
+    if (secp256k1_sigcache_lookup_stats(cache, stats, key)) {
+        return 1;
+    }
+    secp256k1_scalar_set_b32(&m, msghash32, NULL);
+    if (!secp256k1_ecdsa_sig_verify(&r, &s, &q, &m)) {
+        return 0;
+    }
+    if (store) {
+        secp256k1_sigcache_insert(cache, key);
+    }
+    return 1;
+}
+
 static SECP256K1_INLINE void buffer_append(unsigned char *buf, unsigned int *offset, const void *data, unsigned int len) {
     memcpy(buf + *offset, data, len);
     *offset += len;
 }
 
-static int nonce_function_rfc6979(unsigned char *nonce32, const unsigned char *msg32, const unsigned char *key32, const unsigned char *algo16, void *data, unsigned int counter) {
+/* Implementation of nonce_function_rfc6979 that continues from a state start returned by
+ * secp256k1_rfc6979_hmac_sha256_start for a prefix of key32 if start is not NULL. */
+static int nonce_function_rfc6979_from(unsigned char *nonce32, const unsigned char *msg32, const unsigned char *key32, const unsigned char *algo16, const void *data, unsigned int counter, const secp256k1_hmac_sha256 *start) {
    unsigned char keydata[112];
    unsigned int offset = 0;
    secp256k1_rfc6979_hmac_sha256 rng;
@@ -461,7 +737,11 @@ static int nonce_function_rfc6979(unsigned char *nonce32, const unsigned char *m
    if (algo16 != NULL) {
        buffer_append(keydata, &offset, algo16, 16);
    }
-   secp256k1_rfc6979_hmac_sha256_initialize(&rng, keydata, offset);
+   if (start != NULL) {
+       secp256k1_rfc6979_hmac_sha256_initialize_from(&rng, start, keydata, offset);
+   } else {
+       secp256k1_rfc6979_hmac_sha256_initialize(&rng, keydata, offset);
+   }
    memset(keydata, 0, sizeof(keydata));
    for (i = 0; i <= counter; i++) {
        secp256k1_rfc6979_hmac_sha256_generate(&rng, nonce32, 32);
@@ -470,6 +750,10 @@ static int nonce_function_rfc6979(unsigned char *nonce32, const unsigned char *m
    return 1;
 }
 
+static int nonce_function_rfc6979(unsigned char *nonce32, const unsigned char *msg32, const unsigned char *key32, const unsigned char *algo16, void *data, unsigned int counter) {
+   return nonce_function_rfc6979_from(nonce32, msg32, key32, algo16, data, counter, NULL);
+}
+
 const secp256k1_nonce_function secp256k1_nonce_function_rfc6979 = nonce_function_rfc6979;
 const secp256k1_nonce_function secp256k1_nonce_function_default = nonce_function_rfc6979;
 
@@ -543,6 +827,251 @@ int secp256k1_ecdsa_sign(const secp256k1_context* ctx, secp256k1_ecdsa_signature
     return ret;
 }
 
+/* The number of signatures for which secp256k1_ecdsa_sign_batch shares the
+ * inversions of the nonces and of the Z coordinates of the nonce points. */
+#define ECDSA_SIGN_BATCH_SIZE 32
+
+int secp256k1_ecdsa_sign_batch(const secp256k1_context* ctx, secp256k1_ecdsa_signature *signatures, const unsigned char * const *msghash32s, size_t n, const unsigned char *seckey, secp256k1_nonce_function noncefp, const void* noncedata) {
+    secp256k1_scalar non[ECDSA_SIGN_BATCH_SIZE], non_inv[ECDSA_SIGN_BATCH_SIZE];
+    secp256k1_gej rpj[ECDSA_SIGN_BATCH_SIZE];
+    secp256k1_ge rp[ECDSA_SIGN_BATCH_SIZE];
+    int is_valid[ECDSA_SIGN_BATCH_SIZE];
+    secp256k1_scalar sec, msg, r, s;
+    unsigned char nonce32[32];
+    int is_sec_valid;
+    int ret = 1;
+    size_t i, j;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(n == 0 || msghash32s != NULL);
+    ARG_CHECK(n == 0 || signatures != NULL);
+    ARG_CHECK(seckey != NULL);
+    for (i = 0; i < n; i++) {
+        ARG_CHECK(msghash32s[i] != NULL);
+    }
+    if (noncefp == NULL) {
+        noncefp = secp256k1_nonce_function_default;
+    }
+
+    /* Fail if the secret key is invalid. */
+    is_sec_valid = secp256k1_scalar_set_b32_seckey(&sec, seckey);
+    secp256k1_scalar_cmov(&sec, &secp256k1_scalar_one, !is_sec_valid);
+
+    for (i = 0; i < n; i += ECDSA_SIGN_BATCH_SIZE) {
+        size_t batch = n - i < ECDSA_SIGN_BATCH_SIZE ? n - i : ECDSA_SIGN_BATCH_SIZE;
+
+        /* Compute the nonce points for the first nonces (count = 0). */
+        for (j = 0; j < batch; j++) {
+            is_valid[j] = 0;
+            if (noncefp(nonce32, msghash32s[i + j], seckey, NULL, (void*)noncedata, 0)) {
+                is_valid[j] = secp256k1_scalar_set_b32_seckey(&non[j], nonce32);
+                /* The nonce is still secret here, but it being invalid is is less likely than 1:2^255. */
+                secp256k1_declassify(ctx, &is_valid[j], sizeof(is_valid[j]));
+            }
+            /* Use a dummy nonce if the nonce is invalid */
+            if (!is_valid[j]) {
+                non[j] = secp256k1_scalar_one;
+            }
+            secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &rpj[j], &non[j]);
+        }
+        secp256k1_ge_set_all_gej(rp, rpj, batch);
+        secp256k1_scalar_inverse_all(non_inv, non, batch);
+
+        for (j = 0; j < batch; j++) {
+            int sig_ret = 0;
+            secp256k1_scalar_set_b32(&msg, msghash32s[i + j], NULL);
+            if (is_valid[j]) {
+                sig_ret = secp256k1_ecdsa_sig_sign_finish(&r, &s, &rp[j], &sec, &msg, &non_inv[j], NULL);
+                /* The final signature is no longer a secret, nor is the fact that we were successful or not. */
+                secp256k1_declassify(ctx, &sig_ret, sizeof(sig_ret));
+            }
+            if (!sig_ret) {
+                /* The first nonce was invalid or resulted in an invalid
+                 * signature, or the nonce function failed. These cases are
+                 * rare, so just use the single-signature path, which tries
+                 * further nonces. */
+                sig_ret = secp256k1_ecdsa_sign_inner(ctx, &r, &s, NULL, msghash32s[i + j], seckey, noncefp, noncedata);
+            }
+            sig_ret &= is_sec_valid;
+            secp256k1_scalar_cmov(&r, &secp256k1_scalar_zero, !sig_ret);
+            secp256k1_scalar_cmov(&s, &secp256k1_scalar_zero, !sig_ret);
+            secp256k1_ecdsa_signature_save(&signatures[i + j], &r, &s);
+            ret &= sig_ret;
+        }
+    }
+
+    memset(nonce32, 0, 32);
+    for (j = 0; j < ECDSA_SIGN_BATCH_SIZE; j++) {
+        secp256k1_scalar_clear(&non[j]);
+        secp256k1_scalar_clear(&non_inv[j]);
+        secp256k1_gej_clear(&rpj[j]);
+        secp256k1_ge_clear(&rp[j]);
+    }
+    secp256k1_scalar_clear(&msg);
+    secp256k1_scalar_clear(&sec);
+    return ret;
+}
+
+/* A signing key stores the secret key (32 bytes), followed by the words of the inner
+ * (32 bytes) and outer (32 bytes) hash states of the first HMAC of the RFC6979 nonce
+ * derivation after the first SIGNING_KEY_PREFIX bytes of the secret key, at which point the
+ * inner hash has processed exactly two blocks and the outer hash one block. */
+#define SIGNING_KEY_PREFIX 31
+
+static void secp256k1_ecdsa_signing_key_load(secp256k1_hmac_sha256 *start, const secp256k1_ecdsa_signing_key *signing_key) {
+    int i;
+    for (i = 0; i < 8; i++) {
+        start->inner.s[i] = secp256k1_read_be32(&signing_key->data[32 + 4*i]);
+        start->outer.s[i] = secp256k1_read_be32(&signing_key->data[64 + 4*i]);
+    }
+    start->inner.bytes = 128;
+    start->outer.bytes = 64;
+}
+
+static void secp256k1_ecdsa_signing_key_save(secp256k1_ecdsa_signing_key *signing_key, const unsigned char *seckey, const secp256k1_hmac_sha256 *start) {
+    int i;
+    VERIFY_CHECK(start->inner.bytes == 128 && start->outer.bytes == 64);
+    memcpy(&signing_key->data[0], seckey, 32);
+    for (i = 0; i < 8; i++) {
+        secp256k1_write_be32(&signing_key->data[32 + 4*i], start->inner.s[i]);
+        secp256k1_write_be32(&signing_key->data[64 + 4*i], start->outer.s[i]);
+    }
+}
+
+int secp256k1_ecdsa_signing_key_create(const secp256k1_context* ctx, secp256k1_ecdsa_signing_key *signing_key, const unsigned char *seckey) {
+    secp256k1_hmac_sha256 start;
+    secp256k1_scalar sec;
+    int ret;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(signing_key != NULL);
+    memset(signing_key, 0, sizeof(*signing_key));
+    ARG_CHECK(seckey != NULL);
+
+    ret = secp256k1_scalar_set_b32_seckey(&sec, seckey);
+    secp256k1_rfc6979_hmac_sha256_start(&start, seckey, SIGNING_KEY_PREFIX);
+    secp256k1_ecdsa_signing_key_save(signing_key, seckey, &start);
+    secp256k1_memczero(signing_key, sizeof(*signing_key), !ret);
+
+    memset(&start, 0, sizeof(start));
+    secp256k1_scalar_clear(&sec);
+    return ret;
+}
+
+typedef struct {
+    secp256k1_hmac_sha256 start;
+    const void *ndata;
+} secp256k1_ecdsa_signing_key_nonce_data;
+
+/* Same as nonce_function_rfc6979, but continues from the precomputed state of a signing key. */
+static int nonce_function_rfc6979_signing_key(unsigned char *nonce32, const unsigned char *msg32, const unsigned char *key32, const unsigned char *algo16, void *data, unsigned int counter) {
+    const secp256k1_ecdsa_signing_key_nonce_data *nonce_data = (const secp256k1_ecdsa_signing_key_nonce_data *)data;
+    return nonce_function_rfc6979_from(nonce32, msg32, key32, algo16, nonce_data->ndata, counter, &nonce_data->start);
+}
+
+int secp256k1_ecdsa_sign_with_key(const secp256k1_context* ctx, secp256k1_ecdsa_signature *signature, const unsigned char *msghash32, const secp256k1_ecdsa_signing_key *signing_key, const unsigned char *ndata32) {
+    secp256k1_ecdsa_signing_key_nonce_data nonce_data;
+    secp256k1_scalar r, s;
+    int ret;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(msghash32 != NULL);
+    ARG_CHECK(signature != NULL);
+    ARG_CHECK(signing_key != NULL);
+
+    secp256k1_ecdsa_signing_key_load(&nonce_data.start, signing_key);
+    nonce_data.ndata = ndata32;
+    ret = secp256k1_ecdsa_sign_inner(ctx, &r, &s, NULL, msghash32, &signing_key->data[0], nonce_function_rfc6979_signing_key, &nonce_data);
+    secp256k1_ecdsa_signature_save(signature, &r, &s);
+    memset(&nonce_data, 0, sizeof(nonce_data));
+    return ret;
+}
+
+int secp256k1_ecdsa_sign_low_r(const secp256k1_context* ctx, secp256k1_ecdsa_signature *signature, const unsigned char *msghash32, const secp256k1_ecdsa_signing_key *signing_key) {
+    secp256k1_hmac_sha256 start;
+    secp256k1_scalar sec, msg, non, non_inv, r, s, n;
+    secp256k1_gej rpj;
+    secp256k1_ge rp;
+    unsigned char nonce32[32];
+    unsigned char extra[32] = {0};
+    unsigned char r32[32];
+    const unsigned char *seckey;
+    uint32_t counter = 0;
+    unsigned int count = 0;
+    int is_sec_valid;
+    int ret = 0;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(msghash32 != NULL);
+    ARG_CHECK(signature != NULL);
+    ARG_CHECK(signing_key != NULL);
+
+    seckey = &signing_key->data[0];
+    secp256k1_ecdsa_signing_key_load(&start, signing_key);
+    is_sec_valid = secp256k1_scalar_set_b32_seckey(&sec, seckey);
+    secp256k1_scalar_cmov(&sec, &secp256k1_scalar_one, !is_sec_valid);
+    secp256k1_scalar_set_b32(&msg, msghash32, NULL);
+    while (1) {
+        int is_nonce_valid, is_sig_valid, is_low_r;
+        /* The same nonces as secp256k1_ecdsa_sign_with_key with extra entropy NULL for the
+         * first attempt and the attempt counter afterwards, and the same retries within an
+         * attempt if the nonce or the signature are invalid. */
+        nonce_function_rfc6979_from(nonce32, msghash32, seckey, NULL, counter ? extra : NULL, count, &start);
+        is_nonce_valid = secp256k1_scalar_set_b32_seckey(&non, nonce32);
+        /* The nonce is still secret here, but it being invalid is is less likely than 1:2^255. */
+        secp256k1_declassify(ctx, &is_nonce_valid, sizeof(is_nonce_valid));
+        if (is_nonce_valid) {
+            secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &rpj, &non);
+            secp256k1_ge_set_gej(&rp, &rpj);
+            secp256k1_fe_normalize(&rp.x);
+            secp256k1_fe_get_b32(r32, &rp.x);
+            secp256k1_scalar_set_b32(&r, r32, NULL);
+            secp256k1_scalar_mul(&n, &r, &sec);
+            secp256k1_scalar_add(&n, &n, &msg);
+            /* These are the conditions under which secp256k1_ecdsa_sig_sign fails, checked
+             * without computing s. Like its result, they are not secret. */
+            is_sig_valid = !secp256k1_scalar_is_zero(&r) & !secp256k1_scalar_is_zero(&n);
+            secp256k1_declassify(ctx, &is_sig_valid, sizeof(is_sig_valid));
+            if (is_sig_valid) {
+                /* R of a rejected nonce is no more secret than R of an accepted one. Like
+                 * Bitcoin Core, test the serialized r = x mod n rather than x itself. */
+                secp256k1_scalar_get_b32(r32, &r);
+                is_low_r = r32[0] < 0x80;
+                secp256k1_declassify(ctx, &is_low_r, sizeof(is_low_r));
+                if (is_low_r) {
+                    secp256k1_scalar_inverse(&non_inv, &non);
+                    ret = secp256k1_ecdsa_sig_sign_finish(&r, &s, &rp, &sec, &msg, &non_inv, NULL);
+                    secp256k1_declassify(ctx, &ret, sizeof(ret));
+                    break;
+                }
+                /* The counter is written in little endian, like Bitcoin Core does. */
+                counter++;
+                extra[0] = counter;
+                extra[1] = counter >> 8;
+                extra[2] = counter >> 16;
+                extra[3] = counter >> 24;
+                count = 0;
+                continue;
+            }
+        }
+        count++;
+    }
+    /* See secp256k1_ecdsa_sign_inner. */
+    ret &= is_sec_valid;
+    memset(nonce32, 0, 32);
+    memset(&start, 0, sizeof(start));
+    secp256k1_scalar_clear(&msg);
+    secp256k1_scalar_clear(&non);
+    secp256k1_scalar_clear(&non_inv);
+    secp256k1_scalar_clear(&n);
+    secp256k1_scalar_clear(&sec);
+    secp256k1_gej_clear(&rpj);
+    secp256k1_ge_clear(&rp);
+    secp256k1_scalar_cmov(&r, &secp256k1_scalar_zero, !ret);
+    secp256k1_scalar_cmov(&s, &secp256k1_scalar_zero, !ret);
+    secp256k1_ecdsa_signature_save(signature, &r, &s);
+    return ret;
+}
+
 int secp256k1_ec_seckey_verify(const secp256k1_context* ctx, const unsigned char *seckey) {
     secp256k1_scalar sec;
     int ret;
@@ -566,6 +1095,36 @@ static int secp256k1_ec_pubkey_create_helper(const secp256k1_ecmult_gen_context
     return ret;
 }
 
+/* The number of public keys that secp256k1_ec_pubkey_create_batch_helper
+ * converts to affine coordinates with a single field inversion. */
+#define PUBKEY_CREATE_BATCH_SIZE 32
+
+/* Same as secp256k1_ec_pubkey_create_helper for n secret keys, but all points
+ * are converted to affine coordinates with a single inversion. Writes the
+ * return values of the individual computations to ret.
+ *
+ * The shared inversion does not need extra blinding: secp256k1_ecmult_gen
+ * already gives every result a random Z coordinate (the projective blinding
+ * factor of the context), so the product of the Z coordinates that is
+ * inverted by secp256k1_ge_set_all_gej does not only depend on the secret
+ * keys. */
+static void secp256k1_ec_pubkey_create_batch_helper(const secp256k1_ecmult_gen_context *ecmult_gen_ctx, secp256k1_scalar *seckey_scalars, secp256k1_ge *p, int *ret, const unsigned char * const *seckeys, size_t n) {
+    secp256k1_gej pj[PUBKEY_CREATE_BATCH_SIZE];
+    size_t i;
+
+    VERIFY_CHECK(n > 0 && n <= PUBKEY_CREATE_BATCH_SIZE);
+    for (i = 0; i < n; i++) {
+        ret[i] = secp256k1_scalar_set_b32_seckey(&seckey_scalars[i], seckeys[i]);
+        secp256k1_scalar_cmov(&seckey_scalars[i], &secp256k1_scalar_one, !ret[i]);
+        secp256k1_ecmult_gen(ecmult_gen_ctx, &pj[i], &seckey_scalars[i]);
+    }
+    secp256k1_ge_set_all_gej(p, pj, n);
+
+    for (i = 0; i < n; i++) {
+        secp256k1_gej_clear(&pj[i]);
+    }
+}
+
 int secp256k1_ec_pubkey_create(const secp256k1_context* ctx, secp256k1_pubkey *pubkey, const unsigned char *seckey) {
     secp256k1_ge p;
     secp256k1_scalar seckey_scalar;
@@ -584,6 +1143,106 @@ int secp256k1_ec_pubkey_create(const secp256k1_context* ctx, secp256k1_pubkey *p
     return ret;
 }
 
+int secp256k1_ec_pubkey_create_batch(const secp256k1_context* ctx, secp256k1_pubkey *pubkeys, const unsigned char * const *seckeys, size_t n) {
+    secp256k1_ge p[PUBKEY_CREATE_BATCH_SIZE];
+    secp256k1_scalar seckey_scalars[PUBKEY_CREATE_BATCH_SIZE];
+    int rets[PUBKEY_CREATE_BATCH_SIZE];
+    int ret = 1;
+    size_t i, j;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(n == 0 || pubkeys != NULL);
+    if (n > 0) {
+        memset(pubkeys, 0, n * sizeof(*pubkeys));
+    }
+    ARG_CHECK(secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(n == 0 || seckeys != NULL);
+    for (i = 0; i < n; i++) {
+        ARG_CHECK(seckeys[i] != NULL);
+    }
+
+    for (i = 0; i < n; i += PUBKEY_CREATE_BATCH_SIZE) {
+        size_t batch = n - i < PUBKEY_CREATE_BATCH_SIZE ? n - i : PUBKEY_CREATE_BATCH_SIZE;
+        secp256k1_ec_pubkey_create_batch_helper(&ctx->ecmult_gen_ctx, seckey_scalars, p, rets, &seckeys[i], batch);
+        for (j = 0; j < batch; j++) {
+            secp256k1_pubkey_save(&pubkeys[i + j], &p[j]);
+            secp256k1_memczero(&pubkeys[i + j], sizeof(pubkeys[i + j]), !rets[j]);
+            ret &= rets[j];
+        }
+    }
+
+    for (j = 0; j < PUBKEY_CREATE_BATCH_SIZE; j++) {
+        secp256k1_scalar_clear(&seckey_scalars[j]);
+    }
+    return ret;
+}
+
+/* The number of public keys that secp256k1_ec_pubkey_create_sequence
+ * converts to affine coordinates with a single field inversion. */
+#define PUBKEY_SEQUENCE_BLOCK_SIZE 64
+
+int secp256k1_ec_pubkey_create_sequence(const secp256k1_context* ctx, secp256k1_pubkey *pubkeys, const unsigned char *seckey, const unsigned char *step32, size_t n) {
+    secp256k1_gej pj[PUBKEY_SEQUENCE_BLOCK_SIZE];
+    secp256k1_ge p[PUBKEY_SEQUENCE_BLOCK_SIZE];
+    secp256k1_gej accj, stepj;
+    secp256k1_ge step;
+    secp256k1_scalar k, t;
+    int overflow = 0;
+    int ret;
+    size_t i, j;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(n == 0 || pubkeys != NULL);
+    if (n > 0) {
+        memset(pubkeys, 0, n * sizeof(*pubkeys));
+    }
+    ARG_CHECK(secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(seckey != NULL);
+    ARG_CHECK(step32 != NULL);
+
+    ret = secp256k1_scalar_set_b32_seckey(&k, seckey);
+    secp256k1_scalar_set_b32(&t, step32, &overflow);
+    ret &= !overflow;
+    /* Whether the inputs are valid is revealed by the return value anyway. */
+    secp256k1_declassify(ctx, &ret, sizeof(ret));
+    if (!ret || n == 0) {
+        secp256k1_scalar_clear(&k);
+        secp256k1_scalar_clear(&t);
+        return ret;
+    }
+
+    /* Only the first point and the step point are computed from the secret
+     * scalars, in constant time. All following points are sums of public
+     * points, so they can be computed with variable-time additions. */
+    secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &accj, &k);
+    secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &stepj, &t);
+    secp256k1_ge_set_gej(&step, &stepj);
+    secp256k1_scalar_clear(&k);
+    secp256k1_scalar_clear(&t);
+
+    /* We declassify accj and step to allow using them as branch points in the
+     * variable-time additions. This is fine because the first public key and
+     * the difference between consecutive public keys are not secret. */
+    secp256k1_declassify(ctx, &accj, sizeof(accj));
+    secp256k1_declassify(ctx, &step, sizeof(step));
+
+    for (i = 0; i < n; i += PUBKEY_SEQUENCE_BLOCK_SIZE) {
+        size_t block = n - i < PUBKEY_SEQUENCE_BLOCK_SIZE ? n - i : PUBKEY_SEQUENCE_BLOCK_SIZE;
+        for (j = 0; j < block; j++) {
+            pj[j] = accj;
+            secp256k1_gej_add_ge_var(&accj, &accj, &step, NULL);
+        }
+        secp256k1_ge_set_all_gej_var(p, pj, block);
+        for (j = 0; j < block; j++) {
+            /* The secret key seckey + (i + j)*step is zero */
+            if (secp256k1_ge_is_infinity(&p[j])) {
+                ret = 0;
+                continue;
+            }
+            secp256k1_pubkey_save(&pubkeys[i + j], &p[j]);
+        }
+    }
+    return ret;
+}
+
 int secp256k1_ec_seckey_negate(const secp256k1_context* ctx, unsigned char *seckey) {
     secp256k1_scalar sec;
     int ret = 0;
@@ -768,6 +1427,99 @@ int secp256k1_tagged_sha256(const secp256k1_context* ctx, unsigned char *hash32,
     return 1;
 }
 
+int secp256k1_tagged_sha256_batch(const secp256k1_context* ctx, unsigned char * const *hash32s, const unsigned char *tag, size_t taglen, const unsigned char * const *msgs, size_t msglen, size_t n) {
+    secp256k1_sha256 sha;
+    size_t i;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(tag != NULL);
+    ARG_CHECK(n == 0 || hash32s != NULL);
+    ARG_CHECK(n == 0 || msgs != NULL);
+    for (i = 0; i < n; i++) {
+        ARG_CHECK(hash32s[i] != NULL);
+        ARG_CHECK(msgs[i] != NULL);
+    }
+
+    secp256k1_sha256_initialize_tagged(&sha, tag, taglen);
+    secp256k1_sha256_many(hash32s, &sha, msgs, msglen, n);
+    return 1;
+}
+
+/* A tagged hasher stores the words of the state after the tag prefix (32 bytes), followed
+ * by the words (32 bytes), buffer (64 bytes) and byte count (8 bytes) of the current hash. */
+static void secp256k1_tagged_hasher_load(secp256k1_sha256 *mid, secp256k1_sha256 *cur, const secp256k1_tagged_hasher *hasher) {
+    int i;
+    for (i = 0; i < 8; i++) {
+        mid->s[i] = secp256k1_read_be32(&hasher->data[4*i]);
+    }
+    memset(mid->buf, 0, sizeof(mid->buf));
+    mid->bytes = 64;
+    if (cur != NULL) {
+        for (i = 0; i < 8; i++) {
+            cur->s[i] = secp256k1_read_be32(&hasher->data[32 + 4*i]);
+        }
+        memcpy(cur->buf, &hasher->data[64], 64);
+        cur->bytes = (uint64_t)secp256k1_read_be32(&hasher->data[128]) << 32 | secp256k1_read_be32(&hasher->data[132]);
+    }
+}
+
+static void secp256k1_tagged_hasher_save(secp256k1_tagged_hasher *hasher, const secp256k1_sha256 *mid, const secp256k1_sha256 *cur) {
+    int i;
+    for (i = 0; i < 8; i++) {
+        secp256k1_write_be32(&hasher->data[4*i], mid->s[i]);
+        secp256k1_write_be32(&hasher->data[32 + 4*i], cur->s[i]);
+    }
+    memcpy(&hasher->data[64], cur->buf, 64);
+    secp256k1_write_be64(&hasher->data[128], cur->bytes);
+}
+
+int secp256k1_tagged_hasher_init(const secp256k1_context* ctx, secp256k1_tagged_hasher *hasher, const unsigned char *tag, size_t taglen) {
+    secp256k1_sha256 sha;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(hasher != NULL);
+    ARG_CHECK(tag != NULL);
+
+    secp256k1_sha256_initialize_tagged(&sha, tag, taglen);
+    secp256k1_tagged_hasher_save(hasher, &sha, &sha);
+    return 1;
+}
+
+int secp256k1_tagged_hasher_hash(const secp256k1_context* ctx, unsigned char *hash32, const secp256k1_tagged_hasher *hasher, const unsigned char *msg, size_t msglen) {
+    secp256k1_sha256 sha;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(hash32 != NULL);
+    ARG_CHECK(hasher != NULL);
+    ARG_CHECK(msg != NULL);
+
+    secp256k1_tagged_hasher_load(&sha, NULL, hasher);
+    secp256k1_sha256_write(&sha, msg, msglen);
+    secp256k1_sha256_finalize(&sha, hash32);
+    return 1;
+}
+
+int secp256k1_tagged_hasher_write(const secp256k1_context* ctx, secp256k1_tagged_hasher *hasher, const unsigned char *data, size_t len) {
+    secp256k1_sha256 mid, cur;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(hasher != NULL);
+    ARG_CHECK(data != NULL);
+
+    secp256k1_tagged_hasher_load(&mid, &cur, hasher);
+    secp256k1_sha256_write(&cur, data, len);
+    secp256k1_tagged_hasher_save(hasher, &mid, &cur);
+    return 1;
+}
+
+int secp256k1_tagged_hasher_finalize(const secp256k1_context* ctx, unsigned char *hash32, secp256k1_tagged_hasher *hasher) {
+    secp256k1_sha256 mid, cur;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(hash32 != NULL);
+    ARG_CHECK(hasher != NULL);
+
+    secp256k1_tagged_hasher_load(&mid, &cur, hasher);
+    secp256k1_sha256_finalize(&cur, hash32);
+    secp256k1_tagged_hasher_save(hasher, &mid, &mid);
+    return 1;
+}
+
 #ifdef ENABLE_MODULE_ECDH
 # include "modules/ecdh/main_impl.h"
 #endif
@@ -776,6 +1528,10 @@ int secp256k1_tagged_sha256(const secp256k1_context* ctx, unsigned char *hash32,
 # include "modules/recovery/main_impl.h"
 #endif
 
+#ifdef ENABLE_MODULE_ECMULT
+# include "modules/ecmult/main_impl.h"
+#endif
+
 #ifdef ENABLE_MODULE_EXTRAKEYS
 # include "modules/extrakeys/main_impl.h"
 #endif
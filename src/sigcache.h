@@ -0,0 +1,50 @@
+/***********************************************************************
+ * Copyright (c) 2023 The libsecp256k1 developers                      *
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_SIGCACHE_H
+#define SECP256K1_SIGCACHE_H
+
+#include "hash.h"
+#include "util.h"
+
+/** The number of candidate slots of an entry in the cuckoo hash table. */
+#define SIGCACHE_WAYS 4
+/** The maximum number of entries that are moved to make room for a new one
+ *  before the last moved entry is dropped from the cache. */
+#define SIGCACHE_MAX_KICKS 16
+#define SIGCACHE_ENTRY_SIZE 32
+
+/* The struct name is used in the public API. The table consists of n_entries
+ * salted 32-byte hashes of verified signatures, where the all-zero value
+ * marks an empty slot. */
+struct secp256k1_sigcache_struct {
+    /** SHA256 state after writing the tag and the salt */
+    secp256k1_sha256 hasher;
+    uint32_t n_entries;
+    unsigned char (*entries)[SIGCACHE_ENTRY_SIZE];
+};
+
+/** Returns the number of entries that fit into size bytes, or 0 if not even a
+ *  single entry fits. */
+static uint32_t secp256k1_sigcache_n_entries(size_t size);
+
+/** Initializes an empty cache with n_entries entries in the memory pointed to
+ *  by entries, and with a hasher salted by salt32. */
+static void secp256k1_sigcache_init(struct secp256k1_sigcache_struct *cache, void *entries, uint32_t n_entries, const unsigned char *salt32);
+
+/** Initializes hash with the salted hasher of the cache. The cache key of an
+ *  item is the 32-byte output of the hash after writing the item. */
+static void secp256k1_sigcache_hasher(const struct secp256k1_sigcache_struct *cache, secp256k1_sha256 *hash);
+
+/** Returns whether key32 is in the cache. Only reads the cache, so it is safe
+ *  to call concurrently with other lookups. */
+static int secp256k1_sigcache_lookup(const struct secp256k1_sigcache_struct *cache, const unsigned char *key32);
+
+/** Inserts key32 into the cache, possibly dropping another entry. Must not be
+ *  called concurrently with any other function using the cache. */
+static void secp256k1_sigcache_insert(struct secp256k1_sigcache_struct *cache, const unsigned char *key32);
+
+#endif /* SECP256K1_SIGCACHE_H */
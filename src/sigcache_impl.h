@@ -0,0 +1,99 @@
+/***********************************************************************
+ * Copyright (c) 2023 The libsecp256k1 developers                      *
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_SIGCACHE_IMPL_H
+#define SECP256K1_SIGCACHE_IMPL_H
+
+#include "sigcache.h"
+#include "hash_impl.h"
+#include "util.h"
+
+static const unsigned char secp256k1_sigcache_tag[18] = "secp256k1/sigcache";
+
+static uint32_t secp256k1_sigcache_n_entries(size_t size) {
+    size_t n = size / SIGCACHE_ENTRY_SIZE;
+    return n > UINT32_MAX ? UINT32_MAX : (uint32_t)n;
+}
+
+static void secp256k1_sigcache_init(struct secp256k1_sigcache_struct *cache, void *entries, uint32_t n_entries, const unsigned char *salt32) {
+    VERIFY_CHECK(n_entries > 0);
+    secp256k1_sha256_initialize_tagged(&cache->hasher, secp256k1_sigcache_tag, sizeof(secp256k1_sigcache_tag));
+    secp256k1_sha256_write(&cache->hasher, salt32, 32);
+    cache->n_entries = n_entries;
+    cache->entries = (unsigned char (*)[SIGCACHE_ENTRY_SIZE])entries;
+    memset(entries, 0, (size_t)n_entries * SIGCACHE_ENTRY_SIZE);
+}
+
+static void secp256k1_sigcache_hasher(const struct secp256k1_sigcache_struct *cache, secp256k1_sha256 *hash) {
+    *hash = cache->hasher;
+}
+
+/* Returns the slot for the i-th way of key32. The key is a uniformly random
+ * hash, so every way uses 32 bits of it, which are mapped to
+ * [0, n_entries) by a multiplication instead of a modular reduction. */
+static uint32_t secp256k1_sigcache_slot(const struct secp256k1_sigcache_struct *cache, const unsigned char *key32, int i) {
+    return ((uint64_t)secp256k1_read_be32(&key32[4 * i]) * cache->n_entries) >> 32;
+}
+
+static int secp256k1_sigcache_is_empty(const unsigned char *entry) {
+    static const unsigned char zero[SIGCACHE_ENTRY_SIZE] = { 0 };
+    return secp256k1_memcmp_var(entry, zero, SIGCACHE_ENTRY_SIZE) == 0;
+}
+
+static int secp256k1_sigcache_lookup(const struct secp256k1_sigcache_struct *cache, const unsigned char *key32) {
+    int i;
+    for (i = 0; i < SIGCACHE_WAYS; i++) {
+        if (secp256k1_memcmp_var(cache->entries[secp256k1_sigcache_slot(cache, key32, i)], key32, SIGCACHE_ENTRY_SIZE) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void secp256k1_sigcache_insert(struct secp256k1_sigcache_struct *cache, const unsigned char *key32) {
+    unsigned char key[SIGCACHE_ENTRY_SIZE];
+    unsigned char tmp[SIGCACHE_ENTRY_SIZE];
+    uint32_t first_slot = cache->n_entries;
+    uint32_t prev_slot = cache->n_entries;
+    int kick, i, j;
+
+    memcpy(key, key32, SIGCACHE_ENTRY_SIZE);
+    for (kick = 0; kick < SIGCACHE_MAX_KICKS; kick++) {
+        uint32_t slot = cache->n_entries;
+        for (i = 0; i < SIGCACHE_WAYS; i++) {
+            unsigned char *entry = cache->entries[secp256k1_sigcache_slot(cache, key, i)];
+            if (secp256k1_sigcache_is_empty(entry) || secp256k1_memcmp_var(entry, key, SIGCACHE_ENTRY_SIZE) == 0) {
+                memcpy(entry, key, SIGCACHE_ENTRY_SIZE);
+                return;
+            }
+        }
+        /* All candidate slots are occupied. Evict the entry from a candidate
+         * slot that depends on the key and the number of kicks, and continue
+         * with the evicted entry. The slot the key has just been moved from is
+         * skipped, and so is the slot of the new entry, which is never
+         * evicted. */
+        for (j = 0; j < SIGCACHE_WAYS; j++) {
+            uint32_t candidate = secp256k1_sigcache_slot(cache, key, (key[16] + kick + j) % SIGCACHE_WAYS);
+            if (candidate != prev_slot && candidate != first_slot) {
+                slot = candidate;
+                break;
+            }
+        }
+        if (slot == cache->n_entries) {
+            break;
+        }
+        memcpy(tmp, cache->entries[slot], SIGCACHE_ENTRY_SIZE);
+        memcpy(cache->entries[slot], key, SIGCACHE_ENTRY_SIZE);
+        memcpy(key, tmp, SIGCACHE_ENTRY_SIZE);
+        if (kick == 0) {
+            first_slot = slot;
+        }
+        prev_slot = slot;
+    }
+    /* The last evicted entry is dropped. */
+}
+
+#endif /* SECP256K1_SIGCACHE_IMPL_H */
@@ -434,6 +434,24 @@ void run_scratch_tests(void) {
     CHECK(secp256k1_scratch_alloc(&none->error_callback, scratch, SIZE_MAX) == NULL);
     secp256k1_scratch_space_destroy(none, scratch);
 
+    /* Test child scratch spaces */
+    scratch = secp256k1_scratch_space_create(none, 1000);
+    checkpoint = secp256k1_scratch_checkpoint(&none->error_callback, scratch);
+    {
+        secp256k1_scratch *child = secp256k1_scratch_alloc_child(&none->error_callback, scratch, adj_alloc);
+        CHECK(child != NULL);
+        CHECK(secp256k1_scratch_max_allocation(&none->error_callback, child, 0) == adj_alloc);
+        CHECK(secp256k1_scratch_alloc(&none->error_callback, child, 500) != NULL);
+        CHECK(secp256k1_scratch_alloc(&none->error_callback, child, 1) == NULL);
+        CHECK(secp256k1_scratch_max_allocation(&none->error_callback, scratch, 0) == 1000 - adj_alloc - ROUND_TO_ALIGN(sizeof(secp256k1_scratch)));
+        /* The parent is unchanged if the child does not fit */
+        CHECK(secp256k1_scratch_alloc_child(&none->error_callback, scratch, 500) == NULL);
+        CHECK(secp256k1_scratch_max_allocation(&none->error_callback, scratch, 0) == 1000 - adj_alloc - ROUND_TO_ALIGN(sizeof(secp256k1_scratch)));
+    }
+    secp256k1_scratch_apply_checkpoint(&none->error_callback, scratch, checkpoint);
+    CHECK(ecount == 5);
+    secp256k1_scratch_space_destroy(none, scratch);
+
     /* cleanup */
     secp256k1_scratch_space_destroy(none, NULL); /* no-op */
     secp256k1_context_destroy(none);
@@ -459,6 +477,20 @@ void run_ctz_tests(void) {
     }
 }
 
+void run_rotr32_tests(void) {
+    static const uint32_t b32[] = {1, 0xffffffff, 0x5e56968f, 0xe0d63129};
+    unsigned i;
+    unsigned int by;
+    CHECK(secp256k1_rotr32(0x12345678, 0) == 0x12345678);
+    CHECK(secp256k1_rotr32(0x12345678, 8) == 0x78123456);
+    CHECK(secp256k1_rotr32(0x12345678, 31) == 0x2468acf0);
+    for (i = 0; i < sizeof(b32) / sizeof(b32[0]); ++i) {
+        for (by = 1; by < 32; ++by) {
+            CHECK(secp256k1_rotr32(b32[i], by) == ((b32[i] >> by) | (b32[i] << (32 - by))));
+        }
+    }
+}
+
 /***** HASH TESTS *****/
 
 void run_sha256_known_output_tests(void) {
@@ -518,6 +550,37 @@ void run_sha256_known_output_tests(void) {
     }
 }
 
+/* Compares the SHA-256 transform implementations on random states and blocks. */
+void run_sha256_transform_tests(void) {
+    uint32_t s[8], r[8], r2[8];
+    unsigned char buf[64];
+    int i;
+
+    for (i = 0; i < count * 16; i++) {
+        secp256k1_testrand_bytes_test((unsigned char *)s, sizeof(s));
+        secp256k1_testrand_bytes_test(buf, sizeof(buf));
+        memcpy(r, s, sizeof(r));
+        secp256k1_sha256_transform_portable(r, buf);
+        memcpy(r2, s, sizeof(r2));
+        secp256k1_sha256_transform(r2, buf);
+        CHECK(memcmp(r, r2, sizeof(r)) == 0);
+#ifdef USE_X86_SHANI
+        if (secp256k1_cpu_has_shani()) {
+            memcpy(r2, s, sizeof(r2));
+            secp256k1_sha256_transform_shani(r2, buf);
+            CHECK(memcmp(r, r2, sizeof(r)) == 0);
+        }
+#endif
+#ifdef USE_X86_SIMD
+        if (secp256k1_cpu_has_sse4()) {
+            memcpy(r2, s, sizeof(r2));
+            secp256k1_sha256_transform_sse4(r2, buf);
+            CHECK(memcmp(r, r2, sizeof(r)) == 0);
+        }
+#endif
+    }
+}
+
 /** SHA256 counter tests
 
 The tests verify that the SHA256 counter doesn't wrap around at message length
@@ -680,8 +743,10 @@ void run_rfc6979_hmac_sha256_tests(void) {
     };
 
     secp256k1_rfc6979_hmac_sha256 rng;
+    secp256k1_hmac_sha256 start;
     unsigned char out[32];
     int i;
+    size_t j;
 
     secp256k1_rfc6979_hmac_sha256_initialize(&rng, key1, 64);
     for (i = 0; i < 3; i++) {
@@ -703,6 +768,15 @@ void run_rfc6979_hmac_sha256_tests(void) {
         CHECK(secp256k1_memcmp_var(out, out2[i], 32) == 0);
     }
     secp256k1_rfc6979_hmac_sha256_finalize(&rng);
+
+    /* Continuing from a precomputed prefix of the key gives the same output */
+    for (j = 0; j <= 64; j++) {
+        secp256k1_rfc6979_hmac_sha256_start(&start, key1, j);
+        secp256k1_rfc6979_hmac_sha256_initialize_from(&rng, &start, key1, 64);
+        secp256k1_rfc6979_hmac_sha256_generate(&rng, out, 32);
+        CHECK(secp256k1_memcmp_var(out, out1[0], 32) == 0);
+        secp256k1_rfc6979_hmac_sha256_finalize(&rng);
+    }
 }
 
 void run_tagged_sha256_tests(void) {
@@ -737,6 +811,157 @@ void run_tagged_sha256_tests(void) {
     secp256k1_context_destroy(none);
 }
 
+void run_tagged_hasher_tests(void) {
+    int ecount = 0;
+    secp256k1_context *none = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    secp256k1_tagged_hasher hasher, hasher2;
+    unsigned char tag[40];
+    unsigned char msg[150];
+    unsigned char hash32[32], expected[32];
+    size_t taglen, msglen, split, i;
+    int iter;
+
+    secp256k1_context_set_illegal_callback(none, counting_illegal_callback_fn, &ecount);
+
+    /* API test */
+    CHECK(secp256k1_tagged_hasher_init(none, &hasher, msg, 0) == 1);
+    CHECK(secp256k1_tagged_hasher_init(none, NULL, msg, 0) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_tagged_hasher_init(none, &hasher, NULL, 0) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_tagged_hasher_hash(none, hash32, &hasher, msg, 0) == 1);
+    CHECK(secp256k1_tagged_hasher_hash(none, NULL, &hasher, msg, 0) == 0);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_tagged_hasher_hash(none, hash32, NULL, msg, 0) == 0);
+    CHECK(ecount == 4);
+    CHECK(secp256k1_tagged_hasher_hash(none, hash32, &hasher, NULL, 0) == 0);
+    CHECK(ecount == 5);
+    CHECK(secp256k1_tagged_hasher_write(none, &hasher, msg, 0) == 1);
+    CHECK(secp256k1_tagged_hasher_write(none, NULL, msg, 0) == 0);
+    CHECK(ecount == 6);
+    CHECK(secp256k1_tagged_hasher_write(none, &hasher, NULL, 0) == 0);
+    CHECK(ecount == 7);
+    CHECK(secp256k1_tagged_hasher_finalize(none, hash32, &hasher) == 1);
+    CHECK(secp256k1_tagged_hasher_finalize(none, NULL, &hasher) == 0);
+    CHECK(ecount == 8);
+    CHECK(secp256k1_tagged_hasher_finalize(none, hash32, NULL) == 0);
+    CHECK(ecount == 9);
+
+    for (iter = 0; iter < count; iter++) {
+        secp256k1_testrand_bytes_test(tag, sizeof(tag));
+        secp256k1_testrand_bytes_test(msg, sizeof(msg));
+        taglen = secp256k1_testrand_int(sizeof(tag) + 1);
+        msglen = secp256k1_testrand_int(sizeof(msg) + 1);
+        split = secp256k1_testrand_int(msglen + 1);
+        CHECK(secp256k1_tagged_sha256(none, expected, tag, taglen, msg, msglen) == 1);
+        CHECK(secp256k1_tagged_hasher_init(none, &hasher, tag, taglen) == 1);
+
+        /* One-shot mode, also in the middle of a streamed hash */
+        CHECK(secp256k1_tagged_hasher_hash(none, hash32, &hasher, msg, msglen) == 1);
+        CHECK(secp256k1_memcmp_var(hash32, expected, 32) == 0);
+        CHECK(secp256k1_tagged_hasher_write(none, &hasher, msg, split) == 1);
+        CHECK(secp256k1_tagged_hasher_hash(none, hash32, &hasher, msg, msglen) == 1);
+        CHECK(secp256k1_memcmp_var(hash32, expected, 32) == 0);
+
+        /* Streaming mode, continued in a copy */
+        hasher2 = hasher;
+        CHECK(secp256k1_tagged_hasher_write(none, &hasher2, msg + split, msglen - split) == 1);
+        CHECK(secp256k1_tagged_hasher_finalize(none, hash32, &hasher2) == 1);
+        CHECK(secp256k1_memcmp_var(hash32, expected, 32) == 0);
+
+        /* The finalized hasher can be reused */
+        for (i = 0; i < msglen; i++) {
+            CHECK(secp256k1_tagged_hasher_write(none, &hasher2, &msg[i], 1) == 1);
+        }
+        CHECK(secp256k1_tagged_hasher_finalize(none, hash32, &hasher2) == 1);
+        CHECK(secp256k1_memcmp_var(hash32, expected, 32) == 0);
+    }
+    secp256k1_context_destroy(none);
+}
+
+/* Compares secp256k1_sha256_many with hashing every message separately, for midstates with
+ * buffered bytes and message lengths around block boundaries. */
+void run_sha256_many_tests(void) {
+    unsigned char data[13][150];
+    unsigned char out[13][32], expected[32];
+    unsigned char *out32s[13];
+    const unsigned char *msgs[13];
+    secp256k1_sha256 mid, sha;
+    size_t i, n, msglen, prefixlen;
+    int iter;
+
+    for (i = 0; i < 13; i++) {
+        out32s[i] = out[i];
+        msgs[i] = data[i];
+    }
+    for (iter = 0; iter < count * 4; iter++) {
+        secp256k1_testrand_bytes_test(&data[0][0], sizeof(data));
+        prefixlen = secp256k1_testrand_int(130);
+        msglen = secp256k1_testrand_int(151);
+        n = secp256k1_testrand_int(14);
+        secp256k1_sha256_initialize(&mid);
+        secp256k1_sha256_write(&mid, data[12], prefixlen);
+        secp256k1_sha256_many(out32s, &mid, msgs, msglen, n);
+        for (i = 0; i < n; i++) {
+            sha = mid;
+            secp256k1_sha256_write(&sha, msgs[i], msglen);
+            secp256k1_sha256_finalize(&sha, expected);
+            CHECK(secp256k1_memcmp_var(out[i], expected, 32) == 0);
+        }
+#ifdef USE_X86_SIMD
+        if (secp256k1_cpu_has_avx2()) {
+            memset(out, 0, sizeof(out));
+            i = secp256k1_sha256_many_avx2(out32s, &mid, msgs, msglen, n);
+            CHECK(i == n - (n % 8 < 4 ? n % 8 : 0));
+            while (i--) {
+                sha = mid;
+                secp256k1_sha256_write(&sha, msgs[i], msglen);
+                secp256k1_sha256_finalize(&sha, expected);
+                CHECK(secp256k1_memcmp_var(out[i], expected, 32) == 0);
+            }
+        }
+#endif
+    }
+}
+
+void run_tagged_sha256_batch_tests(void) {
+    int ecount = 0;
+    secp256k1_context *none = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    unsigned char tag[] = "tag";
+    unsigned char data[9][96];
+    unsigned char out[9][32], expected[32];
+    unsigned char *hash32s[9];
+    const unsigned char *msgs[9];
+    size_t i;
+
+    secp256k1_context_set_illegal_callback(none, counting_illegal_callback_fn, &ecount);
+    secp256k1_testrand_bytes_test(&data[0][0], sizeof(data));
+    for (i = 0; i < 9; i++) {
+        hash32s[i] = out[i];
+        msgs[i] = data[i];
+    }
+
+    /* API test */
+    CHECK(secp256k1_tagged_sha256_batch(none, NULL, tag, 3, NULL, 96, 0) == 1);
+    CHECK(secp256k1_tagged_sha256_batch(none, hash32s, NULL, 0, msgs, 96, 9) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_tagged_sha256_batch(none, NULL, tag, 3, msgs, 96, 9) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_tagged_sha256_batch(none, hash32s, tag, 3, NULL, 96, 9) == 0);
+    CHECK(ecount == 3);
+    msgs[4] = NULL;
+    CHECK(secp256k1_tagged_sha256_batch(none, hash32s, tag, 3, msgs, 96, 9) == 0);
+    CHECK(ecount == 4);
+    msgs[4] = data[4];
+
+    CHECK(secp256k1_tagged_sha256_batch(none, hash32s, tag, 3, msgs, 96, 9) == 1);
+    for (i = 0; i < 9; i++) {
+        CHECK(secp256k1_tagged_sha256(none, expected, tag, 3, msgs[i], 96) == 1);
+        CHECK(secp256k1_memcmp_var(out[i], expected, 32) == 0);
+    }
+    secp256k1_context_destroy(none);
+}
+
 /***** RANDOM TESTS *****/
 
 void test_rand_bits(int rand32, int bits) {
@@ -2056,6 +2281,32 @@ void scalar_test(void) {
         CHECK(secp256k1_scalar_eq(&n, &s));
     }
 
+    {
+        int i;
+        /* Test that fetching 32-bit limbs from a scalar and recursing n(i)=2^32*n(i-1)+p(i) reconstructs it. */
+        secp256k1_scalar n;
+        secp256k1_scalar_set_int(&n, 0);
+        for (i = 0; i < 256; i += 32) {
+            secp256k1_scalar t;
+            int j;
+            uint32_t limb = secp256k1_scalar_get_bits_limb32(&s, 256 - 32 - i, 32);
+            /* Compare with the 16-bit halves, as secp256k1_scalar_set_int only takes an unsigned int. */
+            CHECK((limb >> 16) == secp256k1_scalar_get_bits(&s, 256 - 16 - i, 16));
+            CHECK((limb & 0xFFFF) == secp256k1_scalar_get_bits_limb32(&s, 256 - 32 - i, 16));
+            for (j = 0; j < 32; j++) {
+                secp256k1_scalar_add(&n, &n, &n);
+            }
+            secp256k1_scalar_set_int(&t, limb >> 16);
+            for (j = 0; j < 16; j++) {
+                secp256k1_scalar_add(&t, &t, &t);
+            }
+            secp256k1_scalar_add(&n, &n, &t);
+            secp256k1_scalar_set_int(&t, limb & 0xFFFF);
+            secp256k1_scalar_add(&n, &n, &t);
+        }
+        CHECK(secp256k1_scalar_eq(&n, &s));
+    }
+
     {
         /* Test that fetching groups of randomly-sized bits from a scalar and recursing n(i)=b*n(i-1)+p(i) reconstructs it. */
         secp256k1_scalar n;
@@ -3109,6 +3360,82 @@ void run_fe_mul(void) {
     }
 }
 
+void run_fe4_tests(void) {
+#ifdef USE_X86_SIMD
+    int i, k;
+    if (!secp256k1_cpu_has_avx2()) {
+        return;
+    }
+    for (i = 0; i < 10 * count; ++i) {
+        secp256k1_fe a[4], b[4], r[4], t;
+        const secp256k1_fe *in[4];
+        secp256k1_fe *out[4];
+        secp256k1_fe4 a4, b4, r4;
+        int zero = 0;
+
+        for (k = 0; k < 4; k++) {
+            if (secp256k1_testrand_bits(1)) {
+                random_fe(&a[k]);
+                random_fe(&b[k]);
+            } else {
+                random_fe_test(&a[k]);
+                random_fe_test(&b[k]);
+            }
+            if (secp256k1_testrand_bits(2) == 0) {
+                /* a[k] = b[k] - b[k], which is zero mod p */
+                secp256k1_fe_negate(&a[k], &b[k], 1);
+                secp256k1_fe_add(&a[k], &b[k]);
+            } else {
+                random_field_element_magnitude(&a[k]);
+            }
+            /* random_fe_test can also return zero */
+            if (secp256k1_fe_normalizes_to_zero(&a[k])) {
+                zero |= 1 << k;
+            }
+            random_field_element_magnitude(&b[k]);
+            in[k] = &a[k];
+            out[k] = &r[k];
+        }
+        secp256k1_fe4_load(&a4, in);
+        for (k = 0; k < 4; k++) {
+            in[k] = &b[k];
+        }
+        secp256k1_fe4_load(&b4, in);
+
+        CHECK(secp256k1_fe4_normalizes_to_zero(&a4) == zero);
+        secp256k1_fe4_mul(&r4, &a4, &b4);
+        secp256k1_fe4_store(out, &r4);
+        for (k = 0; k < 4; k++) {
+            secp256k1_fe_mul(&t, &a[k], &b[k]);
+            CHECK(secp256k1_fe_equal_var(&t, &r[k]));
+        }
+        secp256k1_fe4_sqr(&r4, &b4);
+        secp256k1_fe4_store(out, &r4);
+        for (k = 0; k < 4; k++) {
+            secp256k1_fe_sqr(&t, &b[k]);
+            CHECK(secp256k1_fe_equal_var(&t, &r[k]));
+        }
+        r4 = a4;
+        secp256k1_fe4_add(&r4, &b4);
+        secp256k1_fe4_half(&r4);
+        secp256k1_fe4_store(out, &r4);
+        for (k = 0; k < 4; k++) {
+            t = a[k];
+            secp256k1_fe_add(&t, &b[k]);
+            secp256k1_fe_normalize_weak(&t);
+            secp256k1_fe_half(&t);
+            CHECK(secp256k1_fe_equal_var(&t, &r[k]));
+        }
+        secp256k1_fe4_negate(&r4, &b4, 8);
+        secp256k1_fe4_store(out, &r4);
+        for (k = 0; k < 4; k++) {
+            secp256k1_fe_add(&r[k], &b[k]);
+            CHECK(secp256k1_fe_normalizes_to_zero_var(&r[k]));
+        }
+    }
+#endif
+}
+
 void run_sqr(void) {
     secp256k1_fe x, s;
 
@@ -3700,6 +4027,17 @@ void test_ge(void) {
         free(ge_set_all);
     }
 
+    /* Test constant-time batch gej -> ge conversion (which doesn't support
+     * infinity, so skip the first element). */
+    {
+        secp256k1_ge *ge_set_all = (secp256k1_ge *)checked_malloc(&ctx->error_callback, (4 * runs) * sizeof(secp256k1_ge));
+        secp256k1_ge_set_all_gej(ge_set_all, &gej[1], 4 * runs);
+        for (i = 0; i < 4 * runs; i++) {
+            ge_equals_gej(&ge_set_all[i], &gej[i + 1]);
+        }
+        free(ge_set_all);
+    }
+
     /* Test batch gej -> ge conversion with many infinities. */
     for (i = 0; i < 4 * runs + 1; i++) {
         int odd;
@@ -3950,6 +4288,119 @@ void run_group_decompress(void) {
     }
 }
 
+void run_ge_storage_table_select_tests(void) {
+    secp256k1_ge_storage table[33];
+    secp256k1_ge_storage r;
+    int n, idx, iter;
+
+    for (iter = 0; iter < count; iter++) {
+        secp256k1_testrand_bytes_test((unsigned char *)table, sizeof(table));
+        for (n = 1; n <= 33; n++) {
+            for (idx = 0; idx < n; idx++) {
+                secp256k1_ge_storage_table_select(&r, table, n, idx);
+                CHECK(secp256k1_memcmp_var(&r, &table[idx], sizeof(r)) == 0);
+                secp256k1_ge_storage_table_select_portable(&r, table, n, idx);
+                CHECK(secp256k1_memcmp_var(&r, &table[idx], sizeof(r)) == 0);
+#ifdef USE_X86_SIMD
+                if (secp256k1_cpu_has_avx2()) {
+                    secp256k1_ge_storage_table_select_avx2(&r, table, n, idx);
+                    CHECK(secp256k1_memcmp_var(&r, &table[idx], sizeof(r)) == 0);
+                }
+#endif
+            }
+        }
+    }
+}
+
+void test_gej_x4(void (*add)(secp256k1_gej *const *, const secp256k1_gej *const *, const secp256k1_ge *const *), void (*dbl)(secp256k1_gej *const *, const secp256k1_gej *const *)) {
+    secp256k1_gej a[4], r[4];
+    secp256k1_ge b[4], expected[4];
+    secp256k1_gej *out[4];
+    const secp256k1_gej *in[4];
+    const secp256k1_ge *in_ge[4];
+    int k;
+
+    for (k = 0; k < 4; k++) {
+        secp256k1_ge p;
+        random_group_element_test(&p);
+        random_group_element_jacobian_test(&a[k], &p);
+        random_field_element_magnitude(&a[k].x);
+        random_field_element_magnitude(&a[k].y);
+        random_field_element_magnitude(&a[k].z);
+        switch (secp256k1_testrand_int(8)) {
+        case 0: /* a is infinity */
+            secp256k1_gej_set_infinity(&a[k]);
+            random_group_element_test(&b[k]);
+            break;
+        case 1: /* b is infinity */
+            secp256k1_ge_set_infinity(&b[k]);
+            break;
+        case 2: /* a == b */
+            b[k] = p;
+            break;
+        case 3: /* a == -b */
+            secp256k1_ge_neg(&b[k], &p);
+            break;
+        default:
+            random_group_element_test(&b[k]);
+        }
+        random_field_element_magnitude(&b[k].x);
+        random_field_element_magnitude(&b[k].y);
+        in[k] = &a[k];
+        in_ge[k] = &b[k];
+        out[k] = &r[k];
+    }
+
+    for (k = 0; k < 4; k++) {
+        secp256k1_gej t;
+        secp256k1_gej_add_ge_var(&t, &a[k], &b[k], NULL);
+        secp256k1_ge_set_gej_var(&expected[k], &t);
+    }
+    add(out, in, in_ge);
+    for (k = 0; k < 4; k++) {
+        ge_equals_gej(&expected[k], &r[k]);
+    }
+    /* In place */
+    add(out, (const secp256k1_gej *const *)out, in_ge);
+    for (k = 0; k < 4; k++) {
+        secp256k1_gej t;
+        secp256k1_gej_set_ge(&t, &expected[k]);
+        secp256k1_gej_add_ge_var(&t, &t, &b[k], NULL);
+        secp256k1_ge_set_gej_var(&expected[k], &t);
+        ge_equals_gej(&expected[k], &r[k]);
+    }
+
+    for (k = 0; k < 4; k++) {
+        secp256k1_gej t;
+        secp256k1_gej_double_var(&t, &a[k], NULL);
+        secp256k1_ge_set_gej_var(&expected[k], &t);
+    }
+    dbl(out, in);
+    for (k = 0; k < 4; k++) {
+        ge_equals_gej(&expected[k], &r[k]);
+    }
+    dbl(out, (const secp256k1_gej *const *)out);
+    for (k = 0; k < 4; k++) {
+        secp256k1_gej t;
+        secp256k1_gej_set_ge(&t, &expected[k]);
+        secp256k1_gej_double_var(&t, &t, NULL);
+        secp256k1_ge_set_gej_var(&expected[k], &t);
+        ge_equals_gej(&expected[k], &r[k]);
+    }
+}
+
+void run_gej_x4_tests(void) {
+    int i;
+    for (i = 0; i < 10 * count; i++) {
+        test_gej_x4(secp256k1_gej_add_ge_var_x4, secp256k1_gej_double_var_x4);
+#ifdef USE_X86_SIMD
+        if (secp256k1_cpu_has_avx2()) {
+            test_gej_x4(secp256k1_gej_add_ge_var_x4_avx2, secp256k1_gej_double_var_x4_avx2);
+        }
+#endif
+    }
+}
+
 /***** ECMULT TESTS *****/
 
 void test_pre_g_table(const secp256k1_ge_storage * pre_g, size_t n) {
@@ -4155,10 +4606,11 @@ static const secp256k1_scalar scalars_near_split_bounds[20] = {
 };
 
 void test_ecmult_target(const secp256k1_scalar* target, int mode) {
-    /* Mode: 0=ecmult_gen, 1=ecmult, 2=ecmult_const */
+    /* Mode: 0=ecmult_gen, 1=ecmult, 2=ecmult_const, 3=ecmult_pubkey_precomp */
     secp256k1_scalar n1, n2;
     secp256k1_ge p;
     secp256k1_gej pj, p1j, p2j, ptj;
+    secp256k1_ge_storage pre[ECMULT_PUBKEY_PRECOMP_TABLE_SIZE], pre_lam[ECMULT_PUBKEY_PRECOMP_TABLE_SIZE];
     static const secp256k1_scalar zero = SECP256K1_SCALAR_CONST(0, 0, 0, 0, 0, 0, 0, 0);
 
     /* Generate random n1,n2 such that n1+n2 = -target. */
@@ -4181,10 +4633,15 @@ void test_ecmult_target(const secp256k1_scalar* target, int mode) {
         secp256k1_ecmult(&p1j, &pj, &n1, &zero);
         secp256k1_ecmult(&p2j, &pj, &n2, &zero);
         secp256k1_ecmult(&ptj, &pj, target, &zero);
-    } else {
+    } else if (mode == 2) {
         secp256k1_ecmult_const(&p1j, &p, &n1, 256);
         secp256k1_ecmult_const(&p2j, &p, &n2, 256);
         secp256k1_ecmult_const(&ptj, &p, target, 256);
+    } else {
+        secp256k1_ecmult_pubkey_precomp_table(pre, pre_lam, &p);
+        secp256k1_ecmult_pubkey_precomp(&p1j, pre, pre_lam, &n1, &zero);
+        secp256k1_ecmult_pubkey_precomp(&p2j, pre, pre_lam, &n2, &zero);
+        secp256k1_ecmult_pubkey_precomp(&ptj, pre, pre_lam, target, &zero);
     }
 
     /* Add them all up: n1*P + n2*P + target*P = (n1+n2+target)*P = (n1+n1-n1-n2)*P = 0. */
@@ -4201,6 +4658,97 @@ void run_ecmult_near_split_bound(void) {
             test_ecmult_target(&scalars_near_split_bounds[j], 0);
             test_ecmult_target(&scalars_near_split_bounds[j], 1);
             test_ecmult_target(&scalars_near_split_bounds[j], 2);
+            test_ecmult_target(&scalars_near_split_bounds[j], 3);
+        }
+    }
+}
+
+/* Compares secp256k1_ecmult_pubkey_precomp with secp256k1_ecmult. */
+void test_ecmult_pubkey_precomp(void) {
+    secp256k1_ge_storage pre[ECMULT_PUBKEY_PRECOMP_TABLE_SIZE], pre_lam[ECMULT_PUBKEY_PRECOMP_TABLE_SIZE];
+    secp256k1_scalar na, ng;
+    secp256k1_ge a;
+    secp256k1_gej aj, r, r2;
+    int i;
+
+    random_group_element_test(&a);
+    secp256k1_gej_set_ge(&aj, &a);
+    secp256k1_ecmult_pubkey_precomp_table(pre, pre_lam, &a);
+    for (i = 0; i < 4; i++) {
+        random_scalar_order_test(&na);
+        random_scalar_order_test(&ng);
+        if (i == 1) {
+            secp256k1_scalar_set_int(&na, 0);
+        } else if (i == 2) {
+            secp256k1_scalar_set_int(&ng, 0);
+        } else if (i == 3) {
+            secp256k1_scalar_set_int(&na, 1);
+        }
+        secp256k1_ecmult(&r, &aj, &na, &ng);
+        secp256k1_ecmult_pubkey_precomp(&r2, pre, pre_lam, &na, &ng);
+        secp256k1_gej_neg(&r2, &r2);
+        secp256k1_gej_add_var(&r, &r, &r2, NULL);
+        CHECK(secp256k1_gej_is_infinity(&r));
+    }
+    /* Both scalars zero */
+    secp256k1_scalar_set_int(&na, 0);
+    secp256k1_ecmult_pubkey_precomp(&r, pre, pre_lam, &na, &na);
+    CHECK(secp256k1_gej_is_infinity(&r));
+}
+
+void run_ecmult_pubkey_precomp(void) {
+    int i;
+    for (i = 0; i < count; i++) {
+        test_ecmult_pubkey_precomp();
+    }
+}
+
+/* Compares secp256k1_ecmult_many with secp256k1_ecmult for num inputs, some of
+ * which have zero scalars or points at infinity. */
+void test_ecmult_many(size_t num) {
+    secp256k1_gej a[4], r[4], r2;
+    secp256k1_scalar na[4], ng[4];
+    secp256k1_ge ge;
+    size_t k;
+
+    for (k = 0; k < 4; k++) {
+        random_group_element_test(&ge);
+        random_group_element_jacobian_test(&a[k], &ge);
+        random_scalar_order_test(&na[k]);
+        random_scalar_order_test(&ng[k]);
+        switch (secp256k1_testrand_int(8)) {
+        case 0:
+            secp256k1_scalar_set_int(&na[k], 0);
+            break;
+        case 1:
+            secp256k1_scalar_set_int(&ng[k], 0);
+            break;
+        case 2:
+            secp256k1_gej_set_infinity(&a[k]);
+            break;
+        case 3:
+            /* The G terms cancel the A term */
+            secp256k1_scalar_set_int(&na[k], 1);
+            secp256k1_gej_set_ge(&a[k], &secp256k1_ge_const_g);
+            secp256k1_scalar_negate(&ng[k], &na[k]);
+            break;
+        }
+    }
+    secp256k1_ecmult_many(r, a, na, ng, num);
+    for (k = 0; k < num; k++) {
+        secp256k1_ecmult(&r2, &a[k], &na[k], &ng[k]);
+        secp256k1_gej_neg(&r2, &r2);
+        secp256k1_gej_add_var(&r2, &r2, &r[k], NULL);
+        CHECK(secp256k1_gej_is_infinity(&r2));
+    }
+}
+
+void run_ecmult_many(void) {
+    int i;
+    size_t num;
+    for (i = 0; i < count; i++) {
+        for (num = 1; num <= 4; num++) {
+            test_ecmult_many(num);
         }
     }
 }
@@ -4781,8 +5329,9 @@ void test_secp256k1_pippenger_bucket_window_inv(void) {
 
     CHECK(secp256k1_pippenger_bucket_window_inv(0) == 0);
     for(i = 1; i <= PIPPENGER_MAX_BUCKET_WINDOW; i++) {
-        /* Bucket_window of 8 is not used with endo */
-        if (i == 8) {
+        /* Bucket_windows of 8, 13 and 14 are not used */
+        if (i == 8 || i == 13 || i == 14) {
+            CHECK(secp256k1_pippenger_bucket_window_inv(i) == 0);
             continue;
         }
         CHECK(secp256k1_pippenger_bucket_window(secp256k1_pippenger_bucket_window_inv(i)) == i);
@@ -4798,12 +5347,16 @@ void test_secp256k1_pippenger_bucket_window_inv(void) {
  */
 void test_ecmult_multi_pippenger_max_points(void) {
     size_t scratch_size = secp256k1_testrand_bits(8);
-    size_t max_size = secp256k1_pippenger_scratch_size(secp256k1_pippenger_bucket_window_inv(PIPPENGER_MAX_BUCKET_WINDOW-1)+512, 12);
+    /* 12 is the largest bucket_window below PIPPENGER_MAX_BUCKET_WINDOW in use */
+    size_t max_points = secp256k1_pippenger_bucket_window_inv(12);
+    size_t max_size = secp256k1_pippenger_scratch_size(max_points + max_points/16, PIPPENGER_MAX_BUCKET_WINDOW);
     secp256k1_scratch *scratch;
     size_t n_points_supported;
     int bucket_window = 0;
 
-    for(; scratch_size < max_size; scratch_size+=256) {
+    /* Increase the step size with the scratch size to keep the number of
+     * iterations manageable for large bucket windows. */
+    for(; scratch_size < max_size; scratch_size += 256 + scratch_size/64) {
         size_t i;
         size_t total_alloc;
         size_t checkpoint;
@@ -4829,6 +5382,78 @@ void test_ecmult_multi_pippenger_max_points(void) {
     CHECK(bucket_window == PIPPENGER_MAX_BUCKET_WINDOW);
 }
 
+void test_ecmult_multi_pippenger_scratch_size_for_points(void) {
+    size_t n_points[7] = { 1, 5, 88, 1261, 16051, 160001, 0 };
+    size_t i;
+
+    n_points[6] = 1 + secp256k1_testrand_int(20000);
+    for (i = 0; i < sizeof(n_points)/sizeof(n_points[0]); i++) {
+        size_t scratch_size = secp256k1_pippenger_scratch_size_for_points(n_points[i]);
+        secp256k1_scratch *scratch;
+
+        /* The returned size is sufficient... */
+        scratch = secp256k1_scratch_create(&ctx->error_callback, scratch_size);
+        CHECK(secp256k1_pippenger_max_points(&ctx->error_callback, scratch) >= n_points[i]);
+        secp256k1_scratch_destroy(&ctx->error_callback, scratch);
+        /* ...and minimal. */
+        scratch = secp256k1_scratch_create(&ctx->error_callback, scratch_size - 1);
+        CHECK(secp256k1_pippenger_max_points(&ctx->error_callback, scratch) < n_points[i]);
+        secp256k1_scratch_destroy(&ctx->error_callback, scratch);
+    }
+}
+
+/* Compare the affine bucket accumulation of Pippenger's algorithm with the
+ * Jacobian one, also for points which are equal or negations of each other
+ * and end up in the same bucket. */
+void test_ecmult_multi_pippenger_affine(void) {
+    static const size_t n_points[4] = { 1, 10, 100, 400 };
+    secp256k1_scalar sc[400];
+    secp256k1_ge pt[400];
+    secp256k1_scalar sc_pool[2];
+    secp256k1_ge pt_pool[2];
+    secp256k1_scalar g_sc;
+    ecmult_multi_data data;
+    secp256k1_scratch *scratch;
+    size_t i, j;
+    int k, w;
+
+    data.sc = sc;
+    data.pt = pt;
+    /* The affine accumulation is forced for bucket windows below
+     * PIPPENGER_AFFINE_MIN_WINDOW, so size the scratch space for it directly. */
+    w = secp256k1_pippenger_bucket_window(400);
+    scratch = secp256k1_scratch_create(&ctx->error_callback, secp256k1_pippenger_buckets_size(w, 1) + sizeof(struct secp256k1_pippenger_state) + (2*400 + 2) * secp256k1_pippenger_entry_size(w, 1) + PIPPENGER_SCRATCH_OBJECTS * (ALIGNMENT - 1));
+    for (i = 0; i < sizeof(n_points)/sizeof(n_points[0]); i++) {
+        for (k = 0; k < 2; k++) {
+            secp256k1_gej r, r2;
+
+            random_scalar_order(&g_sc);
+            for (j = 0; j < 2; j++) {
+                random_scalar_order(&sc_pool[j]);
+                random_group_element_test(&pt_pool[j]);
+            }
+            for (j = 0; j < n_points[i]; j++) {
+                if (k == 0) {
+                    random_scalar_order(&sc[j]);
+                    random_group_element_test(&pt[j]);
+                } else {
+                    sc[j] = sc_pool[secp256k1_testrand_bits(1)];
+                    pt[j] = pt_pool[secp256k1_testrand_bits(1)];
+                    if (secp256k1_testrand_bits(1)) {
+                        secp256k1_ge_neg(&pt[j], &pt[j]);
+                    }
+                }
+            }
+            CHECK(secp256k1_ecmult_pippenger_batch_strategy(&ctx->error_callback, scratch, &r, &g_sc, ecmult_multi_callback, &data, n_points[i], 0, 1));
+            CHECK(secp256k1_ecmult_pippenger_batch_strategy(&ctx->error_callback, scratch, &r2, &g_sc, ecmult_multi_callback, &data, n_points[i], 0, 0));
+            secp256k1_gej_neg(&r2, &r2);
+            secp256k1_gej_add_var(&r, &r, &r2, NULL);
+            CHECK(secp256k1_gej_is_infinity(&r));
+        }
+    }
+    secp256k1_scratch_destroy(&ctx->error_callback, scratch);
+}
+
 void test_ecmult_multi_batch_size_helper(void) {
     size_t n_batches, n_batch_points, max_n_batch_points, n;
 
@@ -4950,6 +5575,8 @@ void run_ecmult_multi_tests(void) {
 
     test_secp256k1_pippenger_bucket_window_inv();
     test_ecmult_multi_pippenger_max_points();
+    test_ecmult_multi_pippenger_scratch_size_for_points();
+    test_ecmult_multi_pippenger_affine();
     scratch = secp256k1_scratch_create(&ctx->error_callback, 819200);
     test_ecmult_multi(scratch, secp256k1_ecmult_multi_var);
     test_ecmult_multi(NULL, secp256k1_ecmult_multi_var);
@@ -5376,18 +6003,18 @@ void test_ecmult_gen_blind(void) {
     unsigned char seed32[32];
     secp256k1_gej pgej;
     secp256k1_gej pgej2;
-    secp256k1_gej i;
+    secp256k1_ge p;
     secp256k1_ge pge;
     random_scalar_order_test(&key);
     secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &pgej, &key);
     secp256k1_testrand256(seed32);
-    b = ctx->ecmult_gen_ctx.blind;
-    i = ctx->ecmult_gen_ctx.initial;
+    b = ctx->ecmult_gen_ctx.scalar_offset;
+    p = ctx->ecmult_gen_ctx.ge_offset;
     secp256k1_ecmult_gen_blind(&ctx->ecmult_gen_ctx, seed32);
-    CHECK(!secp256k1_scalar_eq(&b, &ctx->ecmult_gen_ctx.blind));
+    CHECK(!secp256k1_scalar_eq(&b, &ctx->ecmult_gen_ctx.scalar_offset));
     secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &pgej2, &key);
     CHECK(!gej_xyz_equals_gej(&pgej, &pgej2));
-    CHECK(!gej_xyz_equals_gej(&i, &ctx->ecmult_gen_ctx.initial));
+    CHECK(!secp256k1_fe_equal_var(&p.x, &ctx->ecmult_gen_ctx.ge_offset.x));
     secp256k1_ge_set_gej(&pge, &pgej);
     ge_equals_gej(&pge, &pgej2);
 }
@@ -5395,13 +6022,14 @@ void test_ecmult_gen_blind(void) {
 void test_ecmult_gen_blind_reset(void) {
     /* Test ecmult_gen() blinding reset and confirm that the blinding is consistent. */
     secp256k1_scalar b;
-    secp256k1_gej initial;
+    secp256k1_ge p1, p2;
     secp256k1_ecmult_gen_blind(&ctx->ecmult_gen_ctx, 0);
-    b = ctx->ecmult_gen_ctx.blind;
-    initial = ctx->ecmult_gen_ctx.initial;
+    b = ctx->ecmult_gen_ctx.scalar_offset;
+    p1 = ctx->ecmult_gen_ctx.ge_offset;
     secp256k1_ecmult_gen_blind(&ctx->ecmult_gen_ctx, 0);
-    CHECK(secp256k1_scalar_eq(&b, &ctx->ecmult_gen_ctx.blind));
-    CHECK(gej_xyz_equals_gej(&initial, &ctx->ecmult_gen_ctx.initial));
+    CHECK(secp256k1_scalar_eq(&b, &ctx->ecmult_gen_ctx.scalar_offset));
+    p2 = ctx->ecmult_gen_ctx.ge_offset;
+    ge_equals_ge(&p1, &p2);
 }
 
 void run_ecmult_gen_blind(void) {
@@ -5412,6 +6040,137 @@ void run_ecmult_gen_blind(void) {
     }
 }
 
+/* Compare secp256k1_ecmult_gen with secp256k1_ecmult for a scalar gn chosen such that the
+ * comb in secp256k1_ecmult_gen operates on the scalar d = gn + scalar_offset. */
+void test_ecmult_gen_comb_input(const secp256k1_ecmult_gen_context *gen_ctx, const secp256k1_scalar *d) {
+    secp256k1_scalar gn;
+    secp256k1_scalar zero = SECP256K1_SCALAR_CONST(0, 0, 0, 0, 0, 0, 0, 0);
+    secp256k1_gej res1, res2, infj;
+    secp256k1_ge res1_ge;
+
+    secp256k1_gej_set_infinity(&infj);
+    secp256k1_scalar_negate(&gn, &gen_ctx->scalar_offset);
+    secp256k1_scalar_add(&gn, &gn, d);
+    secp256k1_ecmult_gen(gen_ctx, &res1, &gn);
+    secp256k1_ecmult(&res2, &infj, &zero, &gn);
+    if (secp256k1_gej_is_infinity(&res2)) {
+        CHECK(secp256k1_gej_is_infinity(&res1));
+    } else {
+        secp256k1_ge_set_gej(&res1_ge, &res1);
+        ge_equals_gej(&res1_ge, &res2);
+    }
+}
+
+void test_ecmult_gen_edge_cases(const secp256k1_ecmult_gen_context *gen_ctx) {
+    int i;
+    secp256k1_scalar d;
+    secp256k1_gej res1, res2, res3;
+    secp256k1_scalar gn = secp256k1_scalar_one;
+
+    /* 1*G + (-1)*G = 0 */
+    secp256k1_ecmult_gen(gen_ctx, &res1, &gn);
+    secp256k1_scalar_negate(&gn, &gn);
+    secp256k1_ecmult_gen(gen_ctx, &res2, &gn);
+    secp256k1_gej_add_var(&res3, &res1, &res2, NULL);
+    CHECK(secp256k1_gej_is_infinity(&res3));
+
+    /* Comb inputs that select the same (negated or not) entry in every lookup. */
+    secp256k1_scalar_set_int(&d, 0);
+    test_ecmult_gen_comb_input(gen_ctx, &d);
+    secp256k1_scalar_negate(&d, &secp256k1_scalar_one);
+    test_ecmult_gen_comb_input(gen_ctx, &d);
+    /* Comb inputs with a single bit set or cleared. */
+    for (i = 0; i < 256; i += 1 + secp256k1_testrand_int(16)) {
+        secp256k1_scalar_set_int(&d, 0);
+        secp256k1_scalar_cadd_bit(&d, i, 1);
+        test_ecmult_gen_comb_input(gen_ctx, &d);
+        secp256k1_scalar_negate(&d, &d);
+        test_ecmult_gen_comb_input(gen_ctx, &d);
+    }
+    /* The scalars (gn = 0 and gn = -1) which result in the point at infinity
+     * or its neighbour. */
+    secp256k1_scalar_set_int(&d, 0);
+    secp256k1_scalar_add(&d, &d, &gen_ctx->scalar_offset);
+    test_ecmult_gen_comb_input(gen_ctx, &d);
+    secp256k1_scalar_negate(&gn, &secp256k1_scalar_one);
+    secp256k1_scalar_add(&d, &d, &gn);
+    test_ecmult_gen_comb_input(gen_ctx, &d);
+}
+
+void run_ecmult_gen_edge_cases(void) {
+    unsigned char seed32[32];
+
+    /* Without blinding. */
+    secp256k1_ecmult_gen_blind(&ctx->ecmult_gen_ctx, NULL);
+    test_ecmult_gen_edge_cases(&ctx->ecmult_gen_ctx);
+    /* With blinding. */
+    secp256k1_testrand256(seed32);
+    secp256k1_ecmult_gen_blind(&ctx->ecmult_gen_ctx, seed32);
+    test_ecmult_gen_edge_cases(&ctx->ecmult_gen_ctx);
+}
+
+void run_ecmult_gen_large_table(void) {
+    secp256k1_context *large, *large_clone;
+    void *prealloc;
+    size_t size;
+    unsigned char seed32[32], seckey[32], msg32[32];
+    secp256k1_pubkey pubkey1, pubkey2;
+    secp256k1_ecdsa_signature sig1, sig2;
+    int i;
+
+    /* If the compiled-in table is at least as large as the runtime one, the flag has no
+     * effect. */
+    size = secp256k1_context_preallocated_size(SECP256K1_CONTEXT_LARGE_GEN_TABLE);
+    if (ECMULT_GEN_LARGE_TABLE_ENABLED) {
+        CHECK(size >= secp256k1_context_preallocated_size(SECP256K1_CONTEXT_NONE) + ECMULT_GEN_LARGE_TABLE_SIZE * sizeof(secp256k1_ge_storage));
+    } else {
+        CHECK(size == secp256k1_context_preallocated_size(SECP256K1_CONTEXT_NONE));
+    }
+    CHECK(secp256k1_context_preallocated_size(SECP256K1_CONTEXT_LARGE_GEN_TABLE | SECP256K1_CONTEXT_DECLASSIFY) == size);
+
+    large = secp256k1_context_create(SECP256K1_CONTEXT_LARGE_GEN_TABLE);
+    CHECK((large->ecmult_gen_ctx.large_table != NULL) == ECMULT_GEN_LARGE_TABLE_ENABLED);
+    CHECK(secp256k1_context_preallocated_clone_size(large) == size);
+    test_ecmult_gen_edge_cases(&large->ecmult_gen_ctx);
+    secp256k1_testrand256(seed32);
+    CHECK(secp256k1_context_randomize(large, seed32));
+    test_ecmult_gen_edge_cases(&large->ecmult_gen_ctx);
+
+    /* The clone and a preallocated context must use their own copy of the table. */
+    large_clone = secp256k1_context_clone(large);
+    if (ECMULT_GEN_LARGE_TABLE_ENABLED) {
+        CHECK(large_clone->ecmult_gen_ctx.large_table != NULL);
+        CHECK(large_clone->ecmult_gen_ctx.large_table != large->ecmult_gen_ctx.large_table);
+    } else {
+        CHECK(large_clone->ecmult_gen_ctx.large_table == NULL);
+    }
+    prealloc = malloc(size);
+    CHECK(prealloc != NULL);
+    CHECK(secp256k1_context_preallocated_create(prealloc, SECP256K1_CONTEXT_LARGE_GEN_TABLE) == prealloc);
+    if (ECMULT_GEN_LARGE_TABLE_ENABLED) {
+        CHECK(secp256k1_memcmp_var(((secp256k1_context *)prealloc)->ecmult_gen_ctx.large_table, large->ecmult_gen_ctx.large_table, ECMULT_GEN_LARGE_TABLE_SIZE * sizeof(secp256k1_ge_storage)) == 0);
+    }
+    secp256k1_context_destroy(large);
+
+    /* Results do not depend on the table in use. */
+    for (i = 0; i < 4*count; i++) {
+        secp256k1_testrand256(msg32);
+        random_scalar_order_b32(seckey);
+        CHECK(secp256k1_ec_pubkey_create(ctx, &pubkey1, seckey));
+        CHECK(secp256k1_ec_pubkey_create(large_clone, &pubkey2, seckey));
+        CHECK(secp256k1_memcmp_var(&pubkey1, &pubkey2, sizeof(pubkey1)) == 0);
+        CHECK(secp256k1_ec_pubkey_create(prealloc, &pubkey2, seckey));
+        CHECK(secp256k1_memcmp_var(&pubkey1, &pubkey2, sizeof(pubkey1)) == 0);
+        CHECK(secp256k1_ecdsa_sign(ctx, &sig1, msg32, seckey, NULL, NULL));
+        CHECK(secp256k1_ecdsa_sign(large_clone, &sig2, msg32, seckey, NULL, NULL));
+        CHECK(secp256k1_memcmp_var(&sig1, &sig2, sizeof(sig1)) == 0);
+    }
+
+    secp256k1_context_destroy(large_clone);
+    secp256k1_context_preallocated_destroy(prealloc);
+    free(prealloc);
+}
+
 /***** ENDOMORPHISH TESTS *****/
 void test_scalar_split(const secp256k1_scalar* full) {
     secp256k1_scalar s, s1, slam;
@@ -6155,6 +6914,163 @@ void run_eckey_negate_test(void) {
     CHECK(secp256k1_memcmp_var(seckey, seckey_tmp, 32) == 0);
 }
 
+void test_ec_pubkey_create_batch_api(void) {
+    secp256k1_context *none = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    secp256k1_pubkey pubkeys[2];
+    const unsigned char *seckeys[2];
+    unsigned char seckey[32];
+    int ecount = 0;
+
+    secp256k1_context_set_illegal_callback(none, counting_illegal_callback_fn, &ecount);
+    random_scalar_order_b32(seckey);
+    seckeys[0] = seckey;
+    seckeys[1] = seckey;
+
+    CHECK(secp256k1_ec_pubkey_create_batch(none, pubkeys, seckeys, 2) == 1);
+    CHECK(secp256k1_ec_pubkey_create_batch(none, NULL, NULL, 0) == 1);
+    CHECK(ecount == 0);
+    CHECK(secp256k1_ec_pubkey_create_batch(none, NULL, seckeys, 2) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_ec_pubkey_create_batch(none, pubkeys, NULL, 2) == 0);
+    CHECK(ecount == 2);
+    seckeys[1] = NULL;
+    CHECK(secp256k1_ec_pubkey_create_batch(none, pubkeys, seckeys, 2) == 0);
+    CHECK(ecount == 3);
+
+    secp256k1_context_destroy(none);
+}
+
+void test_ec_pubkey_create_batch(void) {
+    unsigned char seckey_storage[2 * PUBKEY_CREATE_BATCH_SIZE + 3][32];
+    const unsigned char *seckeys[2 * PUBKEY_CREATE_BATCH_SIZE + 3];
+    secp256k1_pubkey pubkeys[2 * PUBKEY_CREATE_BATCH_SIZE + 3];
+    secp256k1_pubkey pubkey, zero_pubkey;
+    size_t n, i, invalid;
+
+    n = secp256k1_testrand_int(2 * PUBKEY_CREATE_BATCH_SIZE + 3) + 1;
+    for (i = 0; i < 2 * PUBKEY_CREATE_BATCH_SIZE + 3; i++) {
+        random_scalar_order_b32(seckey_storage[i]);
+        seckeys[i] = seckey_storage[i];
+    }
+    CHECK(secp256k1_ec_pubkey_create_batch(ctx, pubkeys, seckeys, n) == 1);
+    for (i = 0; i < n; i++) {
+        CHECK(secp256k1_ec_pubkey_create(ctx, &pubkey, seckeys[i]) == 1);
+        CHECK(secp256k1_memcmp_var(&pubkey, &pubkeys[i], sizeof(pubkey)) == 0);
+    }
+
+    /* An invalid secret key only clears its own public key */
+    invalid = secp256k1_testrand_int(n);
+    if (secp256k1_testrand_bits(1)) {
+        memset(seckey_storage[invalid], 0, 32);
+    } else {
+        memset(seckey_storage[invalid], 0xFF, 32);
+    }
+    memset(&zero_pubkey, 0, sizeof(zero_pubkey));
+    CHECK(secp256k1_ec_pubkey_create_batch(ctx, pubkeys, seckeys, n) == 0);
+    for (i = 0; i < n; i++) {
+        if (i == invalid) {
+            CHECK(secp256k1_memcmp_var(&zero_pubkey, &pubkeys[i], sizeof(pubkey)) == 0);
+        } else {
+            CHECK(secp256k1_ec_pubkey_create(ctx, &pubkey, seckeys[i]) == 1);
+            CHECK(secp256k1_memcmp_var(&pubkey, &pubkeys[i], sizeof(pubkey)) == 0);
+        }
+    }
+}
+
+void test_ec_pubkey_create_sequence_api(void) {
+    secp256k1_context *none = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    secp256k1_pubkey pubkeys[2];
+    secp256k1_pubkey zero_pubkey;
+    unsigned char seckey[32];
+    unsigned char step[32];
+    int ecount = 0;
+
+    secp256k1_context_set_illegal_callback(none, counting_illegal_callback_fn, &ecount);
+    random_scalar_order_b32(seckey);
+    random_scalar_order_b32(step);
+    memset(&zero_pubkey, 0, sizeof(zero_pubkey));
+
+    CHECK(secp256k1_ec_pubkey_create_sequence(none, pubkeys, seckey, step, 2) == 1);
+    CHECK(secp256k1_ec_pubkey_create_sequence(none, NULL, seckey, step, 0) == 1);
+    CHECK(ecount == 0);
+    CHECK(secp256k1_ec_pubkey_create_sequence(none, NULL, seckey, step, 2) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_ec_pubkey_create_sequence(none, pubkeys, NULL, step, 2) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_ec_pubkey_create_sequence(none, pubkeys, seckey, NULL, 2) == 0);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_memcmp_var(&pubkeys[0], &zero_pubkey, sizeof(zero_pubkey)) == 0);
+
+    /* An invalid secret key or an overflowing step clears all outputs */
+    memset(step, 0xFF, 32);
+    CHECK(secp256k1_ec_pubkey_create_sequence(none, pubkeys, seckey, step, 2) == 0);
+    CHECK(secp256k1_memcmp_var(&pubkeys[1], &zero_pubkey, sizeof(zero_pubkey)) == 0);
+    memset(step, 0, 32);
+    memset(seckey, 0, 32);
+    CHECK(secp256k1_ec_pubkey_create_sequence(none, pubkeys, seckey, step, 2) == 0);
+    CHECK(secp256k1_memcmp_var(&pubkeys[1], &zero_pubkey, sizeof(zero_pubkey)) == 0);
+    CHECK(ecount == 3);
+
+    secp256k1_context_destroy(none);
+}
+
+void test_ec_pubkey_create_sequence(void) {
+    secp256k1_pubkey pubkeys[2 * PUBKEY_SEQUENCE_BLOCK_SIZE + 3];
+    secp256k1_pubkey pubkey, zero_pubkey;
+    secp256k1_scalar k, t, zero_idx;
+    unsigned char seckey[32];
+    unsigned char step[32];
+    unsigned char buf[32];
+    size_t n, i, m;
+    int mode;
+
+    memset(&zero_pubkey, 0, sizeof(zero_pubkey));
+    n = secp256k1_testrand_int(2 * PUBKEY_SEQUENCE_BLOCK_SIZE + 3) + 1;
+    m = secp256k1_testrand_int(n);
+    /* Mode: 0=random step, 1=step 1, 2=step 0, 3=the m-th secret key is zero */
+    mode = secp256k1_testrand_int(4);
+    random_scalar_order_test(&t);
+    if (mode == 1) {
+        secp256k1_scalar_set_int(&t, 1);
+    } else if (mode == 2) {
+        secp256k1_scalar_set_int(&t, 0);
+    }
+    if (mode == 3 && m > 0) {
+        /* k = -m*t */
+        secp256k1_scalar_set_int(&zero_idx, m);
+        secp256k1_scalar_mul(&k, &zero_idx, &t);
+        secp256k1_scalar_negate(&k, &k);
+    } else {
+        random_scalar_order_test(&k);
+        mode = mode == 3 ? 0 : mode;
+    }
+    secp256k1_scalar_get_b32(seckey, &k);
+    secp256k1_scalar_get_b32(step, &t);
+
+    CHECK(secp256k1_ec_pubkey_create_sequence(ctx, pubkeys, seckey, step, n) == (mode != 3));
+    for (i = 0; i < n; i++) {
+        if (mode == 3 && i == m) {
+            CHECK(secp256k1_scalar_is_zero(&k));
+            CHECK(secp256k1_memcmp_var(&pubkeys[i], &zero_pubkey, sizeof(zero_pubkey)) == 0);
+        } else {
+            secp256k1_scalar_get_b32(buf, &k);
+            CHECK(secp256k1_ec_pubkey_create(ctx, &pubkey, buf) == 1);
+            CHECK(secp256k1_ec_pubkey_cmp(ctx, &pubkey, &pubkeys[i]) == 0);
+        }
+        secp256k1_scalar_add(&k, &k, &t);
+    }
+}
+
+void run_ec_pubkey_create_batch_test(void) {
+    int i;
+    test_ec_pubkey_create_batch_api();
+    test_ec_pubkey_create_sequence_api();
+    for (i = 0; i < count; i++) {
+        test_ec_pubkey_create_batch();
+        test_ec_pubkey_create_sequence();
+    }
+}
+
 void random_sign(secp256k1_scalar *sigr, secp256k1_scalar *sigs, const secp256k1_scalar *key, const secp256k1_scalar *msg, int *recid) {
     secp256k1_scalar nonce;
     do {
@@ -6165,6 +7081,7 @@ void random_sign(secp256k1_scalar *sigr, secp256k1_scalar *sigs, const secp256k1
 void test_ecdsa_sign_verify(void) {
     secp256k1_gej pubj;
     secp256k1_ge pub;
+    secp256k1_ge_storage pre[ECMULT_PUBKEY_PRECOMP_TABLE_SIZE], pre_lam[ECMULT_PUBKEY_PRECOMP_TABLE_SIZE];
     secp256k1_scalar one;
     secp256k1_scalar msg, key;
     secp256k1_scalar sigr, sigs;
@@ -6184,9 +7101,12 @@ void test_ecdsa_sign_verify(void) {
         random_sign(&sigr, &sigs, &key, &msg, NULL);
     }
     CHECK(secp256k1_ecdsa_sig_verify(&sigr, &sigs, &pub, &msg));
+    secp256k1_ecmult_pubkey_precomp_table(pre, pre_lam, &pub);
+    CHECK(secp256k1_ecdsa_sig_verify_precomp(&sigr, &sigs, pre, pre_lam, &msg));
     secp256k1_scalar_set_int(&one, 1);
     secp256k1_scalar_add(&msg, &msg, &one);
     CHECK(!secp256k1_ecdsa_sig_verify(&sigr, &sigs, &pub, &msg));
+    CHECK(!secp256k1_ecdsa_sig_verify_precomp(&sigr, &sigs, pre, pre_lam, &msg));
 }
 
 void run_ecdsa_sign_verify(void) {
@@ -6393,6 +7313,466 @@ void test_ecdsa_end_to_end(void) {
           secp256k1_ecdsa_verify(ctx, &signature[0], message, &pubkey) == 0);
 }
 
+void test_ecdsa_verify_precomp_api(void) {
+    secp256k1_context *none = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    secp256k1_pubkey_precomp *precomp;
+    secp256k1_ecdsa_signature sig;
+    secp256k1_pubkey pubkey;
+    unsigned char sk[32];
+    unsigned char msg[32];
+    int ecount = 0;
+
+    secp256k1_context_set_illegal_callback(none, counting_illegal_callback_fn, &ecount);
+    secp256k1_testrand256(msg);
+    memset(sk, 1, sizeof(sk));
+    CHECK(secp256k1_ec_pubkey_create(ctx, &pubkey, sk) == 1);
+    CHECK(secp256k1_ecdsa_sign(ctx, &sig, msg, sk, NULL, NULL) == 1);
+
+    precomp = secp256k1_pubkey_precomp_create(none, &pubkey);
+    CHECK(precomp != NULL);
+    CHECK(secp256k1_ecdsa_verify_precomp(none, &sig, msg, precomp) == 1);
+    CHECK(ecount == 0);
+    CHECK(secp256k1_ecdsa_verify_precomp(none, NULL, msg, precomp) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_ecdsa_verify_precomp(none, &sig, NULL, precomp) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_ecdsa_verify_precomp(none, &sig, msg, NULL) == 0);
+    CHECK(ecount == 3);
+    secp256k1_pubkey_precomp_destroy(none, precomp);
+    secp256k1_pubkey_precomp_destroy(none, NULL);
+
+    CHECK(secp256k1_pubkey_precomp_create(none, NULL) == NULL);
+    CHECK(ecount == 4);
+    memset(&pubkey, 0, sizeof(pubkey));
+    CHECK(secp256k1_pubkey_precomp_create(none, &pubkey) == NULL);
+    CHECK(ecount == 5);
+
+    secp256k1_context_destroy(none);
+}
+
+/* Compares secp256k1_ecdsa_verify_precomp with secp256k1_ecdsa_verify on
+ * valid, invalid and high-S signatures. */
+void test_ecdsa_verify_precomp(void) {
+    secp256k1_pubkey_precomp *precomp;
+    secp256k1_ecdsa_signature sig;
+    secp256k1_pubkey pubkey;
+    secp256k1_scalar r, s;
+    unsigned char sk[32];
+    unsigned char msg[32];
+    int i;
+
+    do {
+        secp256k1_testrand256_test(sk);
+    } while (!secp256k1_ec_pubkey_create(ctx, &pubkey, sk));
+    precomp = secp256k1_pubkey_precomp_create(ctx, &pubkey);
+    CHECK(precomp != NULL);
+    for (i = 0; i < 4; i++) {
+        secp256k1_testrand256_test(msg);
+        CHECK(secp256k1_ecdsa_sign(ctx, &sig, msg, sk, NULL, NULL) == 1);
+        if (i == 1) {
+            msg[secp256k1_testrand_int(32)] ^= 1 << secp256k1_testrand_int(8);
+        } else if (i == 2) {
+            secp256k1_ecdsa_signature_load(ctx, &r, &s, &sig);
+            secp256k1_scalar_negate(&s, &s);
+            secp256k1_ecdsa_signature_save(&sig, &r, &s);
+        } else if (i == 3) {
+            random_scalar_order_test(&r);
+            random_scalar_order_test(&s);
+            secp256k1_ecdsa_signature_save(&sig, &r, &s);
+        }
+        CHECK(secp256k1_ecdsa_verify_precomp(ctx, &sig, msg, precomp) == (i == 0));
+        CHECK(secp256k1_ecdsa_verify(ctx, &sig, msg, &pubkey) == (i == 0));
+    }
+    secp256k1_pubkey_precomp_destroy(ctx, precomp);
+}
+
+void run_ecdsa_verify_precomp(void) {
+    int i;
+    test_ecdsa_verify_precomp_api();
+    for (i = 0; i < count; i++) {
+        test_ecdsa_verify_precomp();
+    }
+}
+
+void test_ecdsa_verify_many_api(void) {
+    secp256k1_context *none = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    secp256k1_ecdsa_signature sig;
+    secp256k1_pubkey pubkey;
+    const secp256k1_ecdsa_signature *sigs[1];
+    const unsigned char *msgs[1];
+    const secp256k1_pubkey *pubkeys[1];
+    const secp256k1_ecdsa_signature *null_sigs[1] = { NULL };
+    unsigned char sk[32];
+    unsigned char msg[32];
+    int results[1];
+    int ecount = 0;
+
+    secp256k1_context_set_illegal_callback(none, counting_illegal_callback_fn, &ecount);
+    secp256k1_testrand256(msg);
+    memset(sk, 1, sizeof(sk));
+    CHECK(secp256k1_ec_pubkey_create(ctx, &pubkey, sk) == 1);
+    CHECK(secp256k1_ecdsa_sign(ctx, &sig, msg, sk, NULL, NULL) == 1);
+    sigs[0] = &sig;
+    msgs[0] = msg;
+    pubkeys[0] = &pubkey;
+
+    CHECK(secp256k1_ecdsa_verify_many(none, results, sigs, msgs, pubkeys, 1) == 1);
+    CHECK(results[0] == 1);
+    CHECK(secp256k1_ecdsa_verify_many(none, results, NULL, NULL, NULL, 0) == 1);
+    CHECK(ecount == 0);
+    CHECK(secp256k1_ecdsa_verify_many(none, NULL, sigs, msgs, pubkeys, 1) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_ecdsa_verify_many(none, results, NULL, msgs, pubkeys, 1) == 0);
+    CHECK(ecount == 2);
+    CHECK(results[0] == 0);
+    CHECK(secp256k1_ecdsa_verify_many(none, results, sigs, NULL, pubkeys, 1) == 0);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_ecdsa_verify_many(none, results, sigs, msgs, NULL, 1) == 0);
+    CHECK(ecount == 4);
+    CHECK(secp256k1_ecdsa_verify_many(none, results, null_sigs, msgs, pubkeys, 1) == 0);
+    CHECK(ecount == 5);
+
+    secp256k1_context_destroy(none);
+}
+
+/* Compares secp256k1_ecdsa_verify_many with secp256k1_ecdsa_verify on a mix of
+ * valid, invalid and high-S signatures. */
+void test_ecdsa_verify_many(void) {
+    secp256k1_ecdsa_signature sig[9];
+    secp256k1_pubkey pubkey[9];
+    const secp256k1_ecdsa_signature *sigs[9];
+    const unsigned char *msgs[9];
+    const secp256k1_pubkey *pubkeys[9];
+    secp256k1_scalar r, s;
+    unsigned char sk[32];
+    unsigned char msg[9][32];
+    int results[9];
+    int ret, all = 1;
+    int n = secp256k1_testrand_int(10);
+    int i;
+
+    for (i = 0; i < 9; i++) {
+        do {
+            secp256k1_testrand256_test(sk);
+        } while (!secp256k1_ec_pubkey_create(ctx, &pubkey[i], sk));
+        secp256k1_testrand256_test(msg[i]);
+        CHECK(secp256k1_ecdsa_sign(ctx, &sig[i], msg[i], sk, NULL, NULL) == 1);
+        switch (secp256k1_testrand_int(6)) {
+        case 0:
+            msg[i][secp256k1_testrand_int(32)] ^= 1 << secp256k1_testrand_int(8);
+            break;
+        case 1:
+            secp256k1_ecdsa_signature_load(ctx, &r, &s, &sig[i]);
+            secp256k1_scalar_negate(&s, &s);
+            secp256k1_ecdsa_signature_save(&sig[i], &r, &s);
+            break;
+        case 2:
+            random_scalar_order_test(&r);
+            random_scalar_order_test(&s);
+            secp256k1_ecdsa_signature_save(&sig[i], &r, &s);
+            break;
+        }
+        sigs[i] = &sig[i];
+        msgs[i] = msg[i];
+        pubkeys[i] = &pubkey[i];
+    }
+    ret = secp256k1_ecdsa_verify_many(ctx, results, sigs, msgs, pubkeys, n);
+    for (i = 0; i < n; i++) {
+        CHECK(results[i] == secp256k1_ecdsa_verify(ctx, &sig[i], msg[i], &pubkey[i]));
+        all &= results[i];
+    }
+    CHECK(ret == all);
+}
+
+void run_ecdsa_verify_many(void) {
+    int i;
+    test_ecdsa_verify_many_api();
+    for (i = 0; i < count; i++) {
+        test_ecdsa_verify_many();
+    }
+}
+
+void test_sigcache_table(void) {
+    static unsigned char entries[1024][SIGCACHE_ENTRY_SIZE];
+    static unsigned char keys[256][32];
+    struct secp256k1_sigcache_struct cache;
+    unsigned char salt[32];
+    unsigned char key[32];
+    int i;
+
+    secp256k1_testrand256(salt);
+    secp256k1_sigcache_init(&cache, entries, 1024, salt);
+    for (i = 0; i < 256; i++) {
+        secp256k1_testrand256(keys[i]);
+        CHECK(!secp256k1_sigcache_lookup(&cache, keys[i]));
+        secp256k1_sigcache_insert(&cache, keys[i]);
+        CHECK(secp256k1_sigcache_lookup(&cache, keys[i]));
+    }
+    /* At a load of a quarter, no entry is dropped. */
+    for (i = 0; i < 256; i++) {
+        CHECK(secp256k1_sigcache_lookup(&cache, keys[i]));
+        /* Inserting an existing entry does not change anything */
+        secp256k1_sigcache_insert(&cache, keys[i]);
+    }
+    /* Overfill the cache. The most recently inserted entry is always found. */
+    for (i = 0; i < 2048; i++) {
+        secp256k1_testrand256(key);
+        secp256k1_sigcache_insert(&cache, key);
+        CHECK(secp256k1_sigcache_lookup(&cache, key));
+    }
+
+    /* A cache with a single entry */
+    secp256k1_sigcache_init(&cache, entries, 1, salt);
+    secp256k1_sigcache_insert(&cache, keys[0]);
+    CHECK(secp256k1_sigcache_lookup(&cache, keys[0]));
+    secp256k1_sigcache_insert(&cache, keys[1]);
+    CHECK(secp256k1_sigcache_lookup(&cache, keys[1]));
+    CHECK(!secp256k1_sigcache_lookup(&cache, keys[0]));
+
+    CHECK(secp256k1_sigcache_n_entries(SIGCACHE_ENTRY_SIZE - 1) == 0);
+    CHECK(secp256k1_sigcache_n_entries(2 * SIGCACHE_ENTRY_SIZE + 1) == 2);
+}
+
+void test_ecdsa_verify_cached(void) {
+    secp256k1_context *none = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    secp256k1_sigcache *cache;
+    secp256k1_sigcache_stats stats = { 0, 0 };
+    secp256k1_ecdsa_signature sig, sig_high;
+    secp256k1_pubkey pubkey, pubkey2;
+    secp256k1_scalar r, s;
+    unsigned char salt[32];
+    unsigned char sk[32];
+    unsigned char msg[32];
+    int ecount = 0;
+
+    secp256k1_context_set_illegal_callback(none, counting_illegal_callback_fn, &ecount);
+    secp256k1_testrand256(salt);
+    do {
+        secp256k1_testrand256_test(sk);
+    } while (!secp256k1_ec_pubkey_create(ctx, &pubkey, sk));
+    secp256k1_testrand256_test(msg);
+    CHECK(secp256k1_ecdsa_sign(ctx, &sig, msg, sk, NULL, NULL) == 1);
+    secp256k1_ecdsa_signature_load(ctx, &r, &s, &sig);
+    secp256k1_scalar_negate(&s, &s);
+    secp256k1_ecdsa_signature_save(&sig_high, &r, &s);
+    pubkey2 = pubkey;
+    CHECK(secp256k1_ec_pubkey_negate(ctx, &pubkey2) == 1);
+
+    CHECK(secp256k1_sigcache_create(none, SIGCACHE_ENTRY_SIZE - 1, salt) == NULL);
+    CHECK(secp256k1_sigcache_create(none, 4096, NULL) == NULL);
+    CHECK(ecount == 1);
+    cache = secp256k1_sigcache_create(none, 4096, salt);
+    CHECK(cache != NULL);
+
+    /* Without storing, the signature is verified every time */
+    CHECK(secp256k1_ecdsa_verify_cached(none, cache, &stats, &sig, msg, &pubkey, 0) == 1);
+    CHECK(secp256k1_ecdsa_verify_cached(none, cache, &stats, &sig, msg, &pubkey, 0) == 1);
+    CHECK(stats.hits == 0 && stats.misses == 2);
+    CHECK(secp256k1_ecdsa_verify_cached(none, cache, &stats, &sig, msg, &pubkey, 1) == 1);
+    CHECK(secp256k1_ecdsa_verify_cached(none, cache, &stats, &sig, msg, &pubkey, 0) == 1);
+    CHECK(secp256k1_ecdsa_verify_cached(none, cache, NULL, &sig, msg, &pubkey, 1) == 1);
+    CHECK(stats.hits == 1 && stats.misses == 3);
+    /* Incorrect signatures are not cached */
+    CHECK(secp256k1_ecdsa_verify_cached(none, cache, &stats, &sig, msg, &pubkey2, 1) == 0);
+    CHECK(secp256k1_ecdsa_verify_cached(none, cache, &stats, &sig, msg, &pubkey2, 1) == 0);
+    CHECK(stats.hits == 1 && stats.misses == 5);
+    msg[0] ^= 1;
+    CHECK(secp256k1_ecdsa_verify_cached(none, cache, &stats, &sig, msg, &pubkey, 1) == 0);
+    msg[0] ^= 1;
+    /* A high-S signature is rejected without a lookup */
+    CHECK(secp256k1_ecdsa_verify_cached(none, cache, &stats, &sig_high, msg, &pubkey, 1) == 0);
+    CHECK(stats.hits == 1 && stats.misses == 6);
+    CHECK(ecount == 1);
+
+    CHECK(secp256k1_ecdsa_verify_cached(none, NULL, &stats, &sig, msg, &pubkey, 1) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_ecdsa_verify_cached(none, cache, &stats, NULL, msg, &pubkey, 1) == 0);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_ecdsa_verify_cached(none, cache, &stats, &sig, NULL, &pubkey, 1) == 0);
+    CHECK(ecount == 4);
+    CHECK(secp256k1_ecdsa_verify_cached(none, cache, &stats, &sig, msg, NULL, 1) == 0);
+    CHECK(ecount == 5);
+    memset(&pubkey2, 0, sizeof(pubkey2));
+    CHECK(secp256k1_ecdsa_verify_cached(none, cache, &stats, &sig, msg, &pubkey2, 1) == 0);
+    CHECK(ecount == 6);
+    CHECK(stats.hits == 1 && stats.misses == 6);
+
+    secp256k1_sigcache_destroy(none, cache);
+    secp256k1_sigcache_destroy(none, NULL);
+    secp256k1_context_destroy(none);
+}
+
+void run_sigcache_tests(void) {
+    int i;
+    test_ecdsa_verify_cached();
+    for (i = 0; i < count; i++) {
+        test_sigcache_table();
+    }
+}
+
+void test_pubkey_cache_table(void) {
+    static secp256k1_ge_storage entries[64 * PUBKEYCACHE_WAYS];
+    static secp256k1_ge points[64];
+    struct secp256k1_pubkey_cache_struct cache;
+    secp256k1_ge ge, neg;
+    secp256k1_fe zero;
+    unsigned char salt[32];
+    int i, found;
+
+    secp256k1_testrand256(salt);
+    secp256k1_pubkey_cache_init(&cache, entries, 64, salt);
+    for (i = 0; i < 64; i++) {
+        random_group_element_test(&points[i]);
+        CHECK(!secp256k1_pubkey_cache_lookup(&cache, &ge, &points[i].x));
+        secp256k1_pubkey_cache_insert(&cache, &points[i]);
+        CHECK(secp256k1_pubkey_cache_lookup(&cache, &ge, &points[i].x));
+        ge_equals_ge(&ge, &points[i]);
+        /* The negation has the same X coordinate, so it is not inserted. */
+        secp256k1_ge_neg(&neg, &points[i]);
+        secp256k1_pubkey_cache_insert(&cache, &neg);
+        CHECK(secp256k1_pubkey_cache_lookup(&cache, &ge, &points[i].x));
+        ge_equals_ge(&ge, &points[i]);
+    }
+    /* Points that have been replaced are not found, the others are returned
+     * unchanged. */
+    found = 0;
+    for (i = 0; i < 64; i++) {
+        if (secp256k1_pubkey_cache_lookup(&cache, &ge, &points[i].x)) {
+            ge_equals_ge(&ge, &points[i]);
+            found++;
+        }
+    }
+    CHECK(found > 32);
+    secp256k1_fe_clear(&zero);
+    CHECK(!secp256k1_pubkey_cache_lookup(&cache, &ge, &zero));
+
+    /* A cache with a single set */
+    secp256k1_pubkey_cache_init(&cache, entries, 1, salt);
+    for (i = 0; i < PUBKEYCACHE_WAYS; i++) {
+        secp256k1_pubkey_cache_insert(&cache, &points[i]);
+    }
+    for (i = 0; i < PUBKEYCACHE_WAYS; i++) {
+        CHECK(secp256k1_pubkey_cache_lookup(&cache, &ge, &points[i].x));
+    }
+    secp256k1_pubkey_cache_insert(&cache, &points[PUBKEYCACHE_WAYS]);
+    CHECK(secp256k1_pubkey_cache_lookup(&cache, &ge, &points[PUBKEYCACHE_WAYS].x));
+    found = 0;
+    for (i = 0; i < PUBKEYCACHE_WAYS; i++) {
+        found += secp256k1_pubkey_cache_lookup(&cache, &ge, &points[i].x);
+    }
+    CHECK(found == PUBKEYCACHE_WAYS - 1);
+
+    CHECK(secp256k1_pubkey_cache_n_sets(PUBKEYCACHE_WAYS * sizeof(secp256k1_ge_storage) - 1) == 0);
+    CHECK(secp256k1_pubkey_cache_n_sets(2 * PUBKEYCACHE_WAYS * sizeof(secp256k1_ge_storage) + 1) == 2);
+}
+
+void test_ec_pubkey_parse_cached(void) {
+    secp256k1_context *none = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    secp256k1_pubkey_cache *cache;
+    secp256k1_pubkey pubkey, pubkey_cached;
+    secp256k1_ge ge;
+    secp256k1_fe x;
+    unsigned char salt[32];
+    unsigned char sk[32];
+    unsigned char ser[65];
+    unsigned char ser_neg[33];
+    size_t len;
+    int ecount = 0;
+
+    secp256k1_context_set_illegal_callback(none, counting_illegal_callback_fn, &ecount);
+    secp256k1_testrand256(salt);
+    do {
+        secp256k1_testrand256_test(sk);
+    } while (!secp256k1_ec_pubkey_create(ctx, &pubkey, sk));
+    len = 33;
+    CHECK(secp256k1_ec_pubkey_serialize(ctx, ser, &len, &pubkey, SECP256K1_EC_COMPRESSED) == 1);
+    memcpy(ser_neg, ser, 33);
+    ser_neg[0] ^= 1;
+
+    CHECK(secp256k1_pubkey_cache_create(none, PUBKEYCACHE_WAYS * sizeof(secp256k1_ge_storage) - 1, salt) == NULL);
+    CHECK(secp256k1_pubkey_cache_create(none, 4096, NULL) == NULL);
+    CHECK(ecount == 1);
+    cache = secp256k1_pubkey_cache_create(none, 4096, salt);
+    CHECK(cache != NULL);
+
+    /* Without storing, the cache stays empty */
+    CHECK(secp256k1_ec_pubkey_parse_cached(none, cache, &pubkey_cached, ser, 33, 0) == 1);
+    CHECK(secp256k1_ec_pubkey_cmp(none, &pubkey, &pubkey_cached) == 0);
+    CHECK(secp256k1_fe_set_b32(&x, ser + 1));
+    CHECK(!secp256k1_pubkey_cache_lookup(cache, &ge, &x));
+    CHECK(secp256k1_ec_pubkey_parse_cached(none, cache, &pubkey_cached, ser, 33, 1) == 1);
+    CHECK(secp256k1_ec_pubkey_cmp(none, &pubkey, &pubkey_cached) == 0);
+    CHECK(secp256k1_pubkey_cache_lookup(cache, &ge, &x));
+    /* Both parities are parsed correctly from the cache */
+    CHECK(secp256k1_ec_pubkey_parse_cached(none, cache, &pubkey_cached, ser, 33, 0) == 1);
+    CHECK(secp256k1_ec_pubkey_cmp(none, &pubkey, &pubkey_cached) == 0);
+    CHECK(secp256k1_ec_pubkey_parse_cached(none, cache, &pubkey_cached, ser_neg, 33, 0) == 1);
+    CHECK(secp256k1_ec_pubkey_negate(none, &pubkey_cached) == 1);
+    CHECK(secp256k1_ec_pubkey_cmp(none, &pubkey, &pubkey_cached) == 0);
+    /* Uncompressed keys bypass the cache */
+    len = 65;
+    CHECK(secp256k1_ec_pubkey_serialize(ctx, ser, &len, &pubkey, SECP256K1_EC_UNCOMPRESSED) == 1);
+    CHECK(secp256k1_ec_pubkey_parse_cached(none, cache, &pubkey_cached, ser, 65, 1) == 1);
+    CHECK(secp256k1_ec_pubkey_cmp(none, &pubkey, &pubkey_cached) == 0);
+    CHECK(secp256k1_ec_pubkey_parse_cached(none, cache, &pubkey_cached, ser, 33, 1) == 0);
+    ser[0] = SECP256K1_TAG_PUBKEY_EVEN;
+    /* An X coordinate that overflows the field is rejected */
+    memset(ser + 1, 0xFF, 32);
+    CHECK(secp256k1_ec_pubkey_parse_cached(none, cache, &pubkey_cached, ser, 33, 1) == 0);
+    /* X = 0 is not on the curve */
+    memset(ser + 1, 0, 32);
+    CHECK(secp256k1_ec_pubkey_parse_cached(none, cache, &pubkey_cached, ser, 33, 1) == 0);
+    CHECK(ecount == 1);
+
+    CHECK(secp256k1_ec_pubkey_parse_cached(none, NULL, &pubkey_cached, ser_neg, 33, 1) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_ec_pubkey_parse_cached(none, cache, NULL, ser_neg, 33, 1) == 0);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_ec_pubkey_parse_cached(none, cache, &pubkey_cached, NULL, 33, 1) == 0);
+    CHECK(ecount == 4);
+
+    secp256k1_pubkey_cache_destroy(none, cache);
+    secp256k1_pubkey_cache_destroy(none, NULL);
+    secp256k1_context_destroy(none);
+}
+
+void test_ec_pubkey_parse_cached_random(void) {
+    secp256k1_pubkey_cache *cache;
+    secp256k1_pubkey pubkey, pubkey_cached;
+    secp256k1_ge ge;
+    unsigned char salt[32];
+    unsigned char ser[33];
+    size_t len;
+    int i, j;
+
+    secp256k1_testrand256(salt);
+    cache = secp256k1_pubkey_cache_create(ctx, 16 * PUBKEYCACHE_WAYS * sizeof(secp256k1_ge_storage), salt);
+    CHECK(cache != NULL);
+    for (i = 0; i < 64; i++) {
+        random_group_element_test(&ge);
+        secp256k1_pubkey_save(&pubkey, &ge);
+        len = 33;
+        CHECK(secp256k1_ec_pubkey_serialize(ctx, ser, &len, &pubkey, SECP256K1_EC_COMPRESSED) == 1);
+        for (j = 0; j < 2; j++) {
+            CHECK(secp256k1_ec_pubkey_parse_cached(ctx, cache, &pubkey_cached, ser, 33, 1) == 1);
+            CHECK(secp256k1_ec_pubkey_cmp(ctx, &pubkey, &pubkey_cached) == 0);
+        }
+        /* Random X coordinates give the same result as the uncached parse */
+        secp256k1_testrand256(ser + 1);
+        CHECK(secp256k1_ec_pubkey_parse_cached(ctx, cache, &pubkey_cached, ser, 33, 1) == secp256k1_ec_pubkey_parse(ctx, &pubkey, ser, 33));
+    }
+    secp256k1_pubkey_cache_destroy(ctx, cache);
+}
+
+void run_pubkey_cache_tests(void) {
+    int i;
+    test_ec_pubkey_parse_cached();
+    for (i = 0; i < count; i++) {
+        test_pubkey_cache_table();
+        test_ec_pubkey_parse_cached_random();
+    }
+}
+
 void test_random_pubkeys(void) {
     secp256k1_ge elem;
     secp256k1_ge elem2;
@@ -6509,6 +7889,236 @@ void run_random_pubkeys(void) {
     }
 }
 
+/* Uses nonce_function_test_retry for messages with an odd first byte, and the
+ * default nonce function otherwise. */
+static int nonce_function_test_retry_some(unsigned char *nonce32, const unsigned char *msg32, const unsigned char *key32, const unsigned char *algo16, void *data, unsigned int counter) {
+    if (msg32[0] & 1) {
+        return nonce_function_test_retry(nonce32, msg32, key32, algo16, data, counter);
+    }
+    return secp256k1_nonce_function_default(nonce32, msg32, key32, algo16, data, counter);
+}
+
+void test_ecdsa_sign_batch_api(void) {
+    secp256k1_context *none = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    secp256k1_ecdsa_signature sigs[2];
+    const unsigned char *msgs[2];
+    unsigned char msg[32];
+    unsigned char key[32];
+    int ecount = 0;
+
+    secp256k1_context_set_illegal_callback(none, counting_illegal_callback_fn, &ecount);
+    random_scalar_order_b32(key);
+    secp256k1_testrand256(msg);
+    msgs[0] = msg;
+    msgs[1] = msg;
+
+    CHECK(secp256k1_ecdsa_sign_batch(none, sigs, msgs, 2, key, NULL, NULL) == 1);
+    CHECK(secp256k1_ecdsa_sign_batch(none, NULL, NULL, 0, key, NULL, NULL) == 1);
+    CHECK(ecount == 0);
+    CHECK(secp256k1_ecdsa_sign_batch(none, NULL, msgs, 2, key, NULL, NULL) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_ecdsa_sign_batch(none, sigs, NULL, 2, key, NULL, NULL) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_ecdsa_sign_batch(none, sigs, msgs, 2, NULL, NULL, NULL) == 0);
+    CHECK(ecount == 3);
+    msgs[1] = NULL;
+    CHECK(secp256k1_ecdsa_sign_batch(none, sigs, msgs, 2, key, NULL, NULL) == 0);
+    CHECK(ecount == 4);
+
+    secp256k1_context_destroy(none);
+}
+
+void test_ecdsa_sign_batch(void) {
+    unsigned char msg_storage[2 * ECDSA_SIGN_BATCH_SIZE + 3][32];
+    const unsigned char *msgs[2 * ECDSA_SIGN_BATCH_SIZE + 3];
+    secp256k1_ecdsa_signature sigs[2 * ECDSA_SIGN_BATCH_SIZE + 3];
+    secp256k1_ecdsa_signature sig, zero_sig;
+    unsigned char key[32];
+    unsigned char extra[32];
+    size_t n, i;
+
+    memset(&zero_sig, 0, sizeof(zero_sig));
+    n = secp256k1_testrand_int(2 * ECDSA_SIGN_BATCH_SIZE + 3) + 1;
+    random_scalar_order_b32(key);
+    secp256k1_testrand256(extra);
+    for (i = 0; i < 2 * ECDSA_SIGN_BATCH_SIZE + 3; i++) {
+        secp256k1_testrand256(msg_storage[i]);
+        msgs[i] = msg_storage[i];
+    }
+
+    CHECK(secp256k1_ecdsa_sign_batch(ctx, sigs, msgs, n, key, NULL, NULL) == 1);
+    for (i = 0; i < n; i++) {
+        CHECK(secp256k1_ecdsa_sign(ctx, &sig, msgs[i], key, NULL, NULL) == 1);
+        CHECK(secp256k1_memcmp_var(&sig, &sigs[i], sizeof(sig)) == 0);
+    }
+    CHECK(secp256k1_ecdsa_sign_batch(ctx, sigs, msgs, n, key, NULL, extra) == 1);
+    for (i = 0; i < n; i++) {
+        CHECK(secp256k1_ecdsa_sign(ctx, &sig, msgs[i], key, NULL, extra) == 1);
+        CHECK(secp256k1_memcmp_var(&sig, &sigs[i], sizeof(sig)) == 0);
+    }
+    /* Messages whose first nonces are invalid fall back to the single
+     * signature path */
+    CHECK(secp256k1_ecdsa_sign_batch(ctx, sigs, msgs, n, key, nonce_function_test_retry_some, NULL) == 1);
+    for (i = 0; i < n; i++) {
+        CHECK(secp256k1_ecdsa_sign(ctx, &sig, msgs[i], key, nonce_function_test_retry_some, NULL) == 1);
+        CHECK(secp256k1_memcmp_var(&sig, &sigs[i], sizeof(sig)) == 0);
+    }
+
+    /* Failures clear the signatures */
+    CHECK(secp256k1_ecdsa_sign_batch(ctx, sigs, msgs, n, key, nonce_function_test_fail, NULL) == 0);
+    for (i = 0; i < n; i++) {
+        CHECK(secp256k1_memcmp_var(&zero_sig, &sigs[i], sizeof(sig)) == 0);
+    }
+    memset(key, 0xFF, 32);
+    CHECK(secp256k1_ecdsa_sign_batch(ctx, sigs, msgs, n, key, NULL, NULL) == 0);
+    for (i = 0; i < n; i++) {
+        CHECK(secp256k1_memcmp_var(&zero_sig, &sigs[i], sizeof(sig)) == 0);
+    }
+}
+
+void run_ecdsa_sign_batch(void) {
+    int i;
+    test_ecdsa_sign_batch_api();
+    for (i = 0; i < count; i++) {
+        test_ecdsa_sign_batch();
+    }
+}
+
+void test_ecdsa_signing_key_api(void) {
+    secp256k1_context *none = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    secp256k1_context *sign = secp256k1_context_create(SECP256K1_CONTEXT_SIGN);
+    secp256k1_ecdsa_signing_key signing_key, zero_key;
+    secp256k1_ecdsa_signature sig;
+    unsigned char msg[32];
+    unsigned char key[32];
+    int ecount = 0;
+
+    secp256k1_context_set_illegal_callback(none, counting_illegal_callback_fn, &ecount);
+    secp256k1_context_set_illegal_callback(sign, counting_illegal_callback_fn, &ecount);
+    memset(&zero_key, 0, sizeof(zero_key));
+    random_scalar_order_b32(key);
+    secp256k1_testrand256(msg);
+
+    CHECK(secp256k1_ecdsa_signing_key_create(none, &signing_key, key) == 1);
+    CHECK(secp256k1_ecdsa_signing_key_create(none, NULL, key) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_ecdsa_signing_key_create(none, &signing_key, NULL) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_memcmp_var(&signing_key, &zero_key, sizeof(signing_key)) == 0);
+    CHECK(secp256k1_ecdsa_signing_key_create(none, &signing_key, key) == 1);
+
+    CHECK(secp256k1_ecdsa_sign_with_key(sign, &sig, msg, &signing_key, NULL) == 1);
+    CHECK(secp256k1_ecdsa_sign_with_key(sign, NULL, msg, &signing_key, NULL) == 0);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_ecdsa_sign_with_key(sign, &sig, NULL, &signing_key, NULL) == 0);
+    CHECK(ecount == 4);
+    CHECK(secp256k1_ecdsa_sign_with_key(sign, &sig, msg, NULL, NULL) == 0);
+    CHECK(ecount == 5);
+
+    secp256k1_context_destroy(none);
+    secp256k1_context_destroy(sign);
+}
+
+void test_ecdsa_signing_key(void) {
+    secp256k1_ecdsa_signing_key signing_key, zero_key;
+    secp256k1_ecdsa_signature sig, sig2, zero_sig;
+    unsigned char msg[32];
+    unsigned char key[32];
+    unsigned char extra[32];
+
+    memset(&zero_key, 0, sizeof(zero_key));
+    memset(&zero_sig, 0, sizeof(zero_sig));
+    random_scalar_order_b32(key);
+    secp256k1_testrand256(msg);
+    secp256k1_testrand256(extra);
+
+    CHECK(secp256k1_ecdsa_signing_key_create(ctx, &signing_key, key) == 1);
+    CHECK(secp256k1_ecdsa_sign_with_key(ctx, &sig, msg, &signing_key, NULL) == 1);
+    CHECK(secp256k1_ecdsa_sign(ctx, &sig2, msg, key, NULL, NULL) == 1);
+    CHECK(secp256k1_memcmp_var(&sig, &sig2, sizeof(sig)) == 0);
+    CHECK(secp256k1_ecdsa_sign_with_key(ctx, &sig, msg, &signing_key, extra) == 1);
+    CHECK(secp256k1_ecdsa_sign(ctx, &sig2, msg, key, NULL, extra) == 1);
+    CHECK(secp256k1_memcmp_var(&sig, &sig2, sizeof(sig)) == 0);
+
+    /* Invalid secret keys give a cleared signing key, which cannot sign */
+    memset(key, 0xFF, 32);
+    CHECK(secp256k1_ecdsa_signing_key_create(ctx, &signing_key, key) == 0);
+    CHECK(secp256k1_memcmp_var(&signing_key, &zero_key, sizeof(signing_key)) == 0);
+    CHECK(secp256k1_ecdsa_sign_with_key(ctx, &sig, msg, &signing_key, NULL) == 0);
+    CHECK(secp256k1_memcmp_var(&sig, &zero_sig, sizeof(sig)) == 0);
+}
+
+void test_ecdsa_sign_low_r_api(void) {
+    secp256k1_context *sign = secp256k1_context_create(SECP256K1_CONTEXT_SIGN);
+    secp256k1_ecdsa_signing_key signing_key;
+    secp256k1_ecdsa_signature sig;
+    unsigned char msg[32];
+    unsigned char key[32];
+    int ecount = 0;
+
+    secp256k1_context_set_illegal_callback(sign, counting_illegal_callback_fn, &ecount);
+    random_scalar_order_b32(key);
+    secp256k1_testrand256(msg);
+    CHECK(secp256k1_ecdsa_signing_key_create(sign, &signing_key, key) == 1);
+
+    CHECK(secp256k1_ecdsa_sign_low_r(sign, &sig, msg, &signing_key) == 1);
+    CHECK(secp256k1_ecdsa_sign_low_r(sign, NULL, msg, &signing_key) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_ecdsa_sign_low_r(sign, &sig, NULL, &signing_key) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_ecdsa_sign_low_r(sign, &sig, msg, NULL) == 0);
+    CHECK(ecount == 3);
+
+    secp256k1_context_destroy(sign);
+}
+
+/* Compares secp256k1_ecdsa_sign_low_r with the grinding loop of Bitcoin Core. */
+void test_ecdsa_sign_low_r(void) {
+    secp256k1_ecdsa_signing_key signing_key, zero_key;
+    secp256k1_ecdsa_signature sig, sig2, zero_sig;
+    unsigned char msg[32];
+    unsigned char key[32];
+    unsigned char extra[32] = {0};
+    unsigned char compact[64];
+    uint32_t counter = 0;
+
+    memset(&zero_key, 0, sizeof(zero_key));
+    memset(&zero_sig, 0, sizeof(zero_sig));
+    random_scalar_order_b32(key);
+    secp256k1_testrand256(msg);
+
+    CHECK(secp256k1_ecdsa_signing_key_create(ctx, &signing_key, key) == 1);
+    CHECK(secp256k1_ecdsa_sign_low_r(ctx, &sig, msg, &signing_key) == 1);
+    CHECK(secp256k1_ecdsa_sign(ctx, &sig2, msg, key, NULL, NULL) == 1);
+    CHECK(secp256k1_ecdsa_signature_serialize_compact(ctx, compact, &sig2) == 1);
+    while (compact[0] >= 0x80) {
+        counter++;
+        extra[0] = counter;
+        extra[1] = counter >> 8;
+        extra[2] = counter >> 16;
+        extra[3] = counter >> 24;
+        CHECK(secp256k1_ecdsa_sign(ctx, &sig2, msg, key, NULL, extra) == 1);
+        CHECK(secp256k1_ecdsa_signature_serialize_compact(ctx, compact, &sig2) == 1);
+    }
+    CHECK(secp256k1_memcmp_var(&sig, &sig2, sizeof(sig)) == 0);
+
+    /* Invalid signing keys give no signature */
+    CHECK(secp256k1_ecdsa_sign_low_r(ctx, &sig, msg, &zero_key) == 0);
+    CHECK(secp256k1_memcmp_var(&sig, &zero_sig, sizeof(sig)) == 0);
+}
+
+void run_ecdsa_signing_key(void) {
+    int i;
+    test_ecdsa_signing_key_api();
+    test_ecdsa_sign_low_r_api();
+    for (i = 0; i < count; i++) {
+        test_ecdsa_signing_key();
+    }
+    for (i = 0; i < 4*count; i++) {
+        test_ecdsa_sign_low_r();
+    }
+}
+
 void run_ecdsa_end_to_end(void) {
     int i;
     for (i = 0; i < 64*count; i++) {
@@ -7174,6 +8784,10 @@ void run_ecdsa_edge_cases(void) {
 # include "modules/recovery/tests_impl.h"
 #endif
 
+#ifdef ENABLE_MODULE_ECMULT
+# include "modules/ecmult/tests_impl.h"
+#endif
+
 #ifdef ENABLE_MODULE_EXTRAKEYS
 # include "modules/extrakeys/tests_impl.h"
 #endif
@@ -7415,14 +9029,19 @@ int main(int argc, char **argv) {
     run_int128_tests();
 #endif
     run_ctz_tests();
+    run_rotr32_tests();
     run_modinv_tests();
     run_inverse_tests();
 
     run_sha256_known_output_tests();
+    run_sha256_transform_tests();
     run_sha256_counter_tests();
     run_hmac_sha256_tests();
     run_rfc6979_hmac_sha256_tests();
     run_tagged_sha256_tests();
+    run_tagged_hasher_tests();
+    run_sha256_many_tests();
+    run_tagged_sha256_batch_tests();
 
     /* scalar tests */
     run_scalar_tests();
@@ -7432,6 +9051,7 @@ int main(int argc, char **argv) {
     run_field_misc();
     run_field_convert();
     run_fe_mul();
+    run_fe4_tests();
     run_sqr();
     run_sqrt();
 
@@ -7439,15 +9059,21 @@ int main(int argc, char **argv) {
     run_ge();
     run_gej();
     run_group_decompress();
+    run_ge_storage_table_select_tests();
+    run_gej_x4_tests();
 
     /* ecmult tests */
     run_ecmult_pre_g();
     run_wnaf();
     run_point_times_order();
     run_ecmult_near_split_bound();
+    run_ecmult_pubkey_precomp();
+    run_ecmult_many();
     run_ecmult_chain();
     run_ecmult_constants();
     run_ecmult_gen_blind();
+    run_ecmult_gen_edge_cases();
+    run_ecmult_gen_large_table();
     run_ecmult_const_tests();
     run_ecmult_multi_tests();
     run_ec_combine();
@@ -7464,6 +9090,9 @@ int main(int argc, char **argv) {
     /* EC key arithmetic test */
     run_eckey_negate_test();
 
+    /* Batch public key creation */
+    run_ec_pubkey_create_batch_test();
+
 #ifdef ENABLE_MODULE_ECDH
     /* ecdh tests */
     run_ecdh_tests();
@@ -7475,6 +9104,12 @@ int main(int argc, char **argv) {
     run_ecdsa_der_parse();
     run_ecdsa_sign_verify();
     run_ecdsa_end_to_end();
+    run_ecdsa_sign_batch();
+    run_ecdsa_signing_key();
+    run_ecdsa_verify_precomp();
+    run_ecdsa_verify_many();
+    run_sigcache_tests();
+    run_pubkey_cache_tests();
     run_ecdsa_edge_cases();
 
 #ifdef ENABLE_MODULE_RECOVERY
@@ -7482,6 +9117,10 @@ int main(int argc, char **argv) {
     run_recovery_tests();
 #endif
 
+#ifdef ENABLE_MODULE_ECMULT
+    run_ecmult_module_tests();
+#endif
+
 #ifdef ENABLE_MODULE_EXTRAKEYS
     run_extrakeys_tests();
 #endif
@@ -21,6 +21,9 @@
 #define DEBUG_CONFIG_MSG(x) "DEBUG_CONFIG: " x
 #define DEBUG_CONFIG_DEF(x) DEBUG_CONFIG_MSG(#x "=" STR(x))
 
+/* Ceiling of integer division, for positive x and y. */
+#define CEIL_DIV(x, y) (1 + ((x) - 1) / (y))
+
 typedef struct {
     void (*fn)(const char *text, void* data);
     const void* data;
@@ -164,6 +167,13 @@ static SECP256K1_INLINE void *checked_realloc(const secp256k1_callback* cb, void
 # endif
 #endif
 
+/* Hint that the memory at p will be read soon. */
+#if SECP256K1_GNUC_PREREQ(3,1)
+# define SECP256K1_PREFETCH(p) __builtin_prefetch(p)
+#else
+# define SECP256K1_PREFETCH(p) ((void)(p))
+#endif
+
 #if defined(_WIN32)
 # define I64FORMAT "I64d"
 # define I64uFORMAT "I64u"
@@ -326,6 +336,18 @@ static SECP256K1_INLINE int secp256k1_ctz64_var(uint64_t x) {
 #endif
 }
 
+/* Rotate a uint32_t to the right. */
+static SECP256K1_INLINE uint32_t secp256k1_rotr32(const uint32_t x, const unsigned int by) {
+#if defined(_MSC_VER)
+    return _rotr(x, by);  /* needs <stdlib.h> */
+#else
+    /* Reduce rotation amount to avoid UB when shifting. */
+    const unsigned int mask = CHAR_BIT * sizeof(x) - 1;
+    /* Turned into a rot instruction by GCC and clang. */
+    return (x >> (by & mask)) | (x << ((-by) & mask));
+#endif
+}
+
 /* Read a uint32_t in big endian */
 SECP256K1_INLINE static uint32_t secp256k1_read_be32(const unsigned char* p) {
     return (uint32_t)p[0] << 24 |
@@ -342,4 +364,10 @@ SECP256K1_INLINE static void secp256k1_write_be32(unsigned char* p, uint32_t x)
     p[0] = x >> 24;
 }
 
+/* Write a uint64_t in big endian */
+SECP256K1_INLINE static void secp256k1_write_be64(unsigned char* p, uint64_t x) {
+    secp256k1_write_be32(p, x >> 32);
+    secp256k1_write_be32(p + 4, x);
+}
+
 #endif /* SECP256K1_UTIL_H */
@@ -31,6 +31,7 @@ void run_tests(secp256k1_context *ctx, unsigned char *key);
 
 int main(void) {
     secp256k1_context* ctx;
+    secp256k1_context* large_ctx;
     unsigned char key[32];
     int ret, i;
 
@@ -51,6 +52,15 @@ int main(void) {
 
     run_tests(ctx, key);
 
+    /* Repeat the tests with the runtime table for the multiplication with the generator.
+     * Note that both contexts use the AVX2 table lookups if the library was built with them
+     * and the CPU supports AVX2; the portable lookups are covered by a build with
+     * --with-x86-simd=no. */
+    large_ctx = secp256k1_context_create(SECP256K1_CONTEXT_LARGE_GEN_TABLE
+                                         | SECP256K1_CONTEXT_DECLASSIFY);
+    run_tests(large_ctx, key);
+    secp256k1_context_destroy(large_ctx);
+
     /* Test context randomisation. Do this last because it leaves the context
      * tainted. */
     VALGRIND_MAKE_MEM_UNDEFINED(key, 32);
@@ -64,7 +74,12 @@ int main(void) {
 
 void run_tests(secp256k1_context *ctx, unsigned char *key) {
     secp256k1_ecdsa_signature signature;
+    secp256k1_ecdsa_signature signature_batch[2];
+    const unsigned char *msgs[2];
+    secp256k1_ecdsa_signing_key signing_key;
     secp256k1_pubkey pubkey;
+    secp256k1_pubkey pubkey_batch[2];
+    const unsigned char *seckeys[2];
     size_t siglen = 74;
     size_t outputlen = 33;
     int i;
@@ -72,12 +87,22 @@ void run_tests(secp256k1_context *ctx, unsigned char *key) {
     unsigned char msg[32];
     unsigned char sig[74];
     unsigned char spubkey[33];
+#ifdef ENABLE_MODULE_ECDH
+    unsigned char *outputs[2];
+    const secp256k1_pubkey *pubkeys[2];
+#endif
 #ifdef ENABLE_MODULE_RECOVERY
     secp256k1_ecdsa_recoverable_signature recoverable_signature;
     int recid;
 #endif
 #ifdef ENABLE_MODULE_EXTRAKEYS
     secp256k1_keypair keypair;
+    secp256k1_keypair keypair_batch[2];
+#endif
+#ifdef ENABLE_MODULE_SCHNORRSIG
+    unsigned char sig64_batch[2][64];
+    unsigned char *sig64s[2];
+    size_t msglens[2];
 #endif
 
     for (i = 0; i < 32; i++) {
@@ -92,6 +117,24 @@ void run_tests(secp256k1_context *ctx, unsigned char *key) {
     CHECK(ret);
     CHECK(secp256k1_ec_pubkey_serialize(ctx, spubkey, &outputlen, &pubkey, SECP256K1_EC_COMPRESSED) == 1);
 
+    /* Test batch keygen, which shares a field inversion between the keys. */
+    seckeys[0] = key;
+    seckeys[1] = key;
+    VALGRIND_MAKE_MEM_UNDEFINED(key, 32);
+    ret = secp256k1_ec_pubkey_create_batch(ctx, pubkey_batch, seckeys, 2);
+    VALGRIND_MAKE_MEM_DEFINED(pubkey_batch, sizeof(pubkey_batch));
+    VALGRIND_MAKE_MEM_DEFINED(&ret, sizeof(ret));
+    CHECK(ret);
+
+    /* Test keygen for a sequence of secret keys with a secret step. */
+    VALGRIND_MAKE_MEM_UNDEFINED(key, 32);
+    VALGRIND_MAKE_MEM_UNDEFINED(msg, 32);
+    ret = secp256k1_ec_pubkey_create_sequence(ctx, pubkey_batch, key, msg, 2);
+    VALGRIND_MAKE_MEM_DEFINED(pubkey_batch, sizeof(pubkey_batch));
+    VALGRIND_MAKE_MEM_DEFINED(&ret, sizeof(ret));
+    CHECK(ret);
+    VALGRIND_MAKE_MEM_DEFINED(msg, 32);
+
     /* Test signing. */
     VALGRIND_MAKE_MEM_UNDEFINED(key, 32);
     ret = secp256k1_ecdsa_sign(ctx, &signature, msg, key, NULL, NULL);
@@ -100,12 +143,45 @@ void run_tests(secp256k1_context *ctx, unsigned char *key) {
     CHECK(ret);
     CHECK(secp256k1_ecdsa_signature_serialize_der(ctx, sig, &siglen, &signature));
 
+    /* Test batch signing, which shares the nonce inversions. */
+    msgs[0] = msg;
+    msgs[1] = msg;
+    VALGRIND_MAKE_MEM_UNDEFINED(key, 32);
+    ret = secp256k1_ecdsa_sign_batch(ctx, signature_batch, msgs, 2, key, NULL, NULL);
+    VALGRIND_MAKE_MEM_DEFINED(signature_batch, sizeof(signature_batch));
+    VALGRIND_MAKE_MEM_DEFINED(&ret, sizeof(ret));
+    CHECK(ret);
+
+    /* Test signing with a signing key. */
+    VALGRIND_MAKE_MEM_UNDEFINED(key, 32);
+    ret = secp256k1_ecdsa_signing_key_create(ctx, &signing_key, key);
+    VALGRIND_MAKE_MEM_DEFINED(&ret, sizeof(ret));
+    CHECK(ret);
+    ret = secp256k1_ecdsa_sign_with_key(ctx, &signature, msg, &signing_key, NULL);
+    VALGRIND_MAKE_MEM_DEFINED(&signature, sizeof(secp256k1_ecdsa_signature));
+    VALGRIND_MAKE_MEM_DEFINED(&ret, sizeof(ret));
+    CHECK(ret);
+    ret = secp256k1_ecdsa_sign_low_r(ctx, &signature, msg, &signing_key);
+    VALGRIND_MAKE_MEM_DEFINED(&signature, sizeof(secp256k1_ecdsa_signature));
+    VALGRIND_MAKE_MEM_DEFINED(&ret, sizeof(ret));
+    CHECK(ret);
+
 #ifdef ENABLE_MODULE_ECDH
     /* Test ECDH. */
     VALGRIND_MAKE_MEM_UNDEFINED(key, 32);
     ret = secp256k1_ecdh(ctx, msg, &pubkey, key, NULL, NULL);
     VALGRIND_MAKE_MEM_DEFINED(&ret, sizeof(ret));
     CHECK(ret == 1);
+
+    /* Test batch ECDH. */
+    outputs[0] = msg;
+    outputs[1] = sig;
+    pubkeys[0] = &pubkey;
+    pubkeys[1] = &pubkey;
+    VALGRIND_MAKE_MEM_UNDEFINED(key, 32);
+    ret = secp256k1_ecdh_batch(ctx, outputs, pubkeys, 2, key, NULL, NULL);
+    VALGRIND_MAKE_MEM_DEFINED(&ret, sizeof(ret));
+    CHECK(ret == 1);
 #endif
 
 #ifdef ENABLE_MODULE_RECOVERY
@@ -148,6 +224,11 @@ void run_tests(secp256k1_context *ctx, unsigned char *key) {
     VALGRIND_MAKE_MEM_DEFINED(&ret, sizeof(ret));
     CHECK(ret == 1);
 
+    VALGRIND_MAKE_MEM_UNDEFINED(key, 32);
+    ret = secp256k1_keypair_create_batch(ctx, keypair_batch, seckeys, 2);
+    VALGRIND_MAKE_MEM_DEFINED(&ret, sizeof(ret));
+    CHECK(ret == 1);
+
     /* The tweak is not treated as a secret in keypair_tweak_add */
     VALGRIND_MAKE_MEM_DEFINED(msg, 32);
     ret = secp256k1_keypair_xonly_tweak_add(ctx, &keypair, msg);
@@ -169,5 +250,16 @@ void run_tests(secp256k1_context *ctx, unsigned char *key) {
     ret = secp256k1_schnorrsig_sign32(ctx, sig, msg, &keypair, NULL);
     VALGRIND_MAKE_MEM_DEFINED(&ret, sizeof(ret));
     CHECK(ret == 1);
+
+    sig64s[0] = sig64_batch[0];
+    sig64s[1] = sig64_batch[1];
+    msgs[0] = msg;
+    msgs[1] = msg;
+    msglens[0] = 32;
+    msglens[1] = 32;
+    VALGRIND_MAKE_MEM_UNDEFINED(&keypair, sizeof(keypair));
+    ret = secp256k1_schnorrsig_sign_batch(ctx, sig64s, msgs, msglens, 2, &keypair, NULL);
+    VALGRIND_MAKE_MEM_DEFINED(&ret, sizeof(ret));
+    CHECK(ret == 1);
 #endif
 }